@@ -30,6 +30,7 @@
 
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_asyncio.h>
 #include <SDL3/SDL_atomic.h>
 #include <SDL3/SDL_audio.h>
 #include <SDL3/SDL_bits.h>
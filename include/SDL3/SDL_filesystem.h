@@ -296,6 +296,51 @@ typedef int (SDLCALL *SDL_EnumerateDirectoryCallback)(void *userdata, const char
  */
 extern SDL_DECLSPEC int SDLCALL SDL_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback callback, void *userdata);
 
+/**
+ * Flags for SDL_EnumerateDirectoryWithInfo().
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ */
+typedef Uint32 SDL_EnumerateFlags;
+
+#define SDL_ENUMERATE_RECURSIVE (1u << 0)  /**< Also enumerate all subdirectories. */
+
+/* Callback for directory enumeration with file information. Return 1 to keep
+   enumerating, 0 to stop enumerating (no error), -1 to stop enumerating and
+   report an error. `dirname` is the directory being enumerated, `fname` is
+   the enumerated entry and `info` is what SDL_GetPathInfo() would report for
+   it. */
+typedef int (SDLCALL *SDL_EnumerateDirectoryInfoCallback)(void *userdata, const char *dirname, const char *fname, const SDL_PathInfo *info);
+
+/**
+ * Enumerate a directory through a callback function, along with information
+ * about each entry.
+ *
+ * This works like SDL_EnumerateDirectory(), but also provides the same
+ * information about each entry that SDL_GetPathInfo() would. This is gathered
+ * while reading the directory, which is much faster than calling
+ * SDL_GetPathInfo() on every entry.
+ *
+ * If `flags` contains SDL_ENUMERATE_RECURSIVE, every subdirectory is
+ * enumerated as well, with `dirname` set to the subdirectory's path.
+ * All the entries of a directory are provided before any of its
+ * subdirectories are enumerated. Symbolic links to directories are reported,
+ * but not descended into.
+ *
+ * \param path the path of the directory to enumerate.
+ * \param flags `SDL_ENUMERATE_*` bitflags that affect this enumeration.
+ * \param callback a function that is called for each entry in the directory.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_EnumerateDirectory
+ * \sa SDL_GetPathInfo
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_EnumerateDirectoryWithInfo(const char *path, SDL_EnumerateFlags flags, SDL_EnumerateDirectoryInfoCallback callback, void *userdata);
+
 /**
  * Remove a file or an empty directory.
  *
@@ -197,6 +197,23 @@ extern "C" {
  */
 #define SDL_HINT_APPLE_TV_REMOTE_ALLOW_ROTATION "SDL_APPLE_TV_REMOTE_ALLOW_ROTATION"
 
+/**
+ * A variable controlling which backend is used for asynchronous I/O queues.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "io_uring": Use io_uring on Linux, if the kernel supports it. (default)
+ * - "generic": Use a pool of threads doing blocking reads and writes.
+ *
+ * If the requested backend isn't available, the generic one is used.
+ *
+ * This hint should be set before calling SDL_CreateAsyncIOQueue(), and
+ * affects queues created afterwards.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_ASYNCIO_DRIVER "SDL_ASYNCIO_DRIVER"
+
 /**
  * A variable controlling the audio category on iOS and macOS.
  *
@@ -2751,6 +2768,26 @@ extern "C" {
  */
 #define SDL_HINT_STORAGE_USER_DRIVER "SDL_STORAGE_USER_DRIVER"
 
+/**
+ * A variable controlling how many threads SDL may use to process large
+ * surfaces.
+ *
+ * This is used by SDL_PremultiplyAlpha(), SDL_PremultiplySurfaceAlpha() and
+ * SDL_ClearSurface() on surfaces of a million pixels or more, which are split
+ * into bands of rows that are processed in parallel.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Use one thread per CPU core.
+ * - "1": Process surfaces on the calling thread. (default)
+ * - "N": Use up to N threads.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_SURFACE_THREADS "SDL_SURFACE_THREADS"
+
 /**
  * Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as
  * realtime.
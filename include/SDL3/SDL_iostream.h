@@ -241,6 +241,45 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromFile(const char *file, cons
 #define SDL_PROP_IOSTREAM_STDIO_FILE_POINTER        "SDL.iostream.stdio.file"
 #define SDL_PROP_IOSTREAM_ANDROID_AASSET_POINTER    "SDL.iostream.android.aasset"
 
+/**
+ * Use this function to open a file for reading through a memory mapping.
+ *
+ * The whole file is mapped read-only into the address space of the process
+ * and reads are served by copying directly out of the mapping, so large
+ * files can be read randomly without loading them into memory first. The
+ * operating system shares the mapped pages with other processes that map or
+ * read the same file.
+ *
+ * If the file can't be mapped, for example if it's an Android asset or the
+ * platform doesn't support memory mapping, this falls back to
+ * `SDL_IOFromFile(file, "rb")`.
+ *
+ * The file should not be modified while it's mapped, the contents of the
+ * stream are undefined if it is, and truncating it may crash the program.
+ *
+ * The following properties will be set at creation time by SDL if the file
+ * was mapped:
+ *
+ * - `SDL_PROP_IOSTREAM_MEMORY_POINTER`: a pointer to the start of the
+ *   read-only mapping, which remains valid until the stream is closed.
+ * - `SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER`: the size of the mapping, in
+ *   bytes.
+ *
+ * \param file a UTF-8 string representing the filename to open.
+ * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_IOFromFile
+ * \sa SDL_IOFromConstMem
+ * \sa SDL_CloseIO
+ * \sa SDL_ReadIO
+ * \sa SDL_SeekIO
+ * \sa SDL_TellIO
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromMappedFile(const char *file);
+
 /**
  * Use this function to prepare a read-write memory buffer for use with
  * SDL_IOStream.
@@ -256,6 +295,13 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromFile(const char *file, cons
  * buffer, you should use SDL_IOFromConstMem() with a read-only buffer of
  * memory instead.
  *
+ * The following properties will be set at creation time by SDL:
+ *
+ * - `SDL_PROP_IOSTREAM_MEMORY_POINTER`: this will be the `mem` parameter that
+ *   was passed to this function.
+ * - `SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER`: this will be the `size` parameter
+ *   that was passed to this function.
+ *
  * \param mem a pointer to a buffer to feed an SDL_IOStream stream.
  * \param size the buffer size, in bytes.
  * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
@@ -272,6 +318,9 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromFile(const char *file, cons
  */
 extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromMem(void *mem, size_t size);
 
+#define SDL_PROP_IOSTREAM_MEMORY_POINTER            "SDL.iostream.memory.base"
+#define SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER        "SDL.iostream.memory.size"
+
 /**
  * Use this function to prepare a read-only memory buffer for use with
  * SDL_IOStream.
@@ -289,6 +338,13 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromMem(void *mem, size_t size)
  * If you need to write to a memory buffer, you should use SDL_IOFromMem()
  * with a writable buffer of memory instead.
  *
+ * The following properties will be set at creation time by SDL:
+ *
+ * - `SDL_PROP_IOSTREAM_MEMORY_POINTER`: this will be the `mem` parameter that
+ *   was passed to this function.
+ * - `SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER`: this will be the `size` parameter
+ *   that was passed to this function.
+ *
  * \param mem a pointer to a read-only buffer to feed an SDL_IOStream stream.
  * \param size the buffer size, in bytes.
  * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
@@ -332,6 +388,45 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromConstMem(const void *mem, s
  */
 extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromDynamicMem(void);
 
+/**
+ * Use this function to add a read-ahead and write-behind buffer to an
+ * existing SDL_IOStream.
+ *
+ * Reads from the returned stream are served from a buffer that is refilled
+ * with one large read from `src` at a time, and writes are collected in the
+ * buffer and passed to `src` when it fills up. This makes many small reads
+ * and writes, such as the ones done by SDL_ReadU8(), SDL_ReadU32LE() and
+ * friends, much cheaper; when the bytes are already buffered those functions
+ * don't go through the stream interface at all.
+ *
+ * Reads and writes that are at least as big as the buffer go straight to
+ * `src`.
+ *
+ * Pending writes are passed to `src` when the returned stream is read from,
+ * seeked or closed, so `SDL_SeekIO(stream, 0, SDL_IO_SEEK_CUR)` can be used
+ * to flush them. Seeking within the buffered data doesn't touch `src`.
+ *
+ * `src` should not be used directly while the buffered stream is open, as
+ * its position runs ahead of the buffered stream's while there is read-ahead
+ * data.
+ *
+ * \param src the SDL_IOStream to buffer.
+ * \param buffer_size the size of the buffer, in bytes, or 0 to use a
+ *                    default size of 4 kilobytes.
+ * \param closeio if SDL_TRUE, calls SDL_CloseIO() on `src` when the buffered
+ *                stream is closed, or if this function fails.
+ * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseIO
+ * \sa SDL_ReadIO
+ * \sa SDL_SeekIO
+ * \sa SDL_WriteIO
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_CreateBufferedIO(SDL_IOStream *src, size_t buffer_size, SDL_bool closeio);
+
 #define SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER    "SDL.iostream.dynamic.memory"
 #define SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER  "SDL.iostream.dynamic.chunksize"
 
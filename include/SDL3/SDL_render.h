@@ -236,6 +236,13 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRenderer(SDL_Window *window
  * - `SDL_PROP_RENDERER_CREATE_PRESENT_VSYNC_NUMBER`: non-zero if you want
  *   present synchronized with the refresh rate. This property can take any
  *   value that is supported by SDL_SetRenderVSync() for the renderer.
+ * - `SDL_PROP_RENDERER_CREATE_RENDER_THREAD_BOOLEAN`: true if you want
+ *   SDL_RenderPresent() to hand the finished frame to a separate thread that
+ *   draws and presents it, while the application goes on to record the next
+ *   frame. Functions that need the drawing results or that modify textures
+ *   and render targets wait for that thread to finish first. This is only
+ *   supported by the software renderer on windows with a native framebuffer,
+ *   other renderers draw on the calling thread. Defaults to false.
  *
  * With the vulkan renderer:
  *
@@ -271,6 +278,7 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRendererWithProperties(SDL_
 #define SDL_PROP_RENDERER_CREATE_SURFACE_POINTER                            "surface"
 #define SDL_PROP_RENDERER_CREATE_OUTPUT_COLORSPACE_NUMBER                   "output_colorspace"
 #define SDL_PROP_RENDERER_CREATE_PRESENT_VSYNC_NUMBER                       "present_vsync"
+#define SDL_PROP_RENDERER_CREATE_RENDER_THREAD_BOOLEAN                      "render_thread"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_INSTANCE_POINTER                    "vulkan.instance"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_SURFACE_NUMBER                      "vulkan.surface"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_PHYSICAL_DEVICE_POINTER             "vulkan.physical_device"
@@ -344,6 +352,9 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  * - `SDL_PROP_RENDERER_SURFACE_POINTER`: the surface where rendering is
  *   displayed, if this is a software renderer without a window
  * - `SDL_PROP_RENDERER_VSYNC_NUMBER`: the current vsync setting
+ * - `SDL_PROP_RENDERER_RENDER_THREAD_BOOLEAN`: true if frames are drawn and
+ *   presented on a separate render thread, see
+ *   `SDL_PROP_RENDERER_CREATE_RENDER_THREAD_BOOLEAN`.
  * - `SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER`: the maximum texture width
  *   and height
  * - `SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER`: a (const SDL_PixelFormat *)
@@ -365,6 +376,25 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  *   enabled, this will be 1.0. This property can change dynamically when
  *   SDL_EVENT_DISPLAY_HDR_STATE_CHANGED is sent.
  *
+ * The following statistics describe the most recently presented frame, and
+ * are updated each time SDL_RenderPresent() is called:
+ *
+ * - `SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER`: the number of render commands
+ *   queued, including state changes.
+ * - `SDL_PROP_RENDERER_FRAME_DRAW_CALLS_NUMBER`: the number of draw commands
+ *   queued.
+ * - `SDL_PROP_RENDERER_FRAME_VERTICES_NUMBER`: the number of vertices
+ *   submitted with draw commands.
+ * - `SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER`: the number of bytes of
+ *   vertex data generated by the rendering backend.
+ * - `SDL_PROP_RENDERER_FRAME_STATE_CHANGES_NUMBER`: the number of draw color,
+ *   viewport and clip rectangle changes queued.
+ * - `SDL_PROP_RENDERER_FRAME_TEXTURE_CHANGES_NUMBER`: the number of times a
+ *   draw command used a different texture than the previous textured draw
+ *   command in the same batch.
+ * - `SDL_PROP_RENDERER_FRAME_FLUSHES_NUMBER`: the number of times the command
+ *   queue was sent to the rendering backend.
+ *
  * With the direct3d renderer:
  *
  * - `SDL_PROP_RENDERER_D3D9_DEVICE_POINTER`: the IDirect3DDevice9 associated
@@ -416,12 +446,20 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_WINDOW_POINTER                            "SDL.renderer.window"
 #define SDL_PROP_RENDERER_SURFACE_POINTER                           "SDL.renderer.surface"
 #define SDL_PROP_RENDERER_VSYNC_NUMBER                              "SDL.renderer.vsync"
+#define SDL_PROP_RENDERER_RENDER_THREAD_BOOLEAN                     "SDL.renderer.render_thread"
 #define SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER                   "SDL.renderer.max_texture_size"
 #define SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER                   "SDL.renderer.texture_formats"
 #define SDL_PROP_RENDERER_OUTPUT_COLORSPACE_NUMBER                  "SDL.renderer.output_colorspace"
 #define SDL_PROP_RENDERER_HDR_ENABLED_BOOLEAN                       "SDL.renderer.HDR_enabled"
 #define SDL_PROP_RENDERER_SDR_WHITE_POINT_FLOAT                     "SDL.renderer.SDR_white_point"
 #define SDL_PROP_RENDERER_HDR_HEADROOM_FLOAT                        "SDL.renderer.HDR_headroom"
+#define SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER                     "SDL.renderer.frame.commands"
+#define SDL_PROP_RENDERER_FRAME_DRAW_CALLS_NUMBER                   "SDL.renderer.frame.draw_calls"
+#define SDL_PROP_RENDERER_FRAME_VERTICES_NUMBER                     "SDL.renderer.frame.vertices"
+#define SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER                 "SDL.renderer.frame.vertex_bytes"
+#define SDL_PROP_RENDERER_FRAME_STATE_CHANGES_NUMBER                "SDL.renderer.frame.state_changes"
+#define SDL_PROP_RENDERER_FRAME_TEXTURE_CHANGES_NUMBER              "SDL.renderer.frame.texture_changes"
+#define SDL_PROP_RENDERER_FRAME_FLUSHES_NUMBER                      "SDL.renderer.frame.flushes"
 #define SDL_PROP_RENDERER_D3D9_DEVICE_POINTER                       "SDL.renderer.d3d9.device"
 #define SDL_PROP_RENDERER_D3D11_DEVICE_POINTER                      "SDL.renderer.d3d11.device"
 #define SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER                   "SDL.renderer.d3d11.swap_chain"
@@ -551,6 +589,15 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Rende
  *   If this is defined, any values outside the range supported by the display
  *   will be scaled into the available HDR headroom, otherwise they are
  *   clipped.
+ * - `SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN`: true if the texture may be
+ *   packed into a larger texture shared with other small textures, so that
+ *   drawing them one after the other doesn't require a texture change and
+ *   can be batched. Only small static textures in a format supported
+ *   natively by the renderer are packed, other textures are created normally.
+ *   A packed texture is drawn, updated and destroyed like any other texture,
+ *   but it can't change its scale mode, isn't repeated by texture coordinates
+ *   outside of 0.0 - 1.0 in SDL_RenderGeometry() and has no backend specific
+ *   properties. Defaults to false.
  *
  * With the direct3d11 renderer:
  *
@@ -640,6 +687,7 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureWithProperties(SDL_Re
 #define SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER               "height"
 #define SDL_PROP_TEXTURE_CREATE_SDR_WHITE_POINT_FLOAT       "SDR_white_point"
 #define SDL_PROP_TEXTURE_CREATE_HDR_HEADROOM_FLOAT          "HDR_headroom"
+#define SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN               "atlas"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_POINTER       "d3d11.texture"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_U_POINTER     "d3d11.texture_u"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_V_POINTER     "d3d11.texture_v"
@@ -681,6 +729,8 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureWithProperties(SDL_Re
  *   headroom, otherwise they are clipped. This defaults to 1.0 for SDR
  *   textures, 4.0 for HDR10 textures, and no default for floating point
  *   textures.
+ * - `SDL_PROP_TEXTURE_ATLAS_BOOLEAN`: true if the texture was packed into a
+ *   shared atlas texture, see `SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN`.
  *
  * With the direct3d11 renderer:
  *
@@ -761,6 +811,7 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetTextureProperties(SDL_Textur
 #define SDL_PROP_TEXTURE_HEIGHT_NUMBER                      "SDL.texture.height"
 #define SDL_PROP_TEXTURE_SDR_WHITE_POINT_FLOAT              "SDL.texture.SDR_white_point"
 #define SDL_PROP_TEXTURE_HDR_HEADROOM_FLOAT                 "SDL.texture.HDR_headroom"
+#define SDL_PROP_TEXTURE_ATLAS_BOOLEAN                      "SDL.texture.atlas"
 #define SDL_PROP_TEXTURE_D3D11_TEXTURE_POINTER              "SDL.texture.d3d11.texture"
 #define SDL_PROP_TEXTURE_D3D11_TEXTURE_U_POINTER            "SDL.texture.d3d11.texture_u"
 #define SDL_PROP_TEXTURE_D3D11_TEXTURE_V_POINTER            "SDL.texture.d3d11.texture_v"
@@ -2020,6 +2071,105 @@ extern SDL_DECLSPEC int SDLCALL SDL_RenderGeometryRaw(SDL_Renderer *renderer,
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect);
 
+/**
+ * An in-flight request to read pixels from a rendering target.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ */
+typedef struct SDL_RenderReadback SDL_RenderReadback;
+
+/**
+ * A callback that is called when an asynchronous pixel read has completed.
+ *
+ * This callback may be called on the render thread, or from inside
+ * SDL_RenderPresent(), SDL_IsRenderReadbackComplete() or
+ * SDL_WaitRenderReadback(), so it should do as little work as possible, for
+ * example signal another thread that the data is ready. It is safe to call
+ * SDL_WaitRenderReadback() from this callback.
+ *
+ * \param userdata the `userdata` parameter passed to
+ *                 SDL_RenderReadPixelsAsync().
+ * \param readback the readback that has completed.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ */
+typedef void (SDLCALL *SDL_RenderReadbackCallback)(void *userdata, SDL_RenderReadback *readback);
+
+/**
+ * Start reading pixels from the current rendering target without waiting
+ * for the result.
+ *
+ * The rendering commands issued so far are submitted and the pixels are
+ * read once they have been drawn. If the renderer was created with
+ * `SDL_PROP_RENDERER_CREATE_RENDER_THREAD_BOOLEAN` this happens on the render
+ * thread, so the application can keep recording the next frame in the
+ * meantime. Otherwise the GPU copies the pixels into a staging buffer, or the
+ * software renderer copies them on a worker thread, and the readback
+ * completes once SDL notices the copy has finished: during a later
+ * SDL_RenderPresent(), SDL_IsRenderReadbackComplete() or
+ * SDL_WaitRenderReadback() call. Renderers that can't do either complete the
+ * request, and call `callback`, before this function returns.
+ *
+ * Every readback returned by this function must eventually be passed to
+ * SDL_WaitRenderReadback(), which returns the pixels and releases the
+ * readback.
+ *
+ * \param renderer the rendering context.
+ * \param rect an SDL_Rect structure representing the area in pixels relative
+ *             to the to current viewport, or NULL for the entire viewport.
+ * \param callback an SDL_RenderReadbackCallback to call when the pixels are
+ *                 available, may be NULL.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns a new readback on success or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_IsRenderReadbackComplete
+ * \sa SDL_RenderReadPixels
+ * \sa SDL_WaitRenderReadback
+ */
+extern SDL_DECLSPEC SDL_RenderReadback * SDLCALL SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_RenderReadbackCallback callback, void *userdata);
+
+/**
+ * Check whether an asynchronous pixel read has completed.
+ *
+ * If the GPU has finished copying the pixels, this completes the readback
+ * and calls its callback.
+ *
+ * \param readback the readback to query.
+ * \returns SDL_TRUE if SDL_WaitRenderReadback() would return without
+ *          blocking, SDL_FALSE otherwise.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ * \sa SDL_WaitRenderReadback
+ */
+extern SDL_DECLSPEC SDL_bool SDLCALL SDL_IsRenderReadbackComplete(SDL_RenderReadback *readback);
+
+/**
+ * Wait for an asynchronous pixel read to complete and get the result.
+ *
+ * The readback is released by this function and should not be used
+ * afterwards, even if this function fails. The returned surface should be
+ * freed with SDL_DestroySurface().
+ *
+ * \param readback the readback to wait for.
+ * \returns a new SDL_Surface on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_IsRenderReadbackComplete
+ * \sa SDL_RenderReadPixelsAsync
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_WaitRenderReadback(SDL_RenderReadback *readback);
+
 /**
  * Update the screen with any rendering performed since the previous call.
  *
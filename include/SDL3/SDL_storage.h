@@ -29,6 +29,7 @@
 #define SDL_storage_h_
 
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_asyncio.h>
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_filesystem.h>
 #include <SDL3/SDL_properties.h>
@@ -104,6 +105,12 @@ typedef struct SDL_Storage SDL_Storage;
 /**
  * Opens up a read-only container for the application's filesystem.
  *
+ * If `override` names a zip archive rather than a directory, the container
+ * serves the contents of the archive. Its directory is read into memory when
+ * the container is opened, so path info, enumeration and globbing don't touch
+ * the disk, and files are read directly out of the archive. Only entries that
+ * are stored without compression can be read.
+ *
  * \param override a path to override the backend's default title root.
  * \param props a property list that may contain backend-specific information.
  * \returns a title storage container on success or NULL on failure; call
@@ -192,6 +199,55 @@ extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenFileStorage(const char *path);
  */
 extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenStorage(const SDL_StorageInterface *iface, void *userdata);
 
+/**
+ * Add a read cache in front of an existing storage container.
+ *
+ * Files read through the returned container are kept in memory, and reading
+ * the same path again is served from memory instead of the backend, as long
+ * as the size and modification time that `storage` reports for the path
+ * haven't changed. When the cache grows past `max_bytes`, the least recently
+ * read files are dropped. Files larger than `max_bytes` are never cached.
+ *
+ * Writes, renames, copies and removals made through the returned container
+ * drop the affected files from the cache. Changes made any other way are only
+ * noticed if they change the size or modification time of the file.
+ *
+ * Everything else is passed through to `storage`, which should not be used
+ * directly while the cached container is open.
+ *
+ * The following read-only properties are provided by SDL on the returned
+ * container, see SDL_GetStorageProperties():
+ *
+ * - `SDL_PROP_STORAGE_CACHE_HITS_NUMBER`: the number of reads that were
+ *   served from the cache.
+ * - `SDL_PROP_STORAGE_CACHE_MISSES_NUMBER`: the number of reads that had to
+ *   go to `storage`.
+ * - `SDL_PROP_STORAGE_CACHE_SIZE_NUMBER`: the number of bytes currently held
+ *   in the cache.
+ *
+ * \param storage the storage container to cache.
+ * \param max_bytes the most memory to use for cached files, in bytes.
+ * \param closestorage if SDL_TRUE, calls SDL_CloseStorage() on `storage` when
+ *                     the cached container is closed, or if this function
+ *                     fails.
+ * \returns a storage container on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread. The
+ *               returned container is as thread-safe as `storage`.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseStorage
+ * \sa SDL_GetStorageProperties
+ * \sa SDL_ReadStorageFile
+ */
+extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_CreateCachedStorage(SDL_Storage *storage, Uint64 max_bytes, SDL_bool closestorage);
+
+#define SDL_PROP_STORAGE_CACHE_HITS_NUMBER      "SDL.storage.cache.hits"
+#define SDL_PROP_STORAGE_CACHE_MISSES_NUMBER    "SDL.storage.cache.misses"
+#define SDL_PROP_STORAGE_CACHE_SIZE_NUMBER      "SDL.storage.cache.size"
+
 /**
  * Closes and frees a storage container.
  *
@@ -210,6 +266,19 @@ extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenStorage(const SDL_StorageInter
  */
 extern SDL_DECLSPEC int SDLCALL SDL_CloseStorage(SDL_Storage *storage);
 
+/**
+ * Get the properties associated with a storage container.
+ *
+ * \param storage a storage container.
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateCachedStorage
+ */
+extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetStorageProperties(SDL_Storage *storage);
+
 /**
  * Checks if the storage container is ready to use.
  *
@@ -259,6 +328,38 @@ extern SDL_DECLSPEC int SDLCALL SDL_GetStorageFileSize(SDL_Storage *storage, con
  */
 extern SDL_DECLSPEC int SDLCALL SDL_ReadStorageFile(SDL_Storage *storage, const char *path, void *destination, Uint64 length);
 
+/**
+ * Asynchronously read a file from a storage container into a client-provided
+ * buffer.
+ *
+ * This function returns as quickly as possible; the read is done in the
+ * background by the same workers that service SDL_AsyncIO requests, and its
+ * result is added to `queue` as an SDL_ASYNCIO_TASK_READ task when it
+ * finishes. The outcome's asyncio field will be NULL, and its
+ * bytes_transferred will be `length` if the read succeeded.
+ *
+ * `destination` must remain available until the task is done, and the
+ * storage container must not be closed while the read is pending.
+ *
+ * \param storage a storage container to read from.
+ * \param path the relative path of the file to read.
+ * \param destination a client-provided buffer to read the file into.
+ * \param length the length of the destination buffer.
+ * \param queue a queue to add the new task to.
+ * \param userdata an app-defined pointer that will be provided with the task
+ *                 results.
+ * \returns 0 if the read was started or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateAsyncIOQueue
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_ReadStorageFile
+ * \sa SDL_WaitAsyncIOResult
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_ReadStorageFileAsync(SDL_Storage *storage, const char *path, void *destination, Uint64 length, SDL_AsyncIOQueue *queue, void *userdata);
+
 /**
  * Synchronously write a file from client memory into a storage container.
  *
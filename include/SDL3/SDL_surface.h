@@ -456,6 +456,32 @@ extern SDL_DECLSPEC int SDLCALL SDL_SetSurfaceRLE(SDL_Surface *surface, SDL_bool
  */
 extern SDL_DECLSPEC SDL_bool SDLCALL SDL_SurfaceHasRLE(SDL_Surface *surface);
 
+/**
+ * Encode a surface for RLE accelerated blits ahead of time.
+ *
+ * RLE encoding normally happens during the first blit after RLE is enabled,
+ * which can stall that frame. This function does the encoding up front, for
+ * example on a loading thread, as long as neither surface is used by another
+ * thread at the same time.
+ *
+ * RLE acceleration is enabled on the surface if it isn't already. The
+ * encoding depends on the destination pixel format, so blitting to a surface
+ * with a different format will encode the surface again.
+ *
+ * \param surface the SDL_Surface structure to encode.
+ * \param dst the SDL_Surface that later blits will draw to.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information. It is an error if the color
+ *          key and blend mode of the surface can't be RLE accelerated for
+ *          this destination.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BlitSurface
+ * \sa SDL_SetSurfaceRLE
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PrepareSurfaceRLE(SDL_Surface *surface, SDL_Surface *dst);
+
 /**
  * Set the color key (transparent pixel) in a surface.
  *
@@ -998,6 +1024,15 @@ extern SDL_DECLSPEC int SDLCALL SDL_BlitSurfaceUnchecked(SDL_Surface *src, const
  * Perform a scaled blit to a destination surface, which may be of a different
  * format.
  *
+ * With SDL_SCALEMODE_BEST, reductions average all of the source pixels
+ * covered by each destination pixel and enlargements use bicubic filtering,
+ * which is slower than SDL_SCALEMODE_LINEAR but avoids aliasing when
+ * creating thumbnails.
+ *
+ * If the source surface has mipmaps and the scale mode is not
+ * SDL_SCALEMODE_NEAREST, the smallest mipmap that is still at least as large
+ * as the destination rectangle is used as the source.
+ *
  * \param src the SDL_Surface structure to be copied from.
  * \param srcrect the SDL_Rect structure representing the rectangle to be
  *                copied, or NULL to copy the entire surface.
@@ -1016,9 +1051,69 @@ extern SDL_DECLSPEC int SDLCALL SDL_BlitSurfaceUnchecked(SDL_Surface *src, const
  * \since This function is available since SDL 3.0.0.
  *
  * \sa SDL_BlitSurface
+ * \sa SDL_GenerateSurfaceMipmaps
  */
 extern SDL_DECLSPEC int SDLCALL SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
 
+/**
+ * Generate a chain of half size copies of a surface.
+ *
+ * Each level is half the width and height of the previous one, down to 1x1,
+ * and each pixel is the average of a 2x2 block of pixels in the previous
+ * level. If the surface has an alpha channel and isn't using a premultiplied
+ * blend mode, the colors are weighted by alpha so that transparent pixels
+ * don't darken the edges of visible ones. Indexed, YUV, 10-bit and floating
+ * point formats aren't supported.
+ *
+ * Once generated, SDL_BlitSurfaceScaled() automatically draws from the
+ * closest level when shrinking the surface, which is much faster than
+ * scaling the full size surface and avoids aliasing.
+ *
+ * The mipmaps are marked out of date when the surface pixels may change:
+ * when the surface is unlocked, drawn into with SDL_FillSurfaceRect(),
+ * SDL_ClearSurface(), SDL_WriteSurfacePixel() or a blit, flipped, or its
+ * alpha is premultiplied. Out of date mipmaps aren't used until this
+ * function is called again, which refills the existing levels in place.
+ *
+ * \param surface the SDL_Surface structure to generate mipmaps for.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetSurfaceMipmap
+ * \sa SDL_RemoveSurfaceMipmaps
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GenerateSurfaceMipmaps(SDL_Surface *surface);
+
+/**
+ * Get a mipmap level of a surface.
+ *
+ * \param surface the SDL_Surface structure to query.
+ * \param level the mipmap level, where 0 is the surface itself and each
+ *              following level is half the size of the previous one.
+ * \returns the surface for that level, or NULL if there isn't one or the
+ *          mipmaps are out of date; call SDL_GetError() for more
+ *          information. The surface is owned by `surface` and should not be
+ *          freed.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GenerateSurfaceMipmaps
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_GetSurfaceMipmap(SDL_Surface *surface, int level);
+
+/**
+ * Remove the mipmaps generated for a surface.
+ *
+ * \param surface the SDL_Surface structure to update.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GenerateSurfaceMipmaps
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_RemoveSurfaceMipmaps(SDL_Surface *surface);
+
 /**
  * Perform low-level surface scaled blitting only.
  *
@@ -118,12 +118,38 @@ extern SDL_DECLSPEC void SDLCALL SDL_Delay(Uint32 ms);
  * will attempt to wait as close to the requested time as possible, busy
  * waiting if necessary, but could return later due to OS scheduling.
  *
+ * It sleeps until shortly before the requested time and busy waits for the
+ * rest. How early it wakes up is adjusted based on how late the OS has been
+ * waking it up, so it usually only busy waits for tens of microseconds.
+ *
  * \param ns the number of nanoseconds to delay.
  *
  * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DelayUntilNS
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DelayNS(Uint64 ns);
 
+/**
+ * Wait until a specified time before returning.
+ *
+ * This waits as precisely as SDL_DelayNS(), but until an absolute time
+ * instead of for a duration. In a loop that runs at a fixed rate, waiting
+ * until `start + frame * interval` keeps the time it takes to run each
+ * iteration and any late wakeups from adding up over time.
+ *
+ * If `deadline` has already passed, this returns immediately.
+ *
+ * \param deadline the time to wait for, in the same timebase as
+ *                 SDL_GetTicksNS().
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DelayNS
+ * \sa SDL_GetTicksNS
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DelayUntilNS(Uint64 deadline);
+
 /**
  * Definition of the timer ID type.
  *
@@ -183,11 +183,14 @@
 #cmakedefine HAVE_FSEEKO64 1
 #cmakedefine HAVE_MEMFD_CREATE 1
 #cmakedefine HAVE_POSIX_FALLOCATE 1
+#cmakedefine HAVE_COPY_FILE_RANGE 1
+#cmakedefine HAVE_SENDFILE 1
 #cmakedefine HAVE_SIGACTION 1
 #cmakedefine HAVE_SA_SIGACTION 1
 #cmakedefine HAVE_ST_MTIM 1
 #cmakedefine HAVE_SETJMP 1
 #cmakedefine HAVE_NANOSLEEP 1
+#cmakedefine HAVE_CLOCK_NANOSLEEP 1
 #cmakedefine HAVE_GMTIME_R 1
 #cmakedefine HAVE_LOCALTIME_R 1
 #cmakedefine HAVE_NL_LANGINFO 1
@@ -195,6 +198,9 @@
 #cmakedefine HAVE_SYSCTLBYNAME 1
 #cmakedefine HAVE_CLOCK_GETTIME 1
 #cmakedefine HAVE_GETPAGESIZE 1
+#cmakedefine HAVE_MMAP 1
+#cmakedefine HAVE_PREAD 1
+#cmakedefine HAVE_PWRITE 1
 #cmakedefine HAVE_ICONV 1
 #cmakedefine SDL_USE_LIBICONV 1
 #cmakedefine HAVE_PTHREAD_SETNAME_NP 1
@@ -481,6 +487,9 @@
 #cmakedefine SDL_FSOPS_WINDOWS @SDL_FSOPS_WINDOWS@
 #cmakedefine SDL_FSOPS_DUMMY @SDL_FSOPS_DUMMY@
 
+/* Enable async I/O backends */
+#cmakedefine SDL_ASYNCIO_IO_URING @SDL_ASYNCIO_IO_URING@
+
 /* Enable camera subsystem */
 #cmakedefine SDL_CAMERA_DRIVER_DUMMY @SDL_CAMERA_DRIVER_DUMMY@
 /* !!! FIXME: for later cmakedefine SDL_CAMERA_DRIVER_DISK @SDL_CAMERA_DRIVER_DISK@ */
@@ -140,6 +140,9 @@
 #define HAVE_GMTIME_R 1
 #define HAVE_LOCALTIME_R 1
 #define HAVE_SYSCONF    1
+#define HAVE_MMAP 1
+#define HAVE_PREAD 1
+#define HAVE_PWRITE 1
 #define HAVE_CLOCK_GETTIME  1
 
 /* Enable various audio drivers */
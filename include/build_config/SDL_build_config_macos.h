@@ -138,6 +138,9 @@
 #define HAVE_LOCALTIME_R 1
 #define HAVE_NL_LANGINFO 1
 #define HAVE_SYSCONF    1
+#define HAVE_MMAP 1
+#define HAVE_PREAD 1
+#define HAVE_PWRITE 1
 #define HAVE_SYSCTLBYNAME 1
 
 #if defined(__has_include) && (defined(__i386__) || defined(__x86_64))
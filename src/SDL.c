@@ -52,6 +52,7 @@
 #include "thread/SDL_thread_c.h"
 #include "video/SDL_pixels_c.h"
 #include "video/SDL_video_c.h"
+#include "file/SDL_asyncio_c.h"
 #include "filesystem/SDL_filesystem_c.h"
 
 #define SDL_INIT_EVERYTHING ~0U
@@ -261,6 +262,7 @@ static void SDL_QuitMainThread(void)
 {
     SDL_QuitProperties();
     SDL_QuitLog();
+    SDL_QuitAsyncIO();
     SDL_QuitFilesystem();
     SDL_QuitTicks();
     SDL_QuitTLSData();
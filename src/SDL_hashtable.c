@@ -32,18 +32,21 @@ struct SDL_HashTable
 {
     SDL_HashItem **table;
     Uint32 table_len;
+    Uint32 num_items;
     int hash_shift;
     SDL_bool stackable;
+    SDL_bool growable;
     void *data;
     SDL_HashTable_HashFn hash;
     SDL_HashTable_KeyMatchFn keymatch;
     SDL_HashTable_NukeFn nuke;
 };
 
-SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const SDL_HashTable_HashFn hashfn,
-                                   const SDL_HashTable_KeyMatchFn keymatchfn,
-                                   const SDL_HashTable_NukeFn nukefn,
-                                   const SDL_bool stackable)
+static SDL_HashTable *create_hash_table(void *data, const Uint32 num_buckets, const SDL_HashTable_HashFn hashfn,
+                                        const SDL_HashTable_KeyMatchFn keymatchfn,
+                                        const SDL_HashTable_NukeFn nukefn,
+                                        const SDL_bool stackable,
+                                        const SDL_bool growable)
 {
     SDL_HashTable *table;
 
@@ -68,6 +71,7 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
     table->table_len = num_buckets;
     table->hash_shift = 32 - SDL_MostSignificantBitIndex32(num_buckets);
     table->stackable = stackable;
+    table->growable = growable;
     table->data = data;
     table->hash = hashfn;
     table->keymatch = keymatchfn;
@@ -75,6 +79,22 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
     return table;
 }
 
+SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const SDL_HashTable_HashFn hashfn,
+                                   const SDL_HashTable_KeyMatchFn keymatchfn,
+                                   const SDL_HashTable_NukeFn nukefn,
+                                   const SDL_bool stackable)
+{
+    return create_hash_table(data, num_buckets, hashfn, keymatchfn, nukefn, stackable, SDL_FALSE);
+}
+
+SDL_HashTable *SDL_CreateGrowableHashTable(void *data, const Uint32 num_buckets, const SDL_HashTable_HashFn hashfn,
+                                           const SDL_HashTable_KeyMatchFn keymatchfn,
+                                           const SDL_HashTable_NukeFn nukefn,
+                                           const SDL_bool stackable)
+{
+    return create_hash_table(data, num_buckets, hashfn, keymatchfn, nukefn, stackable, SDL_TRUE);
+}
+
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
     // Mix the bits together, and use the highest bits as the bucket index.
@@ -83,6 +103,42 @@ static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 }
 
 
+// Double the number of buckets, so lookups stay cheap no matter how many items are added.
+static void grow_hash_table(SDL_HashTable *table)
+{
+    const Uint32 old_len = table->table_len;
+    SDL_HashItem **old_table = table->table;
+    SDL_HashItem **new_table;
+    Uint32 i;
+
+    new_table = (SDL_HashItem **) SDL_calloc(old_len * 2, sizeof (SDL_HashItem *));
+    if (!new_table) {
+        return;  // not fatal, the chains just get longer.
+    }
+
+    table->table = new_table;
+    table->table_len = old_len * 2;
+    table->hash_shift--;
+
+    // The bucket index is the top bits of the hash, so bucket i splits into buckets i*2 and i*2+1.
+    // Items are appended to those in the order they're found, so chains keep their newest-first
+    // order and stacked values keep shadowing the older ones.
+    for (i = 0; i < old_len; i++) {
+        SDL_HashItem **tails[2] = { &new_table[i * 2], &new_table[i * 2 + 1] };
+        SDL_HashItem *item = old_table[i];
+        while (item) {
+            SDL_HashItem *next = item->next;
+            const Uint32 half = calc_hash(table, item->key) - (i * 2);
+            SDL_assert(half <= 1);
+            item->next = NULL;
+            *tails[half] = item;
+            tails[half] = &item->next;
+            item = next;
+        }
+    }
+    SDL_free(old_table);
+}
+
 SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
 {
     SDL_HashItem *item;
@@ -96,7 +152,10 @@ SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const vo
         return SDL_FALSE;
     }
 
-    // !!! FIXME: grow and rehash table if it gets too saturated.
+    if (table->growable && (table->num_items >= table->table_len * 2) && (table->table_len < 0x40000000)) {
+        grow_hash_table(table);
+    }
+
     item = (SDL_HashItem *) SDL_malloc(sizeof (SDL_HashItem));
     if (!item) {
         return SDL_FALSE;
@@ -108,6 +167,7 @@ SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const vo
     item->value = value;
     item->next = table->table[hash];
     table->table[hash] = item;
+    table->num_items++;
 
     return SDL_TRUE;
 }
@@ -163,6 +223,7 @@ SDL_bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
                 table->nuke(item->key, item->value, data);
             }
             SDL_free(item);
+            table->num_items--;
             return SDL_TRUE;
         }
 
@@ -264,6 +325,7 @@ void SDL_EmptyHashTable(SDL_HashTable *table)
             }
             table->table[i] = NULL;
         }
+        table->num_items = 0;
     }
 }
 
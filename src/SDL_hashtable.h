@@ -36,6 +36,15 @@ extern SDL_HashTable *SDL_CreateHashTable(void *data,
                                           const SDL_HashTable_NukeFn nukefn,
                                           const SDL_bool stackable);
 
+// Like SDL_CreateHashTable(), but the table doubles its buckets as items are added. Growing frees the
+// old bucket array, so every lookup has to hold the same lock as the inserts, unlike fixed size tables.
+extern SDL_HashTable *SDL_CreateGrowableHashTable(void *data,
+                                                  const Uint32 num_buckets,
+                                                  const SDL_HashTable_HashFn hashfn,
+                                                  const SDL_HashTable_KeyMatchFn keymatchfn,
+                                                  const SDL_HashTable_NukeFn nukefn,
+                                                  const SDL_bool stackable);
+
 extern void SDL_EmptyHashTable(SDL_HashTable *table);
 extern void SDL_DestroyHashTable(SDL_HashTable *table);
 extern SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value);
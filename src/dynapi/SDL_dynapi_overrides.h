@@ -1086,3 +1086,29 @@
 #define SDL_wcsnstr SDL_wcsnstr_REAL
 #define SDL_wcsstr SDL_wcsstr_REAL
 #define SDL_wcstol SDL_wcstol_REAL
+#define SDL_RenderReadPixelsAsync SDL_RenderReadPixelsAsync_REAL
+#define SDL_IsRenderReadbackComplete SDL_IsRenderReadbackComplete_REAL
+#define SDL_WaitRenderReadback SDL_WaitRenderReadback_REAL
+#define SDL_GenerateSurfaceMipmaps SDL_GenerateSurfaceMipmaps_REAL
+#define SDL_GetSurfaceMipmap SDL_GetSurfaceMipmap_REAL
+#define SDL_RemoveSurfaceMipmaps SDL_RemoveSurfaceMipmaps_REAL
+#define SDL_PrepareSurfaceRLE SDL_PrepareSurfaceRLE_REAL
+#define SDL_IOFromMappedFile SDL_IOFromMappedFile_REAL
+#define SDL_AsyncIOFromFile SDL_AsyncIOFromFile_REAL
+#define SDL_GetAsyncIOSize SDL_GetAsyncIOSize_REAL
+#define SDL_ReadAsyncIO SDL_ReadAsyncIO_REAL
+#define SDL_WriteAsyncIO SDL_WriteAsyncIO_REAL
+#define SDL_CloseAsyncIO SDL_CloseAsyncIO_REAL
+#define SDL_CreateAsyncIOQueue SDL_CreateAsyncIOQueue_REAL
+#define SDL_DestroyAsyncIOQueue SDL_DestroyAsyncIOQueue_REAL
+#define SDL_GetAsyncIOResult SDL_GetAsyncIOResult_REAL
+#define SDL_GetAsyncIOResults SDL_GetAsyncIOResults_REAL
+#define SDL_WaitAsyncIOResult SDL_WaitAsyncIOResult_REAL
+#define SDL_SignalAsyncIOQueue SDL_SignalAsyncIOQueue_REAL
+#define SDL_LoadFileAsync SDL_LoadFileAsync_REAL
+#define SDL_ReadStorageFileAsync SDL_ReadStorageFileAsync_REAL
+#define SDL_CreateBufferedIO SDL_CreateBufferedIO_REAL
+#define SDL_EnumerateDirectoryWithInfo SDL_EnumerateDirectoryWithInfo_REAL
+#define SDL_CreateCachedStorage SDL_CreateCachedStorage_REAL
+#define SDL_GetStorageProperties SDL_GetStorageProperties_REAL
+#define SDL_DelayUntilNS SDL_DelayUntilNS_REAL
@@ -1092,3 +1092,29 @@ SDL_DYNAPI_PROC(size_t,SDL_wcsnlen,(const wchar_t *a, size_t b),(a,b),return)
 SDL_DYNAPI_PROC(wchar_t*,SDL_wcsnstr,(const wchar_t *a, const wchar_t *b, size_t c),(a,b,c),return)
 SDL_DYNAPI_PROC(wchar_t*,SDL_wcsstr,(const wchar_t *a, const wchar_t *b),(a,b),return)
 SDL_DYNAPI_PROC(long,SDL_wcstol,(const wchar_t *a, wchar_t **b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_RenderReadback*,SDL_RenderReadPixelsAsync,(SDL_Renderer *a, const SDL_Rect *b, SDL_RenderReadbackCallback c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_IsRenderReadbackComplete,(SDL_RenderReadback *a),(a),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_WaitRenderReadback,(SDL_RenderReadback *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GenerateSurfaceMipmaps,(SDL_Surface *a),(a),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_GetSurfaceMipmap,(SDL_Surface *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_RemoveSurfaceMipmaps,(SDL_Surface *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_PrepareSurfaceRLE,(SDL_Surface *a, SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_IOFromMappedFile,(const char *a),(a),return)
+SDL_DYNAPI_PROC(SDL_AsyncIO*,SDL_AsyncIOFromFile,(const char *a, const char *b),(a,b),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetAsyncIOSize,(SDL_AsyncIO *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_ReadAsyncIO,(SDL_AsyncIO *a, void *b, Uint64 c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_WriteAsyncIO,(SDL_AsyncIO *a, void *b, Uint64 c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_CloseAsyncIO,(SDL_AsyncIO *a, SDL_bool b, SDL_AsyncIOQueue *c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_AsyncIOQueue*,SDL_CreateAsyncIOQueue,(void),(),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetAsyncIOResults,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_WaitAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_SignalAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_LoadFileAsync,(const char *a, SDL_AsyncIOQueue *b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_ReadStorageFileAsync,(SDL_Storage *a, const char *b, void *c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_CreateBufferedIO,(SDL_IOStream *a, size_t b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_EnumerateDirectoryWithInfo,(const char *a, SDL_EnumerateFlags b, SDL_EnumerateDirectoryInfoCallback c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_Storage*,SDL_CreateCachedStorage,(SDL_Storage *a, Uint64 b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_GetStorageProperties,(SDL_Storage *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DelayUntilNS,(Uint64 a),(a),)
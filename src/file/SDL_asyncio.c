@@ -0,0 +1,447 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_sysasyncio.h"
+
+SDL_AsyncIO *SDL_AsyncIOFromFile(const char *file, const char *mode)
+{
+    SDL_AsyncIO *asyncio;
+
+    if (!file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+    if (!mode) {
+        SDL_InvalidParamError("mode");
+        return NULL;
+    }
+
+    asyncio = (SDL_AsyncIO *)SDL_calloc(1, sizeof(*asyncio));
+    if (!asyncio) {
+        return NULL;
+    }
+
+    asyncio->lock = SDL_CreateMutex();
+    if (!asyncio->lock) {
+        SDL_free(asyncio);
+        return NULL;
+    }
+
+    if (SDL_SYS_OpenAsyncIOFile(asyncio, file, mode) < 0) {
+        SDL_DestroyMutex(asyncio->lock);
+        SDL_free(asyncio);
+        return NULL;
+    }
+    return asyncio;
+}
+
+static void SDL_DestroyAsyncIO(SDL_AsyncIO *asyncio)
+{
+    SDL_SYS_CloseAsyncIOFile(asyncio);
+    SDL_DestroyMutex(asyncio->lock);
+    SDL_free(asyncio);
+}
+
+Sint64 SDL_GetAsyncIOSize(SDL_AsyncIO *asyncio)
+{
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    }
+    return SDL_SYS_GetAsyncIOFileSize(asyncio);
+}
+
+static SDL_AsyncIOTask *SDL_CreateAsyncIOTask(SDL_AsyncIO *asyncio, SDL_AsyncIOTaskType type, void *buffer, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *)SDL_calloc(1, sizeof(*task));
+    if (task) {
+        task->asyncio = asyncio;
+        task->type = type;
+        task->queue = queue;
+        task->buffer = buffer;
+        task->offset = offset;
+        task->requested_size = size;
+        task->app_userdata = userdata;
+    }
+    return task;
+}
+
+static int SDL_StartAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIOQueue *queue = task->queue;
+
+    SDL_AtomicIncRef(&queue->tasks_inflight);
+    if (queue->iface.queue_task(queue->userdata, task) < 0) {
+        SDL_AtomicDecRef(&queue->tasks_inflight);
+        return -1;
+    }
+    return 0;
+}
+
+static void SDL_StartDeferredClose(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIOQueue *queue = task->queue;
+
+    /* The queue's task count was already raised by SDL_CloseAsyncIO() */
+    if (queue->iface.queue_task(queue->userdata, task) < 0) {
+        /* Nothing else will deliver this, so do the work right here */
+        SDL_SYS_RunAsyncIOTask(task);
+        SDL_FinishAsyncIOTask(task);
+        queue->iface.post_result(queue->userdata, task);
+    }
+}
+
+static void SDL_ReleasePendingAsyncIO(SDL_AsyncIO *asyncio)
+{
+    SDL_AsyncIOTask *closing = NULL;
+
+    SDL_LockMutex(asyncio->lock);
+    if (--asyncio->num_pending == 0) {
+        closing = asyncio->closing;
+    }
+    SDL_UnlockMutex(asyncio->lock);
+
+    if (closing) {
+        SDL_StartDeferredClose(closing);
+    }
+}
+
+void SDL_FinishAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIO *asyncio = task->asyncio;
+
+    task->finished = SDL_TRUE;
+
+    if (!asyncio) {
+        return;
+    }
+
+    if (task->type == SDL_ASYNCIO_TASK_CLOSE) {
+        SDL_DestroyAsyncIO(asyncio);
+        return;
+    }
+
+    if (asyncio->oneshot) {
+        /* This is the only task on a file opened by SDL_LoadFileAsync() */
+        task->asyncio = NULL;
+        if (task->result == SDL_ASYNCIO_COMPLETE) {
+            ((Uint8 *)task->buffer)[task->result_size] = '\0';
+        } else {
+            SDL_free(task->buffer);
+            task->buffer = NULL;
+        }
+        SDL_DestroyAsyncIO(asyncio);
+        return;
+    }
+
+    SDL_ReleasePendingAsyncIO(asyncio);
+}
+
+static int SDL_RequestAsyncIO(SDL_AsyncIOTaskType type, SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    }
+    if (!ptr) {
+        return SDL_InvalidParamError("ptr");
+    }
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    task = SDL_CreateAsyncIOTask(asyncio, type, ptr, offset, size, queue, userdata);
+    if (!task) {
+        return -1;
+    }
+
+    SDL_LockMutex(asyncio->lock);
+    if (asyncio->closing) {
+        SDL_UnlockMutex(asyncio->lock);
+        SDL_free(task);
+        return SDL_SetError("SDL_AsyncIO is closing, can't start new tasks");
+    }
+    ++asyncio->num_pending;
+    SDL_UnlockMutex(asyncio->lock);
+
+    if (SDL_StartAsyncIOTask(task) < 0) {
+        SDL_free(task);
+        SDL_ReleasePendingAsyncIO(asyncio);
+        return -1;
+    }
+    return 0;
+}
+
+int SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    return SDL_RequestAsyncIO(SDL_ASYNCIO_TASK_READ, asyncio, ptr, offset, size, queue, userdata);
+}
+
+int SDL_WriteAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    return SDL_RequestAsyncIO(SDL_ASYNCIO_TASK_WRITE, asyncio, ptr, offset, size, queue, userdata);
+}
+
+int SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, SDL_bool flush, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIOTask *task;
+    SDL_bool start_now;
+
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    }
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    task = SDL_CreateAsyncIOTask(asyncio, SDL_ASYNCIO_TASK_CLOSE, NULL, 0, 0, queue, userdata);
+    if (!task) {
+        return -1;
+    }
+    task->flush = flush;
+
+    SDL_LockMutex(asyncio->lock);
+    if (asyncio->closing) {
+        SDL_UnlockMutex(asyncio->lock);
+        SDL_free(task);
+        return SDL_SetError("SDL_AsyncIO is already closing");
+    }
+    /* If tasks are pending, the last one will start the close when it finishes */
+    start_now = (asyncio->num_pending == 0);
+    asyncio->closing = task;
+    SDL_AtomicIncRef(&queue->tasks_inflight);
+    SDL_UnlockMutex(asyncio->lock);
+
+    if (start_now && queue->iface.queue_task(queue->userdata, task) < 0) {
+        SDL_LockMutex(asyncio->lock);
+        asyncio->closing = NULL;
+        SDL_UnlockMutex(asyncio->lock);
+        SDL_AtomicDecRef(&queue->tasks_inflight);
+        SDL_free(task);
+        return -1;
+    }
+    return 0;
+}
+
+int SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIO *asyncio;
+    SDL_AsyncIOTask *task;
+    Sint64 size;
+    void *buffer;
+
+    if (!file) {
+        return SDL_InvalidParamError("file");
+    }
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    asyncio = SDL_AsyncIOFromFile(file, "r");
+    if (!asyncio) {
+        return -1;
+    }
+    asyncio->oneshot = SDL_TRUE;
+
+    size = SDL_GetAsyncIOSize(asyncio);
+    if (size < 0) {
+        SDL_DestroyAsyncIO(asyncio);
+        return -1;
+    }
+    if ((Uint64)size >= SDL_SIZE_MAX) {
+        SDL_DestroyAsyncIO(asyncio);
+        return SDL_SetError("File is too large to load");
+    }
+
+    buffer = SDL_malloc((size_t)size + 1);
+    if (!buffer) {
+        SDL_DestroyAsyncIO(asyncio);
+        return -1;
+    }
+
+    task = SDL_CreateAsyncIOTask(asyncio, SDL_ASYNCIO_TASK_READ, buffer, 0, (Uint64)size, queue, userdata);
+    if (!task) {
+        SDL_free(buffer);
+        SDL_DestroyAsyncIO(asyncio);
+        return -1;
+    }
+    task->free_buffer = SDL_TRUE;
+
+    if (SDL_StartAsyncIOTask(task) < 0) {
+        SDL_free(task);
+        SDL_free(buffer);
+        SDL_DestroyAsyncIO(asyncio);
+        return -1;
+    }
+    return 0;
+}
+
+int SDL_QueueAsyncIOFunction(SDL_AsyncIOQueue *queue, SDL_AsyncIOTaskType type, SDL_AsyncIOTaskFunc func, void *funcdata, void *buffer, Uint64 size, void *userdata)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    task = SDL_CreateAsyncIOTask(NULL, type, buffer, 0, size, queue, userdata);
+    if (!task) {
+        return -1;
+    }
+    task->func = func;
+    task->funcdata = funcdata;
+
+    if (SDL_StartAsyncIOTask(task) < 0) {
+        SDL_free(task);
+        return -1;
+    }
+    return 0;
+}
+
+SDL_AsyncIOQueue *SDL_CreateAsyncIOQueue(void)
+{
+    SDL_AsyncIOQueue *queue = (SDL_AsyncIOQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+
+#ifdef SDL_ASYNCIO_IO_URING
+    {
+        const char *driver = SDL_GetHint(SDL_HINT_ASYNCIO_DRIVER);
+        if (!driver || !*driver || SDL_strcasecmp(driver, "io_uring") == 0) {
+            if (SDL_SYS_CreateAsyncIOQueue_io_uring(queue) == 0) {
+                return queue;
+            }
+        }
+    }
+#endif
+
+    if (SDL_SYS_CreateAsyncIOQueue_Generic(queue) < 0) {
+        SDL_free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+static void SDL_GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *outcome)
+{
+    SDL_AsyncIOQueue *queue = task->queue;
+
+    outcome->asyncio = task->asyncio;
+    outcome->type = task->type;
+    outcome->result = task->result;
+    outcome->buffer = task->buffer;
+    outcome->offset = task->offset;
+    outcome->bytes_requested = task->requested_size;
+    outcome->bytes_transferred = task->result_size;
+    outcome->userdata = task->app_userdata;
+
+    SDL_AtomicDecRef(&queue->tasks_inflight);
+    SDL_free(task);
+}
+
+SDL_bool SDL_GetAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!queue || !outcome) {
+        return SDL_FALSE;
+    }
+
+    task = queue->iface.get_results(queue->userdata);
+    if (!task) {
+        return SDL_FALSE;
+    }
+    SDL_GetAsyncIOTaskOutcome(task, outcome);
+    return SDL_TRUE;
+}
+
+int SDL_GetAsyncIOResults(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcomes, int count)
+{
+    int i;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+    if (!outcomes && count > 0) {
+        return SDL_InvalidParamError("outcomes");
+    }
+
+    for (i = 0; i < count; ++i) {
+        SDL_AsyncIOTask *task = queue->iface.get_results(queue->userdata);
+        if (!task) {
+            break;
+        }
+        SDL_GetAsyncIOTaskOutcome(task, &outcomes[i]);
+    }
+    return i;
+}
+
+SDL_bool SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome, Sint32 timeoutMS)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!queue || !outcome) {
+        return SDL_FALSE;
+    }
+
+    task = queue->iface.wait_results(queue->userdata, timeoutMS);
+    if (!task) {
+        return SDL_FALSE;
+    }
+    SDL_GetAsyncIOTaskOutcome(task, outcome);
+    return SDL_TRUE;
+}
+
+void SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    if (queue) {
+        queue->iface.signal(queue->userdata);
+    }
+}
+
+void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    if (!queue) {
+        return;
+    }
+
+    /* Block until everything in flight has landed, then throw it away */
+    while (SDL_AtomicGet(&queue->tasks_inflight) > 0) {
+        SDL_AsyncIOTask *task = queue->iface.wait_results(queue->userdata, -1);
+        if (task) {
+            if (task->free_buffer) {
+                SDL_free(task->buffer);
+            }
+            SDL_AtomicDecRef(&queue->tasks_inflight);
+            SDL_free(task);
+        }
+    }
+
+    queue->iface.destroy(queue->userdata);
+    SDL_free(queue);
+}
+
+void SDL_QuitAsyncIO(void)
+{
+    SDL_SYS_QuitAsyncIOPool();
+}
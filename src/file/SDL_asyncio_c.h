@@ -0,0 +1,36 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_asyncio_c_h_
+#define SDL_asyncio_c_h_
+
+/* Runs on a worker thread, returns the number of bytes transferred or -1 on failure.
+   Once queued, it is called exactly once and is responsible for freeing funcdata.
+   If the task is canceled, buffer is NULL and the function should only clean up. */
+typedef Sint64 (*SDL_AsyncIOTaskFunc)(void *funcdata, void *buffer, Uint64 size);
+
+/* Run a function on the async I/O worker pool and report it as a task of the given type on queue */
+extern int SDL_QueueAsyncIOFunction(SDL_AsyncIOQueue *queue, SDL_AsyncIOTaskType type, SDL_AsyncIOTaskFunc func, void *funcdata, void *buffer, Uint64 size, void *userdata);
+
+extern void SDL_QuitAsyncIO(void);
+
+#endif /* SDL_asyncio_c_h_ */
@@ -31,17 +31,26 @@
 #ifdef HAVE_LIMITS_H
 #include <limits.h>
 #endif
+#ifdef HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 /* This file provides a general interface for SDL to read and write
    data sources.  It can easily be extended to files, memory, etc.
 */
 
+typedef struct IOStreamBufferedData IOStreamBufferedData;
+
 struct SDL_IOStream
 {
     SDL_IOStreamInterface iface;
     void *userdata;
     SDL_IOStatus status;
     SDL_PropertiesID props;
+    IOStreamBufferedData *buffered;
 };
 
 #ifdef SDL_PLATFORM_3DS
@@ -507,6 +516,98 @@ static int SDLCALL mem_close(void *userdata)
     return 0;
 }
 
+static void SetMemoryProperties(SDL_IOStream *iostr, const void *mem, size_t size)
+{
+    const SDL_PropertiesID props = SDL_GetIOProperties(iostr);
+    if (props) {
+        SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_MEMORY_POINTER, (void *)mem);
+        SDL_SetNumberProperty(props, SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, (Sint64)size);
+    }
+}
+
+/* Functions to read memory mapped files */
+
+#if defined(HAVE_MMAP) || (defined(SDL_PLATFORM_WIN32) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES))
+#define HAVE_MAPPED_FILES
+
+/* Empty files can't be mapped, but they can still be read */
+static const Uint8 mapped_empty_file[1] = { 0 };
+
+static void UnmapFile(void *mem, size_t size)
+{
+    if (mem != mapped_empty_file) {
+#ifdef HAVE_MMAP
+        munmap(mem, size);
+#else
+        UnmapViewOfFile(mem);
+#endif
+    }
+}
+
+static int SDLCALL mapped_close(void *userdata)
+{
+    IOStreamMemData *iodata = (IOStreamMemData *) userdata;
+
+    UnmapFile(iodata->base, (size_t)(iodata->stop - iodata->base));
+    SDL_free(iodata);
+    return 0;
+}
+
+/* Map the whole file read-only, returns NULL without setting an error if the file can't be mapped */
+static void *MapFile(const char *file, size_t *size)
+{
+    void *mem = NULL;
+
+#ifdef HAVE_MMAP
+    struct stat st;
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && (Uint64)st.st_size < SDL_SIZE_MAX) {
+        *size = (size_t)st.st_size;
+        if (*size == 0) {
+            mem = (void *)mapped_empty_file;
+        } else {
+            /* Shared mappings of the same file use the same pages of the page cache */
+            mem = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+            if (mem == MAP_FAILED) {
+                mem = NULL;
+            }
+        }
+    }
+    close(fd);
+#else
+    LARGE_INTEGER file_size;
+    HANDLE h, mapping;
+    LPWSTR str = WIN_UTF8ToStringW(file);
+    if (!str) {
+        return NULL;
+    }
+    h = CreateFileW(str, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    SDL_free(str);
+    if (h == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    if (GetFileSizeEx(h, &file_size) && (Uint64)file_size.QuadPart < SDL_SIZE_MAX) {
+        *size = (size_t)file_size.QuadPart;
+        if (*size == 0) {
+            mem = (void *)mapped_empty_file;
+        } else {
+            /* The view keeps the mapping alive after the handles are closed */
+            mapping = CreateFileMappingW(h, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping) {
+                mem = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+        }
+    }
+    CloseHandle(h);
+#endif
+    return mem;
+}
+#endif /* HAVE_MAPPED_FILES */
+
 /* Functions to create SDL_IOStream structures from various data sources */
 
 #if defined(HAVE_STDIO_H) && !defined(SDL_PLATFORM_WINDOWS)
@@ -672,6 +773,51 @@ SDL_IOStream *SDL_IOFromFile(const char *file, const char *mode)
     return iostr;
 }
 
+SDL_IOStream *SDL_IOFromMappedFile(const char *file)
+{
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+
+#ifdef HAVE_MAPPED_FILES
+    {
+        size_t size = 0;
+        void *mem = MapFile(file, &size);
+        if (mem) {
+            IOStreamMemData *iodata = (IOStreamMemData *) SDL_malloc(sizeof (*iodata));
+            if (!iodata) {
+                UnmapFile(mem, size);
+                return NULL;
+            }
+
+            SDL_IOStreamInterface iface;
+            SDL_zero(iface);
+            iface.size = mem_size;
+            iface.seek = mem_seek;
+            iface.read = mem_read;
+            // leave iface.write as NULL, the mapping is read-only.
+            iface.close = mapped_close;
+
+            iodata->base = (Uint8 *)mem;
+            iodata->here = iodata->base;
+            iodata->stop = iodata->base + size;
+
+            SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
+            if (!iostr) {
+                mapped_close(iodata);
+            } else {
+                SetMemoryProperties(iostr, mem, size);
+            }
+            return iostr;
+        }
+    }
+#endif /* HAVE_MAPPED_FILES */
+
+    /* Fall back to regular file access, e.g. for Android assets */
+    return SDL_IOFromFile(file, "rb");
+}
+
 SDL_IOStream *SDL_IOFromMem(void *mem, size_t size)
 {
     if (!mem) {
@@ -702,6 +848,8 @@ SDL_IOStream *SDL_IOFromMem(void *mem, size_t size)
     SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
     if (!iostr) {
         SDL_free(iodata);
+    } else {
+        SetMemoryProperties(iostr, mem, size);
     }
     return iostr;
 }
@@ -736,6 +884,8 @@ SDL_IOStream *SDL_IOFromConstMem(const void *mem, size_t size)
     SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
     if (!iostr) {
         SDL_free(iodata);
+    } else {
+        SetMemoryProperties(iostr, mem, size);
     }
     return iostr;
 }
@@ -843,6 +993,262 @@ SDL_IOStream *SDL_IOFromDynamicMem(void)
     return iostr;
 }
 
+#define DEFAULT_BUFFERED_IO_SIZE 4096
+
+struct IOStreamBufferedData
+{
+    SDL_IOStream *source;
+    SDL_bool closeio;
+    Uint8 *buffer;
+    size_t buffer_size;
+    Uint8 *read_pos;    /* read-ahead data is between read_pos and read_end */
+    Uint8 *read_end;
+    size_t write_size;  /* write-behind data is at the start of the buffer */
+    Sint64 source_pos;  /* where the source is positioned, or -1 if not known yet */
+};
+
+static int buffered_flush_writes(IOStreamBufferedData *iodata)
+{
+    size_t written = 0;
+
+    while (written < iodata->write_size) {
+        const size_t bytes = SDL_WriteIO(iodata->source, iodata->buffer + written, iodata->write_size - written);
+        if (bytes == 0) {
+            /* Keep whatever didn't make it, so a later flush can retry */
+            iodata->write_size -= written;
+            SDL_memmove(iodata->buffer, iodata->buffer + written, iodata->write_size);
+            return -1;
+        }
+        written += bytes;
+        if (iodata->source_pos >= 0) {
+            iodata->source_pos += bytes;
+        }
+    }
+    iodata->write_size = 0;
+    return 0;
+}
+
+/* Drop the read-ahead data, moving the source back to where the reader is */
+static int buffered_discard_reads(IOStreamBufferedData *iodata)
+{
+    const Sint64 unread = (Sint64)(iodata->read_end - iodata->read_pos);
+
+    iodata->read_pos = iodata->read_end = iodata->buffer;
+    if (unread > 0) {
+        iodata->source_pos = SDL_SeekIO(iodata->source, -unread, SDL_IO_SEEK_CUR);
+        if (iodata->source_pos < 0) {
+            iodata->source_pos = -1;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static Sint64 SDLCALL buffered_size(void *userdata)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+
+    if (buffered_flush_writes(iodata) < 0) {
+        return -1;
+    }
+    return SDL_GetIOSize(iodata->source);
+}
+
+static Sint64 SDLCALL buffered_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    Sint64 retval;
+
+    if (whence == SDL_IO_SEEK_CUR && offset == 0 && iodata->source_pos >= 0) {
+        /* Telling the position doesn't need to flush or touch the source */
+        return iodata->source_pos + (Sint64)iodata->write_size - (Sint64)(iodata->read_end - iodata->read_pos);
+    }
+
+    if (buffered_flush_writes(iodata) < 0) {
+        return -1;
+    }
+
+    if (iodata->read_end > iodata->buffer) {
+        /* The source is positioned at the end of the buffered data */
+        const Sint64 unread = (Sint64)(iodata->read_end - iodata->read_pos);
+        Sint64 end;
+
+        if (iodata->source_pos < 0) {
+            iodata->source_pos = SDL_TellIO(iodata->source);
+        }
+        end = iodata->source_pos;
+
+        if (end >= 0 && whence != SDL_IO_SEEK_END) {
+            const Sint64 start = end - (Sint64)(iodata->read_end - iodata->buffer);
+            const Sint64 target = (whence == SDL_IO_SEEK_CUR) ? (end - unread + offset) : offset;
+
+            if (target >= start && target <= end) {
+                iodata->read_pos = iodata->buffer + (size_t)(target - start);
+                return target;
+            }
+            offset = target;
+            whence = SDL_IO_SEEK_SET;
+        } else if (whence == SDL_IO_SEEK_CUR) {
+            offset -= unread;
+        }
+        iodata->read_pos = iodata->read_end = iodata->buffer;
+    }
+
+    retval = SDL_SeekIO(iodata->source, offset, whence);
+    iodata->source_pos = (retval < 0) ? -1 : retval;
+    return retval;
+}
+
+static size_t SDLCALL buffered_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+
+    if (buffered_flush_writes(iodata) < 0) {
+        *status = SDL_IO_STATUS_ERROR;
+        return 0;
+    }
+
+    while (total < size) {
+        size_t avail = (size_t)(iodata->read_end - iodata->read_pos);
+
+        if (avail == 0) {
+            const size_t left = size - total;
+            size_t bytes;
+
+            if (left >= iodata->buffer_size) {
+                /* Big reads go straight to the destination, leaving nothing buffered */
+                bytes = SDL_ReadIO(iodata->source, dst + total, left);
+                iodata->read_pos = iodata->read_end = iodata->buffer;
+                total += bytes;
+            } else {
+                bytes = SDL_ReadIO(iodata->source, iodata->buffer, iodata->buffer_size);
+                iodata->read_pos = iodata->buffer;
+                iodata->read_end = iodata->buffer + bytes;
+            }
+            if (iodata->source_pos >= 0) {
+                iodata->source_pos += bytes;
+            }
+            if (bytes == 0) {
+                *status = SDL_GetIOStatus(iodata->source);
+                break;
+            }
+            continue;
+        }
+
+        avail = SDL_min(avail, size - total);
+        SDL_memcpy(dst + total, iodata->read_pos, avail);
+        iodata->read_pos += avail;
+        total += avail;
+    }
+    return total;
+}
+
+static size_t SDLCALL buffered_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+
+    if (iodata->read_end > iodata->buffer && buffered_discard_reads(iodata) < 0) {
+        *status = SDL_IO_STATUS_ERROR;
+        return 0;
+    }
+
+    if (size > iodata->buffer_size - iodata->write_size) {
+        if (buffered_flush_writes(iodata) < 0) {
+            *status = SDL_IO_STATUS_ERROR;
+            return 0;
+        }
+        if (size >= iodata->buffer_size) {
+            /* Big writes go straight to the source */
+            const size_t bytes = SDL_WriteIO(iodata->source, ptr, size);
+            if (iodata->source_pos >= 0) {
+                iodata->source_pos += bytes;
+            }
+            if (bytes < size) {
+                *status = SDL_GetIOStatus(iodata->source);
+            }
+            return bytes;
+        }
+    }
+
+    SDL_memcpy(iodata->buffer + iodata->write_size, ptr, size);
+    iodata->write_size += size;
+    return size;
+}
+
+static int SDLCALL buffered_close(void *userdata)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    int retval = buffered_flush_writes(iodata);
+
+    if (iodata->closeio && SDL_CloseIO(iodata->source) < 0) {
+        retval = -1;
+    }
+    SDL_free(iodata->buffer);
+    SDL_free(iodata);
+    return retval;
+}
+
+SDL_IOStream *SDL_CreateBufferedIO(SDL_IOStream *src, size_t buffer_size, SDL_bool closeio)
+{
+    IOStreamBufferedData *iodata;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *iostr = NULL;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+
+    if (buffer_size == 0) {
+        buffer_size = DEFAULT_BUFFERED_IO_SIZE;
+    }
+
+    iodata = (IOStreamBufferedData *) SDL_calloc(1, sizeof(*iodata));
+    if (!iodata) {
+        goto done;
+    }
+    iodata->buffer = (Uint8 *)SDL_malloc(buffer_size);
+    if (!iodata->buffer) {
+        goto done;
+    }
+    iodata->source = src;
+    iodata->closeio = closeio;
+    iodata->buffer_size = buffer_size;
+    iodata->read_pos = iodata->read_end = iodata->buffer;
+    iodata->source_pos = -1;
+
+    /* Keep reporting read-only and write-only streams as such */
+    SDL_zero(iface);
+    iface.size = buffered_size;
+    iface.seek = buffered_seek;
+    if (src->iface.read) {
+        iface.read = buffered_read;
+    }
+    if (src->iface.write) {
+        iface.write = buffered_write;
+    }
+    iface.close = buffered_close;
+
+    iostr = SDL_OpenIO(&iface, iodata);
+    if (iostr) {
+        iostr->buffered = iodata;
+    }
+
+done:
+    if (!iostr) {
+        if (iodata) {
+            SDL_free(iodata->buffer);
+            SDL_free(iodata);
+        }
+        if (closeio) {
+            SDL_CloseIO(src);
+        }
+    }
+    return iostr;
+}
+
 SDL_IOStatus SDL_GetIOStatus(SDL_IOStream *context)
 {
     if (!context) {
@@ -1096,12 +1502,43 @@ size_t SDL_IOvprintf(SDL_IOStream *context, SDL_PRINTF_FORMAT_STRING const char
 
 /* Functions for dynamically reading and writing endian-specific values */
 
+/* Small fixed-size reads and writes skip the stream interface entirely
+   when a buffered stream has enough bytes or space on hand */
+SDL_FORCE_INLINE SDL_bool SDL_ReadIOFixed(SDL_IOStream *src, void *data, size_t size)
+{
+    if (src && src->buffered) {
+        IOStreamBufferedData *iodata = src->buffered;
+        if ((size_t)(iodata->read_end - iodata->read_pos) >= size) {
+            SDL_memcpy(data, iodata->read_pos, size);
+            iodata->read_pos += size;
+            src->status = SDL_IO_STATUS_READY;
+            return SDL_TRUE;
+        }
+    }
+    return (SDL_ReadIO(src, data, size) == size);
+}
+
+SDL_FORCE_INLINE SDL_bool SDL_WriteIOFixed(SDL_IOStream *dst, const void *data, size_t size)
+{
+    /* Read-only streams have no write interface and go through SDL_WriteIO() to fail */
+    if (dst && dst->buffered && dst->iface.write) {
+        IOStreamBufferedData *iodata = dst->buffered;
+        if (iodata->read_end == iodata->buffer && size <= iodata->buffer_size - iodata->write_size) {
+            SDL_memcpy(iodata->buffer + iodata->write_size, data, size);
+            iodata->write_size += size;
+            dst->status = SDL_IO_STATUS_READY;
+            return SDL_TRUE;
+        }
+    }
+    return (SDL_WriteIO(dst, data, size) == size);
+}
+
 SDL_bool SDL_ReadU8(SDL_IOStream *src, Uint8 *value)
 {
     Uint8 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOFixed(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1115,7 +1552,7 @@ SDL_bool SDL_ReadS8(SDL_IOStream *src, Sint8 *value)
     Sint8 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOFixed(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1129,7 +1566,7 @@ SDL_bool SDL_ReadU16LE(SDL_IOStream *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOFixed(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1148,7 +1585,7 @@ SDL_bool SDL_ReadU16BE(SDL_IOStream *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOFixed(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1167,7 +1604,7 @@ SDL_bool SDL_ReadU32LE(SDL_IOStream *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOFixed(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1186,7 +1623,7 @@ SDL_bool SDL_ReadU32BE(SDL_IOStream *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOFixed(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1205,7 +1642,7 @@ SDL_bool SDL_ReadU64LE(SDL_IOStream *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOFixed(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1224,7 +1661,7 @@ SDL_bool SDL_ReadU64BE(SDL_IOStream *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOFixed(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1240,18 +1677,18 @@ SDL_bool SDL_ReadS64BE(SDL_IOStream *src, Sint64 *value)
 
 SDL_bool SDL_WriteU8(SDL_IOStream *dst, Uint8 value)
 {
-    return (SDL_WriteIO(dst, &value, sizeof(value)) == sizeof(value));
+    return SDL_WriteIOFixed(dst, &value, sizeof(value));
 }
 
 SDL_bool SDL_WriteS8(SDL_IOStream *dst, Sint8 value)
 {
-    return (SDL_WriteIO(dst, &value, sizeof(value)) == sizeof(value));
+    return SDL_WriteIOFixed(dst, &value, sizeof(value));
 }
 
 SDL_bool SDL_WriteU16LE(SDL_IOStream *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_Swap16LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteIOFixed(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS16LE(SDL_IOStream *dst, Sint16 value)
@@ -1262,7 +1699,7 @@ SDL_bool SDL_WriteS16LE(SDL_IOStream *dst, Sint16 value)
 SDL_bool SDL_WriteU16BE(SDL_IOStream *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_Swap16BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteIOFixed(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS16BE(SDL_IOStream *dst, Sint16 value)
@@ -1273,7 +1710,7 @@ SDL_bool SDL_WriteS16BE(SDL_IOStream *dst, Sint16 value)
 SDL_bool SDL_WriteU32LE(SDL_IOStream *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_Swap32LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteIOFixed(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS32LE(SDL_IOStream *dst, Sint32 value)
@@ -1284,7 +1721,7 @@ SDL_bool SDL_WriteS32LE(SDL_IOStream *dst, Sint32 value)
 SDL_bool SDL_WriteU32BE(SDL_IOStream *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_Swap32BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteIOFixed(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS32BE(SDL_IOStream *dst, Sint32 value)
@@ -1295,7 +1732,7 @@ SDL_bool SDL_WriteS32BE(SDL_IOStream *dst, Sint32 value)
 SDL_bool SDL_WriteU64LE(SDL_IOStream *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_Swap64LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteIOFixed(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS64LE(SDL_IOStream *dst, Sint64 value)
@@ -1306,7 +1743,7 @@ SDL_bool SDL_WriteS64LE(SDL_IOStream *dst, Sint64 value)
 SDL_bool SDL_WriteU64BE(SDL_IOStream *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_Swap64BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteIOFixed(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS64BE(SDL_IOStream *dst, Sint64 value)
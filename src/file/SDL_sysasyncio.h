@@ -0,0 +1,116 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_sysasyncio_h_
+#define SDL_sysasyncio_h_
+
+#include "SDL_asyncio_c.h"
+
+/* Files are accessed with positioned reads and writes where the platform
+   has them, so tasks on the same file never have to serialize. Otherwise
+   an SDL_IOStream is shared between the workers under a lock, which is
+   also the only way to reach Android assets. */
+#if defined(HAVE_PREAD) && defined(HAVE_PWRITE) && !defined(SDL_PLATFORM_ANDROID)
+#define SDL_ASYNCIO_USE_PREAD 1
+#endif
+
+/* io_uring needs a file descriptor */
+#ifndef SDL_ASYNCIO_USE_PREAD
+#undef SDL_ASYNCIO_IO_URING
+#endif
+
+typedef struct SDL_AsyncIOTask SDL_AsyncIOTask;
+
+struct SDL_AsyncIOTask
+{
+    SDL_AsyncIO *asyncio;
+    SDL_AsyncIOTaskType type;
+    SDL_AsyncIOQueue *queue;
+    Uint64 offset;
+    SDL_bool flush;
+    void *buffer;
+    SDL_AsyncIOResult result;
+    Uint64 requested_size;
+    Uint64 result_size;
+    void *app_userdata;
+    SDL_AsyncIOTaskFunc func;   /* if set, run on the worker pool instead of touching asyncio */
+    void *funcdata;
+    SDL_bool finished;          /* SDL_FinishAsyncIOTask() was already called */
+    SDL_bool free_buffer;       /* buffer was allocated by SDL_LoadFileAsync() */
+    SDL_AsyncIOTask *next;      /* for backend lists */
+};
+
+struct SDL_AsyncIO
+{
+#ifdef SDL_ASYNCIO_USE_PREAD
+    int fd;
+#else
+    SDL_IOStream *io;
+    SDL_Mutex *io_lock;
+#endif
+    SDL_Mutex *lock;
+    int num_pending;
+    SDL_AsyncIOTask *closing;
+    SDL_bool oneshot;
+};
+
+typedef struct SDL_AsyncIOQueueInterface
+{
+    /* Start a task, the backend owns it until it's returned from get_results() or wait_results() */
+    int (*queue_task)(void *userdata, SDL_AsyncIOTask *task);
+
+    /* Add a task that was already run by the worker pool to the completed list */
+    void (*post_result)(void *userdata, SDL_AsyncIOTask *task);
+
+    SDL_AsyncIOTask *(*get_results)(void *userdata);
+    SDL_AsyncIOTask *(*wait_results)(void *userdata, Sint32 timeoutMS);
+    void (*signal)(void *userdata);
+    void (*destroy)(void *userdata);
+} SDL_AsyncIOQueueInterface;
+
+struct SDL_AsyncIOQueue
+{
+    SDL_AsyncIOQueueInterface iface;
+    void *userdata;
+    SDL_AtomicInt tasks_inflight;
+};
+
+/* Called by the backends as soon as a task has done its work, before it
+   becomes visible in the queue. Handles deferred closes and SDL_LoadFileAsync(). */
+extern void SDL_FinishAsyncIOTask(SDL_AsyncIOTask *task);
+
+/* Synchronous file operations, used by the worker pool */
+extern int SDL_SYS_OpenAsyncIOFile(SDL_AsyncIO *asyncio, const char *file, const char *mode);
+extern Sint64 SDL_SYS_GetAsyncIOFileSize(SDL_AsyncIO *asyncio);
+extern void SDL_SYS_CloseAsyncIOFile(SDL_AsyncIO *asyncio);
+extern void SDL_SYS_RunAsyncIOTask(SDL_AsyncIOTask *task);
+
+/* The worker pool runs the task, finishes it and posts it to its queue */
+extern int SDL_SYS_QueueAsyncIOPoolTask(SDL_AsyncIOTask *task);
+extern void SDL_SYS_QuitAsyncIOPool(void);
+
+extern int SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue);
+#ifdef SDL_ASYNCIO_IO_URING
+extern int SDL_SYS_CreateAsyncIOQueue_io_uring(SDL_AsyncIOQueue *queue);
+#endif
+
+#endif /* SDL_sysasyncio_h_ */
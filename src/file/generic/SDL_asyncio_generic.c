@@ -0,0 +1,520 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* The generic async I/O backend: a small pool of threads doing blocking,
+   positioned reads and writes, with completed tasks collected in a list. */
+
+#include "../SDL_sysasyncio.h"
+
+#ifdef SDL_ASYNCIO_USE_PREAD
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* One worker per core, at least two so one slow request doesn't hold up the rest,
+   and no more than eight since past that the storage device is the bottleneck */
+#define MIN_ASYNCIO_THREADS 2
+#define MAX_ASYNCIO_THREADS 8
+
+/* Don't hand more than this to a single read or write call */
+#define MAX_ASYNCIO_CHUNK (1024 * 1024 * 1024)
+
+typedef struct GenericAsyncIOQueueData
+{
+    SDL_Mutex *lock;
+    SDL_Condition *condition;
+    SDL_AsyncIOTask *completed_head;
+    SDL_AsyncIOTask *completed_tail;
+} GenericAsyncIOQueueData;
+
+static struct
+{
+    SDL_SpinLock init_lock;
+    SDL_bool initialized;
+    SDL_Mutex *lock;
+    SDL_Condition *condition;
+    SDL_Thread *threads[MAX_ASYNCIO_THREADS];
+    int num_threads;
+    SDL_bool shutting_down;
+    SDL_AsyncIOTask *head;
+    SDL_AsyncIOTask *tail;
+} asyncio_pool;
+
+int SDL_SYS_OpenAsyncIOFile(SDL_AsyncIO *asyncio, const char *file, const char *mode)
+{
+#ifdef SDL_ASYNCIO_USE_PREAD
+    int flags;
+
+    if (SDL_strcmp(mode, "r") == 0) {
+        flags = O_RDONLY;
+    } else if (SDL_strcmp(mode, "w") == 0) {
+        flags = O_WRONLY | O_CREAT | O_TRUNC;
+    } else if (SDL_strcmp(mode, "r+") == 0) {
+        flags = O_RDWR;
+    } else if (SDL_strcmp(mode, "w+") == 0) {
+        flags = O_RDWR | O_CREAT | O_TRUNC;
+    } else {
+        return SDL_SetError("Unsupported file mode \"%s\"", mode);
+    }
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+
+    do {
+        asyncio->fd = open(file, flags, 0666);
+    } while (asyncio->fd < 0 && errno == EINTR);
+
+    if (asyncio->fd < 0) {
+        return SDL_SetError("Couldn't open %s: %s", file, strerror(errno));
+    }
+    return 0;
+#else
+    const char *iomode;
+
+    if (SDL_strcmp(mode, "r") == 0) {
+        iomode = "rb";
+    } else if (SDL_strcmp(mode, "w") == 0) {
+        iomode = "wb";
+    } else if (SDL_strcmp(mode, "r+") == 0) {
+        iomode = "r+b";
+    } else if (SDL_strcmp(mode, "w+") == 0) {
+        iomode = "w+b";
+    } else {
+        return SDL_SetError("Unsupported file mode \"%s\"", mode);
+    }
+
+    asyncio->io_lock = SDL_CreateMutex();
+    if (!asyncio->io_lock) {
+        return -1;
+    }
+
+    asyncio->io = SDL_IOFromFile(file, iomode);
+    if (!asyncio->io) {
+        SDL_DestroyMutex(asyncio->io_lock);
+        asyncio->io_lock = NULL;
+        return -1;
+    }
+    return 0;
+#endif
+}
+
+Sint64 SDL_SYS_GetAsyncIOFileSize(SDL_AsyncIO *asyncio)
+{
+#ifdef SDL_ASYNCIO_USE_PREAD
+    struct stat statbuf;
+
+    if (fstat(asyncio->fd, &statbuf) < 0) {
+        return SDL_SetError("fstat failed: %s", strerror(errno));
+    }
+    return (Sint64)statbuf.st_size;
+#else
+    Sint64 size;
+
+    SDL_LockMutex(asyncio->io_lock);
+    size = SDL_GetIOSize(asyncio->io);
+    SDL_UnlockMutex(asyncio->io_lock);
+    return size;
+#endif
+}
+
+void SDL_SYS_CloseAsyncIOFile(SDL_AsyncIO *asyncio)
+{
+#ifdef SDL_ASYNCIO_USE_PREAD
+    close(asyncio->fd);
+    asyncio->fd = -1;
+#else
+    SDL_CloseIO(asyncio->io);
+    asyncio->io = NULL;
+    SDL_DestroyMutex(asyncio->io_lock);
+    asyncio->io_lock = NULL;
+#endif
+}
+
+static Sint64 SDL_SYS_TransferAsyncIOFile(SDL_AsyncIO *asyncio, SDL_bool reading, Uint8 *ptr, Uint64 offset, Uint64 size)
+{
+    Uint64 total = 0;
+
+#ifdef SDL_ASYNCIO_USE_PREAD
+    while (total < size) {
+        size_t chunk = (size_t)SDL_min(size - total, MAX_ASYNCIO_CHUNK);
+        ssize_t rc;
+
+        if (reading) {
+            rc = pread(asyncio->fd, ptr + total, chunk, (off_t)(offset + total));
+        } else {
+            rc = pwrite(asyncio->fd, ptr + total, chunk, (off_t)(offset + total));
+        }
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return SDL_SetError("%s failed: %s", reading ? "pread" : "pwrite", strerror(errno));
+        } else if (rc == 0) {
+            break;
+        }
+        total += (Uint64)rc;
+    }
+#else
+    SDL_LockMutex(asyncio->io_lock);
+    if (SDL_SeekIO(asyncio->io, (Sint64)offset, SDL_IO_SEEK_SET) < 0) {
+        SDL_UnlockMutex(asyncio->io_lock);
+        return -1;
+    }
+    while (total < size) {
+        size_t chunk = (size_t)SDL_min(size - total, MAX_ASYNCIO_CHUNK);
+        size_t rc;
+
+        if (reading) {
+            rc = SDL_ReadIO(asyncio->io, ptr + total, chunk);
+        } else {
+            rc = SDL_WriteIO(asyncio->io, ptr + total, chunk);
+        }
+        total += rc;
+        if (rc < chunk) {
+            if (SDL_GetIOStatus(asyncio->io) == SDL_IO_STATUS_ERROR) {
+                SDL_UnlockMutex(asyncio->io_lock);
+                return -1;
+            }
+            break;
+        }
+    }
+    SDL_UnlockMutex(asyncio->io_lock);
+#endif
+
+    return (Sint64)total;
+}
+
+static int SDL_SYS_FlushAsyncIOFile(SDL_AsyncIO *asyncio)
+{
+#ifdef SDL_ASYNCIO_USE_PREAD
+    int rc;
+
+    do {
+        rc = fsync(asyncio->fd);
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc < 0) {
+        return SDL_SetError("fsync failed: %s", strerror(errno));
+    }
+#else
+    /* SDL_CloseIO() flushes the stream when the file is closed */
+    (void)asyncio;
+#endif
+    return 0;
+}
+
+void SDL_SYS_RunAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    Sint64 rc;
+
+    if (task->func) {
+        rc = task->func(task->funcdata, task->buffer, task->requested_size);
+    } else {
+        switch (task->type) {
+        case SDL_ASYNCIO_TASK_READ:
+            rc = SDL_SYS_TransferAsyncIOFile(task->asyncio, SDL_TRUE, (Uint8 *)task->buffer, task->offset, task->requested_size);
+            break;
+        case SDL_ASYNCIO_TASK_WRITE:
+            rc = SDL_SYS_TransferAsyncIOFile(task->asyncio, SDL_FALSE, (Uint8 *)task->buffer, task->offset, task->requested_size);
+            break;
+        case SDL_ASYNCIO_TASK_CLOSE:
+            rc = task->flush ? SDL_SYS_FlushAsyncIOFile(task->asyncio) : 0;
+            break;
+        default:
+            rc = SDL_SetError("Unknown async I/O task type");
+            break;
+        }
+    }
+
+    if (rc < 0) {
+        task->result = SDL_ASYNCIO_FAILURE;
+    } else {
+        task->result = SDL_ASYNCIO_COMPLETE;
+        task->result_size = (Uint64)rc;
+    }
+}
+
+static void SDL_CompleteAsyncIOPoolTask(SDL_AsyncIOTask *task, SDL_bool canceled)
+{
+    SDL_AsyncIOQueue *queue = task->queue;
+
+    if (canceled) {
+        task->result = SDL_ASYNCIO_CANCELED;
+        if (task->func) {
+            /* Give it a chance to clean up */
+            task->func(task->funcdata, NULL, 0);
+        }
+    } else {
+        SDL_SYS_RunAsyncIOTask(task);
+    }
+    SDL_FinishAsyncIOTask(task);
+    queue->iface.post_result(queue->userdata, task);
+}
+
+static int SDLCALL SDL_AsyncIOWorkerThread(void *data)
+{
+    (void)data;
+
+    for (;;) {
+        SDL_AsyncIOTask *task;
+        SDL_bool canceled;
+
+        SDL_LockMutex(asyncio_pool.lock);
+        while (!asyncio_pool.head && !asyncio_pool.shutting_down) {
+            SDL_WaitCondition(asyncio_pool.condition, asyncio_pool.lock);
+        }
+        task = asyncio_pool.head;
+        if (task) {
+            asyncio_pool.head = task->next;
+            if (!asyncio_pool.head) {
+                asyncio_pool.tail = NULL;
+            }
+            task->next = NULL;
+        }
+        canceled = asyncio_pool.shutting_down;
+        SDL_UnlockMutex(asyncio_pool.lock);
+
+        if (!task) {
+            break;
+        }
+        SDL_CompleteAsyncIOPoolTask(task, canceled);
+    }
+    return 0;
+}
+
+static SDL_bool SDL_InitAsyncIOPool(void)
+{
+    SDL_bool initialized;
+
+    SDL_LockSpinlock(&asyncio_pool.init_lock);
+    if (!asyncio_pool.initialized) {
+        asyncio_pool.lock = SDL_CreateMutex();
+        asyncio_pool.condition = SDL_CreateCondition();
+        if (asyncio_pool.lock && asyncio_pool.condition) {
+            const int num_threads = SDL_clamp(SDL_GetCPUCount(), MIN_ASYNCIO_THREADS, MAX_ASYNCIO_THREADS);
+            int i;
+
+            asyncio_pool.shutting_down = SDL_FALSE;
+            for (i = 0; i < num_threads; ++i) {
+                SDL_Thread *thread = SDL_CreateThread(SDL_AsyncIOWorkerThread, "SDLAsyncIO", NULL);
+                if (!thread) {
+                    break;
+                }
+                asyncio_pool.threads[asyncio_pool.num_threads++] = thread;
+            }
+        }
+        if (asyncio_pool.num_threads > 0) {
+            asyncio_pool.initialized = SDL_TRUE;
+        } else {
+            SDL_DestroyCondition(asyncio_pool.condition);
+            asyncio_pool.condition = NULL;
+            SDL_DestroyMutex(asyncio_pool.lock);
+            asyncio_pool.lock = NULL;
+        }
+    }
+    initialized = asyncio_pool.initialized;
+    SDL_UnlockSpinlock(&asyncio_pool.init_lock);
+
+    return initialized;
+}
+
+int SDL_SYS_QueueAsyncIOPoolTask(SDL_AsyncIOTask *task)
+{
+    SDL_bool canceled;
+
+    if (!SDL_InitAsyncIOPool()) {
+        /* No threads available, do the work synchronously */
+        SDL_CompleteAsyncIOPoolTask(task, SDL_FALSE);
+        return 0;
+    }
+
+    task->next = NULL;
+    SDL_LockMutex(asyncio_pool.lock);
+    canceled = asyncio_pool.shutting_down;
+    if (!canceled) {
+        if (asyncio_pool.tail) {
+            asyncio_pool.tail->next = task;
+        } else {
+            asyncio_pool.head = task;
+        }
+        asyncio_pool.tail = task;
+        SDL_SignalCondition(asyncio_pool.condition);
+    }
+    SDL_UnlockMutex(asyncio_pool.lock);
+
+    if (canceled) {
+        /* The pool is going away, this can happen when a worker queues more work while finishing a task */
+        SDL_CompleteAsyncIOPoolTask(task, SDL_TRUE);
+    }
+    return 0;
+}
+
+void SDL_SYS_QuitAsyncIOPool(void)
+{
+    int i;
+
+    SDL_LockSpinlock(&asyncio_pool.init_lock);
+    if (!asyncio_pool.initialized) {
+        SDL_UnlockSpinlock(&asyncio_pool.init_lock);
+        return;
+    }
+
+    /* Anything still waiting for a worker is reported as canceled */
+    SDL_LockMutex(asyncio_pool.lock);
+    asyncio_pool.shutting_down = SDL_TRUE;
+    SDL_BroadcastCondition(asyncio_pool.condition);
+    SDL_UnlockMutex(asyncio_pool.lock);
+
+    /* Workers may queue more tasks while they finish up, so they must be
+       able to get through SDL_InitAsyncIOPool() while we wait for them.
+       Those tasks see shutting_down and are canceled right away.
+     */
+    SDL_UnlockSpinlock(&asyncio_pool.init_lock);
+
+    for (i = 0; i < asyncio_pool.num_threads; ++i) {
+        SDL_WaitThread(asyncio_pool.threads[i], NULL);
+        asyncio_pool.threads[i] = NULL;
+    }
+
+    SDL_LockSpinlock(&asyncio_pool.init_lock);
+    asyncio_pool.num_threads = 0;
+    SDL_DestroyCondition(asyncio_pool.condition);
+    asyncio_pool.condition = NULL;
+    SDL_DestroyMutex(asyncio_pool.lock);
+    asyncio_pool.lock = NULL;
+    asyncio_pool.initialized = SDL_FALSE;
+    SDL_UnlockSpinlock(&asyncio_pool.init_lock);
+}
+
+static int GENERIC_QueueTask(void *userdata, SDL_AsyncIOTask *task)
+{
+    (void)userdata;
+    return SDL_SYS_QueueAsyncIOPoolTask(task);
+}
+
+static void GENERIC_PostResult(void *userdata, SDL_AsyncIOTask *task)
+{
+    GenericAsyncIOQueueData *data = (GenericAsyncIOQueueData *)userdata;
+
+    task->next = NULL;
+    SDL_LockMutex(data->lock);
+    if (data->completed_tail) {
+        data->completed_tail->next = task;
+    } else {
+        data->completed_head = task;
+    }
+    data->completed_tail = task;
+    SDL_SignalCondition(data->condition);
+    SDL_UnlockMutex(data->lock);
+}
+
+/* data->lock must be held */
+static SDL_AsyncIOTask *GENERIC_PopResult(GenericAsyncIOQueueData *data)
+{
+    SDL_AsyncIOTask *task = data->completed_head;
+    if (task) {
+        data->completed_head = task->next;
+        if (!data->completed_head) {
+            data->completed_tail = NULL;
+        }
+        task->next = NULL;
+    }
+    return task;
+}
+
+static SDL_AsyncIOTask *GENERIC_GetResults(void *userdata)
+{
+    GenericAsyncIOQueueData *data = (GenericAsyncIOQueueData *)userdata;
+    SDL_AsyncIOTask *task;
+
+    SDL_LockMutex(data->lock);
+    task = GENERIC_PopResult(data);
+    SDL_UnlockMutex(data->lock);
+
+    return task;
+}
+
+static SDL_AsyncIOTask *GENERIC_WaitResults(void *userdata, Sint32 timeoutMS)
+{
+    GenericAsyncIOQueueData *data = (GenericAsyncIOQueueData *)userdata;
+    SDL_AsyncIOTask *task;
+
+    SDL_LockMutex(data->lock);
+    task = GENERIC_PopResult(data);
+    if (!task && timeoutMS != 0) {
+        SDL_WaitConditionTimeout(data->condition, data->lock, timeoutMS);
+        task = GENERIC_PopResult(data);
+    }
+    SDL_UnlockMutex(data->lock);
+
+    return task;
+}
+
+static void GENERIC_Signal(void *userdata)
+{
+    GenericAsyncIOQueueData *data = (GenericAsyncIOQueueData *)userdata;
+
+    SDL_LockMutex(data->lock);
+    SDL_BroadcastCondition(data->condition);
+    SDL_UnlockMutex(data->lock);
+}
+
+static void GENERIC_Destroy(void *userdata)
+{
+    GenericAsyncIOQueueData *data = (GenericAsyncIOQueueData *)userdata;
+
+    SDL_DestroyCondition(data->condition);
+    SDL_DestroyMutex(data->lock);
+    SDL_free(data);
+}
+
+int SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue)
+{
+    static const SDL_AsyncIOQueueInterface GENERIC_iface = {
+        GENERIC_QueueTask,
+        GENERIC_PostResult,
+        GENERIC_GetResults,
+        GENERIC_WaitResults,
+        GENERIC_Signal,
+        GENERIC_Destroy
+    };
+    GenericAsyncIOQueueData *data;
+
+    data = (GenericAsyncIOQueueData *)SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        return -1;
+    }
+
+    data->lock = SDL_CreateMutex();
+    data->condition = SDL_CreateCondition();
+    if (!data->lock || !data->condition) {
+        GENERIC_Destroy(data);
+        return -1;
+    }
+
+    SDL_copyp(&queue->iface, &GENERIC_iface);
+    queue->userdata = data;
+    return 0;
+}
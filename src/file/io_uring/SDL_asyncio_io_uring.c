@@ -0,0 +1,407 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* The Linux io_uring async I/O backend. Each queue owns a ring, reads and
+   writes are handed to the kernel directly and their completions are reaped
+   from the ring when the app asks for results. We talk to the kernel with
+   raw system calls, so there is no dependency on liburing. */
+
+#include "../SDL_sysasyncio.h"
+
+#ifdef SDL_ASYNCIO_IO_URING
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+
+#define IO_URING_ENTRIES 256
+
+/* The length of a ring request is 32 bits, bigger transfers go to the worker pool */
+#define IO_URING_MAX_TRANSFER (1024 * 1024 * 1024)
+
+/* These features are needed for reliable completions and waiting with a timeout */
+#define IO_URING_REQUIRED_FEATURES (IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG)
+
+typedef struct IOUringQueueData
+{
+    int ring_fd;
+
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+
+    unsigned int *sq_head;
+    unsigned int *sq_tail;
+    unsigned int sq_mask;
+    unsigned int sq_entries;
+    unsigned int *sq_array;
+
+    unsigned int *cq_head;
+    unsigned int *cq_tail;
+    unsigned int cq_mask;
+    struct io_uring_cqe *cqes;
+
+    SDL_Mutex *sq_lock;
+    SDL_Mutex *cq_lock;
+
+    /* Tasks run by the worker pool, protected by cq_lock */
+    SDL_AsyncIOTask *posted_head;
+    SDL_AsyncIOTask *posted_tail;
+} IOUringQueueData;
+
+static int io_uring_setup_syscall(unsigned int entries, struct io_uring_params *params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int io_uring_enter_syscall(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags, const void *arg, size_t argsz)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+/* sq_lock must be held */
+static struct io_uring_sqe *IO_URING_GetSQE(IOUringQueueData *data)
+{
+    const unsigned int tail = *data->sq_tail;
+    const unsigned int head = __atomic_load_n(data->sq_head, __ATOMIC_ACQUIRE);
+    struct io_uring_sqe *sqe;
+    unsigned int index;
+
+    if ((tail - head) >= data->sq_entries) {
+        return NULL;
+    }
+
+    index = tail & data->sq_mask;
+    sqe = &data->sqes[index];
+    SDL_zerop(sqe);
+    data->sq_array[index] = index;
+    return sqe;
+}
+
+/* sq_lock must be held. Once the tail moves the entry belongs to the kernel,
+   anything that fails to submit now is picked up by the next submission. */
+static void IO_URING_SubmitSQE(IOUringQueueData *data)
+{
+    const unsigned int tail = *data->sq_tail + 1;
+    int rc;
+
+    __atomic_store_n(data->sq_tail, tail, __ATOMIC_RELEASE);
+
+    do {
+        const unsigned int pending = tail - __atomic_load_n(data->sq_head, __ATOMIC_ACQUIRE);
+        rc = io_uring_enter_syscall(data->ring_fd, pending, 0, 0, NULL, 0);
+    } while (rc < 0 && errno == EINTR);
+}
+
+static void IO_URING_PrepareTransfer(struct io_uring_sqe *sqe, SDL_AsyncIOTask *task)
+{
+    sqe->opcode = (task->type == SDL_ASYNCIO_TASK_READ) ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe->fd = task->asyncio->fd;
+    sqe->addr = (Uint64)(uintptr_t)((Uint8 *)task->buffer + task->result_size);
+    sqe->len = (Uint32)(task->requested_size - task->result_size);
+    sqe->off = task->offset + task->result_size;
+    sqe->user_data = (Uint64)(uintptr_t)task;
+}
+
+static int IO_URING_SubmitTransfer(IOUringQueueData *data, SDL_AsyncIOTask *task)
+{
+    struct io_uring_sqe *sqe;
+
+    SDL_LockMutex(data->sq_lock);
+    sqe = IO_URING_GetSQE(data);
+    if (!sqe) {
+        SDL_UnlockMutex(data->sq_lock);
+        return -1;
+    }
+    IO_URING_PrepareTransfer(sqe, task);
+    IO_URING_SubmitSQE(data);
+    SDL_UnlockMutex(data->sq_lock);
+
+    return 0;
+}
+
+/* Generates a completion without a task, to wake up waiting threads */
+static void IO_URING_SubmitWakeup(IOUringQueueData *data)
+{
+    struct io_uring_sqe *sqe;
+
+    SDL_LockMutex(data->sq_lock);
+    sqe = IO_URING_GetSQE(data);
+    if (sqe) {
+        sqe->opcode = IORING_OP_NOP;
+        sqe->user_data = 0;
+        IO_URING_SubmitSQE(data);
+    }
+    SDL_UnlockMutex(data->sq_lock);
+}
+
+static int IO_URING_QueueTask(void *userdata, SDL_AsyncIOTask *task)
+{
+    IOUringQueueData *data = (IOUringQueueData *)userdata;
+
+    /* Closing, flushing and internal functions are blocking work for the pool */
+    if (task->func || task->type == SDL_ASYNCIO_TASK_CLOSE || task->requested_size > IO_URING_MAX_TRANSFER) {
+        return SDL_SYS_QueueAsyncIOPoolTask(task);
+    }
+
+    if (IO_URING_SubmitTransfer(data, task) < 0) {
+        return SDL_SYS_QueueAsyncIOPoolTask(task);
+    }
+    return 0;
+}
+
+static void IO_URING_PostResult(void *userdata, SDL_AsyncIOTask *task)
+{
+    IOUringQueueData *data = (IOUringQueueData *)userdata;
+
+    task->next = NULL;
+    SDL_LockMutex(data->cq_lock);
+    if (data->posted_tail) {
+        data->posted_tail->next = task;
+    } else {
+        data->posted_head = task;
+    }
+    data->posted_tail = task;
+
+    /* Wake up waiters before the task can be reaped, once it's been seen
+       the queue may be destroyed at any moment. */
+    IO_URING_SubmitWakeup(data);
+    SDL_UnlockMutex(data->cq_lock);
+}
+
+/* cq_lock must be held */
+static SDL_AsyncIOTask *IO_URING_ReapTask(IOUringQueueData *data)
+{
+    for (;;) {
+        SDL_AsyncIOTask *task = data->posted_head;
+        const struct io_uring_cqe *cqe;
+        unsigned int head, tail;
+        int res;
+
+        if (task) {
+            data->posted_head = task->next;
+            if (!data->posted_head) {
+                data->posted_tail = NULL;
+            }
+            task->next = NULL;
+            return task;
+        }
+
+        head = *data->cq_head;
+        tail = __atomic_load_n(data->cq_tail, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            return NULL;
+        }
+
+        cqe = &data->cqes[head & data->cq_mask];
+        task = (SDL_AsyncIOTask *)(uintptr_t)cqe->user_data;
+        res = cqe->res;
+        __atomic_store_n(data->cq_head, head + 1, __ATOMIC_RELEASE);
+
+        if (!task) {
+            continue;  /* a wakeup */
+        }
+
+        if (res < 0) {
+            task->result = SDL_ASYNCIO_FAILURE;
+            SDL_SetError("%s failed: %s", (task->type == SDL_ASYNCIO_TASK_READ) ? "Read" : "Write", strerror(-res));
+        } else {
+            task->result = SDL_ASYNCIO_COMPLETE;
+            task->result_size += (Uint64)res;
+
+            /* Short transfers that made progress get the rest queued up */
+            if (res > 0 && task->result_size < task->requested_size) {
+                if (IO_URING_SubmitTransfer(data, task) == 0) {
+                    continue;
+                }
+
+                /* The submission queue is full, redo the whole transfer on the
+                   thread pool rather than report a partial result as complete.
+                   It comes back through IO_URING_PostResult(). */
+                SDL_SYS_QueueAsyncIOPoolTask(task);
+                continue;
+            }
+        }
+
+        SDL_FinishAsyncIOTask(task);
+        return task;
+    }
+}
+
+static SDL_AsyncIOTask *IO_URING_GetResults(void *userdata)
+{
+    IOUringQueueData *data = (IOUringQueueData *)userdata;
+    SDL_AsyncIOTask *task;
+
+    SDL_LockMutex(data->cq_lock);
+    task = IO_URING_ReapTask(data);
+    SDL_UnlockMutex(data->cq_lock);
+
+    return task;
+}
+
+static SDL_AsyncIOTask *IO_URING_WaitResults(void *userdata, Sint32 timeoutMS)
+{
+    IOUringQueueData *data = (IOUringQueueData *)userdata;
+    struct io_uring_getevents_arg arg;
+    struct __kernel_timespec ts;
+    SDL_AsyncIOTask *task;
+
+    task = IO_URING_GetResults(data);
+    if (task || timeoutMS == 0) {
+        return task;
+    }
+
+    SDL_zero(arg);
+    if (timeoutMS > 0) {
+        ts.tv_sec = timeoutMS / 1000;
+        ts.tv_nsec = (timeoutMS % 1000) * 1000000;
+        arg.ts = (Uint64)(uintptr_t)&ts;
+    }
+    io_uring_enter_syscall(data->ring_fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+
+    return IO_URING_GetResults(data);
+}
+
+static void IO_URING_Signal(void *userdata)
+{
+    IO_URING_SubmitWakeup((IOUringQueueData *)userdata);
+}
+
+static void IO_URING_Destroy(void *userdata)
+{
+    IOUringQueueData *data = (IOUringQueueData *)userdata;
+
+    if (data->sqes) {
+        munmap(data->sqes, data->sqes_size);
+    }
+    if (data->cq_ring && data->cq_ring != data->sq_ring) {
+        munmap(data->cq_ring, data->cq_ring_size);
+    }
+    if (data->sq_ring) {
+        munmap(data->sq_ring, data->sq_ring_size);
+    }
+    if (data->ring_fd >= 0) {
+        close(data->ring_fd);
+    }
+    SDL_DestroyMutex(data->sq_lock);
+    SDL_DestroyMutex(data->cq_lock);
+    SDL_free(data);
+}
+
+static void *IO_URING_MapRing(int fd, size_t size, off_t offset)
+{
+    void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return (ptr == MAP_FAILED) ? NULL : ptr;
+}
+
+int SDL_SYS_CreateAsyncIOQueue_io_uring(SDL_AsyncIOQueue *queue)
+{
+    static const SDL_AsyncIOQueueInterface IO_URING_iface = {
+        IO_URING_QueueTask,
+        IO_URING_PostResult,
+        IO_URING_GetResults,
+        IO_URING_WaitResults,
+        IO_URING_Signal,
+        IO_URING_Destroy
+    };
+    struct io_uring_params params;
+    IOUringQueueData *data;
+    Uint8 *sq_ring, *cq_ring;
+
+    data = (IOUringQueueData *)SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        return -1;
+    }
+
+    SDL_zero(params);
+    data->ring_fd = io_uring_setup_syscall(IO_URING_ENTRIES, &params);
+    if (data->ring_fd < 0) {
+        SDL_SetError("io_uring_setup failed: %s", strerror(errno));
+        SDL_free(data);
+        return -1;
+    }
+    if ((params.features & IO_URING_REQUIRED_FEATURES) != IO_URING_REQUIRED_FEATURES) {
+        IO_URING_Destroy(data);
+        return SDL_SetError("io_uring is missing required features");
+    }
+
+    data->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    data->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        data->sq_ring_size = SDL_max(data->sq_ring_size, data->cq_ring_size);
+        data->cq_ring_size = data->sq_ring_size;
+    }
+
+    data->sq_ring = IO_URING_MapRing(data->ring_fd, data->sq_ring_size, IORING_OFF_SQ_RING);
+    if (!data->sq_ring) {
+        IO_URING_Destroy(data);
+        return SDL_SetError("Couldn't map io_uring submission queue: %s", strerror(errno));
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        data->cq_ring = data->sq_ring;
+    } else {
+        data->cq_ring = IO_URING_MapRing(data->ring_fd, data->cq_ring_size, IORING_OFF_CQ_RING);
+        if (!data->cq_ring) {
+            IO_URING_Destroy(data);
+            return SDL_SetError("Couldn't map io_uring completion queue: %s", strerror(errno));
+        }
+    }
+    data->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    data->sqes = (struct io_uring_sqe *)IO_URING_MapRing(data->ring_fd, data->sqes_size, IORING_OFF_SQES);
+    if (!data->sqes) {
+        IO_URING_Destroy(data);
+        return SDL_SetError("Couldn't map io_uring submission entries: %s", strerror(errno));
+    }
+
+    sq_ring = (Uint8 *)data->sq_ring;
+    data->sq_head = (unsigned int *)(sq_ring + params.sq_off.head);
+    data->sq_tail = (unsigned int *)(sq_ring + params.sq_off.tail);
+    data->sq_mask = *(unsigned int *)(sq_ring + params.sq_off.ring_mask);
+    data->sq_entries = *(unsigned int *)(sq_ring + params.sq_off.ring_entries);
+    data->sq_array = (unsigned int *)(sq_ring + params.sq_off.array);
+
+    cq_ring = (Uint8 *)data->cq_ring;
+    data->cq_head = (unsigned int *)(cq_ring + params.cq_off.head);
+    data->cq_tail = (unsigned int *)(cq_ring + params.cq_off.tail);
+    data->cq_mask = *(unsigned int *)(cq_ring + params.cq_off.ring_mask);
+    data->cqes = (struct io_uring_cqe *)(cq_ring + params.cq_off.cqes);
+
+    data->sq_lock = SDL_CreateMutex();
+    data->cq_lock = SDL_CreateMutex();
+    if (!data->sq_lock || !data->cq_lock) {
+        IO_URING_Destroy(data);
+        return -1;
+    }
+
+    SDL_copyp(&queue->iface, &IO_URING_iface);
+    queue->userdata = data;
+    return 0;
+}
+
+#endif /* SDL_ASYNCIO_IO_URING */
@@ -72,176 +72,350 @@ int SDL_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback call
     return (SDL_SYS_EnumerateDirectory(path, path, callback, userdata) < 0) ? -1 : 0;
 }
 
-int SDL_GetPathInfo(const char *path, SDL_PathInfo *info)
+typedef struct EnumerateInfoCallbackData
 {
-    SDL_PathInfo dummy;
+    SDL_EnumerateDirectoryInfoCallback callback;
+    void *userdata;
+} EnumerateInfoCallbackData;
 
-    if (!info) {
-        info = &dummy;
+static int EnumerateInfoCallback(void *userdata, const char *dirname, const char *fname, const SDL_PathInfo *info, SDL_bool is_link)
+{
+    EnumerateInfoCallbackData *data = (EnumerateInfoCallbackData *) userdata;
+    return data->callback(data->userdata, dirname, fname, info);
+}
+
+// Recursive enumeration reads each directory into a listing, hands its entries to the app and
+// then moves on to its subdirectories. Only one directory is open at a time, however deep the tree.
+typedef struct DirectoryEntry
+{
+    size_t name;  // offset into the listing's names
+    SDL_PathInfo info;
+    SDL_bool descend;
+} DirectoryEntry;
+
+typedef struct DirectoryListing
+{
+    char *path;
+    char *names;
+    size_t names_len;
+    size_t names_allocated;
+    DirectoryEntry *entries;
+    int num_entries;
+    int entries_allocated;
+    struct DirectoryListing *next;
+} DirectoryListing;
+
+static int AddDirectoryEntry(void *userdata, const char *dirname, const char *fname, const SDL_PathInfo *info, SDL_bool is_link)
+{
+    DirectoryListing *listing = (DirectoryListing *) userdata;
+    const size_t namelen = SDL_strlen(fname) + 1;
+
+    if (listing->num_entries == listing->entries_allocated) {
+        const int allocated = listing->entries_allocated ? (listing->entries_allocated * 2) : 64;
+        DirectoryEntry *entries = (DirectoryEntry *) SDL_realloc(listing->entries, allocated * sizeof (*entries));
+        if (!entries) {
+            return -1;
+        }
+        listing->entries = entries;
+        listing->entries_allocated = allocated;
     }
-    SDL_zerop(info);
 
-    if (!path) {
-        return SDL_InvalidParamError("path");
+    if ((listing->names_len + namelen) > listing->names_allocated) {
+        size_t allocated = listing->names_allocated ? (listing->names_allocated * 2) : 1024;
+        while (allocated < (listing->names_len + namelen)) {
+            allocated *= 2;
+        }
+        char *names = (char *) SDL_realloc(listing->names, allocated);
+        if (!names) {
+            return -1;
+        }
+        listing->names = names;
+        listing->names_allocated = allocated;
     }
 
-    return SDL_SYS_GetPathInfo(path, info);
+    DirectoryEntry *entry = &listing->entries[listing->num_entries++];
+    entry->name = listing->names_len;
+    entry->info = *info;
+    entry->descend = ((info->type == SDL_PATHTYPE_DIRECTORY) && !is_link);  // don't get caught in symlink loops.
+    SDL_memcpy(listing->names + listing->names_len, fname, namelen);
+    listing->names_len += namelen;
+    return 1;
+}
+
+static void FreeDirectoryListing(DirectoryListing *listing)
+{
+    SDL_free(listing->path);
+    SDL_free(listing->names);
+    SDL_free(listing->entries);
+    SDL_free(listing);
 }
 
-static SDL_bool EverythingMatch(const char *pattern, const char *str, SDL_bool *matched_to_dir)
+static DirectoryListing *CreateDirectoryListing(const char *dirname, const char *fname)
 {
-    SDL_assert(pattern == NULL);
-    SDL_assert(str != NULL);
-    SDL_assert(matched_to_dir != NULL);
+    DirectoryListing *listing = (DirectoryListing *) SDL_calloc(1, sizeof (*listing));
+    if (!listing) {
+        return NULL;
+    }
 
-    *matched_to_dir = SDL_TRUE;
-    return SDL_TRUE;  // everything matches!
+    if (!fname) {
+        listing->path = SDL_strdup(dirname);
+    } else {
+        const size_t dirlen = SDL_strlen(dirname);
+        SDL_bool need_separator = (dirlen > 0) && (dirname[dirlen-1] != '/');
+#ifdef SDL_PLATFORM_WINDOWS
+        need_separator = need_separator && (dirname[dirlen-1] != '\\');
+#endif
+        if (SDL_asprintf(&listing->path, "%s%s%s", dirname, need_separator ? "/" : "", fname) < 0) {
+            listing->path = NULL;
+        }
+    }
+    if (!listing->path) {
+        SDL_free(listing);
+        return NULL;
+    }
+    return listing;
 }
 
-// this is just '*' and '?', with '/' matching nothing.
-static SDL_bool WildcardMatch(const char *pattern, const char *str, SDL_bool *matched_to_dir)
+static int EnumerateDirectoryTree(const char *path, SDL_EnumerateDirectoryInfoCallback callback, void *userdata)
 {
-    SDL_assert(pattern != NULL);
-    SDL_assert(str != NULL);
-    SDL_assert(matched_to_dir != NULL);
-
-    const char *str_backtrack = NULL;
-    const char *pattern_backtrack = NULL;
-    char sch_backtrack = 0;
-    char sch = *str;
-    char pch = *pattern;
-
-    while (sch) {
-        if (pch == '*') {
-            str_backtrack = str;
-            pattern_backtrack = ++pattern;
-            sch_backtrack = sch;
-            pch = *pattern;
-        } else if (pch == sch) {
-            if (pch == '/') {
-                str_backtrack = pattern_backtrack = NULL;
+    DirectoryListing *pending = CreateDirectoryListing(path, NULL);  // a stack of directories still to be read.
+    if (!pending) {
+        return -1;
+    }
+
+    int retval = 0;
+    SDL_bool done = SDL_FALSE;
+    while (pending) {
+        DirectoryListing *listing = pending;
+        pending = listing->next;
+
+        // once we're done, just free whatever is left.
+        if (!done) {
+            if (SDL_SYS_EnumerateDirectoryWithInfo(listing->path, listing->path, SDL_TRUE, AddDirectoryEntry, listing) < 0) {
+                retval = -1;
+                done = SDL_TRUE;
+            }
+            for (int i = 0; !done && (i < listing->num_entries); i++) {
+                const DirectoryEntry *entry = &listing->entries[i];
+                const int rc = callback(userdata, listing->path, listing->names + entry->name, &entry->info);
+                if (rc <= 0) {
+                    retval = (rc < 0) ? -1 : 0;
+                    done = SDL_TRUE;
+                }
+            }
+            // push the subdirectories last to first, so they're read in the order they were listed.
+            for (int i = listing->num_entries - 1; !done && (i >= 0); i--) {
+                const DirectoryEntry *entry = &listing->entries[i];
+                if (entry->descend) {
+                    DirectoryListing *subdir = CreateDirectoryListing(listing->path, listing->names + entry->name);
+                    if (!subdir) {
+                        retval = -1;
+                        done = SDL_TRUE;
+                        break;
+                    }
+                    subdir->next = pending;
+                    pending = subdir;
+                }
             }
-            sch = *(++str);
-            pch = *(++pattern);
-        } else if ((pch == '?') && (sch != '/')) {  // end of string (checked at `while`) or path separator do not match '?'.
-            sch = *(++str);
-            pch = *(++pattern);
-        } else if (!pattern_backtrack || (sch_backtrack == '/')) { // we didn't have a match. Are we in a '*' and NOT on a path separator? Keep going. Otherwise, fail.
-            *matched_to_dir = SDL_FALSE;
-            return SDL_FALSE;
-        } else {  // still here? Wasn't a match, but we're definitely in a '*' pattern.
-            str = ++str_backtrack;
-            pattern = pattern_backtrack;
-            sch_backtrack = sch;
-            sch = *str;
-            pch = *pattern;
         }
+
+        FreeDirectoryListing(listing);
     }
 
-    // '*' at the end can be ignored, they are allowed to match nothing.
-    while (pch == '*') {
-        pch = *(++pattern);
+    return retval;
+}
+
+int SDL_EnumerateDirectoryWithInfo(const char *path, SDL_EnumerateFlags flags, SDL_EnumerateDirectoryInfoCallback callback, void *userdata)
+{
+    if (!path) {
+        return SDL_InvalidParamError("path");
+    } else if (!callback) {
+        return SDL_InvalidParamError("callback");
     }
 
-    *matched_to_dir = ((pch == '/') || (pch == '\0'));  // end of string and the pattern is complete or failed at a '/'? We should descend into this directory.
+    if (flags & SDL_ENUMERATE_RECURSIVE) {
+        return EnumerateDirectoryTree(path, callback, userdata);
+    }
 
-    return (pch == '\0');  // survived the whole pattern? That's a match!
+    EnumerateInfoCallbackData data = { callback, userdata };
+    return (SDL_SYS_EnumerateDirectoryWithInfo(path, path, SDL_TRUE, EnumerateInfoCallback, &data) < 0) ? -1 : 0;
 }
 
-
-// Note that this will currently encode illegal codepoints: UTF-16 surrogates, 0xFFFE, and 0xFFFF.
-// and a codepoint > 0x10FFFF will fail the same as if there wasn't enough memory.
-// clean this up if you want to move this to SDL_string.c.
-static size_t EncodeCodepointToUtf8(char *ptr, Uint32 cp, size_t remaining)
+int SDL_GetPathInfo(const char *path, SDL_PathInfo *info)
 {
-    if (cp < 0x80) {  // fits in a single UTF-8 byte.
-        if (remaining) {
-            *ptr = (char) cp;
-            return 1;
-        }
-    } else if (cp < 0x800) {  // fits in 2 bytes.
-        if (remaining >= 2) {
-            ptr[0] = (char) ((cp >> 6) | 128 | 64);
-            ptr[1] = (char) (cp & 0x3F) | 128;
-            return 2;
-        }
-    } else if (cp < 0x10000) { // fits in 3 bytes.
-        if (remaining >= 3) {
-            ptr[0] = (char) ((cp >> 12) | 128 | 64 | 32);
-            ptr[1] = (char) ((cp >> 6) & 0x3F) | 128;
-            ptr[2] = (char) (cp & 0x3F) | 128;
-            return 3;
-        }
-    } else if (cp <= 0x10FFFF) {  // fits in 4 bytes.
-        if (remaining >= 4) {
-            ptr[0] = (char) ((cp >> 18) | 128 | 64 | 32 | 16);
-            ptr[1] = (char) ((cp >> 12) & 0x3F) | 128;
-            ptr[2] = (char) ((cp >> 6) & 0x3F) | 128;
-            ptr[3] = (char) (cp & 0x3F) | 128;
-            return 4;
-        }
+    SDL_PathInfo dummy;
+
+    if (!info) {
+        info = &dummy;
+    }
+    SDL_zerop(info);
+
+    if (!path) {
+        return SDL_InvalidParamError("path");
     }
 
-    return 0;
+    return SDL_SYS_GetPathInfo(path, info);
 }
 
-static char *CaseFoldUtf8String(const char *fname)
+// Glob patterns are compiled once into an array of characters per path segment, with the wildcards
+// replaced by values that can't show up in a path. For case-insensitive globs, the characters are
+// case-folded codepoints, otherwise they are the bytes of the pattern. Each directory level of the
+// tree is matched against its own segment, so paths never have to be built or folded to be matched.
+#define GLOB_ANY_CHARS 0xFFFFFFFFu  // '*'
+#define GLOB_ANY_CHAR 0xFFFFFFFEu   // '?'
+
+typedef struct GlobPattern
 {
-    SDL_assert(fname != NULL);
-    const size_t allocation = (SDL_strlen(fname) + 1) * 3 * 4;
-    char *retval = (char *) SDL_malloc(allocation);  // lazy: just allocating the max needed.
-    if (!retval) {
-        return NULL;
+    SDL_bool caseinsensitive;
+    int num_segments;
+    size_t *segments;  // num_segments + 1 offsets into `chars`.
+    Uint32 *chars;
+} GlobPattern;
+
+// Returns the number of characters in `str`, but only writes up to `dstlen` of them.
+static size_t DecodeGlobString(const char *str, size_t len, SDL_bool caseinsensitive, Uint32 *dst, size_t dstlen)
+{
+    size_t count = 0;
+
+    if (!caseinsensitive) {
+        for (size_t i = 0; i < len; i++, count++) {
+            if (count < dstlen) {
+                dst[count] = (Uint8) str[i];
+            }
+        }
+        return count;
     }
 
-    Uint32 codepoint;
-    char *ptr = retval;
-    size_t remaining = allocation;
-    while ((codepoint = SDL_StepUTF8(&fname, NULL)) != 0) {
+    while (len > 0) {
         Uint32 folded[3];
+        const Uint32 codepoint = SDL_StepUTF8(&str, &len);
         const int num_folded = SDL_CaseFoldUnicode(codepoint, folded);
         SDL_assert(num_folded > 0);
         SDL_assert(num_folded <= SDL_arraysize(folded));
-        for (int i = 0; i < num_folded; i++) {
-            SDL_assert(remaining > 0);
-            const size_t rc = EncodeCodepointToUtf8(ptr, folded[i], remaining);
-            SDL_assert(rc > 0);
-            SDL_assert(rc < remaining);
-            remaining -= rc;
-            ptr += rc;
+        for (int i = 0; i < num_folded; i++, count++) {
+            if (count < dstlen) {
+                dst[count] = folded[i];
+            }
         }
     }
+    return count;
+}
 
-    SDL_assert(remaining > 0);
-    remaining--;
-    *ptr = '\0';
+static GlobPattern *CompileGlobPattern(const char *pattern, SDL_bool caseinsensitive)
+{
+    const size_t patternlen = SDL_strlen(pattern);
+    int num_segments = 1;
+    for (const char *ptr = pattern; *ptr; ptr++) {
+        if (*ptr == '/') {
+            num_segments++;
+        }
+    }
 
-    if (remaining > 0) {
-        SDL_assert(allocation > remaining);
-        ptr = SDL_realloc(retval, allocation - remaining);  // shrink it down.
-        if (ptr) {  // shouldn't fail, but if it does, `retval` is still valid.
-            retval = ptr;
+    // every byte decodes to at most one codepoint, which folds to at most three.
+    const size_t maxchars = caseinsensitive ? (patternlen * 3) : patternlen;
+    const size_t allocation = sizeof (GlobPattern) + ((num_segments + 1) * sizeof (size_t)) + (maxchars * sizeof (Uint32));
+    GlobPattern *glob = (GlobPattern *) SDL_malloc(allocation);
+    if (!glob) {
+        return NULL;
+    }
+    glob->caseinsensitive = caseinsensitive;
+    glob->num_segments = num_segments;
+    glob->segments = (size_t *) (glob + 1);
+    glob->chars = (Uint32 *) (glob->segments + (num_segments + 1));
+
+    size_t numchars = 0;
+    const char *segment = pattern;
+    for (int i = 0; i < num_segments; i++) {
+        const char *sep = SDL_strchr(segment, '/');
+        const size_t seglen = sep ? (size_t) (sep - segment) : SDL_strlen(segment);
+        glob->segments[i] = numchars;
+        numchars += DecodeGlobString(segment, seglen, caseinsensitive, glob->chars + numchars, maxchars - numchars);
+        segment += seglen + 1;
+    }
+    glob->segments[num_segments] = numchars;
+    SDL_assert(numchars <= maxchars);
+
+    for (size_t i = 0; i < numchars; i++) {
+        if (glob->chars[i] == '*') {
+            glob->chars[i] = GLOB_ANY_CHARS;
+        } else if (glob->chars[i] == '?') {
+            glob->chars[i] = GLOB_ANY_CHAR;
         }
     }
 
-    return retval;
+    return glob;
 }
 
+// this is just '*' and '?' within a single path segment.
+static SDL_bool MatchGlobSegment(const Uint32 *pattern, size_t patternlen, const Uint32 *str, size_t len)
+{
+    size_t p = 0, s = 0;
+    size_t star = 0, star_str = 0;
+    SDL_bool have_star = SDL_FALSE;
+
+    while (s < len) {
+        if ((p < patternlen) && ((pattern[p] == str[s]) || (pattern[p] == GLOB_ANY_CHAR))) {
+            p++;
+            s++;
+        } else if ((p < patternlen) && (pattern[p] == GLOB_ANY_CHARS)) {
+            have_star = SDL_TRUE;
+            star = ++p;
+            star_str = s;
+        } else if (have_star) {  // let the last '*' eat one more character and try again from there.
+            p = star;
+            s = ++star_str;
+        } else {
+            return SDL_FALSE;
+        }
+    }
+
+    // '*' at the end can be ignored, they are allowed to match nothing.
+    while ((p < patternlen) && (pattern[p] == GLOB_ANY_CHARS)) {
+        p++;
+    }
+    return (p == patternlen);
+}
+
+static SDL_bool MatchGlobName(const GlobPattern *glob, int segment, const char *fname)
+{
+    Uint32 stackbuf[256];
+    Uint32 *str = stackbuf;
+    const size_t fnamelen = SDL_strlen(fname);
+    const size_t len = DecodeGlobString(fname, fnamelen, glob->caseinsensitive, stackbuf, SDL_arraysize(stackbuf));
+
+    if (len > SDL_arraysize(stackbuf)) {  // an unusually long filename, do it the slow way.
+        str = (Uint32 *) SDL_malloc(len * sizeof (Uint32));
+        if (!str) {
+            return SDL_FALSE;
+        }
+        DecodeGlobString(fname, fnamelen, glob->caseinsensitive, str, len);
+    }
+
+    const size_t *segments = glob->segments;
+    const SDL_bool retval = MatchGlobSegment(glob->chars + segments[segment], segments[segment + 1] - segments[segment], str, len);
+
+    if (str != stackbuf) {
+        SDL_free(str);
+    }
+    return retval;
+}
 
 typedef struct GlobDirCallbackData
 {
-    SDL_bool (*matcher)(const char *pattern, const char *str, SDL_bool *matched_to_dir);
-    const char *pattern;
+    const GlobPattern *glob;  // NULL to match everything.
+    int depth;  // the pattern segment that entries of the directory being enumerated are matched against.
     int num_entries;
-    SDL_GlobFlags flags;
     SDL_GlobEnumeratorFunc enumerator;
     SDL_GlobGetPathInfoFunc getpathinfo;
     void *fsuserdata;
     size_t basedirlen;
+    char *path;  // the path of the current entry, pushed and popped as we walk the tree.
+    size_t pathlen;
+    size_t pathallocated;
     SDL_IOStream *string_stream;
 } GlobDirCallbackData;
 
-static int SDLCALL GlobDirectoryCallback(void *userdata, const char *dirname, const char *fname)
+static int SDLCALL GlobDirectoryCallback(void *userdata, const char *dirname, const char *fname, const SDL_PathInfo *info)
 {
     SDL_assert(userdata != NULL);
     SDL_assert(dirname != NULL);
@@ -251,49 +425,73 @@ static int SDLCALL GlobDirectoryCallback(void *userdata, const char *dirname, co
 
     GlobDirCallbackData *data = (GlobDirCallbackData *) userdata;
 
-    // !!! FIXME: if we're careful, we can keep a single buffer in `data` that we push and pop paths off the end of as we walk the tree,
-    // !!! FIXME: and only casefold the new pieces instead of allocating and folding full paths for all of this.
+    SDL_bool matched = SDL_TRUE;
+    SDL_bool descend = SDL_TRUE;
+    if (data->glob) {
+        // nothing below the last segment of the pattern can match, so only descend into directories above it.
+        const SDL_bool last_segment = (data->depth == (data->glob->num_segments - 1));
+        const SDL_bool segment_matched = MatchGlobName(data->glob, data->depth, fname);
+        matched = segment_matched && last_segment;
+        descend = segment_matched && !last_segment;
+    }
+    //SDL_Log("GlobDirectoryCallback: Considered '%s' at depth %d: %smatched (descend=%s)", fname, data->depth, matched ? "" : "NOT ", descend ? "TRUE" : "FALSE");
 
-    char *fullpath = NULL;
-    if (SDL_asprintf(&fullpath, "%s/%s", dirname, fname) < 0) {
-        return -1;
+    if (!matched && !descend) {
+        return 1;  // keep enumerating.
     }
 
-    char *folded = NULL;
-    if (data->flags & SDL_GLOB_CASEINSENSITIVE) {
-        folded = CaseFoldUtf8String(fullpath);
-        if (!folded) {
+    // dirname is always the path we're building here, so push this entry onto the end of it.
+    const size_t dirlen = data->pathlen;
+    const size_t fnamelen = SDL_strlen(fname);
+    const size_t needed = dirlen + fnamelen + 2;
+    if (needed > data->pathallocated) {
+        const size_t allocation = SDL_max(needed, data->pathallocated * 2);
+        char *ptr = (char *) SDL_realloc(data->path, allocation);
+        if (!ptr) {
             return -1;
         }
+        data->path = ptr;
+        data->pathallocated = allocation;
     }
+    data->path[dirlen] = '/';
+    SDL_memcpy(data->path + dirlen + 1, fname, fnamelen + 1);
+    data->pathlen = dirlen + 1 + fnamelen;
 
-    SDL_bool matched_to_dir = SDL_FALSE;
-    const SDL_bool matched = data->matcher(data->pattern, (folded ? folded : fullpath) + data->basedirlen, &matched_to_dir);
-    //SDL_Log("GlobDirectoryCallback: Considered %spath='%s' vs pattern='%s': %smatched (matched_to_dir=%s)", folded ? "(folded) " : "", (folded ? folded : fullpath) + data->basedirlen, data->pattern, matched ? "" : "NOT ", matched_to_dir ? "TRUE" : "FALSE");
-    SDL_free(folded);
-
+    int retval = 1;  // keep enumerating by default.
     if (matched) {
-        const char *subpath = fullpath + data->basedirlen;
+        const char *subpath = data->path + data->basedirlen;
         const size_t slen = SDL_strlen(subpath) + 1;
         if (SDL_WriteIO(data->string_stream, subpath, slen) != slen) {
-            SDL_free(fullpath);
-            return -1;  // stop enumerating, return failure to the app.
+            retval = -1;  // stop enumerating, return failure to the app.
+        } else {
+            data->num_entries++;
         }
-        data->num_entries++;
     }
 
-    int retval = 1;  // keep enumerating by default.
-    if (matched_to_dir) {
-        SDL_PathInfo info;
-        if ((data->getpathinfo(fullpath, &info, data->fsuserdata) == 0) && (info.type == SDL_PATHTYPE_DIRECTORY)) {
-            //SDL_Log("GlobDirectoryCallback: Descending into subdir '%s'", fname);
-            if (data->enumerator(fullpath, GlobDirectoryCallback, data, data->fsuserdata) < 0) {
+    if ((retval == 1) && descend) {
+        SDL_PathInfo statinfo;
+        if (!info && (data->getpathinfo(data->path, &statinfo, data->fsuserdata) == 0)) {
+            info = &statinfo;
+        }
+        if (info && (info->type == SDL_PATHTYPE_DIRECTORY)) {
+            // the enumerator holds on to its path while we keep changing (and maybe reallocating) ours.
+            char *subdir = SDL_strdup(data->path);
+            if (!subdir) {
                 retval = -1;
+            } else {
+                //SDL_Log("GlobDirectoryCallback: Descending into subdir '%s'", fname);
+                data->depth++;
+                if (data->enumerator(subdir, GlobDirectoryCallback, data, data->fsuserdata) < 0) {
+                    retval = -1;
+                }
+                data->depth--;
+                SDL_free(subdir);
             }
         }
     }
 
-    SDL_free(fullpath);
+    data->pathlen = dirlen;
+    data->path[dirlen] = '\0';
 
     return retval;
 }
@@ -311,64 +509,49 @@ char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_Glob
         return NULL;
     }
 
-    // if path ends with any '/', chop them off, so we don't confuse the pattern matcher later.
-    char *pathcpy = NULL;
-    size_t pathlen = SDL_strlen(path);
-    if (pathlen && (path[pathlen-1] == '/')) {
-        pathcpy = SDL_strdup(path);
-        if (!pathcpy) {
-            return NULL;
-        }
-        char *ptr = &pathcpy[pathlen-1];
-        while ((ptr >= pathcpy) && (*ptr == '/')) {
-            *(ptr--) = '\0';
-        }
-        path = pathcpy;
+    GlobDirCallbackData data;
+    SDL_zero(data);
+
+    // keep our own copy of the path, we push entries onto the end of it as we walk the tree.
+    data.pathlen = SDL_strlen(path);
+    data.pathallocated = data.pathlen + 256;
+    data.path = (char *) SDL_malloc(data.pathallocated);
+    if (!data.path) {
+        return NULL;
     }
+    SDL_memcpy(data.path, path, data.pathlen + 1);
 
-    if (!pattern) {
-        flags &= ~SDL_GLOB_CASEINSENSITIVE;  // avoid some unnecessary allocations and work later.
+    // if path ends with any '/', chop them off, so we don't confuse the pattern matcher later.
+    while ((data.pathlen > 0) && (data.path[data.pathlen-1] == '/')) {
+        data.path[--data.pathlen] = '\0';
     }
 
-    char *folded = NULL;
-    if (flags & SDL_GLOB_CASEINSENSITIVE) {
-        SDL_assert(pattern != NULL);
-        folded = CaseFoldUtf8String(pattern);
-        if (!folded) {
-            SDL_free(pathcpy);
+    GlobPattern *glob = NULL;
+    if (pattern) {  // no pattern? Everything matches.
+        // !!! FIXME: SDL_GLOB_GITIGNORE
+        glob = CompileGlobPattern(pattern, (flags & SDL_GLOB_CASEINSENSITIVE) ? SDL_TRUE : SDL_FALSE);
+        if (!glob) {
+            SDL_free(data.path);
             return NULL;
         }
     }
 
-    GlobDirCallbackData data;
-    SDL_zero(data);
     data.string_stream = SDL_IOFromDynamicMem();
     if (!data.string_stream) {
-        SDL_free(folded);
-        SDL_free(pathcpy);
+        SDL_free(glob);
+        SDL_free(data.path);
         return NULL;
     }
 
-    if (!pattern) {
-        data.matcher = EverythingMatch;  // no pattern? Everything matches.
-
-    // !!! FIXME
-    //} else if (flags & SDL_GLOB_GITIGNORE) {
-    //    data.matcher = GitIgnoreMatch;
-
-    } else {
-        data.matcher = WildcardMatch;
-    }
-
-    data.pattern = folded ? folded : pattern;
-    data.flags = flags;
+    data.glob = glob;
     data.enumerator = enumerator;
     data.getpathinfo = getpathinfo;
     data.fsuserdata = userdata;
-    data.basedirlen = SDL_strlen(path) + 1;  // +1 for the '/' we'll be adding.
+    data.basedirlen = data.pathlen + 1;  // +1 for the '/' we'll be adding.
 
     char **retval = NULL;
-    if (data.enumerator(path, GlobDirectoryCallback, &data, data.fsuserdata) == 0) {
+    char *basedir = SDL_strdup(data.path);  // the enumerator holds on to this while we change data.path.
+    if (basedir && (data.enumerator(basedir, GlobDirectoryCallback, &data, data.fsuserdata) == 0)) {
         const size_t streamlen = (size_t) SDL_GetIOSize(data.string_stream);
         const size_t buflen = streamlen + ((data.num_entries + 1) * sizeof (char *));  // +1 for NULL terminator at end of array.
         retval = (char **) SDL_malloc(buflen);
@@ -389,9 +572,10 @@ char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_Glob
         }
     }
 
+    SDL_free(basedir);
     SDL_CloseIO(data.string_stream);
-    SDL_free(folded);
-    SDL_free(pathcpy);
+    SDL_free(glob);
+    SDL_free(data.path);
 
     return retval;
 }
@@ -401,9 +585,11 @@ static int GlobDirectoryGetPathInfo(const char *path, SDL_PathInfo *info, void *
     return SDL_GetPathInfo(path, info);
 }
 
-static int GlobDirectoryEnumerator(const char *path, SDL_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata)
+static int GlobDirectoryEnumerator(const char *path, SDL_EnumerateDirectoryInfoCallback cb, void *cbuserdata, void *userdata)
 {
-    return SDL_EnumerateDirectory(path, cb, cbuserdata);
+    EnumerateInfoCallbackData data = { cb, cbuserdata };
+    // the glob only needs to know which entries are directories, which usually doesn't need a stat per entry.
+    return (SDL_SYS_EnumerateDirectoryWithInfo(path, path, SDL_FALSE, EnumerateInfoCallback, &data) < 0) ? -1 : 0;
 }
 
 char **SDL_GlobDirectory(const char *path, const char *pattern, SDL_GlobFlags flags, int *count)
@@ -28,13 +28,20 @@ extern char *SDL_SYS_GetPrefPath(const char *org, const char *app);
 extern char *SDL_SYS_GetUserFolder(SDL_Folder folder);
 
 int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_EnumerateDirectoryCallback cb, void *userdata);
+
+// Like SDL_SYS_EnumerateDirectory, but with information about each entry. If `details` is SDL_FALSE, only
+// `info->type` has to be filled in, which can often be done without asking the filesystem about each entry.
+// `is_link` is set for symbolic links, which are followed for `info`.
+typedef int (*SDL_SYS_EnumerateInfoCallback)(void *userdata, const char *dirname, const char *fname, const SDL_PathInfo *info, SDL_bool is_link);
+int SDL_SYS_EnumerateDirectoryWithInfo(const char *path, const char *dirname, SDL_bool details, SDL_SYS_EnumerateInfoCallback cb, void *userdata);
 int SDL_SYS_RemovePath(const char *path);
 int SDL_SYS_RenamePath(const char *oldpath, const char *newpath);
 int SDL_SYS_CopyFile(const char *oldpath, const char *newpath);
 int SDL_SYS_CreateDirectory(const char *path);
 int SDL_SYS_GetPathInfo(const char *path, SDL_PathInfo *info);
 
-typedef int (*SDL_GlobEnumeratorFunc)(const char *path, SDL_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata);
+// The enumerator may pass a NULL `info` to the callback, then getpathinfo is used for entries that might need to be descended into.
+typedef int (*SDL_GlobEnumeratorFunc)(const char *path, SDL_EnumerateDirectoryInfoCallback cb, void *cbuserdata, void *userdata);
 typedef int (*SDL_GlobGetPathInfoFunc)(const char *path, SDL_PathInfo *info, void *userdata);
 char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_GlobFlags flags, int *count, SDL_GlobEnumeratorFunc enumerator, SDL_GlobGetPathInfoFunc getpathinfo, void *userdata);
 
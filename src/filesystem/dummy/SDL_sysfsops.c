@@ -33,6 +33,11 @@ int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_Enumer
     return SDL_Unsupported();
 }
 
+int SDL_SYS_EnumerateDirectoryWithInfo(const char *path, const char *dirname, SDL_bool details, SDL_SYS_EnumerateInfoCallback cb, void *userdata)
+{
+    return SDL_Unsupported();
+}
+
 int SDL_SYS_RemovePath(const char *path)
 {
     return SDL_Unsupported();
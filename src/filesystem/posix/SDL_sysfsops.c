@@ -32,7 +32,16 @@
 #include <string.h>
 #include <errno.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
+#ifdef SDL_PLATFORM_LINUX
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#ifdef HAVE_SENDFILE
+#include <sys/sendfile.h>
+#endif
+#endif
 
 int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_EnumerateDirectoryCallback cb, void *userdata)
 {
@@ -58,6 +67,106 @@ int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_Enumer
     return retval;
 }
 
+static void StatToPathInfo(const struct stat *statbuf, SDL_PathInfo *info)
+{
+    if (S_ISREG(statbuf->st_mode)) {
+        info->type = SDL_PATHTYPE_FILE;
+        info->size = (Uint64) statbuf->st_size;
+    } else if (S_ISDIR(statbuf->st_mode)) {
+        info->type = SDL_PATHTYPE_DIRECTORY;
+        info->size = 0;
+    } else {
+        info->type = SDL_PATHTYPE_OTHER;
+        info->size = (Uint64) statbuf->st_size;
+    }
+
+#if defined(HAVE_ST_MTIM)
+    /* POSIX.1-2008 standard */
+    info->create_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_ctim.tv_sec) + statbuf->st_ctim.tv_nsec;
+    info->modify_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_mtim.tv_sec) + statbuf->st_mtim.tv_nsec;
+    info->access_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_atim.tv_sec) + statbuf->st_atim.tv_nsec;
+#elif defined(SDL_PLATFORM_APPLE)
+    /* Apple platform stat structs use 'st_*timespec' naming. */
+    info->create_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_ctimespec.tv_sec) + statbuf->st_ctimespec.tv_nsec;
+    info->modify_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_mtimespec.tv_sec) + statbuf->st_mtimespec.tv_nsec;
+    info->access_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_atimespec.tv_sec) + statbuf->st_atimespec.tv_nsec;
+#else
+    info->create_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_ctime);
+    info->modify_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_mtime);
+    info->access_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf->st_atime);
+#endif
+}
+
+int SDL_SYS_EnumerateDirectoryWithInfo(const char *path, const char *dirname, SDL_bool details, SDL_SYS_EnumerateInfoCallback cb, void *userdata)
+{
+    int retval = 1;
+
+    DIR *dir = opendir(path);
+    if (!dir) {
+        return SDL_SetError("Can't open directory: %s", strerror(errno));
+    }
+
+    // stat the entries relative to the open directory, so the kernel doesn't walk the whole path for each of them.
+    const int fd = dirfd(dir);
+
+    struct dirent *ent;
+    while ((retval == 1) && ((ent = readdir(dir)) != NULL))
+    {
+        const char *name = ent->d_name;
+        if ((SDL_strcmp(name, ".") == 0) || (SDL_strcmp(name, "..") == 0)) {
+            continue;
+        }
+
+        SDL_PathInfo info;
+        SDL_zero(info);
+        SDL_bool is_link = SDL_FALSE;
+        SDL_bool need_stat = details;
+
+#ifdef _DIRENT_HAVE_D_TYPE
+        switch (ent->d_type) {
+        case DT_REG:
+            info.type = SDL_PATHTYPE_FILE;
+            break;
+        case DT_DIR:
+            info.type = SDL_PATHTYPE_DIRECTORY;
+            break;
+        case DT_LNK:
+            is_link = SDL_TRUE;
+            need_stat = SDL_TRUE;
+            break;
+        case DT_UNKNOWN:
+            need_stat = SDL_TRUE;  // some filesystems don't fill in d_type
+            break;
+        default:
+            info.type = SDL_PATHTYPE_OTHER;
+            break;
+        }
+#else
+        need_stat = SDL_TRUE;
+#endif
+
+        if (need_stat) {
+            struct stat statbuf, targetbuf;
+            if (fstatat(fd, name, &statbuf, AT_SYMLINK_NOFOLLOW) < 0) {
+                continue;  // it vanished since readdir()
+            }
+            if (S_ISLNK(statbuf.st_mode)) {
+                is_link = SDL_TRUE;
+                if (fstatat(fd, name, &targetbuf, 0) == 0) {
+                    statbuf = targetbuf;
+                }  // otherwise it's a dangling link, report the link itself.
+            }
+            StatToPathInfo(&statbuf, &info);
+        }
+
+        retval = cb(userdata, dirname, name, &info, is_link);
+    }
+
+    closedir(dir);
+
+    return retval;
+}
+
 int SDL_SYS_RemovePath(const char *path)
 {
     int rc = remove(path);
@@ -79,20 +188,16 @@ int SDL_SYS_RenamePath(const char *oldpath, const char *newpath)
     return 0;
 }
 
-int SDL_SYS_CopyFile(const char *oldpath, const char *newpath)
+/* Copy the file through SDL_IOStreams, which also handles Android assets */
+static int CopyFileStreams(const char *oldpath, const char *tmppath)
 {
     char *buffer = NULL;
-    char *tmppath = NULL;
     SDL_IOStream *input = NULL;
     SDL_IOStream *output = NULL;
     const size_t maxlen = 4096;
     size_t len;
     int retval = -1;
 
-    if (SDL_asprintf(&tmppath, "%s.tmp", newpath) < 0) {
-        goto done;
-    }
-
     input = SDL_IOFromFile(oldpath, "rb");
     if (!input) {
         goto done;
@@ -121,14 +226,11 @@ int SDL_SYS_CopyFile(const char *oldpath, const char *newpath)
     input = NULL;
 
     if (SDL_CloseIO(output) < 0) {
-        goto done;
-    }
-    output = NULL;
-
-    if (SDL_RenamePath(tmppath, newpath) < 0) {
+        output = NULL;
         SDL_RemovePath(tmppath);
         goto done;
     }
+    output = NULL;
 
     retval = 0;
 
@@ -140,12 +242,192 @@ done:
     if (input) {
         SDL_CloseIO(input);
     }
-    SDL_free(tmppath);
     SDL_free(buffer);
 
     return retval;
 }
 
+#ifdef SDL_PLATFORM_LINUX
+
+/* Copy whatever is left of the input with plain reads and writes. The
+   buffer is big enough that the syscall overhead doesn't matter. */
+static int CopyFileContents(int input, int output)
+{
+    const size_t maxlen = 1024 * 1024;
+    char *buffer = (char *)SDL_malloc(maxlen);
+    int retval = -1;
+
+    if (!buffer) {
+        return -1;
+    }
+
+    for (;;) {
+        ssize_t len = read(input, buffer, maxlen);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SDL_SetError("Can't read file: %s", strerror(errno));
+            break;
+        } else if (len == 0) {
+            retval = 0;
+            break;
+        }
+
+        ssize_t written = 0;
+        while (written < len) {
+            const ssize_t rc = write(output, buffer + written, (size_t)(len - written));
+            if (rc < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            written += rc;
+        }
+        if (written < len) {
+            SDL_SetError("Can't write file: %s", strerror(errno));
+            break;
+        }
+    }
+
+    SDL_free(buffer);
+    return retval;
+}
+
+/* Let the kernel move the data without a round trip through user space.
+   Returns SDL_TRUE if the whole file was copied, otherwise the file
+   positions are left after whatever was copied and the caller finishes
+   the copy with CopyFileContents(). The copy runs until the kernel
+   reports the end of the file, in case the file grew since it was
+   stat'd. */
+static SDL_bool CopyFileKernel(int input, int output, const struct stat *statbuf)
+{
+    if (!S_ISREG(statbuf->st_mode) || statbuf->st_size <= 0) {
+        return SDL_FALSE;  /* special files often report no size, just read them */
+    }
+
+#ifdef FICLONE
+    /* Filesystems like btrfs and XFS can share the extents instead of copying them */
+    if (ioctl(output, FICLONE, input) == 0) {
+        return SDL_TRUE;
+    }
+#endif
+
+#ifdef HAVE_COPY_FILE_RANGE
+    for (;;) {
+        const ssize_t rc = copy_file_range(input, NULL, output, NULL, 0x40000000, 0);
+        if (rc == 0) {
+            return SDL_TRUE;
+        } else if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  /* older kernels refuse to copy across filesystems */
+        }
+    }
+#endif
+#ifdef HAVE_SENDFILE
+    for (;;) {
+        const ssize_t rc = sendfile(output, input, NULL, 0x40000000);
+        if (rc == 0) {
+            return SDL_TRUE;
+        } else if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+    }
+#endif
+
+    return SDL_FALSE;
+}
+
+/* Copy the file using file descriptors, so the kernel can do the work.
+   Returns 1 if the file was copied, 0 if the input couldn't be opened
+   and the caller should fall back to CopyFileStreams(), or -1 on error. */
+static int CopyFileDescriptors(const char *oldpath, const char *tmppath)
+{
+    int input = -1;
+    int output = -1;
+    struct stat statbuf;
+    int retval = -1;
+
+    input = open(oldpath, O_RDONLY | O_CLOEXEC);
+    if (input < 0) {
+        return 0;
+    }
+    if (fstat(input, &statbuf) < 0) {
+        SDL_SetError("Can't stat: %s", strerror(errno));
+        goto done;
+    }
+
+    output = open(tmppath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (output < 0) {
+        SDL_SetError("Couldn't open %s: %s", tmppath, strerror(errno));
+        goto done;
+    }
+
+    if (!CopyFileKernel(input, output, &statbuf) && CopyFileContents(input, output) < 0) {
+        goto done;
+    }
+
+    if (close(output) < 0) {
+        output = -1;
+        SDL_SetError("Can't write file: %s", strerror(errno));
+        SDL_RemovePath(tmppath);
+        goto done;
+    }
+    output = -1;
+
+    retval = 1;
+
+done:
+    if (output >= 0) {
+        close(output);
+        SDL_RemovePath(tmppath);
+    }
+    close(input);
+
+    return retval;
+}
+
+#endif /* SDL_PLATFORM_LINUX */
+
+int SDL_SYS_CopyFile(const char *oldpath, const char *newpath)
+{
+    char *tmppath = NULL;
+    int rc = 0;
+    int retval = -1;
+
+    if (SDL_asprintf(&tmppath, "%s.tmp", newpath) < 0) {
+        goto done;
+    }
+
+#ifdef SDL_PLATFORM_LINUX
+    rc = CopyFileDescriptors(oldpath, tmppath);
+    if (rc < 0) {
+        goto done;
+    }
+#endif
+    if (rc == 0 && CopyFileStreams(oldpath, tmppath) < 0) {
+        goto done;
+    }
+
+    if (SDL_RenamePath(tmppath, newpath) < 0) {
+        SDL_RemovePath(tmppath);
+        goto done;
+    }
+
+    retval = 0;
+
+done:
+    SDL_free(tmppath);
+
+    return retval;
+}
+
 int SDL_SYS_CreateDirectory(const char *path)
 {
     const int rc = mkdir(path, 0770);
@@ -168,32 +450,8 @@ int SDL_SYS_GetPathInfo(const char *path, SDL_PathInfo *info)
     const int rc = stat(path, &statbuf);
     if (rc < 0) {
         return SDL_SetError("Can't stat: %s", strerror(errno));
-    } else if (S_ISREG(statbuf.st_mode)) {
-        info->type = SDL_PATHTYPE_FILE;
-        info->size = (Uint64) statbuf.st_size;
-    } else if (S_ISDIR(statbuf.st_mode)) {
-        info->type = SDL_PATHTYPE_DIRECTORY;
-        info->size = 0;
-    } else {
-        info->type = SDL_PATHTYPE_OTHER;
-        info->size = (Uint64) statbuf.st_size;
     }
-
-#if defined(HAVE_ST_MTIM)
-    /* POSIX.1-2008 standard */
-    info->create_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_ctim.tv_sec) + statbuf.st_ctim.tv_nsec;
-    info->modify_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_mtim.tv_sec) + statbuf.st_mtim.tv_nsec;
-    info->access_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_atim.tv_sec) + statbuf.st_atim.tv_nsec;
-#elif defined(SDL_PLATFORM_APPLE)
-    /* Apple platform stat structs use 'st_*timespec' naming. */
-    info->create_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_ctimespec.tv_sec) + statbuf.st_ctimespec.tv_nsec;
-    info->modify_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_mtimespec.tv_sec) + statbuf.st_mtimespec.tv_nsec;
-    info->access_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_atimespec.tv_sec) + statbuf.st_atimespec.tv_nsec;
-#else
-    info->create_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_ctime);
-    info->modify_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_mtime);
-    info->access_time = (SDL_Time)SDL_SECONDS_TO_NS(statbuf.st_atime);
-#endif
+    StatToPathInfo(&statbuf, info);
     return 0;
 }
 
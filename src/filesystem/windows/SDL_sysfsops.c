@@ -90,6 +90,103 @@ int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_Enumer
     return retval;
 }
 
+static void FindDataToPathInfo(const WIN32_FIND_DATAW *entw, SDL_PathInfo *info)
+{
+    if (entw->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        info->type = SDL_PATHTYPE_DIRECTORY;
+        info->size = 0;
+    } else if (entw->dwFileAttributes & (FILE_ATTRIBUTE_OFFLINE | FILE_ATTRIBUTE_DEVICE)) {
+        info->type = SDL_PATHTYPE_OTHER;
+        info->size = ((((Uint64) entw->nFileSizeHigh) << 32) | entw->nFileSizeLow);
+    } else {
+        info->type = SDL_PATHTYPE_FILE;
+        info->size = ((((Uint64) entw->nFileSizeHigh) << 32) | entw->nFileSizeLow);
+    }
+
+    info->create_time = SDL_TimeFromWindows(entw->ftCreationTime.dwLowDateTime, entw->ftCreationTime.dwHighDateTime);
+    info->modify_time = SDL_TimeFromWindows(entw->ftLastWriteTime.dwLowDateTime, entw->ftLastWriteTime.dwHighDateTime);
+    info->access_time = SDL_TimeFromWindows(entw->ftLastAccessTime.dwLowDateTime, entw->ftLastAccessTime.dwHighDateTime);
+}
+
+int SDL_SYS_EnumerateDirectoryWithInfo(const char *path, const char *dirname, SDL_bool details, SDL_SYS_EnumerateInfoCallback cb, void *userdata)
+{
+    int retval = 1;
+    SDL_PathInfo info;
+
+    if (*path == '\0') {  // if empty (completely at the root), we need to enumerate drive letters.
+        const DWORD drives = GetLogicalDrives();
+        char name[3] = { 0, ':', '\0' };
+        SDL_zero(info);
+        info.type = SDL_PATHTYPE_DIRECTORY;
+        for (int i = 'A'; (retval == 1) && (i <= 'Z'); i++) {
+            if (drives & (1 << (i - 'A'))) {
+                name[0] = (char) i;
+                retval = cb(userdata, dirname, name, &info, SDL_FALSE);
+            }
+        }
+        return retval;
+    }
+
+    const size_t patternlen = SDL_strlen(path) + 3;
+    char *pattern = (char *) SDL_malloc(patternlen);
+    if (!pattern) {
+        return -1;
+    }
+    SDL_snprintf(pattern, patternlen, "%s\\*", path);
+
+    WCHAR *wpattern = WIN_UTF8ToStringW(pattern);
+    SDL_free(pattern);
+    if (!wpattern) {
+        return -1;
+    }
+
+    // The find data already has everything that's in an SDL_PathInfo, so this needs no extra requests per entry.
+    WIN32_FIND_DATAW entw;
+    HANDLE dir = FindFirstFileExW(wpattern, FindExInfoBasic, &entw, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+    SDL_free(wpattern);
+    if (dir == INVALID_HANDLE_VALUE) {
+        return WIN_SetError("Failed to enumerate directory");
+    }
+
+    do {
+        const WCHAR *fn = entw.cFileName;
+
+        if (fn[0] == '.') {  // ignore "." and ".."
+            if ((fn[1] == '\0') || ((fn[1] == '.') && (fn[2] == '\0'))) {
+                continue;
+            }
+        }
+
+        char *utf8fn = WIN_StringToUTF8W(fn);
+        if (!utf8fn) {
+            retval = -1;
+            break;
+        }
+
+        const SDL_bool is_link = ((entw.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) && (entw.dwReserved0 == IO_REPARSE_TAG_SYMLINK)) ? SDL_TRUE : SDL_FALSE;
+        SDL_zero(info);
+        FindDataToPathInfo(&entw, &info);
+        if (is_link) {
+            // the find data describes the link itself, ask about what it points to.
+            char *fullpath = NULL;
+            if (SDL_asprintf(&fullpath, "%s\\%s", path, utf8fn) < 0) {
+                SDL_free(utf8fn);
+                retval = -1;
+                break;
+            }
+            SDL_SYS_GetPathInfo(fullpath, &info);  // if the link is dangling, report the link itself.
+            SDL_free(fullpath);
+        }
+
+        retval = cb(userdata, dirname, utf8fn, &info, is_link);
+        SDL_free(utf8fn);
+    } while ((retval == 1) && (FindNextFileW(dir, &entw) != 0));
+
+    FindClose(dir);
+
+    return retval;
+}
+
 int SDL_SYS_RemovePath(const char *path)
 {
     WCHAR *wpath = WIN_UTF8ToStringW(path);
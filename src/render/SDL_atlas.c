@@ -0,0 +1,142 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_internal.h"
+
+#include "SDL_atlas_c.h"
+
+/* The skyline is the list of top edges of the packed area, sorted by x and
+ * covering the whole width. Each new rectangle is placed at the lowest
+ * position it fits, which keeps the wasted space below the skyline small.
+ */
+
+int SDL_InitSkyline(SDL_Skyline *skyline, int w, int h)
+{
+    /* Every node is at least one pixel wide, plus one while inserting */
+    skyline->nodes = (SDL_SkylineNode *)SDL_malloc((w + 1) * sizeof(*skyline->nodes));
+    if (!skyline->nodes) {
+        return -1;
+    }
+    skyline->w = w;
+    skyline->h = h;
+    skyline->num_nodes = 1;
+    skyline->nodes[0].x = 0;
+    skyline->nodes[0].y = 0;
+    skyline->nodes[0].w = w;
+    return 0;
+}
+
+/* Returns the y position of a rectangle placed at the left edge of a node, or -1 if it doesn't fit */
+static int SkylineFit(const SDL_Skyline *skyline, int index, int w, int h)
+{
+    const SDL_SkylineNode *node = &skyline->nodes[index];
+    int y = 0;
+    int remaining = w;
+
+    if (node->x + w > skyline->w) {
+        return -1;
+    }
+
+    while (remaining > 0) {
+        SDL_assert(index < skyline->num_nodes);
+        y = SDL_max(y, skyline->nodes[index].y);
+        if (y + h > skyline->h) {
+            return -1;
+        }
+        remaining -= skyline->nodes[index].w;
+        ++index;
+    }
+    return y;
+}
+
+SDL_bool SDL_AddSkylineRect(SDL_Skyline *skyline, int w, int h, SDL_Point *position)
+{
+    SDL_SkylineNode *nodes = skyline->nodes;
+    int best_index = -1;
+    int best_y = skyline->h;
+    int best_w = skyline->w;
+    int i;
+
+    if (w <= 0 || h <= 0) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < skyline->num_nodes; ++i) {
+        int y = SkylineFit(skyline, i, w, h);
+        if (y >= 0 && (y < best_y || (y == best_y && nodes[i].w < best_w))) {
+            best_index = i;
+            best_y = y;
+            best_w = nodes[i].w;
+        }
+    }
+    if (best_index < 0) {
+        return SDL_FALSE;
+    }
+
+    position->x = nodes[best_index].x;
+    position->y = best_y;
+
+    /* Insert the top edge of the new rectangle */
+    SDL_memmove(&nodes[best_index + 1], &nodes[best_index], (skyline->num_nodes - best_index) * sizeof(*nodes));
+    ++skyline->num_nodes;
+    nodes[best_index].x = position->x;
+    nodes[best_index].y = best_y + h;
+    nodes[best_index].w = w;
+
+    /* Shrink or remove the nodes that are now covered by it */
+    i = best_index + 1;
+    while (i < skyline->num_nodes) {
+        const SDL_SkylineNode *prev = &nodes[i - 1];
+        SDL_SkylineNode *node = &nodes[i];
+        int overlap = (prev->x + prev->w) - node->x;
+
+        if (overlap <= 0) {
+            break;
+        }
+        if (overlap < node->w) {
+            node->x += overlap;
+            node->w -= overlap;
+            break;
+        }
+        SDL_memmove(&nodes[i], &nodes[i + 1], (skyline->num_nodes - i - 1) * sizeof(*nodes));
+        --skyline->num_nodes;
+    }
+
+    /* Merge neighbors at the same height */
+    i = 0;
+    while (i + 1 < skyline->num_nodes) {
+        if (nodes[i].y == nodes[i + 1].y) {
+            nodes[i].w += nodes[i + 1].w;
+            SDL_memmove(&nodes[i + 1], &nodes[i + 2], (skyline->num_nodes - i - 2) * sizeof(*nodes));
+            --skyline->num_nodes;
+        } else {
+            ++i;
+        }
+    }
+    return SDL_TRUE;
+}
+
+void SDL_QuitSkyline(SDL_Skyline *skyline)
+{
+    SDL_free(skyline->nodes);
+    skyline->nodes = NULL;
+    skyline->num_nodes = 0;
+}
@@ -0,0 +1,45 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_atlas_c_h_
+#define SDL_atlas_c_h_
+
+#include "SDL_internal.h"
+
+/* A skyline rectangle packer, used to place small textures in shared atlas textures */
+
+typedef struct SDL_SkylineNode
+{
+    int x, y, w;
+} SDL_SkylineNode;
+
+typedef struct SDL_Skyline
+{
+    int w, h;
+    int num_nodes;
+    SDL_SkylineNode *nodes;
+} SDL_Skyline;
+
+extern int SDL_InitSkyline(SDL_Skyline *skyline, int w, int h);
+extern SDL_bool SDL_AddSkylineRect(SDL_Skyline *skyline, int w, int h, SDL_Point *position);
+extern void SDL_QuitSkyline(SDL_Skyline *skyline);
+
+#endif /* SDL_atlas_c_h_ */
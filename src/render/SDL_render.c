@@ -23,6 +23,7 @@
 /* The SDL 2D rendering system */
 
 #include "SDL_sysrender.h"
+#include "SDL_atlas_c.h"
 #include "software/SDL_render_sw_c.h"
 #include "../video/SDL_pixels_c.h"
 #include "../video/SDL_video_c.h"
@@ -47,6 +48,10 @@ this should probably be removed at some point in the future.  --ryan. */
 #define SDL_PROP_WINDOW_RENDERER_POINTER "SDL.internal.window.renderer"
 #define SDL_PROP_TEXTURE_PARENT_POINTER "SDL.internal.texture.parent"
 
+/* The size of the shared textures that small textures are packed into, and the largest texture packed */
+#define SDL_ATLAS_PAGE_SIZE         1024
+#define SDL_ATLAS_MAX_TEXTURE_SIZE  256
+
 #define CHECK_RENDERER_MAGIC_BUT_NOT_DESTROYED_FLAG(renderer, retval)   \
     if (!SDL_ObjectValid(renderer, SDL_OBJECT_TYPE_RENDERER)) {         \
         SDL_InvalidParamError("renderer");                              \
@@ -308,12 +313,267 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+static void ResetRenderCommandState(SDL_Renderer *renderer)
+{
+    renderer->vertex_data_used = 0;
+    renderer->render_command_generation++;
+    renderer->color_queued = SDL_FALSE;
+    renderer->color_scale_queued = SDL_FALSE;
+    renderer->viewport_queued = SDL_FALSE;
+    renderer->cliprect_queued = SDL_FALSE;
+    renderer->stats_last_texture = NULL;
+}
+
+struct SDL_RenderReadback
+{
+    SDL_Rect rect;
+    float SDR_white_point;
+    float HDR_headroom;
+    SDL_RenderReadbackCallback callback;
+    void *userdata;
+    SDL_Renderer *renderer;
+    SDL_Surface *surface;
+    char *error;
+    void *pending;
+    struct SDL_RenderReadback *next;
+    SDL_AtomicInt complete;
+    SDL_AtomicInt refcount;
+};
+
+static void ReleaseRenderReadback(SDL_RenderReadback *readback)
+{
+    if (SDL_AtomicAdd(&readback->refcount, -1) == 1) {
+        SDL_DestroySurface(readback->surface);
+        SDL_free(readback->error);
+        SDL_free(readback);
+    }
+}
+
+/* Hand the pixels of a readback to the application, or the error if there aren't any */
+static void FinishRenderReadback(SDL_RenderReadback *readback, SDL_Surface *surface)
+{
+    if (surface) {
+        SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
+
+        SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, readback->SDR_white_point);
+        SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, readback->HDR_headroom);
+    } else {
+        /* The error may have been set on another thread, save it for SDL_WaitRenderReadback() */
+        readback->error = SDL_strdup(SDL_GetError());
+    }
+    readback->surface = surface;
+    SDL_AtomicSet(&readback->complete, 1);
+
+    if (readback->callback) {
+        readback->callback(readback->userdata, readback);
+    }
+    ReleaseRenderReadback(readback);
+}
+
+/* Read the pixels of a readback, this is called after all the commands before it have been run */
+static void CompleteRenderReadback(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    FinishRenderReadback(readback, renderer->RenderReadPixels(renderer, &readback->rect));
+}
+
+/* Finish the readbacks the backend has copied out, in the order they were started.
+   If wait_for is set, block until that readback is done. */
+static void UpdatePendingReadbacks(SDL_Renderer *renderer, SDL_RenderReadback *wait_for)
+{
+    while (renderer->pending_readbacks) {
+        SDL_RenderReadback *readback = renderer->pending_readbacks;
+
+        if (!wait_for && !renderer->IsReadPixelsDone(renderer, readback->pending)) {
+            break;
+        }
+
+        renderer->pending_readbacks = readback->next;
+        if (!renderer->pending_readbacks) {
+            renderer->pending_readbacks_tail = NULL;
+        }
+        readback->next = NULL;
+
+        FinishRenderReadback(readback, renderer->FinishReadPixels(renderer, readback->pending));
+
+        if (readback == wait_for) {
+            break;
+        }
+    }
+}
+
+static int SDLCALL SDL_RenderThread(void *userdata)
+{
+    SDL_Renderer *renderer = (SDL_Renderer *)userdata;
+
+    SDL_LockMutex(renderer->render_thread_lock);
+    for (;;) {
+        SDL_bool presented;
+
+        while (!renderer->render_thread_busy && !renderer->render_thread_quit) {
+            SDL_WaitCondition(renderer->render_thread_cond, renderer->render_thread_lock);
+        }
+        if (!renderer->render_thread_busy) {
+            break;
+        }
+        SDL_UnlockMutex(renderer->render_thread_lock);
+
+        if (renderer->render_thread_commands) {
+            renderer->RunCommandQueue(renderer, renderer->render_thread_commands, renderer->render_thread_vertex_data, renderer->render_thread_vertex_data_used);
+        }
+        if (renderer->render_thread_readback) {
+            CompleteRenderReadback(renderer, renderer->render_thread_readback);
+        }
+        presented = renderer->render_thread_present;
+        if (presented && renderer->RenderPresent(renderer) < 0) {
+            presented = SDL_FALSE;
+        }
+
+        SDL_LockMutex(renderer->render_thread_lock);
+        if (renderer->render_thread_present) {
+            renderer->render_thread_presented = presented;
+        }
+        renderer->render_thread_readback = NULL;
+        renderer->render_thread_busy = SDL_FALSE;
+        SDL_BroadcastCondition(renderer->render_thread_cond);
+    }
+    SDL_UnlockMutex(renderer->render_thread_lock);
+
+    return 0;
+}
+
+/* Wait for the render thread to finish its frame, after which the backend may be used directly again */
+static void WaitRenderThread(SDL_Renderer *renderer)
+{
+    if (!renderer->render_thread) {
+        return;
+    }
+
+    SDL_LockMutex(renderer->render_thread_lock);
+    while (renderer->render_thread_busy) {
+        SDL_WaitCondition(renderer->render_thread_cond, renderer->render_thread_lock);
+    }
+    SDL_UnlockMutex(renderer->render_thread_lock);
+
+    /* Move the finished commands to the unused pool so we can reuse them next time. */
+    if (renderer->render_thread_commands_tail) {
+        renderer->render_thread_commands_tail->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = renderer->render_thread_commands;
+        renderer->render_thread_commands_tail = NULL;
+        renderer->render_thread_commands = NULL;
+    }
+
+    /* Switch the backend to a render target that was set while the render thread was busy.
+       The software renderer can't fail to do this, so there's no error to report. */
+    if (renderer->render_thread_target_pending) {
+        renderer->render_thread_target_pending = SDL_FALSE;
+
+        SDL_LockMutex(renderer->target_mutex);
+        renderer->SetRenderTarget(renderer, renderer->target);
+        SDL_UnlockMutex(renderer->target_mutex);
+    }
+}
+
+/* Hand the current frame to the render thread and start recording the next one,
+   optionally presenting it or reading back pixels once it has been drawn */
+static int SubmitRenderThread(SDL_Renderer *renderer, SDL_bool present, SDL_RenderReadback *readback)
+{
+    void *vertex_data;
+    size_t vertex_data_allocation;
+
+    WaitRenderThread(renderer);
+
+    if (renderer->PrepareRenderThread(renderer) < 0) {
+        return -1;
+    }
+
+    SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
+
+    if (renderer->render_commands) {
+        DebugLogRenderCommands(renderer->render_commands);
+        renderer->stats.flushes++;
+    }
+
+    /* The vertex buffers are double buffered, the next frame is recorded into the one that was just drawn */
+    vertex_data = renderer->render_thread_vertex_data;
+    vertex_data_allocation = renderer->render_thread_vertex_data_allocation;
+    renderer->render_thread_vertex_data = renderer->vertex_data;
+    renderer->render_thread_vertex_data_used = renderer->vertex_data_used;
+    renderer->render_thread_vertex_data_allocation = renderer->vertex_data_allocation;
+    renderer->vertex_data = vertex_data;
+    renderer->vertex_data_allocation = vertex_data_allocation;
+
+    renderer->render_thread_commands = renderer->render_commands;
+    renderer->render_thread_commands_tail = renderer->render_commands_tail;
+    renderer->render_commands = NULL;
+    renderer->render_commands_tail = NULL;
+    ResetRenderCommandState(renderer);
+
+    SDL_LockMutex(renderer->render_thread_lock);
+    renderer->render_thread_present = present;
+    renderer->render_thread_readback = readback;
+    renderer->render_thread_busy = SDL_TRUE;
+    SDL_BroadcastCondition(renderer->render_thread_cond);
+    SDL_UnlockMutex(renderer->render_thread_lock);
+
+    return 0;
+}
+
+static void StartRenderThread(SDL_Renderer *renderer)
+{
+    if (!renderer->PrepareRenderThread) {
+        return; /* the backend has to render on the application thread */
+    }
+
+    renderer->render_thread_lock = SDL_CreateMutex();
+    renderer->render_thread_cond = SDL_CreateCondition();
+    if (renderer->render_thread_lock && renderer->render_thread_cond) {
+        renderer->render_thread_presented = SDL_TRUE;
+        renderer->render_thread = SDL_CreateThread(SDL_RenderThread, "SDLRender", renderer);
+    }
+
+    if (!renderer->render_thread) {
+        SDL_DestroyCondition(renderer->render_thread_cond);
+        renderer->render_thread_cond = NULL;
+        SDL_DestroyMutex(renderer->render_thread_lock);
+        renderer->render_thread_lock = NULL;
+    }
+}
+
+static void StopRenderThread(SDL_Renderer *renderer)
+{
+    if (!renderer->render_thread) {
+        return;
+    }
+
+    WaitRenderThread(renderer);
+
+    SDL_LockMutex(renderer->render_thread_lock);
+    renderer->render_thread_quit = SDL_TRUE;
+    SDL_BroadcastCondition(renderer->render_thread_cond);
+    SDL_UnlockMutex(renderer->render_thread_lock);
+
+    SDL_WaitThread(renderer->render_thread, NULL);
+    renderer->render_thread = NULL;
+
+    SDL_DestroyCondition(renderer->render_thread_cond);
+    renderer->render_thread_cond = NULL;
+    SDL_DestroyMutex(renderer->render_thread_lock);
+    renderer->render_thread_lock = NULL;
+
+    SDL_free(renderer->render_thread_vertex_data);
+    renderer->render_thread_vertex_data = NULL;
+    renderer->render_thread_vertex_data_used = 0;
+    renderer->render_thread_vertex_data_allocation = 0;
+}
+
 static int FlushRenderCommands(SDL_Renderer *renderer)
 {
     int retval;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
 
+    WaitRenderThread(renderer);
+
     if (!renderer->render_commands) { /* nothing to do! */
         SDL_assert(renderer->vertex_data_used == 0);
         return 0;
@@ -321,6 +581,8 @@ static int FlushRenderCommands(SDL_Renderer *renderer)
 
     DebugLogRenderCommands(renderer->render_commands);
 
+    renderer->stats.flushes++;
+
     retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
 
     /* Move the whole render command queue to the unused pool so we can reuse them next time. */
@@ -330,18 +592,17 @@ static int FlushRenderCommands(SDL_Renderer *renderer)
         renderer->render_commands_tail = NULL;
         renderer->render_commands = NULL;
     }
-    renderer->vertex_data_used = 0;
-    renderer->render_command_generation++;
-    renderer->color_queued = SDL_FALSE;
-    renderer->color_scale_queued = SDL_FALSE;
-    renderer->viewport_queued = SDL_FALSE;
-    renderer->cliprect_queued = SDL_FALSE;
+    ResetRenderCommandState(renderer);
     return retval;
 }
 
 static int FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
 {
     SDL_Renderer *renderer = texture->renderer;
+
+    /* the render thread may still be reading from this texture */
+    WaitRenderThread(renderer);
+
     if (texture->last_command_generation == renderer->render_command_generation) {
         /* the current command queue depends on this texture, flush the queue now before it changes */
         return FlushRenderCommands(renderer);
@@ -349,6 +610,29 @@ static int FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
     return 0;
 }
 
+/* Start copying the pixels of a readback without waiting for the GPU, returns -1 if the backend can't */
+static int StartPendingReadback(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    if (!renderer->StartReadPixels) {
+        return -1;
+    }
+
+    FlushRenderCommands(renderer); /* the copy is queued after everything drawn so far */
+
+    readback->pending = renderer->StartReadPixels(renderer, &readback->rect);
+    if (!readback->pending) {
+        return -1;
+    }
+
+    if (renderer->pending_readbacks_tail) {
+        renderer->pending_readbacks_tail->next = readback;
+    } else {
+        renderer->pending_readbacks = readback;
+    }
+    renderer->pending_readbacks_tail = readback;
+    return 0;
+}
+
 int SDL_FlushRenderer(SDL_Renderer *renderer)
 {
     if (FlushRenderCommands(renderer) == -1) {
@@ -388,6 +672,7 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes,
     }
 
     renderer->vertex_data_used += aligner + numbytes;
+    renderer->stats.vertex_bytes += (Sint64)(aligner + numbytes);
 
     return ((Uint8 *)renderer->vertex_data) + aligned;
 }
@@ -415,6 +700,7 @@ static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
         renderer->render_commands = retval;
     }
     renderer->render_commands_tail = retval;
+    renderer->stats.commands++;
 
     return retval;
 }
@@ -455,6 +741,7 @@ static int QueueCmdSetViewport(SDL_Renderer *renderer)
             } else {
                 SDL_copyp(&renderer->last_queued_viewport, &viewport);
                 renderer->viewport_queued = SDL_TRUE;
+                renderer->stats.state_changes++;
             }
         } else {
             retval = -1;
@@ -489,6 +776,7 @@ static int QueueCmdSetClipRect(SDL_Renderer *renderer)
             SDL_copyp(&renderer->last_queued_cliprect, &clip_rect);
             renderer->last_queued_cliprect_enabled = renderer->view->clipping_enabled;
             renderer->cliprect_queued = SDL_TRUE;
+            renderer->stats.state_changes++;
         } else {
             retval = -1;
         }
@@ -519,6 +807,7 @@ static int QueueCmdSetDrawColor(SDL_Renderer *renderer, SDL_FColor *color)
             } else {
                 renderer->last_queued_color = *color;
                 renderer->color_queued = SDL_TRUE;
+                renderer->stats.state_changes++;
             }
         }
     }
@@ -583,6 +872,17 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
     return cmd;
 }
 
+/* Only draws the backend accepted show up in the frame statistics */
+static void CountQueuedDraw(SDL_Renderer *renderer, SDL_Texture *texture, int vertices)
+{
+    renderer->stats.draw_calls++;
+    renderer->stats.vertices += vertices;
+    if (texture && texture != renderer->stats_last_texture) {
+        renderer->stats.texture_changes++;
+        renderer->stats_last_texture = texture;
+    }
+}
+
 static int QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, const int count)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_POINTS, NULL);
@@ -591,6 +891,8 @@ static int QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points,
         retval = renderer->QueueDrawPoints(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            CountQueuedDraw(renderer, cmd->data.draw.texture, count);
         }
     }
     return retval;
@@ -604,6 +906,8 @@ static int QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, c
         retval = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            CountQueuedDraw(renderer, cmd->data.draw.texture, count);
         }
     }
     return retval;
@@ -668,6 +972,8 @@ static int QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, con
 
                 if (retval < 0) {
                     cmd->command = SDL_RENDERCMD_NO_OP;
+                } else {
+                    CountQueuedDraw(renderer, cmd->data.draw.texture, num_indices);
                 }
             }
             SDL_small_free(xy, isstack1);
@@ -677,6 +983,8 @@ static int QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, con
             retval = renderer->QueueFillRects(renderer, cmd, rects, count);
             if (retval < 0) {
                 cmd->command = SDL_RENDERCMD_NO_OP;
+            } else {
+                CountQueuedDraw(renderer, cmd->data.draw.texture, 4 * count);
             }
         }
     }
@@ -691,6 +999,8 @@ static int QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_
         retval = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            CountQueuedDraw(renderer, cmd->data.draw.texture, 4);
         }
     }
     return retval;
@@ -706,6 +1016,8 @@ static int QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
         retval = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip, scale_x, scale_y);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            CountQueuedDraw(renderer, cmd->data.draw.texture, 4);
         }
     }
     return retval;
@@ -732,6 +1044,8 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                                          scale_x, scale_y);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            CountQueuedDraw(renderer, cmd->data.draw.texture, (indices ? num_indices : num_vertices));
         }
     }
     return retval;
@@ -791,6 +1105,23 @@ static void UpdateHDRProperties(SDL_Renderer *renderer)
     renderer->color_scale *= renderer->SDR_white_point;
 }
 
+static void UpdateFrameStatistics(SDL_Renderer *renderer)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    const SDL_RenderStats *stats = &renderer->stats;
+
+    if (props) {
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER, stats->commands);
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_DRAW_CALLS_NUMBER, stats->draw_calls);
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_VERTICES_NUMBER, stats->vertices);
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER, stats->vertex_bytes);
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_STATE_CHANGES_NUMBER, stats->state_changes);
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_TEXTURE_CHANGES_NUMBER, stats->texture_changes);
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_FLUSHES_NUMBER, stats->flushes);
+    }
+    SDL_zero(renderer->stats);
+}
+
 static int UpdateLogicalPresentation(SDL_Renderer *renderer);
 
 
@@ -826,6 +1157,7 @@ static int SDLCALL SDL_RendererEventWatch(void *userdata, SDL_Event *event)
         SDL_Window *window = SDL_GetWindowFromID(event->window.windowID);
         if (window == renderer->window) {
             if (renderer->WindowEvent) {
+                WaitRenderThread(renderer);
                 renderer->WindowEvent(renderer, &event->window);
             }
 
@@ -1125,6 +1457,11 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
     }
     SDL_CalculateSimulatedVSyncInterval(renderer, window);
 
+    if (SDL_GetBooleanProperty(props, SDL_PROP_RENDERER_CREATE_RENDER_THREAD_BOOLEAN, SDL_FALSE)) {
+        StartRenderThread(renderer);
+    }
+    SDL_SetBooleanProperty(new_props, SDL_PROP_RENDERER_RENDER_THREAD_BOOLEAN, renderer->render_thread != NULL);
+
     SDL_LogInfo(SDL_LOG_CATEGORY_RENDER,
                 "Created renderer: %s", renderer->name);
 
@@ -1324,6 +1661,202 @@ static Uint32 GetClosestSupportedFormat(SDL_Renderer *renderer, SDL_PixelFormat
     return renderer->texture_formats[0];
 }
 
+struct SDL_TextureAtlasPage
+{
+    SDL_Texture *texture;
+    SDL_Skyline skyline;
+    int refcount;
+    SDL_TextureAtlasPage *next;
+};
+
+static SDL_bool CanPackTexture(SDL_Renderer *renderer, SDL_PropertiesID props, SDL_PixelFormat format, SDL_TextureAccess access, int w, int h)
+{
+    if (!SDL_GetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN, SDL_FALSE)) {
+        return SDL_FALSE;
+    }
+    if (access != SDL_TEXTUREACCESS_STATIC ||
+        w > SDL_ATLAS_MAX_TEXTURE_SIZE || h > SDL_ATLAS_MAX_TEXTURE_SIZE ||
+        SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format) ||
+        !IsSupportedFormat(renderer, format)) {
+        return SDL_FALSE;
+    }
+
+    /* The shared texture has the default colorspace and HDR settings for the format */
+    if (SDL_HasProperty(props, SDL_PROP_TEXTURE_CREATE_COLORSPACE_NUMBER) &&
+        SDL_GetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_COLORSPACE_NUMBER, 0) != SDL_GetDefaultColorspaceForFormat(format)) {
+        return SDL_FALSE;
+    }
+    if (SDL_HasProperty(props, SDL_PROP_TEXTURE_CREATE_SDR_WHITE_POINT_FLOAT) ||
+        SDL_HasProperty(props, SDL_PROP_TEXTURE_CREATE_HDR_HEADROOM_FLOAT)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_TextureAtlasPage *CreateAtlasPage(SDL_Renderer *renderer, SDL_PixelFormat format)
+{
+    SDL_TextureAtlasPage *page;
+    int size = SDL_ATLAS_PAGE_SIZE;
+    int max_texture_size = (int)SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0);
+    int pitch;
+    void *pixels;
+
+    if (max_texture_size && max_texture_size < size) {
+        size = max_texture_size;
+    }
+
+    page = (SDL_TextureAtlasPage *)SDL_calloc(1, sizeof(*page));
+    if (!page) {
+        return NULL;
+    }
+
+    page->texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC, size, size);
+    if (!page->texture) {
+        SDL_free(page);
+        return NULL;
+    }
+
+    /* Clear the texture so the space that isn't used by packed textures is transparent */
+    pitch = size * SDL_BYTESPERPIXEL(format);
+    pixels = SDL_calloc(size, pitch);
+    if (!pixels ||
+        SDL_UpdateTexture(page->texture, NULL, pixels, pitch) < 0 ||
+        SDL_InitSkyline(&page->skyline, size, size) < 0) {
+        SDL_free(pixels);
+        SDL_DestroyTexture(page->texture);
+        SDL_free(page);
+        return NULL;
+    }
+    SDL_free(pixels);
+
+    page->next = renderer->atlas_pages;
+    renderer->atlas_pages = page;
+    return page;
+}
+
+static void ReleaseAtlasPage(SDL_Renderer *renderer, SDL_TextureAtlasPage *page, SDL_bool is_destroying)
+{
+    SDL_TextureAtlasPage *prev = NULL;
+    SDL_TextureAtlasPage *curr;
+
+    /* When the renderer is destroyed the shared textures go away with all the others */
+    if (--page->refcount > 0 || is_destroying) {
+        return;
+    }
+
+    for (curr = renderer->atlas_pages; curr; prev = curr, curr = curr->next) {
+        if (curr == page) {
+            if (prev) {
+                prev->next = page->next;
+            } else {
+                renderer->atlas_pages = page->next;
+            }
+            break;
+        }
+    }
+    SDL_DestroyTexture(page->texture);
+    SDL_QuitSkyline(&page->skyline);
+    SDL_free(page);
+}
+
+static SDL_TextureAtlasPage *AllocateAtlasRect(SDL_Renderer *renderer, SDL_PixelFormat format, int w, int h, SDL_Rect *rect)
+{
+    SDL_TextureAtlasPage *page;
+    SDL_Point position;
+
+    /* Leave a pixel of padding on every side, filled with the edge pixels when the texture is
+       updated, so linear filtering at the edges doesn't pick up neighbors or empty space */
+    for (page = renderer->atlas_pages; page; page = page->next) {
+        if (page->texture->format == format &&
+            SDL_AddSkylineRect(&page->skyline, w + 2, h + 2, &position)) {
+            break;
+        }
+    }
+    if (!page) {
+        page = CreateAtlasPage(renderer, format);
+        if (!page) {
+            return NULL;
+        }
+        if (!SDL_AddSkylineRect(&page->skyline, w + 2, h + 2, &position)) {
+            ++page->refcount;
+            ReleaseAtlasPage(renderer, page, SDL_FALSE);
+            SDL_SetError("Texture doesn't fit in atlas");
+            return NULL;
+        }
+    }
+
+    rect->x = position.x + 1;
+    rect->y = position.y + 1;
+    rect->w = w;
+    rect->h = h;
+    ++page->refcount;
+    return page;
+}
+
+/* Update the area of a packed texture, along with the padding next to any edge that was updated */
+static int UpdateAtlasTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    SDL_Texture *atlas = texture->atlas->texture;
+    const int bpp = SDL_BYTESPERPIXEL(texture->format);
+    int dx, dy;
+
+    for (dy = -1; dy <= 1; ++dy) {
+        if ((dy < 0 && rect->y > 0) || (dy > 0 && rect->y + rect->h < texture->h)) {
+            continue;
+        }
+        for (dx = -1; dx <= 1; ++dx) {
+            SDL_Rect dst;
+            const Uint8 *src = (const Uint8 *)pixels;
+
+            if ((dx < 0 && rect->x > 0) || (dx > 0 && rect->x + rect->w < texture->w)) {
+                continue;
+            }
+
+            if (dx == 0) {
+                dst.x = rect->x;
+                dst.w = rect->w;
+            } else {
+                dst.x = (dx < 0) ? -1 : texture->w;
+                dst.w = 1;
+                if (dx > 0) {
+                    src += (rect->w - 1) * bpp;
+                }
+            }
+            if (dy == 0) {
+                dst.y = rect->y;
+                dst.h = rect->h;
+            } else {
+                dst.y = (dy < 0) ? -1 : texture->h;
+                dst.h = 1;
+                if (dy > 0) {
+                    src += (rect->h - 1) * pitch;
+                }
+            }
+            dst.x += texture->atlas_rect.x;
+            dst.y += texture->atlas_rect.y;
+
+            if (SDL_UpdateTexture(atlas, &dst, src, pitch) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Packed textures are drawn from their shared texture, using their own modulation and blend mode */
+static SDL_Texture *GetAtlasDrawTexture(SDL_Texture *texture, SDL_FRect *srcrect)
+{
+    SDL_Texture *atlas = texture->atlas->texture;
+
+    if (srcrect) {
+        srcrect->x += (float)texture->atlas_rect.x;
+        srcrect->y += (float)texture->atlas_rect.y;
+    }
+    atlas->color = texture->color;
+    atlas->blendMode = texture->blendMode;
+    return atlas;
+}
+
 SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props)
 {
     SDL_Texture *texture;
@@ -1399,7 +1932,13 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     /* FOURCC format cannot be used directly by renderer back-ends for target texture */
     texture_is_fourcc_and_target = (access == SDL_TEXTUREACCESS_TARGET && SDL_ISPIXELFORMAT_FOURCC(format));
 
-    if (!texture_is_fourcc_and_target && IsSupportedFormat(renderer, format)) {
+    if (CanPackTexture(renderer, props, format, access, w, h)) {
+        texture->atlas = AllocateAtlasRect(renderer, format, w, h, &texture->atlas_rect);
+    }
+
+    if (texture->atlas) {
+        texture->scaleMode = texture->atlas->texture->scaleMode;
+    } else if (!texture_is_fourcc_and_target && IsSupportedFormat(renderer, format)) {
         if (renderer->CreateTexture(renderer, texture, props) < 0) {
             SDL_DestroyTexture(texture);
             return NULL;
@@ -1479,6 +2018,9 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     if (texture->HDR_headroom > 0.0f) {
         SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_HDR_HEADROOM_FLOAT, texture->HDR_headroom);
     }
+    if (texture->atlas) {
+        SDL_SetBooleanProperty(props, SDL_PROP_TEXTURE_ATLAS_BOOLEAN, SDL_TRUE);
+    }
     return texture;
 }
 
@@ -1641,7 +2183,7 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
         if (SDL_MUSTLOCK(surface)) {
             SDL_LockSurface(surface);
             SDL_UpdateTexture(texture, NULL, surface->pixels, surface->pitch);
-            SDL_UnlockSurface(surface);
+            SDL_UnlockSurfaceReadOnly(surface);
         } else {
             SDL_UpdateTexture(texture, NULL, surface->pixels, surface->pitch);
         }
@@ -1889,6 +2431,15 @@ int SDL_SetTextureScaleMode(SDL_Texture *texture, SDL_ScaleMode scaleMode)
     CHECK_TEXTURE_MAGIC(texture, -1);
 
     renderer = texture->renderer;
+    WaitRenderThread(renderer);
+
+    if (texture->atlas) {
+        if (scaleMode != texture->scaleMode) {
+            return SDL_SetError("Packed textures can't change their scale mode");
+        }
+        return 0;
+    }
+
     texture->scaleMode = scaleMode;
     if (texture->native) {
         return SDL_SetTextureScaleMode(texture->native, scaleMode);
@@ -2024,6 +2575,8 @@ int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pi
 
     if (real_rect.w == 0 || real_rect.h == 0) {
         return 0; /* nothing to do. */
+    } else if (texture->atlas) {
+        return UpdateAtlasTexture(texture, &real_rect, pixels, pitch);
 #if SDL_HAVE_YUV
     } else if (texture->yuv) {
         return SDL_UpdateTextureYUV(texture, &real_rect, pixels, pitch);
@@ -2419,6 +2972,7 @@ void SDL_UnlockTexture(SDL_Texture *texture)
         SDL_UnlockTextureNative(texture);
     } else {
         SDL_Renderer *renderer = texture->renderer;
+        WaitRenderThread(renderer);
         renderer->UnlockTexture(renderer, texture);
     }
 
@@ -2448,24 +3002,40 @@ static int SDL_SetRenderTargetInternal(SDL_Renderer *renderer, SDL_Texture *text
         return 0;
     }
 
-    FlushRenderCommands(renderer); /* time to send everything to the GPU! */
+    if (renderer->render_thread && !renderer->render_commands) {
+        /* Nothing was drawn to the old target since the last frame was submitted,
+           so don't wait for the render thread, it switches the backend once it's done. */
+        SDL_LockMutex(renderer->target_mutex);
 
-    SDL_LockMutex(renderer->target_mutex);
+        renderer->target = texture;
+        if (texture) {
+            renderer->view = &texture->view;
+        } else {
+            renderer->view = &renderer->main_view;
+        }
+        renderer->render_thread_target_pending = SDL_TRUE;
 
-    renderer->target = texture;
-    if (texture) {
-        renderer->view = &texture->view;
+        SDL_UnlockMutex(renderer->target_mutex);
     } else {
-        renderer->view = &renderer->main_view;
-    }
+        FlushRenderCommands(renderer); /* time to send everything to the GPU! */
+
+        SDL_LockMutex(renderer->target_mutex);
+
+        renderer->target = texture;
+        if (texture) {
+            renderer->view = &texture->view;
+        } else {
+            renderer->view = &renderer->main_view;
+        }
+
+        if (renderer->SetRenderTarget(renderer, texture) < 0) {
+            SDL_UnlockMutex(renderer->target_mutex);
+            return -1;
+        }
 
-    if (renderer->SetRenderTarget(renderer, texture) < 0) {
         SDL_UnlockMutex(renderer->target_mutex);
-        return -1;
     }
 
-    SDL_UnlockMutex(renderer->target_mutex);
-
     if (QueueCmdSetViewport(renderer) < 0) {
         return -1;
     }
@@ -3883,6 +4453,9 @@ int SDL_RenderTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FR
         real_dstrect = *dstrect;
     }
 
+    if (texture->atlas) {
+        texture = GetAtlasDrawTexture(texture, &real_srcrect);
+    }
     if (texture->native) {
         texture = texture->native;
     }
@@ -3942,6 +4515,9 @@ int SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
         GetRenderViewportSize(renderer, &real_dstrect);
     }
 
+    if (texture->atlas) {
+        texture = GetAtlasDrawTexture(texture, &real_srcrect);
+    }
     if (texture->native) {
         texture = texture->native;
     }
@@ -4196,6 +4772,11 @@ int SDL_RenderTextureTiled(SDL_Renderer *renderer, SDL_Texture *texture, const S
         real_dstrect = *dstrect;
     }
 
+    if (texture->atlas) {
+        /* Packed textures can't be repeated with texture coordinates */
+        texture = GetAtlasDrawTexture(texture, &real_srcrect);
+        srcrect = &real_srcrect;
+    }
     if (texture->native) {
         texture = texture->native;
     }
@@ -4729,8 +5310,11 @@ int SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                           const void *indices, int num_indices, int size_indices)
 {
     int i;
+    int retval;
     int count = indices ? num_indices : num_vertices;
     SDL_TextureAddressMode texture_address_mode;
+    float *atlas_uv = NULL;
+    SDL_bool isstack = SDL_FALSE;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -4815,6 +5399,34 @@ int SDL_RenderGeometryRaw(SDL_Renderer *renderer,
         }
     }
 
+    if (texture && texture->atlas) {
+        const float atlas_w = (float)texture->atlas->texture->w;
+        const float atlas_h = (float)texture->atlas->texture->h;
+        const float scale_u = (float)texture->w / atlas_w;
+        const float scale_v = (float)texture->h / atlas_h;
+        const float offset_u = (float)texture->atlas_rect.x / atlas_w;
+        const float offset_v = (float)texture->atlas_rect.y / atlas_h;
+
+        if (texture_address_mode == SDL_TEXTURE_ADDRESS_WRAP) {
+            return SDL_SetError("Packed textures can't be repeated");
+        }
+
+        /* Map the texture coordinates into the shared texture */
+        atlas_uv = SDL_small_alloc(float, num_vertices * 2, &isstack);
+        if (!atlas_uv) {
+            return -1;
+        }
+        for (i = 0; i < num_vertices; ++i) {
+            const float *uv_ = (const float *)((const char *)uv + i * uv_stride);
+            atlas_uv[i * 2 + 0] = offset_u + uv_[0] * scale_u;
+            atlas_uv[i * 2 + 1] = offset_v + uv_[1] * scale_v;
+        }
+        uv = atlas_uv;
+        uv_stride = 2 * sizeof(float);
+
+        texture = GetAtlasDrawTexture(texture, NULL);
+    }
+
     if (texture) {
         texture->last_command_generation = renderer->render_command_generation;
     }
@@ -4822,18 +5434,24 @@ int SDL_RenderGeometryRaw(SDL_Renderer *renderer,
     /* For the software renderer, try to reinterpret triangles as SDL_Rect */
 #if SDL_VIDEO_RENDER_SW
     if (renderer->software && texture_address_mode == SDL_TEXTURE_ADDRESS_CLAMP) {
-        return SDL_SW_RenderGeometryRaw(renderer, texture,
-                                        xy, xy_stride, color, color_stride, uv, uv_stride, num_vertices,
-                                        indices, num_indices, size_indices);
-    }
+        retval = SDL_SW_RenderGeometryRaw(renderer, texture,
+                                          xy, xy_stride, color, color_stride, uv, uv_stride, num_vertices,
+                                          indices, num_indices, size_indices);
+    } else
 #endif
+    {
+        retval = QueueCmdGeometry(renderer, texture,
+                                  xy, xy_stride, color, color_stride, uv, uv_stride,
+                                  num_vertices,
+                                  indices, num_indices, size_indices,
+                                  renderer->view->scale.x,
+                                  renderer->view->scale.y, texture_address_mode);
+    }
 
-    return QueueCmdGeometry(renderer, texture,
-                              xy, xy_stride, color, color_stride, uv, uv_stride,
-                              num_vertices,
-                              indices, num_indices, size_indices,
-                              renderer->view->scale.x,
-                              renderer->view->scale.y, texture_address_mode);
+    if (atlas_uv) {
+        SDL_small_free(atlas_uv, isstack);
+    }
+    return retval;
 }
 
 SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
@@ -4873,6 +5491,99 @@ SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
     return surface;
 }
 
+SDL_RenderReadback *SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_RenderReadbackCallback callback, void *userdata)
+{
+    SDL_RenderReadback *readback;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!renderer->RenderReadPixels) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    readback = (SDL_RenderReadback *)SDL_calloc(1, sizeof(*readback));
+    if (!readback) {
+        return NULL;
+    }
+
+    readback->rect = renderer->view->pixel_viewport;
+    if (rect) {
+        if (!SDL_GetRectIntersection(rect, &readback->rect, &readback->rect)) {
+            SDL_free(readback);
+            SDL_InvalidParamError("rect");
+            return NULL;
+        }
+    }
+    if (renderer->target) {
+        readback->SDR_white_point = renderer->target->SDR_white_point;
+        readback->HDR_headroom = renderer->target->HDR_headroom;
+    } else {
+        readback->SDR_white_point = renderer->SDR_white_point;
+        readback->HDR_headroom = renderer->HDR_headroom;
+    }
+    readback->callback = callback;
+    readback->userdata = userdata;
+    readback->renderer = renderer;
+    /* One reference for the application and one until the renderer is done with it */
+    SDL_AtomicSet(&readback->refcount, 2);
+
+    /* The render thread reads the pixels after drawing the frame, otherwise the backend copies
+       them out once the GPU gets there. If neither is possible they are read right away. */
+    if (renderer->render_thread) {
+        if (SubmitRenderThread(renderer, SDL_FALSE, readback) == 0) {
+            return readback;
+        }
+    } else if (StartPendingReadback(renderer, readback) == 0) {
+        return readback;
+    }
+    FlushRenderCommands(renderer); /* we need to render before we read the results. */
+    CompleteRenderReadback(renderer, readback);
+    return readback;
+}
+
+SDL_bool SDL_IsRenderReadbackComplete(SDL_RenderReadback *readback)
+{
+    if (!readback) {
+        SDL_InvalidParamError("readback");
+        return SDL_FALSE;
+    }
+
+    /* See whether the backend has finished copying out the pixels */
+    if (!SDL_AtomicGet(&readback->complete) && readback->pending) {
+        UpdatePendingReadbacks(readback->renderer, NULL);
+    }
+    return SDL_AtomicGet(&readback->complete) ? SDL_TRUE : SDL_FALSE;
+}
+
+SDL_Surface *SDL_WaitRenderReadback(SDL_RenderReadback *readback)
+{
+    SDL_Surface *surface;
+
+    if (!readback) {
+        SDL_InvalidParamError("readback");
+        return NULL;
+    }
+
+    /* An incomplete readback is still being copied by the backend or queued on the render thread of a live renderer */
+    if (!SDL_AtomicGet(&readback->complete)) {
+        if (readback->pending) {
+            UpdatePendingReadbacks(readback->renderer, readback);
+        } else {
+            WaitRenderThread(readback->renderer);
+        }
+    }
+    SDL_assert(SDL_AtomicGet(&readback->complete));
+
+    surface = readback->surface;
+    readback->surface = NULL;
+    if (!surface) {
+        SDL_SetError("%s", readback->error ? readback->error : "Couldn't read pixels");
+    }
+    ReleaseRenderReadback(readback);
+    return surface;
+}
+
 static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
 {
     SDL_Surface *shape = (SDL_Surface *)SDL_GetPointerProperty(SDL_GetWindowProperties(renderer->window), SDL_PROP_WINDOW_SHAPE_POINTER, NULL);
@@ -4928,6 +5639,7 @@ static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
 
 int SDL_RenderPresent(SDL_Renderer *renderer)
 {
+    SDL_bool present = SDL_TRUE;
     SDL_bool presented = SDL_TRUE;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
@@ -4941,18 +5653,33 @@ int SDL_RenderPresent(SDL_Renderer *renderer)
         SDL_RenderApplyWindowShape(renderer);
     }
 
-    FlushRenderCommands(renderer); /* time to send everything to the GPU! */
-
 #if DONT_DRAW_WHILE_HIDDEN
     /* Don't present while we're hidden */
     if (renderer->hidden) {
-        presented = SDL_FALSE;
-    } else
+        present = SDL_FALSE;
+    }
 #endif
-    if (renderer->RenderPresent(renderer) < 0) {
-        presented = SDL_FALSE;
+
+    if (renderer->render_thread && SubmitRenderThread(renderer, present, NULL) == 0) {
+        /* The render thread draws and presents this frame, report how the previous one went */
+        SDL_LockMutex(renderer->render_thread_lock);
+        presented = renderer->render_thread_presented;
+        SDL_UnlockMutex(renderer->render_thread_lock);
+    } else {
+        FlushRenderCommands(renderer); /* time to send everything to the GPU! */
+
+        if (!present || renderer->RenderPresent(renderer) < 0) {
+            presented = SDL_FALSE;
+        }
+    }
+
+    /* Hand out the readbacks the GPU has caught up with */
+    if (renderer->pending_readbacks) {
+        UpdatePendingReadbacks(renderer, NULL);
     }
 
+    UpdateFrameStatistics(renderer);
+
     if (renderer->logical_target) {
         SDL_SetRenderTargetInternal(renderer, renderer->logical_target);
     }
@@ -4992,6 +5719,9 @@ static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroyi
     if (texture == renderer->logical_target) {
         renderer->logical_target = NULL;
     }
+    if (texture == renderer->stats_last_texture) {
+        renderer->stats_last_texture = NULL;
+    }
 
     SDL_SetObjectValid(texture, SDL_OBJECT_TYPE_TEXTURE, SDL_FALSE);
 
@@ -5014,7 +5744,12 @@ static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroyi
 #endif
     SDL_free(texture->pixels);
 
-    renderer->DestroyTexture(renderer, texture);
+    if (texture->atlas) {
+        ReleaseAtlasPage(renderer, texture->atlas, is_destroying);
+    } else {
+        WaitRenderThread(renderer);
+        renderer->DestroyTexture(renderer, texture);
+    }
 
     SDL_DestroySurface(texture->locked_surface);
     texture->locked_surface = NULL;
@@ -5059,6 +5794,13 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
+    StopRenderThread(renderer);
+
+    /* Readbacks can't outlive the backend, finish them while it's still around */
+    if (renderer->pending_readbacks) {
+        UpdatePendingReadbacks(renderer, renderer->pending_readbacks_tail);
+    }
+
     if (renderer->window) {
         SDL_PropertiesID props = SDL_GetWindowProperties(renderer->window);
         if (SDL_GetPointerProperty(props, SDL_PROP_WINDOW_RENDERER_POINTER, NULL) == renderer) {
@@ -5075,6 +5817,14 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         SDL_assert(tex != renderer->textures); /* satisfy static analysis. */
     }
 
+    /* The shared textures of packed textures were destroyed above */
+    while (renderer->atlas_pages) {
+        SDL_TextureAtlasPage *page = renderer->atlas_pages;
+        renderer->atlas_pages = page->next;
+        SDL_QuitSkyline(&page->skyline);
+        SDL_free(page);
+    }
+
     /* Clean up renderer-specific resources */
     if (renderer->DestroyRenderer) {
         renderer->DestroyRenderer(renderer);
@@ -5263,6 +6013,8 @@ int SDL_SetRenderVSync(SDL_Renderer *renderer, int vsync)
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    WaitRenderThread(renderer);
+
     renderer->wanted_vsync = vsync ? SDL_TRUE : SDL_FALSE;
 
     /* for the software renderer, forward the call to the WindowTexture renderer */
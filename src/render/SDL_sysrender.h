@@ -51,6 +51,7 @@ typedef struct SDL_DRect
 /* The SDL 2D rendering system */
 
 typedef struct SDL_RenderDriver SDL_RenderDriver;
+typedef struct SDL_TextureAtlasPage SDL_TextureAtlasPage;
 
 /* Rendering view state */
 typedef struct SDL_RenderViewState
@@ -91,6 +92,10 @@ struct SDL_Texture
     SDL_Rect locked_rect;
     SDL_Surface *locked_surface; /**< Locked region exposed as a SDL surface */
 
+    /* Support for small textures packed into a shared texture */
+    SDL_TextureAtlasPage *atlas;
+    SDL_Rect atlas_rect;
+
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
 
     SDL_PropertiesID props;
@@ -164,6 +169,18 @@ typedef enum
     SDL_RENDERLINEMETHOD_GEOMETRY,
 } SDL_RenderLineMethod;
 
+/* Per-frame counters, published as renderer properties by SDL_RenderPresent() */
+typedef struct SDL_RenderStats
+{
+    Sint64 commands;
+    Sint64 draw_calls;
+    Sint64 vertices;
+    Sint64 vertex_bytes;
+    Sint64 state_changes;
+    Sint64 texture_changes;
+    Sint64 flushes;
+} SDL_RenderStats;
+
 /* Define the SDL renderer structure */
 struct SDL_Renderer
 {
@@ -211,6 +228,13 @@ struct SDL_Renderer
     void (*SetTextureScaleMode)(SDL_Renderer *renderer, SDL_Texture *texture, SDL_ScaleMode scaleMode);
     int (*SetRenderTarget)(SDL_Renderer *renderer, SDL_Texture *texture);
     SDL_Surface *(*RenderReadPixels)(SDL_Renderer *renderer, const SDL_Rect *rect);
+
+    /* Optional, StartReadPixels() queues a copy of the pixels drawn so far into memory the CPU can read
+       and returns a handle without waiting for it. IsReadPixelsDone() checks whether the copy has
+       finished and FinishReadPixels() waits for it if needed, frees the handle and returns the pixels. */
+    void *(*StartReadPixels)(SDL_Renderer *renderer, const SDL_Rect *rect);
+    SDL_bool (*IsReadPixelsDone)(SDL_Renderer *renderer, void *pending);
+    SDL_Surface *(*FinishReadPixels)(SDL_Renderer *renderer, void *pending);
     int (*RenderPresent)(SDL_Renderer *renderer);
     void (*DestroyTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
 
@@ -218,6 +242,10 @@ struct SDL_Renderer
 
     int (*SetVSync)(SDL_Renderer *renderer, int vsync);
 
+    /* Called on the application thread before a frame is handed to the render thread.
+       Backends that can't run RunCommandQueue() and RenderPresent() on another thread leave this NULL. */
+    int (*PrepareRenderThread)(SDL_Renderer *renderer);
+
     void *(*GetMetalLayer)(SDL_Renderer *renderer);
     void *(*GetMetalCommandEncoder)(SDL_Renderer *renderer);
 
@@ -260,6 +288,7 @@ struct SDL_Renderer
 
     /* The list of textures */
     SDL_Texture *textures;
+    SDL_TextureAtlasPage *atlas_pages;
     SDL_Texture *target;
     SDL_Mutex *target_mutex;
 
@@ -290,6 +319,30 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* Deferred rendering, the render thread owns the frame it is working on */
+    SDL_Thread *render_thread;
+    SDL_Mutex *render_thread_lock;
+    SDL_Condition *render_thread_cond;
+    SDL_bool render_thread_busy;
+    SDL_bool render_thread_quit;
+    SDL_bool render_thread_present;
+    SDL_bool render_thread_presented;
+    SDL_bool render_thread_target_pending;
+    SDL_RenderReadback *render_thread_readback;
+    SDL_RenderCommand *render_thread_commands;
+    SDL_RenderCommand *render_thread_commands_tail;
+    void *render_thread_vertex_data;
+    size_t render_thread_vertex_data_used;
+    size_t render_thread_vertex_data_allocation;
+
+    /* Readbacks being copied out by the backend, in the order they were started */
+    SDL_RenderReadback *pending_readbacks;
+    SDL_RenderReadback *pending_readbacks_tail;
+
+    /* Statistics for the frame being built */
+    SDL_RenderStats stats;
+    SDL_Texture *stats_last_texture;
+
     /* Shaped window support */
     SDL_bool transparent_window;
     SDL_Surface *shape_surface;
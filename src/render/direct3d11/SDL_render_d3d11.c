@@ -2728,6 +2728,155 @@ done:
     return output;
 }
 
+/* A copy of the render target into a staging texture, waiting for the GPU to get to it */
+typedef struct
+{
+    ID3D11Texture2D *stagingTexture;
+    SDL_PixelFormat format;
+    SDL_Colorspace colorspace;
+    int w, h;
+    BOOL mapped;
+    D3D11_MAPPED_SUBRESOURCE textureMemory;
+} D3D11_PendingReadback;
+
+static void *D3D11_StartReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->internal;
+    ID3D11RenderTargetView *renderTargetView = NULL;
+    ID3D11Texture2D *backBuffer = NULL;
+    D3D11_PendingReadback *pending = NULL;
+    HRESULT result;
+    D3D11_TEXTURE2D_DESC stagingTextureDesc;
+    D3D11_RECT srcRect = { 0, 0, 0, 0 };
+    D3D11_BOX srcBox;
+
+    renderTargetView = D3D11_GetCurrentRenderTargetView(renderer);
+    if (!renderTargetView) {
+        SDL_SetError("%s, ID3D11DeviceContext::OMGetRenderTargets failed", __FUNCTION__);
+        goto done;
+    }
+
+    ID3D11View_GetResource(renderTargetView, (ID3D11Resource **)&backBuffer);
+    if (!backBuffer) {
+        SDL_SetError("%s, ID3D11View::GetResource failed", __FUNCTION__);
+        goto done;
+    }
+
+    if (D3D11_GetViewportAlignedD3DRect(renderer, rect, &srcRect, FALSE) != 0) {
+        /* D3D11_GetViewportAlignedD3DRect will have set the SDL error */
+        goto done;
+    }
+
+    pending = (D3D11_PendingReadback *)SDL_calloc(1, sizeof(*pending));
+    if (!pending) {
+        goto done;
+    }
+
+    /* Create a staging texture to copy the screen's data to: */
+    ID3D11Texture2D_GetDesc(backBuffer, &stagingTextureDesc);
+    stagingTextureDesc.Width = rect->w;
+    stagingTextureDesc.Height = rect->h;
+    stagingTextureDesc.BindFlags = 0;
+    stagingTextureDesc.MiscFlags = 0;
+    stagingTextureDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    stagingTextureDesc.Usage = D3D11_USAGE_STAGING;
+    result = ID3D11Device_CreateTexture2D(data->d3dDevice,
+                                          &stagingTextureDesc,
+                                          NULL,
+                                          &pending->stagingTexture);
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::CreateTexture2D [create staging texture]"), result);
+        SDL_free(pending);
+        pending = NULL;
+        goto done;
+    }
+    pending->format = D3D11_DXGIFormatToSDLPixelFormat(stagingTextureDesc.Format);
+    pending->colorspace = renderer->target ? renderer->target->colorspace : renderer->output_colorspace;
+    pending->w = rect->w;
+    pending->h = rect->h;
+
+    /* Queue the copy of the desired portion of the back buffer, it runs after everything drawn so far */
+    srcBox.left = srcRect.left;
+    srcBox.right = srcRect.right;
+    srcBox.top = srcRect.top;
+    srcBox.bottom = srcRect.bottom;
+    srcBox.front = 0;
+    srcBox.back = 1;
+    ID3D11DeviceContext_CopySubresourceRegion(data->d3dContext,
+                                              (ID3D11Resource *)pending->stagingTexture,
+                                              0,
+                                              0, 0, 0,
+                                              (ID3D11Resource *)backBuffer,
+                                              0,
+                                              &srcBox);
+    ID3D11DeviceContext_Flush(data->d3dContext);
+
+done:
+    SAFE_RELEASE(backBuffer);
+    return pending;
+}
+
+static SDL_bool D3D11_IsReadPixelsDone(SDL_Renderer *renderer, void *handle)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->internal;
+    D3D11_PendingReadback *pending = (D3D11_PendingReadback *)handle;
+    HRESULT result;
+
+    if (!pending->mapped) {
+        /* The staging texture can only be mapped once the copy has finished, keep it mapped if it has */
+        result = ID3D11DeviceContext_Map(data->d3dContext,
+                                         (ID3D11Resource *)pending->stagingTexture,
+                                         0,
+                                         D3D11_MAP_READ,
+                                         D3D11_MAP_FLAG_DO_NOT_WAIT,
+                                         &pending->textureMemory);
+        if (result == DXGI_ERROR_WAS_STILL_DRAWING) {
+            return SDL_FALSE;
+        }
+        pending->mapped = SUCCEEDED(result);
+    }
+    return SDL_TRUE;
+}
+
+static SDL_Surface *D3D11_FinishReadPixels(SDL_Renderer *renderer, void *handle)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->internal;
+    D3D11_PendingReadback *pending = (D3D11_PendingReadback *)handle;
+    SDL_Surface *output = NULL;
+    HRESULT result;
+
+    if (!pending->mapped) {
+        result = ID3D11DeviceContext_Map(data->d3dContext,
+                                         (ID3D11Resource *)pending->stagingTexture,
+                                         0,
+                                         D3D11_MAP_READ,
+                                         0,
+                                         &pending->textureMemory);
+        if (FAILED(result)) {
+            WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [map staging texture]"), result);
+        } else {
+            pending->mapped = TRUE;
+        }
+    }
+
+    if (pending->mapped) {
+        output = SDL_DuplicatePixels(
+            pending->w, pending->h,
+            pending->format,
+            pending->colorspace,
+            pending->textureMemory.pData,
+            pending->textureMemory.RowPitch);
+
+        ID3D11DeviceContext_Unmap(data->d3dContext,
+                                  (ID3D11Resource *)pending->stagingTexture,
+                                  0);
+    }
+
+    SAFE_RELEASE(pending->stagingTexture);
+    SDL_free(pending);
+    return output;
+}
+
 static int D3D11_RenderPresent(SDL_Renderer *renderer)
 {
     D3D11_RenderData *data = (D3D11_RenderData *)renderer->internal;
@@ -2852,6 +3001,9 @@ static int D3D11_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
     renderer->InvalidateCachedState = D3D11_InvalidateCachedState;
     renderer->RunCommandQueue = D3D11_RunCommandQueue;
     renderer->RenderReadPixels = D3D11_RenderReadPixels;
+    renderer->StartReadPixels = D3D11_StartReadPixels;
+    renderer->IsReadPixelsDone = D3D11_IsReadPixelsDone;
+    renderer->FinishReadPixels = D3D11_FinishReadPixels;
     renderer->RenderPresent = D3D11_RenderPresent;
     renderer->DestroyTexture = D3D11_DestroyTexture;
     renderer->DestroyRenderer = D3D11_DestroyRenderer;
@@ -297,6 +297,11 @@ typedef struct
     ID3D12Fence *fence;
     HANDLE fenceEvent;
 
+    /* Fences of readbacks recorded into the current command list, signaled once it's executed */
+    ID3D12Fence **readbackFences;
+    int readbackFenceCount;
+    int readbackFenceMax;
+
     /* Root signature and pipeline state data */
     ID3D12RootSignature *rootSignatures[NUM_ROOTSIGS];
     int pipelineStateCount;
@@ -467,6 +472,12 @@ static void D3D12_ReleaseAll(SDL_Renderer *renderer)
     if (data) {
         int i;
 
+        /* Readbacks that were never executed are completed without pixels from the lost device */
+        for (i = 0; i < data->readbackFenceCount; ++i) {
+            D3D_CALL(data->readbackFences[i], Signal, 1);
+        }
+        data->readbackFenceCount = 0;
+
 #if !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
         SAFE_RELEASE(data->dxgiFactory);
         SAFE_RELEASE(data->dxgiAdapter);
@@ -622,6 +633,17 @@ static void D3D12_ResetCommandList(D3D12_RenderData *data)
     D3D_CALL(data->commandList, SetDescriptorHeaps, 2, rootDescriptorHeaps);
 }
 
+/* Signal the fences of the readbacks in the command list that was just executed */
+static void D3D12_SignalReadbackFences(D3D12_RenderData *data)
+{
+    int i;
+
+    for (i = 0; i < data->readbackFenceCount; ++i) {
+        D3D_CALL(data->commandQueue, Signal, data->readbackFences[i], 1);
+    }
+    data->readbackFenceCount = 0;
+}
+
 static int D3D12_IssueBatch(D3D12_RenderData *data)
 {
     HRESULT result = S_OK;
@@ -633,6 +655,7 @@ static int D3D12_IssueBatch(D3D12_RenderData *data)
         return result;
     }
     D3D_CALL(data->commandQueue, ExecuteCommandLists, 1, (ID3D12CommandList *const *)&data->commandList);
+    D3D12_SignalReadbackFences(data);
 
     D3D12_WaitForGPU(data);
 
@@ -647,6 +670,7 @@ static void D3D12_DestroyRenderer(SDL_Renderer *renderer)
     if (data) {
         D3D12_WaitForGPU(data);
         D3D12_ReleaseAll(renderer);
+        SDL_free(data->readbackFences);
         SDL_free(data);
     }
 }
@@ -3177,6 +3201,226 @@ done:
     return output;
 }
 
+/* A copy of the render target into a readback buffer, waiting for the GPU to get to it */
+typedef struct
+{
+    ID3D12Resource *readbackBuffer;
+    ID3D12Fence *fence;
+    SDL_PixelFormat format;
+    SDL_Colorspace colorspace;
+    int w, h;
+    UINT pitch;
+} D3D12_PendingReadback;
+
+static void D3D12_FreePendingReadback(D3D12_PendingReadback *pending)
+{
+    SAFE_RELEASE(pending->readbackBuffer);
+    SAFE_RELEASE(pending->fence);
+    SDL_free(pending);
+}
+
+static void *D3D12_StartReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    D3D12_RenderData *data = (D3D12_RenderData *)renderer->internal;
+    ID3D12Resource *backBuffer = NULL;
+    D3D12_PendingReadback *pending;
+    HRESULT result;
+    D3D12_RESOURCE_DESC textureDesc;
+    D3D12_RESOURCE_DESC readbackDesc;
+    D3D12_HEAP_PROPERTIES heapProps;
+    D3D12_RECT srcRect = { 0, 0, 0, 0 };
+    D3D12_BOX srcBox;
+    D3D12_TEXTURE_COPY_LOCATION dstLocation;
+    D3D12_TEXTURE_COPY_LOCATION srcLocation;
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT placedTextureDesc;
+    D3D12_SUBRESOURCE_FOOTPRINT pitchedDesc;
+    int bpp;
+
+    if (D3D12_GetViewportAlignedD3DRect(renderer, rect, &srcRect, FALSE) != 0) {
+        /* D3D12_GetViewportAlignedD3DRect will have set the SDL error */
+        return NULL;
+    }
+
+    /* Make room to track the fence before recording anything */
+    if (data->readbackFenceCount == data->readbackFenceMax) {
+        ID3D12Fence **readbackFences = (ID3D12Fence **)SDL_realloc(data->readbackFences, (data->readbackFenceMax + 1) * sizeof(*readbackFences));
+        if (!readbackFences) {
+            return NULL;
+        }
+        data->readbackFences = readbackFences;
+        ++data->readbackFenceMax;
+    }
+
+    pending = (D3D12_PendingReadback *)SDL_calloc(1, sizeof(*pending));
+    if (!pending) {
+        return NULL;
+    }
+
+    result = D3D_CALL(data->d3dDevice, CreateFence,
+                      0,
+                      D3D12_FENCE_FLAG_NONE,
+                      D3D_GUID(SDL_IID_ID3D12Fence),
+                      (void **)&pending->fence);
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateFence"), result);
+        D3D12_FreePendingReadback(pending);
+        return NULL;
+    }
+
+    if (data->textureRenderTarget) {
+        backBuffer = data->textureRenderTarget->mainTexture;
+    } else {
+        backBuffer = data->renderTargets[data->currentBackBufferIndex];
+    }
+
+    /* Create a staging buffer to copy the screen's data to: */
+    SDL_zero(textureDesc);
+    D3D_CALL_RET_ID3D12Resource_GetDesc(backBuffer, &textureDesc);
+    textureDesc.Width = rect->w;
+    textureDesc.Height = rect->h;
+
+    SDL_zero(readbackDesc);
+    readbackDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    readbackDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    readbackDesc.Height = 1;
+    readbackDesc.DepthOrArraySize = 1;
+    readbackDesc.MipLevels = 1;
+    readbackDesc.Format = DXGI_FORMAT_UNKNOWN;
+    readbackDesc.SampleDesc.Count = 1;
+    readbackDesc.SampleDesc.Quality = 0;
+    readbackDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    readbackDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+    /* Figure out how much we need to allocate for the readback buffer */
+    D3D_CALL(data->d3dDevice, GetCopyableFootprints,
+             &textureDesc,
+             0,
+             1,
+             0,
+             NULL,
+             NULL,
+             NULL,
+             &readbackDesc.Width);
+
+    SDL_zero(heapProps);
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+    heapProps.CreationNodeMask = 1;
+    heapProps.VisibleNodeMask = 1;
+
+    result = D3D_CALL(data->d3dDevice, CreateCommittedResource,
+                      &heapProps,
+                      D3D12_HEAP_FLAG_NONE,
+                      &readbackDesc,
+                      D3D12_RESOURCE_STATE_COPY_DEST,
+                      NULL,
+                      D3D_GUID(SDL_IID_ID3D12Resource),
+                      (void **)&pending->readbackBuffer);
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateTexture2D [create staging texture]"), result);
+        D3D12_FreePendingReadback(pending);
+        return NULL;
+    }
+
+    srcBox.left = srcRect.left;
+    srcBox.right = srcRect.right;
+    srcBox.top = srcRect.top;
+    srcBox.bottom = srcRect.bottom;
+    srcBox.front = 0;
+    srcBox.back = 1;
+
+    SDL_zero(pitchedDesc);
+    pitchedDesc.Format = textureDesc.Format;
+    pitchedDesc.Width = (UINT)textureDesc.Width;
+    pitchedDesc.Height = textureDesc.Height;
+    pitchedDesc.Depth = 1;
+    bpp = SDL_BYTESPERPIXEL(D3D12_DXGIFormatToSDLPixelFormat(pitchedDesc.Format));
+    pitchedDesc.RowPitch = D3D12_Align(pitchedDesc.Width * bpp, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+
+    SDL_zero(placedTextureDesc);
+    placedTextureDesc.Offset = 0;
+    placedTextureDesc.Footprint = pitchedDesc;
+
+    SDL_zero(dstLocation);
+    dstLocation.pResource = pending->readbackBuffer;
+    dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    dstLocation.PlacedFootprint = placedTextureDesc;
+
+    SDL_zero(srcLocation);
+    srcLocation.pResource = backBuffer;
+    srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    srcLocation.SubresourceIndex = 0;
+
+    pending->format = D3D12_DXGIFormatToSDLPixelFormat(textureDesc.Format);
+    pending->colorspace = renderer->target ? renderer->target->colorspace : renderer->output_colorspace;
+    pending->w = rect->w;
+    pending->h = rect->h;
+    pending->pitch = pitchedDesc.RowPitch;
+
+    /* Record the copy, it runs when the command list is executed, at the latest when the frame is presented */
+    D3D12_TransitionResource(data, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    D3D_CALL(data->commandList, CopyTextureRegion,
+             &dstLocation,
+             0, 0, 0,
+             &srcLocation,
+             &srcBox);
+    D3D12_TransitionResource(data, backBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    data->readbackFences[data->readbackFenceCount++] = pending->fence;
+
+    return pending;
+}
+
+static SDL_bool D3D12_IsReadPixelsDone(SDL_Renderer *renderer, void *handle)
+{
+    D3D12_PendingReadback *pending = (D3D12_PendingReadback *)handle;
+
+    return (D3D_CALL(pending->fence, GetCompletedValue) >= 1);
+}
+
+static SDL_Surface *D3D12_FinishReadPixels(SDL_Renderer *renderer, void *handle)
+{
+    D3D12_RenderData *data = (D3D12_RenderData *)renderer->internal;
+    D3D12_PendingReadback *pending = (D3D12_PendingReadback *)handle;
+    SDL_Surface *output = NULL;
+    BYTE *textureMemory;
+    HRESULT result;
+    int i;
+
+    /* Execute the copy if it's still waiting in the current command list */
+    for (i = 0; i < data->readbackFenceCount; ++i) {
+        if (data->readbackFences[i] == pending->fence) {
+            D3D12_IssueBatch(data);
+            break;
+        }
+    }
+
+    if (D3D_CALL(pending->fence, GetCompletedValue) < 1) {
+        D3D_CALL(pending->fence, SetEventOnCompletion, 1, data->fenceEvent);
+        WaitForSingleObjectEx(data->fenceEvent, INFINITE, FALSE);
+    }
+
+    /* Map the staging buffer's data to CPU-accessible memory: */
+    result = D3D_CALL(pending->readbackBuffer, Map,
+                      0,
+                      NULL,
+                      (void **)&textureMemory);
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Resource::Map [map staging texture]"), result);
+    } else {
+        output = SDL_DuplicatePixels(
+            pending->w, pending->h,
+            pending->format,
+            pending->colorspace,
+            textureMemory,
+            pending->pitch);
+
+        D3D_CALL(pending->readbackBuffer, Unmap, 0, NULL);
+    }
+
+    D3D12_FreePendingReadback(pending);
+    return output;
+}
+
 static int D3D12_RenderPresent(SDL_Renderer *renderer)
 {
     D3D12_RenderData *data = (D3D12_RenderData *)renderer->internal;
@@ -3191,6 +3435,7 @@ static int D3D12_RenderPresent(SDL_Renderer *renderer)
     /* Issue the command list */
     result = D3D_CALL(data->commandList, Close);
     D3D_CALL(data->commandQueue, ExecuteCommandLists, 1, (ID3D12CommandList *const *)&data->commandList);
+    D3D12_SignalReadbackFences(data);
 
 #if defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES)
     result = D3D12_XBOX_PresentFrame(data->commandQueue, data->frameToken, data->renderTargets[data->currentBackBufferIndex]);
@@ -3314,6 +3559,9 @@ int D3D12_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Propert
     renderer->InvalidateCachedState = D3D12_InvalidateCachedState;
     renderer->RunCommandQueue = D3D12_RunCommandQueue;
     renderer->RenderReadPixels = D3D12_RenderReadPixels;
+    renderer->StartReadPixels = D3D12_StartReadPixels;
+    renderer->IsReadPixelsDone = D3D12_IsReadPixelsDone;
+    renderer->FinishReadPixels = D3D12_FinishReadPixels;
     renderer->RenderPresent = D3D12_RenderPresent;
     renderer->DestroyTexture = D3D12_DestroyTexture;
     renderer->DestroyRenderer = D3D12_DestroyRenderer;
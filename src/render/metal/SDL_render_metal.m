@@ -171,6 +171,19 @@ typedef struct METAL_ShaderPipelines
 @implementation SDL3METAL_TextureData
 @end
 
+/* A copy of the render target into a shared buffer, waiting for the GPU to get to it */
+@interface SDL3METAL_PendingReadback : NSObject
+@property(nonatomic, retain) id<MTLCommandBuffer> mtlcmdbuffer;
+@property(nonatomic, retain) id<MTLBuffer> mtlbuffer;
+@property(nonatomic, assign) SDL_PixelFormat format;
+@property(nonatomic, assign) int w;
+@property(nonatomic, assign) int h;
+@property(nonatomic, assign) int pitch;
+@end
+
+@implementation SDL3METAL_PendingReadback
+@end
+
 static SDL_bool IsMetalAvailable()
 {
 #if (defined(SDL_PLATFORM_MACOS) && (MAC_OS_X_VERSION_MIN_REQUIRED < 101100))
@@ -1689,13 +1702,126 @@ static int METAL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     }
 }
 
+static SDL_PixelFormat METAL_GetReadPixelsFormat(MTLPixelFormat pixelFormat)
+{
+    switch (pixelFormat) {
+    case MTLPixelFormatBGRA8Unorm:
+    case MTLPixelFormatBGRA8Unorm_sRGB:
+        return SDL_PIXELFORMAT_ARGB8888;
+    case MTLPixelFormatRGBA8Unorm:
+    case MTLPixelFormatRGBA8Unorm_sRGB:
+        return SDL_PIXELFORMAT_ABGR8888;
+    case MTLPixelFormatRGB10A2Unorm:
+        return SDL_PIXELFORMAT_XBGR2101010;
+    case MTLPixelFormatRGBA16Float:
+        return SDL_PIXELFORMAT_RGBA64_FLOAT;
+    default:
+        return SDL_PIXELFORMAT_UNKNOWN;
+    }
+}
+
+static void *METAL_StartReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    @autoreleasepool {
+        SDL3METAL_RenderData *data = (__bridge SDL3METAL_RenderData *)renderer->internal;
+        SDL3METAL_PendingReadback *pending;
+        id<MTLTexture> mtltexture;
+        id<MTLBlitCommandEncoder> blit;
+        SDL_PixelFormat format;
+        int pitch;
+
+        if (!METAL_ActivateRenderCommandEncoder(renderer, MTLLoadActionLoad, NULL, nil)) {
+            SDL_SetError("Failed to activate render command encoder (is your window in the background?");
+            return NULL;
+        }
+
+        mtltexture = data.mtlpassdesc.colorAttachments[0].texture;
+        format = METAL_GetReadPixelsFormat(mtltexture.pixelFormat);
+        if (format == SDL_PIXELFORMAT_UNKNOWN) {
+            SDL_SetError("Unknown framebuffer pixel format");
+            return NULL;
+        }
+        pitch = rect->w * SDL_BYTESPERPIXEL(format);
+
+        pending = [[SDL3METAL_PendingReadback alloc] init];
+        pending.mtlbuffer = [data.mtldevice newBufferWithLength:(NSUInteger)pitch * rect->h options:MTLResourceStorageModeShared];
+        if (pending.mtlbuffer == nil) {
+            SDL_SetError("Failed to allocate buffer for readback");
+            return NULL;
+        }
+        pending.format = format;
+        pending.w = rect->w;
+        pending.h = rect->h;
+        pending.pitch = pitch;
+
+        /* Copy into the buffer after everything drawn so far and commit without waiting,
+           the next draw starts a new command buffer. */
+        [data.mtlcmdencoder endEncoding];
+        blit = [data.mtlcmdbuffer blitCommandEncoder];
+        [blit copyFromTexture:mtltexture
+                         sourceSlice:0
+                         sourceLevel:0
+                        sourceOrigin:MTLOriginMake(rect->x, rect->y, 0)
+                          sourceSize:MTLSizeMake(rect->w, rect->h, 1)
+                            toBuffer:pending.mtlbuffer
+                   destinationOffset:0
+              destinationBytesPerRow:pitch
+            destinationBytesPerImage:(NSUInteger)pitch * rect->h];
+        [blit endEncoding];
+
+        pending.mtlcmdbuffer = data.mtlcmdbuffer;
+        [data.mtlcmdbuffer commit];
+        data.mtlcmdencoder = nil;
+        data.mtlcmdbuffer = nil;
+
+        return (void *)CFBridgingRetain(pending);
+    }
+}
+
+static SDL_bool METAL_IsReadPixelsDone(SDL_Renderer *renderer, void *handle)
+{
+    @autoreleasepool {
+        SDL3METAL_PendingReadback *pending = (__bridge SDL3METAL_PendingReadback *)handle;
+
+        return (pending.mtlcmdbuffer.status >= MTLCommandBufferStatusCompleted);
+    }
+}
+
+static SDL_Surface *METAL_FinishReadPixels(SDL_Renderer *renderer, void *handle)
+{
+    @autoreleasepool {
+        SDL3METAL_PendingReadback *pending = CFBridgingRelease(handle);
+        SDL_Surface *surface;
+
+        [pending.mtlcmdbuffer waitUntilCompleted];
+        if (pending.mtlcmdbuffer.status != MTLCommandBufferStatusCompleted) {
+            SDL_SetError("Failed to read pixels from the GPU");
+            return NULL;
+        }
+
+        surface = SDL_CreateSurface(pending.w, pending.h, pending.format);
+        if (surface) {
+            const Uint8 *src = (const Uint8 *)pending.mtlbuffer.contents;
+            Uint8 *dst = (Uint8 *)surface->pixels;
+            int row;
+
+            for (row = 0; row < pending.h; ++row) {
+                SDL_memcpy(dst, src, pending.pitch);
+                src += pending.pitch;
+                dst += surface->pitch;
+            }
+        }
+        return surface;
+    }
+}
+
 static SDL_Surface *METAL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
 {
     @autoreleasepool {
         SDL3METAL_RenderData *data = (__bridge SDL3METAL_RenderData *)renderer->internal;
         id<MTLTexture> mtltexture;
         MTLRegion mtlregion;
-        Uint32 format;
+        SDL_PixelFormat format;
         SDL_Surface *surface;
 
         if (!METAL_ActivateRenderCommandEncoder(renderer, MTLLoadActionLoad, NULL, nil)) {
@@ -1727,22 +1853,8 @@ static SDL_Surface *METAL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rec
 
         mtlregion = MTLRegionMake2D(rect->x, rect->y, rect->w, rect->h);
 
-        switch (mtltexture.pixelFormat) {
-        case MTLPixelFormatBGRA8Unorm:
-        case MTLPixelFormatBGRA8Unorm_sRGB:
-            format = SDL_PIXELFORMAT_ARGB8888;
-            break;
-        case MTLPixelFormatRGBA8Unorm:
-        case MTLPixelFormatRGBA8Unorm_sRGB:
-            format = SDL_PIXELFORMAT_ABGR8888;
-            break;
-        case MTLPixelFormatRGB10A2Unorm:
-            format = SDL_PIXELFORMAT_XBGR2101010;
-            break;
-        case MTLPixelFormatRGBA16Float:
-            format = SDL_PIXELFORMAT_RGBA64_FLOAT;
-            break;
-        default:
+        format = METAL_GetReadPixelsFormat(mtltexture.pixelFormat);
+        if (format == SDL_PIXELFORMAT_UNKNOWN) {
             SDL_SetError("Unknown framebuffer pixel format");
             return NULL;
         }
@@ -2169,6 +2281,9 @@ static int METAL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
         renderer->InvalidateCachedState = METAL_InvalidateCachedState;
         renderer->RunCommandQueue = METAL_RunCommandQueue;
         renderer->RenderReadPixels = METAL_RenderReadPixels;
+        renderer->StartReadPixels = METAL_StartReadPixels;
+        renderer->IsReadPixelsDone = METAL_IsReadPixelsDone;
+        renderer->FinishReadPixels = METAL_FinishReadPixels;
         renderer->RenderPresent = METAL_RenderPresent;
         renderer->DestroyTexture = METAL_DestroyTexture;
         renderer->DestroyRenderer = METAL_DestroyRenderer;
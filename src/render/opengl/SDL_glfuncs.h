@@ -144,7 +144,7 @@ SDL_PROC_UNUSED(void, glEvalPoint2, (GLint i, GLint j))
 SDL_PROC_UNUSED(void, glFeedbackBuffer,
                 (GLsizei size, GLenum type, GLfloat *buffer))
 SDL_PROC_UNUSED(void, glFinish, (void))
-SDL_PROC_UNUSED(void, glFlush, (void))
+SDL_PROC(void, glFlush, (void))
 SDL_PROC_UNUSED(void, glFogf, (GLenum pname, GLfloat param))
 SDL_PROC_UNUSED(void, glFogfv, (GLenum pname, const GLfloat *params))
 SDL_PROC_UNUSED(void, glFogi, (GLenum pname, GLint param))
@@ -118,12 +118,33 @@ typedef struct
     PFNGLBINDFRAMEBUFFEREXTPROC glBindFramebufferEXT;
     PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC glCheckFramebufferStatusEXT;
 
+    /* Pixel buffer and fence support, for reading pixels without stalling */
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBUFFERDATAPROC glBufferData;
+    PFNGLMAPBUFFERPROC glMapBuffer;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+
     /* Shader support */
     GL_ShaderContext *shaders;
 
     GL_DrawStateCache drawstate;
 } GL_RenderData;
 
+/* A pixel read into a buffer object, waiting for the GPU to get to it */
+typedef struct
+{
+    GLuint buffer;
+    GLsync fence;
+    SDL_PixelFormat format;
+    int w, h;
+    SDL_bool flip;
+} GL_PendingReadback;
+
 typedef struct
 {
     GLuint texture;
@@ -1513,6 +1534,120 @@ static SDL_Surface *GL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *
     return surface;
 }
 
+static void *GL_StartReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    SDL_PixelFormat format = renderer->target ? renderer->target->format : SDL_PIXELFORMAT_ARGB8888;
+    GL_PendingReadback *pending;
+    GLint internalFormat;
+    GLenum targetFormat, type;
+    int w, h;
+
+    GL_ActivateRenderer(renderer);
+
+    if (!convert_format(format, &internalFormat, &targetFormat, &type)) {
+        SDL_SetError("Texture format %s not supported by OpenGL", SDL_GetPixelFormatName(format));
+        return NULL;
+    }
+
+    pending = (GL_PendingReadback *)SDL_calloc(1, sizeof(*pending));
+    if (!pending) {
+        return NULL;
+    }
+    pending->format = format;
+    pending->w = rect->w;
+    pending->h = rect->h;
+    pending->flip = renderer->target ? SDL_FALSE : SDL_TRUE;
+
+    SDL_GetCurrentRenderOutputSize(renderer, &w, &h);
+
+    /* The pixels are copied into the buffer when the GPU gets there, the fence tells us when that is */
+    data->glGenBuffers(1, &pending->buffer);
+    data->glBindBuffer(GL_PIXEL_PACK_BUFFER, pending->buffer);
+    data->glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)rect->w * rect->h * SDL_BYTESPERPIXEL(format), NULL, GL_STREAM_READ);
+
+    data->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    data->glPixelStorei(GL_PACK_ROW_LENGTH, rect->w);
+
+    data->glReadPixels(rect->x, renderer->target ? rect->y : (h - rect->y) - rect->h,
+                       rect->w, rect->h, targetFormat, type, NULL);
+    data->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    pending->fence = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    data->glFlush();
+
+    if (GL_CheckError("glReadPixels()", renderer) < 0 || !pending->fence) {
+        if (pending->fence) {
+            data->glDeleteSync(pending->fence);
+        }
+        data->glDeleteBuffers(1, &pending->buffer);
+        SDL_free(pending);
+        return NULL;
+    }
+    return pending;
+}
+
+static SDL_bool GL_IsReadPixelsDone(SDL_Renderer *renderer, void *handle)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    GL_PendingReadback *pending = (GL_PendingReadback *)handle;
+
+    GL_ActivateRenderer(renderer);
+
+    return (data->glClientWaitSync(pending->fence, 0, 0) != GL_TIMEOUT_EXPIRED);
+}
+
+static SDL_Surface *GL_FinishReadPixels(SDL_Renderer *renderer, void *handle)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    GL_PendingReadback *pending = (GL_PendingReadback *)handle;
+    SDL_Surface *surface = NULL;
+    GLenum status;
+    const Uint8 *src;
+
+    GL_ActivateRenderer(renderer);
+
+    do {
+        status = data->glClientWaitSync(pending->fence, GL_SYNC_FLUSH_COMMANDS_BIT, SDL_NS_PER_SECOND);
+    } while (status == GL_TIMEOUT_EXPIRED);
+
+    data->glBindBuffer(GL_PIXEL_PACK_BUFFER, pending->buffer);
+    src = (const Uint8 *)data->glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if (status == GL_WAIT_FAILED || !src) {
+        GL_CheckError("glMapBuffer()", renderer);
+        SDL_SetError("Couldn't read pixels from OpenGL buffer");
+    } else {
+        surface = SDL_CreateSurface(pending->w, pending->h, pending->format);
+        if (surface) {
+            /* Copy the rows top-down, flipping them if they came from the window */
+            size_t length = (size_t)pending->w * SDL_BYTESPERPIXEL(pending->format);
+            Uint8 *dst = (Uint8 *)surface->pixels;
+            int dst_pitch = surface->pitch;
+            int row;
+
+            if (pending->flip) {
+                dst += (pending->h - 1) * surface->pitch;
+                dst_pitch = -dst_pitch;
+            }
+            for (row = 0; row < pending->h; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += length;
+                dst += dst_pitch;
+            }
+        }
+    }
+    if (src) {
+        data->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    data->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    data->glDeleteSync(pending->fence);
+    data->glDeleteBuffers(1, &pending->buffer);
+    SDL_free(pending);
+
+    return surface;
+}
+
 static int GL_RenderPresent(SDL_Renderer *renderer)
 {
     GL_ActivateRenderer(renderer);
@@ -1820,6 +1955,26 @@ static int GL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pro
         goto error;
     }
 
+    /* Check for pixel buffer objects and fences, to read pixels without waiting for the GPU */
+    if ((SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object") || SDL_GL_ExtensionSupported("GL_EXT_pixel_buffer_object")) &&
+        SDL_GL_ExtensionSupported("GL_ARB_sync")) {
+        data->glGenBuffers = (PFNGLGENBUFFERSPROC)SDL_GL_GetProcAddress("glGenBuffers");
+        data->glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)SDL_GL_GetProcAddress("glDeleteBuffers");
+        data->glBindBuffer = (PFNGLBINDBUFFERPROC)SDL_GL_GetProcAddress("glBindBuffer");
+        data->glBufferData = (PFNGLBUFFERDATAPROC)SDL_GL_GetProcAddress("glBufferData");
+        data->glMapBuffer = (PFNGLMAPBUFFERPROC)SDL_GL_GetProcAddress("glMapBuffer");
+        data->glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)SDL_GL_GetProcAddress("glUnmapBuffer");
+        data->glFenceSync = (PFNGLFENCESYNCPROC)SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCPROC)SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glGenBuffers && data->glDeleteBuffers && data->glBindBuffer && data->glBufferData &&
+            data->glMapBuffer && data->glUnmapBuffer && data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            renderer->StartReadPixels = GL_StartReadPixels;
+            renderer->IsReadPixelsDone = GL_IsReadPixelsDone;
+            renderer->FinishReadPixels = GL_FinishReadPixels;
+        }
+    }
+
     /* Set up parameters for rendering */
     data->glMatrixMode(GL_MODELVIEW);
     data->glLoadIdentity();
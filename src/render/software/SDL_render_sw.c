@@ -34,6 +34,8 @@
 #include "SDL_rotate.h"
 #include "SDL_triangle.h"
 #include "../../video/SDL_pixels_c.h"
+#include "../../video/SDL_rect_c.h"
+#include "../../video/SDL_video_c.h"
 
 /* SDL surface based renderer implementation */
 
@@ -45,12 +47,55 @@ typedef struct
     SDL_Color color;
 } SW_DrawStateCache;
 
+/* The maximum number of separate areas of the window surface tracked between presents.
+ * Once this is exceeded, the tracked areas are merged into their bounding rectangle.
+ */
+#define SW_MAX_DIRTY_RECTS 16
+
+/* A copy of part of the render target made on the readback thread */
+typedef struct SW_PendingReadback
+{
+    SDL_Surface *surface;
+    SDL_Rect rect;
+    SDL_Surface *result;
+    char *error;
+    SDL_bool done;
+    struct SW_PendingReadback *next;
+} SW_PendingReadback;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* Areas of the window surface modified since the last present */
+    SDL_bool dirty_all;
+    int num_dirty_rects;
+    SDL_Rect dirty_rects[SW_MAX_DIRTY_RECTS];
+
+    /* Readbacks waiting to be copied, nothing may draw into the target until they are */
+    SDL_Thread *readback_thread;
+    SDL_Mutex *readback_lock;
+    SDL_Condition *readback_cond;
+    SDL_bool readback_quit;
+    SW_PendingReadback *readback_queue;
+    SW_PendingReadback *readback_queue_tail;
 } SW_RenderData;
 
+/* Wait for the readback thread to finish copying, after which the target may be drawn to again */
+static void SW_WaitReadbacks(SW_RenderData *data)
+{
+    if (!data->readback_thread) {
+        return;
+    }
+
+    SDL_LockMutex(data->readback_lock);
+    while (data->readback_queue) {
+        SDL_WaitCondition(data->readback_cond, data->readback_lock);
+    }
+    SDL_UnlockMutex(data->readback_lock);
+}
+
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
 {
     SW_RenderData *data = (SW_RenderData *)renderer->internal;
@@ -62,6 +107,7 @@ static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            data->dirty_all = SDL_TRUE;
         }
     }
     return data->surface;
@@ -72,9 +118,83 @@ static void SW_WindowEvent(SDL_Renderer *renderer, const SDL_WindowEvent *event)
     SW_RenderData *data = (SW_RenderData *)renderer->internal;
 
     if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
+        SW_WaitReadbacks(data); /* the window surface is about to be replaced */
         data->surface = NULL;
         data->window = NULL;
+        data->dirty_all = SDL_TRUE;
+    } else if (event->type == SDL_EVENT_WINDOW_EXPOSED) {
+        data->dirty_all = SDL_TRUE;
+    }
+}
+
+static void SW_AddDirtyRect(SW_RenderData *data, SDL_Surface *surface, const SDL_Rect *rect)
+{
+    SDL_Rect area;
+    int i;
+
+    if (surface != data->window || data->dirty_all) {
+        return;
+    }
+
+    if (!SDL_GetRectIntersection(rect, &surface->internal->clip_rect, &area)) {
+        return;
+    }
+
+    for (i = 0; i < data->num_dirty_rects; ++i) {
+        if (SDL_HasRectIntersection(&data->dirty_rects[i], &area)) {
+            SDL_GetRectUnion(&data->dirty_rects[i], &area, &data->dirty_rects[i]);
+            return;
+        }
+    }
+
+    if (data->num_dirty_rects == SW_MAX_DIRTY_RECTS) {
+        for (i = 1; i < data->num_dirty_rects; ++i) {
+            SDL_GetRectUnion(&data->dirty_rects[0], &data->dirty_rects[i], &data->dirty_rects[0]);
+        }
+        SDL_GetRectUnion(&data->dirty_rects[0], &area, &data->dirty_rects[0]);
+        data->num_dirty_rects = 1;
+    } else {
+        data->dirty_rects[data->num_dirty_rects++] = area;
+    }
+}
+
+static void SW_AddDirtyPoints(SW_RenderData *data, SDL_Surface *surface, const SDL_Point *points, int count)
+{
+    SDL_Rect rect;
+
+    if (surface != data->window || data->dirty_all) {
+        return;
+    }
+
+    if (SDL_GetRectEnclosingPoints(points, count, NULL, &rect)) {
+        SW_AddDirtyRect(data, surface, &rect);
+    }
+}
+
+static void SW_AddDirtyClipRect(SW_RenderData *data, SDL_Surface *surface)
+{
+    SW_AddDirtyRect(data, surface, &surface->internal->clip_rect);
+}
+
+/* Triangle points are in fixed point and interleaved with other vertex data */
+static void SW_AddDirtyTriangles(SW_RenderData *data, SDL_Surface *surface, const SDL_Point *points, size_t stride, int count)
+{
+    SDL_Rect bounds, rect;
+    int i;
+
+    if (surface != data->window || data->dirty_all || count < 3) {
+        return;
+    }
+
+#define TRIANGLE_POINT(n) ((const SDL_Point *)((const Uint8 *)points + (n) * stride))
+    SDL_SW_GetTriangleBounds(TRIANGLE_POINT(0), TRIANGLE_POINT(1), TRIANGLE_POINT(2), &bounds);
+    for (i = 3; i + 2 < count; i += 3) {
+        SDL_SW_GetTriangleBounds(TRIANGLE_POINT(i), TRIANGLE_POINT(i + 1), TRIANGLE_POINT(i + 2), &rect);
+        SDL_GetRectUnion(&bounds, &rect, &bounds);
     }
+#undef TRIANGLE_POINT
+
+    SW_AddDirtyRect(data, surface, &bounds);
 }
 
 static int SW_GetOutputSize(SDL_Renderer *renderer, int *w, int *h)
@@ -134,6 +254,8 @@ static int SW_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
     int row;
     size_t length;
 
+    SW_WaitReadbacks((SW_RenderData *)renderer->internal);
+
     if (SDL_MUSTLOCK(surface)) {
         if (SDL_LockSurface(surface) < 0) {
             return -1;
@@ -160,6 +282,8 @@ static int SW_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture,
 {
     SDL_Surface *surface = (SDL_Surface *)texture->internal;
 
+    SW_WaitReadbacks((SW_RenderData *)renderer->internal);
+
     *pixels =
         (void *)((Uint8 *)surface->pixels + rect->y * surface->pitch +
                  rect->x * surface->internal->format->bytes_per_pixel);
@@ -354,7 +478,7 @@ static int SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Tex
     src_clone = SDL_CreateSurfaceFrom(src->w, src->h, src->format, src->pixels, src->pitch);
     if (!src_clone) {
         if (SDL_MUSTLOCK(src)) {
-            SDL_UnlockSurface(src);
+            SDL_UnlockSurfaceReadOnly(src);
         }
         return -1;
     }
@@ -506,7 +630,7 @@ static int SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Tex
     }
 
     if (SDL_MUSTLOCK(src)) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceReadOnly(src);
     }
     if (mask) {
         SDL_DestroySurface(mask);
@@ -673,6 +797,7 @@ static void SW_InvalidateCachedState(SDL_Renderer *renderer)
 
 static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SW_DrawStateCache drawstate;
 
@@ -680,6 +805,8 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         return -1;
     }
 
+    SW_WaitReadbacks(data);
+
     drawstate.viewport = NULL;
     drawstate.cliprect = NULL;
     drawstate.surface_cliprect_dirty = SDL_TRUE;
@@ -722,6 +849,7 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             /* By definition the clear ignores the clip rect */
             SDL_SetSurfaceClipRect(surface, NULL);
             SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+            SW_AddDirtyClipRect(data, surface);
             drawstate.surface_cliprect_dirty = SDL_TRUE;
             break;
         }
@@ -746,6 +874,8 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 }
             }
 
+            SW_AddDirtyPoints(data, surface, verts, count);
+
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawPoints(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
             } else {
@@ -774,6 +904,8 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 }
             }
 
+            SW_AddDirtyPoints(data, surface, verts, count);
+
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawLines(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
             } else {
@@ -802,6 +934,13 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 }
             }
 
+            if (surface == data->window) {
+                int i;
+                for (i = 0; i < count; i++) {
+                    SW_AddDirtyRect(data, surface, &verts[i]);
+                }
+            }
+
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_FillSurfaceRects(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
             } else {
@@ -828,6 +967,8 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 dstrect->y += drawstate.viewport->y;
             }
 
+            SW_AddDirtyRect(data, surface, dstrect);
+
             if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
                 SDL_BlitSurface(src, srcrect, surface, dstrect);
             } else {
@@ -887,6 +1028,9 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 copydata->dstrect.y += drawstate.viewport->y;
             }
 
+            /* The rotated and scaled bounds aren't known up front, so assume the whole clip area was touched */
+            SW_AddDirtyClipRect(data, surface);
+
             SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
                             &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
                             copydata->scale_x, copydata->scale_y);
@@ -922,6 +1066,10 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     }
                 }
 
+                if (surface == data->window) {
+                    SW_AddDirtyTriangles(data, surface, &ptr[0].dst, sizeof(*ptr), count);
+                }
+
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_BlitTriangle(
                         src,
@@ -946,6 +1094,10 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     }
                 }
 
+                if (surface == data->window) {
+                    SW_AddDirtyTriangles(data, surface, &ptr[0].dst, sizeof(*ptr), count);
+                }
+
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
                 }
@@ -963,15 +1115,10 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
     return 0;
 }
 
-static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+static SDL_Surface *SW_ReadSurfacePixels(SDL_Surface *surface, const SDL_Rect *rect)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
     void *pixels;
 
-    if (!SDL_SurfaceValid(surface)) {
-        return NULL;
-    }
-
     /* NOTE: The rect is already adjusted according to the viewport by
      * SDL_RenderReadPixels.
      */
@@ -989,20 +1136,175 @@ static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *
     return SDL_DuplicatePixels(rect->w, rect->h, surface->format, SDL_COLORSPACE_SRGB, pixels, surface->pitch);
 }
 
+static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+
+    if (!SDL_SurfaceValid(surface)) {
+        return NULL;
+    }
+    return SW_ReadSurfacePixels(surface, rect);
+}
+
+static int SDLCALL SW_ReadbackThread(void *userdata)
+{
+    SW_RenderData *data = (SW_RenderData *)userdata;
+
+    SDL_LockMutex(data->readback_lock);
+    for (;;) {
+        SW_PendingReadback *pending;
+
+        while (!data->readback_queue && !data->readback_quit) {
+            SDL_WaitCondition(data->readback_cond, data->readback_lock);
+        }
+        if (!data->readback_queue) {
+            break;
+        }
+        pending = data->readback_queue;
+        SDL_UnlockMutex(data->readback_lock);
+
+        pending->result = SW_ReadSurfacePixels(pending->surface, &pending->rect);
+        if (!pending->result) {
+            /* The error is set on this thread, save it for SW_FinishReadPixels() */
+            pending->error = SDL_strdup(SDL_GetError());
+        }
+
+        SDL_LockMutex(data->readback_lock);
+        pending->done = SDL_TRUE;
+        data->readback_queue = pending->next;
+        if (!data->readback_queue) {
+            data->readback_queue_tail = NULL;
+        }
+        SDL_BroadcastCondition(data->readback_cond);
+    }
+    SDL_UnlockMutex(data->readback_lock);
+
+    return 0;
+}
+
+static void *SW_StartReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_PendingReadback *pending;
+
+    if (!SDL_SurfaceValid(surface) || SDL_MUSTLOCK(surface)) {
+        return NULL;
+    }
+
+    /* The copy thread is only started once the application asks for a readback */
+    if (!data->readback_thread) {
+        if (!data->readback_lock) {
+            data->readback_lock = SDL_CreateMutex();
+        }
+        if (!data->readback_cond) {
+            data->readback_cond = SDL_CreateCondition();
+        }
+        if (!data->readback_lock || !data->readback_cond) {
+            return NULL;
+        }
+        data->readback_thread = SDL_CreateThread(SW_ReadbackThread, "SDLReadback", data);
+        if (!data->readback_thread) {
+            return NULL;
+        }
+    }
+
+    pending = (SW_PendingReadback *)SDL_calloc(1, sizeof(*pending));
+    if (!pending) {
+        return NULL;
+    }
+    pending->surface = surface;
+    pending->rect = *rect;
+
+    SDL_LockMutex(data->readback_lock);
+    if (data->readback_queue_tail) {
+        data->readback_queue_tail->next = pending;
+    } else {
+        data->readback_queue = pending;
+    }
+    data->readback_queue_tail = pending;
+    SDL_BroadcastCondition(data->readback_cond);
+    SDL_UnlockMutex(data->readback_lock);
+
+    return pending;
+}
+
+static SDL_bool SW_IsReadPixelsDone(SDL_Renderer *renderer, void *handle)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    SW_PendingReadback *pending = (SW_PendingReadback *)handle;
+    SDL_bool done;
+
+    SDL_LockMutex(data->readback_lock);
+    done = pending->done;
+    SDL_UnlockMutex(data->readback_lock);
+
+    return done;
+}
+
+static SDL_Surface *SW_FinishReadPixels(SDL_Renderer *renderer, void *handle)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    SW_PendingReadback *pending = (SW_PendingReadback *)handle;
+    SDL_Surface *result;
+
+    SDL_LockMutex(data->readback_lock);
+    while (!pending->done) {
+        SDL_WaitCondition(data->readback_cond, data->readback_lock);
+    }
+    SDL_UnlockMutex(data->readback_lock);
+
+    result = pending->result;
+    if (!result) {
+        SDL_SetError("%s", pending->error ? pending->error : "Couldn't read pixels");
+    }
+    SDL_free(pending->error);
+    SDL_free(pending);
+
+    return result;
+}
+
 static int SW_RenderPresent(SDL_Renderer *renderer)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Window *window = renderer->window;
+    int retval;
 
     if (!window) {
         return -1;
     }
-    return SDL_UpdateWindowSurface(window);
+
+    /* The window surface may be reallocated or drawn to by the window system */
+    SW_WaitReadbacks(data);
+
+    /* Only push the parts of the window surface that were drawn since the last present */
+    if (data->dirty_all || !data->window) {
+        retval = SDL_UpdateWindowSurface(window);
+    } else if (data->num_dirty_rects > 0) {
+        retval = SDL_UpdateWindowSurfaceRects(window, data->dirty_rects, data->num_dirty_rects);
+    } else {
+        retval = 0;
+    }
+    data->dirty_all = (retval < 0);
+    data->num_dirty_rects = 0;
+    return retval;
+}
+
+static int SW_PrepareRenderThread(SDL_Renderer *renderer)
+{
+    /* Acquire the window surface here, the render thread only draws into it and presents it */
+    if (!SDL_SurfaceValid(SW_ActivateRenderer(renderer))) {
+        return -1;
+    }
+    return 0;
 }
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
     SDL_Surface *surface = (SDL_Surface *)texture->internal;
 
+    SW_WaitReadbacks((SW_RenderData *)renderer->internal);
+
     SDL_DestroySurface(surface);
 }
 
@@ -1011,6 +1313,19 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     SDL_Window *window = renderer->window;
     SW_RenderData *data = (SW_RenderData *)renderer->internal;
 
+    if (data->readback_thread) {
+        SW_WaitReadbacks(data);
+
+        SDL_LockMutex(data->readback_lock);
+        data->readback_quit = SDL_TRUE;
+        SDL_BroadcastCondition(data->readback_cond);
+        SDL_UnlockMutex(data->readback_lock);
+
+        SDL_WaitThread(data->readback_thread, NULL);
+    }
+    SDL_DestroyCondition(data->readback_cond);
+    SDL_DestroyMutex(data->readback_lock);
+
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
@@ -1128,6 +1443,7 @@ int SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, SD
     }
     data->surface = surface;
     data->window = surface;
+    data->dirty_all = SDL_TRUE;
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
@@ -1148,6 +1464,9 @@ int SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, SD
     renderer->InvalidateCachedState = SW_InvalidateCachedState;
     renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->RenderReadPixels = SW_RenderReadPixels;
+    renderer->StartReadPixels = SW_StartReadPixels;
+    renderer->IsReadPixelsDone = SW_IsReadPixelsDone;
+    renderer->FinishReadPixels = SW_FinishReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
     renderer->DestroyTexture = SW_DestroyTexture;
     renderer->DestroyRenderer = SW_DestroyRenderer;
@@ -1192,7 +1511,16 @@ static int SW_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pro
         return -1;
     }
 
-    return SW_CreateRendererForSurface(renderer, surface, create_props);
+    if (SW_CreateRendererForSurface(renderer, surface, create_props) < 0) {
+        return -1;
+    }
+
+    /* Only a native window framebuffer can be drawn and presented from the render thread,
+       one emulated with another renderer has to be used on the application thread. */
+    if (!SDL_HasWindowTextureFramebuffer(window)) {
+        renderer->PrepareRenderThread = SW_PrepareRenderThread;
+    }
+    return 0;
 }
 
 SDL_RenderDriver SW_RenderDriver = {
@@ -602,7 +602,7 @@ SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smooth, in
 
     /* Unlock source surface */
     if (SDL_MUSTLOCK(src)) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceReadOnly(src);
     }
 
     /* Return rotated surface */
@@ -147,6 +147,14 @@ static void bounding_rect_fixedpoint(const SDL_Point *a, const SDL_Point *b, con
     r->h = (max_y - min_y) >> FP_BITS;
 }
 
+/* pixels covered by a triangle with points in fixed point, including its edges */
+void SDL_SW_GetTriangleBounds(const SDL_Point *d0, const SDL_Point *d1, const SDL_Point *d2, SDL_Rect *r)
+{
+    bounding_rect_fixedpoint(d0, d1, d2, r);
+    r->w += 2;
+    r->h += 2;
+}
+
 /* bounding rect of three points */
 static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Point *c, SDL_Rect *r)
 {
@@ -762,7 +770,7 @@ end:
         SDL_UnlockSurface(dst);
     }
     if (src_locked) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceReadOnly(src);
     }
 
     return ret;
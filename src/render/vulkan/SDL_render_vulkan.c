@@ -377,8 +377,24 @@ typedef struct
     VkComponentMapping identitySwizzle;
     int currentVertexBuffer;
     SDL_bool issueBatch;
+
+    /* Fences of readbacks recorded into the current command buffer, signaled once it's submitted */
+    VkFence *readbackFences;
+    uint32_t readbackFenceCount;
+    uint32_t readbackFenceMax;
 } VULKAN_RenderData;
 
+/* A copy of the render target into a host visible buffer, waiting for the GPU to get to it */
+typedef struct
+{
+    VULKAN_Buffer buffer;
+    VkFence fence;
+    SDL_PixelFormat format;
+    SDL_Colorspace colorspace;
+    int w, h;
+    int pitch;
+} VULKAN_PendingReadback;
+
 static SDL_PixelFormat VULKAN_VkFormatToSDLPixelFormat(VkFormat vkFormat)
 {
     switch (vkFormat) {
@@ -476,6 +492,12 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
         return;
     }
 
+    if (rendererData->readbackFences) {
+        SDL_free(rendererData->readbackFences);
+        rendererData->readbackFences = NULL;
+        rendererData->readbackFenceCount = 0;
+        rendererData->readbackFenceMax = 0;
+    }
     if (rendererData->waitDestStageMasks) {
         SDL_free(rendererData->waitDestStageMasks);
         rendererData->waitDestStageMasks = NULL;
@@ -1023,6 +1045,19 @@ static void VULKAN_ResetCommandList(VULKAN_RenderData *rendererData)
     rendererData->currentUploadBuffer[rendererData->currentCommandBufferIndex] = 0;
 }
 
+/* Signal the fences of the readbacks in the command buffer that was just submitted.
+   A submission without command buffers signals its fence once all earlier work has completed. */
+static void VULKAN_SignalReadbackFences(VULKAN_RenderData *rendererData)
+{
+    for (uint32_t i = 0; i < rendererData->readbackFenceCount; ++i) {
+        VkResult result = vkQueueSubmit(rendererData->graphicsQueue, 0, NULL, rendererData->readbackFences[i]);
+        if (result != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkQueueSubmit(): %s\n", SDL_Vulkan_GetResultString(result));
+        }
+    }
+    rendererData->readbackFenceCount = 0;
+}
+
 static VkResult VULKAN_IssueBatch(VULKAN_RenderData *rendererData)
 {
     VkResult result;
@@ -1064,6 +1099,8 @@ static VkResult VULKAN_IssueBatch(VULKAN_RenderData *rendererData)
     result = vkQueueSubmit(rendererData->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
     rendererData->currentImageAvailableSemaphore = VK_NULL_HANDLE;
 
+    VULKAN_SignalReadbackFences(rendererData);
+
     VULKAN_WaitForGPU(rendererData);
 
     VULKAN_ResetCommandList(rendererData);
@@ -3932,6 +3969,164 @@ static SDL_Surface* VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
     return output;
 }
 
+static void *VULKAN_StartReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_PendingReadback *pending;
+    VkImage backBuffer;
+    VkImageLayout *imageLayout;
+    VkDeviceSize length;
+    VkFormat vkFormat;
+    VkResult result;
+
+    /* Make room to track the fence before recording anything */
+    if (rendererData->readbackFenceCount == rendererData->readbackFenceMax) {
+        VkFence *readbackFences = (VkFence *)SDL_realloc(rendererData->readbackFences, (rendererData->readbackFenceMax + 1) * sizeof(*readbackFences));
+        if (!readbackFences) {
+            return NULL;
+        }
+        rendererData->readbackFences = readbackFences;
+        ++rendererData->readbackFenceMax;
+    }
+
+    pending = (VULKAN_PendingReadback *)SDL_calloc(1, sizeof(*pending));
+    if (!pending) {
+        return NULL;
+    }
+
+    VkFenceCreateInfo fenceCreateInfo = { 0 };
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    result = vkCreateFence(rendererData->device, &fenceCreateInfo, NULL, &pending->fence);
+    if (result != VK_SUCCESS) {
+        SDL_free(pending);
+        SDL_SetError("[Vulkan] vkCreateFence(): %s", SDL_Vulkan_GetResultString(result));
+        return NULL;
+    }
+
+    VULKAN_EnsureCommandBuffer(rendererData);
+
+    /* Stop any outstanding renderpass if open */
+    if (rendererData->currentRenderPass != VK_NULL_HANDLE) {
+        vkCmdEndRenderPass(rendererData->currentCommandBuffer);
+        rendererData->currentRenderPass = VK_NULL_HANDLE;
+    }
+
+    if (rendererData->textureRenderTarget) {
+        backBuffer = rendererData->textureRenderTarget->mainImage.image;
+        imageLayout = &rendererData->textureRenderTarget->mainImage.imageLayout;
+        vkFormat = rendererData->textureRenderTarget->mainImage.format;
+    } else {
+        backBuffer = rendererData->swapchainImages[rendererData->currentSwapchainImageIndex];
+        imageLayout = &rendererData->swapchainImageLayouts[rendererData->currentSwapchainImageIndex];
+        vkFormat = rendererData->surfaceFormat.format;
+    }
+
+    length = rect->w * VULKAN_GetBytesPerPixel(vkFormat);
+    if (VULKAN_AllocateBuffer(rendererData, length * rect->h,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        &pending->buffer) != VK_SUCCESS) {
+        vkDestroyFence(rendererData->device, pending->fence, NULL);
+        SDL_free(pending);
+        SDL_SetError("[Vulkan] Failed to allocate buffer for readback");
+        return NULL;
+    }
+    pending->format = VULKAN_VkFormatToSDLPixelFormat(vkFormat);
+    pending->colorspace = renderer->target ? renderer->target->colorspace : renderer->output_colorspace;
+    pending->w = rect->w;
+    pending->h = rect->h;
+    pending->pitch = (int)length;
+
+    /* Make sure the source is in the correct resource state */
+    VULKAN_RecordPipelineImageBarrier(rendererData,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_TRANSFER_READ_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        backBuffer,
+        imageLayout);
+
+    /* Copy the image to the readback buffer */
+    VkBufferImageCopy region;
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageOffset.x = rect->x;
+    region.imageOffset.y = rect->y;
+    region.imageOffset.z = 0;
+    region.imageExtent.width = rect->w;
+    region.imageExtent.height = rect->h;
+    region.imageExtent.depth = 1;
+    vkCmdCopyImageToBuffer(rendererData->currentCommandBuffer, backBuffer, *imageLayout, pending->buffer.buffer, 1, &region);
+
+    /* Make the copy visible to the CPU once the fence is signaled */
+    VkMemoryBarrier hostBarrier = { 0 };
+    hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(rendererData->currentCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0, NULL, 0, NULL);
+
+    /* Transition the render target back to a render target */
+    VULKAN_RecordPipelineImageBarrier(rendererData,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        backBuffer,
+        imageLayout);
+
+    /* The copy runs when the command buffer is submitted, at the latest when the frame is presented */
+    rendererData->readbackFences[rendererData->readbackFenceCount++] = pending->fence;
+
+    return pending;
+}
+
+static SDL_bool VULKAN_IsReadPixelsDone(SDL_Renderer *renderer, void *handle)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_PendingReadback *pending = (VULKAN_PendingReadback *)handle;
+
+    return (vkGetFenceStatus(rendererData->device, pending->fence) != VK_NOT_READY);
+}
+
+static SDL_Surface *VULKAN_FinishReadPixels(SDL_Renderer *renderer, void *handle)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_PendingReadback *pending = (VULKAN_PendingReadback *)handle;
+    SDL_Surface *output = NULL;
+    VkResult result;
+
+    /* Submit the copy if it's still waiting in the current command buffer */
+    for (uint32_t i = 0; i < rendererData->readbackFenceCount; ++i) {
+        if (rendererData->readbackFences[i] == pending->fence) {
+            VULKAN_IssueBatch(rendererData);
+            break;
+        }
+    }
+
+    result = vkWaitForFences(rendererData->device, 1, &pending->fence, VK_TRUE, UINT64_MAX);
+    if (result != VK_SUCCESS) {
+        SDL_SetError("[Vulkan] vkWaitForFences(): %s", SDL_Vulkan_GetResultString(result));
+    } else {
+        output = SDL_DuplicatePixels(pending->w, pending->h, pending->format, pending->colorspace,
+                                     pending->buffer.mappedBufferPtr, pending->pitch);
+    }
+
+    VULKAN_DestroyBuffer(rendererData, &pending->buffer);
+    vkDestroyFence(rendererData->device, pending->fence, NULL);
+    SDL_free(pending);
+
+    return output;
+}
+
 static int VULKAN_AddVulkanRenderSemaphores(SDL_Renderer *renderer, Uint32 wait_stage_mask, Sint64 wait_semaphore, Sint64 signal_semaphore)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
@@ -4037,6 +4232,8 @@ static int VULKAN_RenderPresent(SDL_Renderer *renderer)
         rendererData->currentCommandBuffer = VK_NULL_HANDLE;
         rendererData->currentImageAvailableSemaphore = VK_NULL_HANDLE;
 
+        VULKAN_SignalReadbackFences(rendererData);
+
 
         VkPresentInfoKHR presentInfo = { 0 };
         presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -4129,6 +4326,9 @@ static int VULKAN_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL
     renderer->InvalidateCachedState = VULKAN_InvalidateCachedState;
     renderer->RunCommandQueue = VULKAN_RunCommandQueue;
     renderer->RenderReadPixels = VULKAN_RenderReadPixels;
+    renderer->StartReadPixels = VULKAN_StartReadPixels;
+    renderer->IsReadPixelsDone = VULKAN_IsReadPixelsDone;
+    renderer->FinishReadPixels = VULKAN_FinishReadPixels;
     renderer->AddVulkanRenderSemaphores = VULKAN_AddVulkanRenderSemaphores;
     renderer->RenderPresent = VULKAN_RenderPresent;
     renderer->DestroyTexture = VULKAN_DestroyTexture;
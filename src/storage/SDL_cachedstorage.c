@@ -0,0 +1,387 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_internal.h"
+
+#include "../SDL_hashtable.h"
+
+/* A read cache that wraps another SDL_Storage.
+
+   Cached files are immutable buffers with a reference count, so readers on
+   the async I/O worker threads copy out of them without holding the cache
+   lock, and a file that is evicted while it's being copied stays alive until
+   the copy is done.
+*/
+
+#define CACHE_NUM_BUCKETS   1024
+
+typedef struct CachedFile
+{
+    char *path;
+    Uint64 size;
+    SDL_Time modify_time;
+    SDL_AtomicInt refcount;
+    struct CachedFile *prev;  /* more recently used */
+    struct CachedFile *next;  /* less recently used */
+    Uint8 data[1];
+} CachedFile;
+
+typedef struct CachedStorage
+{
+    SDL_Storage *storage;
+    SDL_bool closestorage;
+    Uint64 max_bytes;
+    SDL_Mutex *lock;
+    SDL_HashTable *files;  /* path -> CachedFile */
+    CachedFile *newest;
+    CachedFile *oldest;
+    Uint64 cached_bytes;
+    Uint32 generation;     /* bumped whenever files are invalidated */
+    Sint64 hits;
+    Sint64 misses;
+    SDL_PropertiesID props;
+} CachedStorage;
+
+static void ReleaseCachedFile(CachedFile *file)
+{
+    if (SDL_AtomicDecRef(&file->refcount)) {
+        SDL_free(file->path);
+        SDL_free(file);
+    }
+}
+
+/* These are called with the cache locked */
+
+static void UpdateCacheProperties(CachedStorage *cache)
+{
+    if (cache->props) {
+        SDL_SetNumberProperty(cache->props, SDL_PROP_STORAGE_CACHE_HITS_NUMBER, cache->hits);
+        SDL_SetNumberProperty(cache->props, SDL_PROP_STORAGE_CACHE_MISSES_NUMBER, cache->misses);
+        SDL_SetNumberProperty(cache->props, SDL_PROP_STORAGE_CACHE_SIZE_NUMBER, (Sint64)cache->cached_bytes);
+    }
+}
+
+static void UnlinkCachedFile(CachedStorage *cache, CachedFile *file)
+{
+    if (file->prev) {
+        file->prev->next = file->next;
+    } else {
+        cache->newest = file->next;
+    }
+    if (file->next) {
+        file->next->prev = file->prev;
+    } else {
+        cache->oldest = file->prev;
+    }
+    file->prev = NULL;
+    file->next = NULL;
+}
+
+static void LinkCachedFile(CachedStorage *cache, CachedFile *file)
+{
+    file->prev = NULL;
+    file->next = cache->newest;
+    if (cache->newest) {
+        cache->newest->prev = file;
+    } else {
+        cache->oldest = file;
+    }
+    cache->newest = file;
+}
+
+static void DropCachedFile(CachedStorage *cache, CachedFile *file)
+{
+    UnlinkCachedFile(cache, file);
+    SDL_RemoveFromHashTable(cache->files, file->path);
+    cache->cached_bytes -= file->size;
+    ReleaseCachedFile(file);
+}
+
+/* Drop path, and everything under it in case it's a directory */
+static void InvalidatePath(CachedStorage *cache, const char *path)
+{
+    const size_t len = SDL_strlen(path);
+    CachedFile *file = cache->newest;
+
+    while (file) {
+        CachedFile *next = file->next;
+        if ((SDL_strncmp(file->path, path, len) == 0) && ((file->path[len] == '\0') || (file->path[len] == '/'))) {
+            DropCachedFile(cache, file);
+        }
+        file = next;
+    }
+    ++cache->generation;
+    UpdateCacheProperties(cache);
+}
+
+static int CACHE_CloseStorage(void *userdata)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    int result = 0;
+
+    while (cache->newest) {
+        DropCachedFile(cache, cache->newest);
+    }
+    SDL_DestroyHashTable(cache->files);
+    SDL_DestroyMutex(cache->lock);
+    if (cache->closestorage) {
+        result = SDL_CloseStorage(cache->storage);
+    }
+    SDL_free(cache);
+    return result;
+}
+
+static SDL_bool CACHE_StorageReady(void *userdata)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    return SDL_StorageReady(cache->storage);
+}
+
+static int CACHE_EnumerateStorageDirectory(void *userdata, const char *path, SDL_EnumerateDirectoryCallback callback, void *callback_userdata)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    return SDL_EnumerateStorageDirectory(cache->storage, path, callback, callback_userdata);
+}
+
+static int CACHE_GetStoragePathInfo(void *userdata, const char *path, SDL_PathInfo *info)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    return SDL_GetStoragePathInfo(cache->storage, path, info);
+}
+
+static int CACHE_ReadStorageFile(void *userdata, const char *path, void *destination, Uint64 length)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    CachedFile *file = NULL;
+    const void *value = NULL;
+    SDL_PathInfo info;
+    Uint32 generation;
+
+    /* The size and modification time are part of the key, so files changed behind our back are reread */
+    if (SDL_GetStoragePathInfo(cache->storage, path, &info) < 0) {
+        return -1;
+    }
+
+    SDL_LockMutex(cache->lock);
+    if (SDL_FindInHashTable(cache->files, path, &value)) {
+        file = (CachedFile *)value;
+        if ((file->size == info.size) && (file->modify_time == info.modify_time)) {
+            UnlinkCachedFile(cache, file);
+            LinkCachedFile(cache, file);
+            SDL_AtomicIncRef(&file->refcount);
+            ++cache->hits;
+        } else {
+            DropCachedFile(cache, file);
+            file = NULL;
+        }
+    }
+    if (!file) {
+        ++cache->misses;
+    }
+    UpdateCacheProperties(cache);
+    generation = cache->generation;
+    SDL_UnlockMutex(cache->lock);
+
+    if (file) {
+        int result = 0;
+        if (length > file->size) {
+            result = SDL_SetError("Read size exceeds file size");
+        } else {
+            SDL_memcpy(destination, file->data, (size_t)length);
+        }
+        ReleaseCachedFile(file);
+        return result;
+    }
+
+    /* Files that don't fit in the cache, or that the backend reports as something other than a file, go straight through */
+    if ((info.type != SDL_PATHTYPE_FILE) || (info.size > cache->max_bytes) || (length > info.size) || (info.size >= SDL_SIZE_MAX - sizeof(*file))) {
+        return SDL_ReadStorageFile(cache->storage, path, destination, length);
+    }
+
+    file = (CachedFile *)SDL_malloc(sizeof(*file) + (size_t)info.size);
+    if (!file) {
+        return -1;
+    }
+    file->path = SDL_strdup(path);
+    if (!file->path) {
+        SDL_free(file);
+        return -1;
+    }
+    file->size = info.size;
+    file->modify_time = info.modify_time;
+    SDL_AtomicSet(&file->refcount, 1);
+    file->prev = NULL;
+    file->next = NULL;
+
+    if (SDL_ReadStorageFile(cache->storage, path, file->data, info.size) < 0) {
+        ReleaseCachedFile(file);
+        return -1;
+    }
+    SDL_memcpy(destination, file->data, (size_t)length);
+
+    SDL_LockMutex(cache->lock);
+    /* If a write or another reader got here while we were reading, their copy wins */
+    if ((generation == cache->generation) && !SDL_FindInHashTable(cache->files, file->path, NULL)) {
+        while (cache->oldest && ((cache->cached_bytes + file->size) > cache->max_bytes)) {
+            DropCachedFile(cache, cache->oldest);
+        }
+        if (SDL_InsertIntoHashTable(cache->files, file->path, file)) {
+            LinkCachedFile(cache, file);
+            cache->cached_bytes += file->size;
+            file = NULL;
+        }
+        UpdateCacheProperties(cache);
+    }
+    SDL_UnlockMutex(cache->lock);
+
+    if (file) {
+        ReleaseCachedFile(file);
+    }
+    return 0;
+}
+
+static int CACHE_WriteStorageFile(void *userdata, const char *path, const void *source, Uint64 length)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    int result;
+
+    SDL_LockMutex(cache->lock);
+    InvalidatePath(cache, path);
+    SDL_UnlockMutex(cache->lock);
+
+    result = SDL_WriteStorageFile(cache->storage, path, source, length);
+
+    /* Invalidate again, in case a read cached the old contents while the write was in progress */
+    SDL_LockMutex(cache->lock);
+    InvalidatePath(cache, path);
+    SDL_UnlockMutex(cache->lock);
+
+    return result;
+}
+
+static int CACHE_CreateStorageDirectory(void *userdata, const char *path)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    return SDL_CreateStorageDirectory(cache->storage, path);
+}
+
+static int CACHE_RemoveStoragePath(void *userdata, const char *path)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    int result = SDL_RemoveStoragePath(cache->storage, path);
+
+    SDL_LockMutex(cache->lock);
+    InvalidatePath(cache, path);
+    SDL_UnlockMutex(cache->lock);
+
+    return result;
+}
+
+static int CACHE_RenameStoragePath(void *userdata, const char *oldpath, const char *newpath)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    int result = SDL_RenameStoragePath(cache->storage, oldpath, newpath);
+
+    SDL_LockMutex(cache->lock);
+    InvalidatePath(cache, oldpath);
+    InvalidatePath(cache, newpath);
+    SDL_UnlockMutex(cache->lock);
+
+    return result;
+}
+
+static int CACHE_CopyStorageFile(void *userdata, const char *oldpath, const char *newpath)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    int result = SDL_CopyStorageFile(cache->storage, oldpath, newpath);
+
+    SDL_LockMutex(cache->lock);
+    InvalidatePath(cache, newpath);
+    SDL_UnlockMutex(cache->lock);
+
+    return result;
+}
+
+static Uint64 CACHE_GetStorageSpaceRemaining(void *userdata)
+{
+    CachedStorage *cache = (CachedStorage *)userdata;
+    return SDL_GetStorageSpaceRemaining(cache->storage);
+}
+
+static const SDL_StorageInterface CACHE_iface = {
+    CACHE_CloseStorage,
+    CACHE_StorageReady,
+    CACHE_EnumerateStorageDirectory,
+    CACHE_GetStoragePathInfo,
+    CACHE_ReadStorageFile,
+    CACHE_WriteStorageFile,
+    CACHE_CreateStorageDirectory,
+    CACHE_RemoveStoragePath,
+    CACHE_RenameStoragePath,
+    CACHE_CopyStorageFile,
+    CACHE_GetStorageSpaceRemaining
+};
+
+SDL_Storage *SDL_CreateCachedStorage(SDL_Storage *storage, Uint64 max_bytes, SDL_bool closestorage)
+{
+    CachedStorage *cache;
+    SDL_Storage *result;
+
+    if (!storage) {
+        SDL_InvalidParamError("storage");
+        return NULL;
+    }
+
+    cache = (CachedStorage *)SDL_calloc(1, sizeof(*cache));
+    if (!cache) {
+        goto failed;
+    }
+    cache->storage = storage;
+    cache->max_bytes = max_bytes;
+    cache->lock = SDL_CreateMutex();
+    if (!cache->lock) {
+        goto failed;
+    }
+    cache->files = SDL_CreateHashTable(NULL, CACHE_NUM_BUCKETS, SDL_HashString, SDL_KeyMatchString, NULL, SDL_FALSE);
+    if (!cache->files) {
+        goto failed;
+    }
+
+    result = SDL_OpenStorage(&CACHE_iface, cache);
+    if (!result) {
+        goto failed;
+    }
+    cache->closestorage = closestorage;
+    cache->props = SDL_GetStorageProperties(result);
+    UpdateCacheProperties(cache);
+    return result;
+
+failed:
+    if (cache) {
+        SDL_DestroyHashTable(cache->files);
+        SDL_DestroyMutex(cache->lock);
+        SDL_free(cache);
+    }
+    if (closestorage) {
+        SDL_CloseStorage(storage);
+    }
+    return NULL;
+}
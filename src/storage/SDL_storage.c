@@ -22,10 +22,12 @@
 #include "SDL_internal.h"
 
 #include "SDL_sysstorage.h"
+#include "../file/SDL_asyncio_c.h"
 #include "../filesystem/SDL_sysfilesystem.h"
 
 /* Available title storage drivers */
 static TitleStorageBootStrap *titlebootstrap[] = {
+    &PACK_titlebootstrap,
     &GENERIC_titlebootstrap,
     NULL
 };
@@ -43,6 +45,7 @@ struct SDL_Storage
 {
     SDL_StorageInterface iface;
     void *userdata;
+    SDL_PropertiesID props;
 };
 
 #define CHECK_STORAGE_MAGIC()                             \
@@ -171,10 +174,21 @@ int SDL_CloseStorage(SDL_Storage *storage)
     if (storage->iface.close) {
         retval = storage->iface.close(storage->userdata);
     }
+    SDL_DestroyProperties(storage->props);
     SDL_free(storage);
     return retval;
 }
 
+SDL_PropertiesID SDL_GetStorageProperties(SDL_Storage *storage)
+{
+    CHECK_STORAGE_MAGIC_RET(0)
+
+    if (storage->props == 0) {
+        storage->props = SDL_CreateProperties();
+    }
+    return storage->props;
+}
+
 SDL_bool SDL_StorageReady(SDL_Storage *storage)
 {
     CHECK_STORAGE_MAGIC_RET(SDL_FALSE)
@@ -213,6 +227,64 @@ int SDL_ReadStorageFile(SDL_Storage *storage, const char *path, void *destinatio
     return storage->iface.read_file(storage->userdata, path, destination, length);
 }
 
+typedef struct SDL_StorageReadTask
+{
+    SDL_Storage *storage;
+    char *path;
+} SDL_StorageReadTask;
+
+static Sint64 SDL_RunStorageReadTask(void *funcdata, void *buffer, Uint64 size)
+{
+    SDL_StorageReadTask *task = (SDL_StorageReadTask *)funcdata;
+    Sint64 retval = -1;
+
+    if (buffer) {
+        SDL_Storage *storage = task->storage;
+        if (storage->iface.read_file(storage->userdata, task->path, buffer, size) == 0) {
+            retval = (Sint64)size;
+        }
+    }
+    SDL_free(task->path);
+    SDL_free(task);
+    return retval;
+}
+
+int SDL_ReadStorageFileAsync(SDL_Storage *storage, const char *path, void *destination, Uint64 length, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_StorageReadTask *task;
+
+    CHECK_STORAGE_MAGIC()
+
+    if (!path) {
+        return SDL_InvalidParamError("path");
+    }
+    if (!destination) {
+        return SDL_InvalidParamError("destination");
+    }
+
+    if (!storage->iface.read_file) {
+        return SDL_Unsupported();
+    }
+
+    task = (SDL_StorageReadTask *)SDL_malloc(sizeof(*task));
+    if (!task) {
+        return -1;
+    }
+    task->storage = storage;
+    task->path = SDL_strdup(path);
+    if (!task->path) {
+        SDL_free(task);
+        return -1;
+    }
+
+    if (SDL_QueueAsyncIOFunction(queue, SDL_ASYNCIO_TASK_READ, SDL_RunStorageReadTask, task, destination, length, userdata) < 0) {
+        SDL_free(task->path);
+        SDL_free(task);
+        return -1;
+    }
+    return 0;
+}
+
 int SDL_WriteStorageFile(SDL_Storage *storage, const char *path, const void *source, Uint64 length)
 {
     CHECK_STORAGE_MAGIC()
@@ -348,9 +420,24 @@ static int GlobStorageDirectoryGetPathInfo(const char *path, SDL_PathInfo *info,
     return SDL_GetStoragePathInfo((SDL_Storage *) userdata, path, info);
 }
 
-static int GlobStorageDirectoryEnumerator(const char *path, SDL_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata)
+typedef struct GlobStorageCallbackData
+{
+    SDL_EnumerateDirectoryInfoCallback cb;
+    void *cbuserdata;
+} GlobStorageCallbackData;
+
+static int SDLCALL GlobStorageDirectoryCallback(void *userdata, const char *dirname, const char *fname)
+{
+    GlobStorageCallbackData *data = (GlobStorageCallbackData *) userdata;
+    return data->cb(data->cbuserdata, dirname, fname, NULL);  // storage doesn't know about the entries, the glob will ask.
+}
+
+static int GlobStorageDirectoryEnumerator(const char *path, SDL_EnumerateDirectoryInfoCallback cb, void *cbuserdata, void *userdata)
 {
-    return SDL_EnumerateStorageDirectory((SDL_Storage *) userdata, path, cb, cbuserdata);
+    GlobStorageCallbackData data;
+    data.cb = cb;
+    data.cbuserdata = cbuserdata;
+    return SDL_EnumerateStorageDirectory((SDL_Storage *) userdata, path, GlobStorageDirectoryCallback, &data);
 }
 
 char **SDL_GlobStorageDirectory(SDL_Storage *storage, const char *path, const char *pattern, SDL_GlobFlags flags, int *count)
@@ -40,6 +40,7 @@ typedef struct UserStorageBootStrap
 
 /* Not all of these are available in a given build. Use #ifdefs, etc. */
 
+extern TitleStorageBootStrap PACK_titlebootstrap;
 extern TitleStorageBootStrap GENERIC_titlebootstrap;
 /* Steam does not have title storage APIs */
 
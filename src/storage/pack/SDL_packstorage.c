@@ -0,0 +1,694 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_internal.h"
+
+#include "../SDL_sysstorage.h"
+#include "../../SDL_hashtable.h"
+
+/* Title storage served from a single zip archive.
+
+   The central directory is read once when the storage is opened and turned
+   into an in-memory tree with a hashed path index, so path info, enumeration
+   and globbing never touch the disk. File data is read straight out of the
+   archive, from a memory mapping when the platform supports it or through one
+   shared file handle otherwise. Only stored (uncompressed) entries can be
+   read, which is what you'd want for data that is read at load time anyway.
+*/
+
+#define ZIP_LOCAL_HEADER_SIG        0x04034b50
+#define ZIP_CENTRAL_HEADER_SIG      0x02014b50
+#define ZIP_END_OF_CENTRAL_SIG      0x06054b50
+#define ZIP64_END_OF_CENTRAL_SIG    0x06064b50
+#define ZIP64_END_LOCATOR_SIG       0x07064b50
+
+#define ZIP_LOCAL_HEADER_SIZE       30
+#define ZIP_CENTRAL_HEADER_SIZE     46
+#define ZIP_END_OF_CENTRAL_SIZE     22
+#define ZIP64_END_OF_CENTRAL_SIZE   56
+#define ZIP64_END_LOCATOR_SIZE      20
+#define ZIP_MAX_COMMENT_SIZE        0xFFFF
+
+#define ZIP_FLAG_ENCRYPTED          0x0001
+#define ZIP_METHOD_STORED           0
+#define ZIP64_EXTRA_FIELD_ID        0x0001
+
+#define PACK_NO_ENTRY               -1
+
+typedef struct PackEntry
+{
+    const char *path;   /* path inside the archive, without leading or trailing '/' */
+    const char *name;   /* the last component of path */
+    SDL_PathType type;
+    Uint16 flags;
+    Uint16 method;
+    Uint64 size;
+    Uint64 header_offset;  /* the local header, the data offset is resolved when the file is read */
+    SDL_Time modify_time;
+    int parent;
+    int first_child;
+    int last_child;
+    int next_sibling;
+} PackEntry;
+
+/* Path strings live in blocks that never move, so the index can key on them directly. */
+typedef struct PackStringBlock
+{
+    struct PackStringBlock *next;
+    size_t used;
+    size_t size;
+    char data[1];
+} PackStringBlock;
+
+typedef struct PackStorage
+{
+    SDL_IOStream *io;
+    const Uint8 *mem;     /* the whole archive, if it's mapped */
+    Uint64 archive_size;
+    SDL_Mutex *lock;      /* serializes seek+read on io when it isn't mapped */
+    PackEntry *entries;
+    int num_entries;
+    int max_entries;
+    SDL_HashTable *index; /* path -> entry index + 1 */
+    PackStringBlock *strings;
+} PackStorage;
+
+static Uint16 PACK_Read16(const Uint8 *ptr)
+{
+    return (Uint16)(ptr[0] | (ptr[1] << 8));
+}
+
+static Uint32 PACK_Read32(const Uint8 *ptr)
+{
+    return ((Uint32)ptr[0]) | ((Uint32)ptr[1] << 8) | ((Uint32)ptr[2] << 16) | ((Uint32)ptr[3] << 24);
+}
+
+static Uint64 PACK_Read64(const Uint8 *ptr)
+{
+    return ((Uint64)PACK_Read32(ptr)) | ((Uint64)PACK_Read32(ptr + 4) << 32);
+}
+
+static int PACK_ReadAt(PackStorage *pack, Uint64 offset, void *buffer, Uint64 length)
+{
+    if ((offset > pack->archive_size) || (length > (pack->archive_size - offset))) {
+        return SDL_SetError("Pack file is truncated");
+    }
+
+    if (pack->mem) {
+        SDL_memcpy(buffer, pack->mem + offset, (size_t)length);
+        return 0;
+    }
+
+    int result = 0;
+    SDL_LockMutex(pack->lock);
+    if (SDL_SeekIO(pack->io, (Sint64)offset, SDL_IO_SEEK_SET) < 0) {
+        result = -1;
+    } else if (SDL_ReadIO(pack->io, buffer, (size_t)length) != length) {
+        result = SDL_SetError("Pack file is truncated");
+    }
+    SDL_UnlockMutex(pack->lock);
+    return result;
+}
+
+static char *PACK_AllocString(PackStorage *pack, const char *str, size_t len)
+{
+    PackStringBlock *block = pack->strings;
+    if (!block || (block->size - block->used) < (len + 1)) {
+        const size_t size = SDL_max(len + 1, 64 * 1024);
+        block = (PackStringBlock *)SDL_malloc(sizeof(*block) + size);
+        if (!block) {
+            return NULL;
+        }
+        block->next = pack->strings;
+        block->used = 0;
+        block->size = size;
+        pack->strings = block;
+    }
+
+    char *result = block->data + block->used;
+    SDL_memcpy(result, str, len);
+    result[len] = '\0';
+    block->used += len + 1;
+    return result;
+}
+
+static int PACK_FindEntry(const PackStorage *pack, const char *path)
+{
+    const void *value = NULL;
+    if (!SDL_FindInHashTable(pack->index, path, &value)) {
+        return PACK_NO_ENTRY;
+    }
+    return (int)((uintptr_t)value - 1);
+}
+
+static int PACK_AddEntry(PackStorage *pack, const char *path, size_t len, SDL_PathType type)
+{
+    char stackbuf[256];
+    char *key = stackbuf;
+    const char *slash;
+    const char *stored;
+    PackEntry *entry;
+    int parent = 0;  /* the root */
+    int index;
+
+    /* The index is keyed on NUL terminated strings and path points into the central directory */
+    if (len >= sizeof(stackbuf)) {
+        key = (char *)SDL_malloc(len + 1);
+        if (!key) {
+            return PACK_NO_ENTRY;
+        }
+    }
+    SDL_memcpy(key, path, len);
+    key[len] = '\0';
+
+    index = PACK_FindEntry(pack, key);
+    if (index != PACK_NO_ENTRY) {
+        /* A directory we made up for an earlier entry, or a duplicate name, the last one wins */
+        if (pack->entries[index].type != type) {
+            SDL_SetError("Pack file uses '%s' as both a file and a directory", key);
+            index = PACK_NO_ENTRY;
+        }
+        goto done;
+    }
+
+    slash = SDL_strrchr(key, '/');
+    if (slash) {
+        parent = PACK_AddEntry(pack, key, (size_t)(slash - key), SDL_PATHTYPE_DIRECTORY);
+        if (parent == PACK_NO_ENTRY) {
+            goto done;
+        }
+    }
+
+    if (pack->num_entries == pack->max_entries) {
+        const int max_entries = pack->max_entries ? (pack->max_entries * 2) : 64;
+        PackEntry *entries = (PackEntry *)SDL_realloc(pack->entries, max_entries * sizeof(*entries));
+        if (!entries) {
+            goto done;
+        }
+        pack->entries = entries;
+        pack->max_entries = max_entries;
+    }
+
+    stored = PACK_AllocString(pack, key, len);
+    if (!stored) {
+        goto done;
+    }
+
+    entry = &pack->entries[pack->num_entries];
+    SDL_zerop(entry);
+    entry->path = stored;
+    slash = SDL_strrchr(stored, '/');
+    entry->name = slash ? (slash + 1) : stored;
+    entry->type = type;
+    entry->parent = parent;
+    entry->first_child = PACK_NO_ENTRY;
+    entry->last_child = PACK_NO_ENTRY;
+    entry->next_sibling = PACK_NO_ENTRY;
+
+    if (!SDL_InsertIntoHashTable(pack->index, stored, (const void *)(uintptr_t)(pack->num_entries + 1))) {
+        goto done;
+    }
+    index = pack->num_entries++;
+
+    /* Keep children in archive order, so enumeration matches what the packing tool wrote */
+    if (index > 0) {
+        PackEntry *dir = &pack->entries[parent];
+        if (dir->last_child == PACK_NO_ENTRY) {
+            dir->first_child = index;
+        } else {
+            pack->entries[dir->last_child].next_sibling = index;
+        }
+        dir->last_child = index;
+    }
+
+done:
+    if (key != stackbuf) {
+        SDL_free(key);
+    }
+    return index;
+}
+
+static SDL_Time PACK_DosTimeToTime(Uint16 dostime, Uint16 dosdate)
+{
+    SDL_DateTime dt;
+    SDL_Time result = 0;
+
+    SDL_zero(dt);
+    dt.year = 1980 + (dosdate >> 9);
+    dt.month = SDL_max((dosdate >> 5) & 0x0F, 1);
+    dt.day = SDL_max(dosdate & 0x1F, 1);
+    dt.hour = dostime >> 11;
+    dt.minute = (dostime >> 5) & 0x3F;
+    dt.second = (dostime & 0x1F) * 2;
+    SDL_DateTimeToTime(&dt, &result);
+    return result;
+}
+
+static int PACK_ParseZip64Extra(const Uint8 *extra, Uint16 extra_len, Uint64 *size, Uint64 *compressed_size, Uint64 *header_offset)
+{
+    while (extra_len >= 4) {
+        const Uint16 id = PACK_Read16(extra);
+        const Uint16 len = PACK_Read16(extra + 2);
+        if (len > extra_len - 4) {
+            break;
+        }
+        if (id == ZIP64_EXTRA_FIELD_ID) {
+            /* Only the fields that overflowed in the central header are present, in this order */
+            const Uint8 *ptr = extra + 4;
+            const Uint8 *end = ptr + len;
+            Uint64 *fields[3];
+            int i;
+
+            fields[0] = size;
+            fields[1] = compressed_size;
+            fields[2] = header_offset;
+            for (i = 0; i < SDL_arraysize(fields); ++i) {
+                if (*fields[i] == 0xFFFFFFFF) {
+                    if ((end - ptr) < 8) {
+                        return SDL_SetError("Pack file has a corrupt zip64 entry");
+                    }
+                    *fields[i] = PACK_Read64(ptr);
+                    ptr += 8;
+                }
+            }
+            return 0;
+        }
+        extra += 4 + len;
+        extra_len -= 4 + len;
+    }
+    return 0;
+}
+
+static int PACK_FindCentralDirectory(PackStorage *pack, Uint64 *cd_offset, Uint64 *cd_size, Uint64 *cd_entries)
+{
+    Uint8 *tail;
+    Uint64 tail_offset, tail_size;
+    const Uint8 *eocd = NULL;
+    int i;
+
+    if (pack->archive_size < ZIP_END_OF_CENTRAL_SIZE) {
+        return SDL_SetError("Not a zip file");
+    }
+
+    /* The end of central directory record is at the end of the file, followed by a comment of up to 64K */
+    tail_size = SDL_min(pack->archive_size, ZIP_END_OF_CENTRAL_SIZE + ZIP_MAX_COMMENT_SIZE + ZIP64_END_LOCATOR_SIZE);
+    tail_offset = pack->archive_size - tail_size;
+    tail = (Uint8 *)SDL_malloc((size_t)tail_size);
+    if (!tail) {
+        return -1;
+    }
+    if (PACK_ReadAt(pack, tail_offset, tail, tail_size) < 0) {
+        SDL_free(tail);
+        return -1;
+    }
+
+    for (i = (int)(tail_size - ZIP_END_OF_CENTRAL_SIZE); i >= 0; --i) {
+        if (PACK_Read32(tail + i) == ZIP_END_OF_CENTRAL_SIG) {
+            eocd = tail + i;
+            break;
+        }
+    }
+    if (!eocd) {
+        SDL_free(tail);
+        return SDL_SetError("Not a zip file");
+    }
+
+    if (PACK_Read16(eocd + 4) != PACK_Read16(eocd + 6)) {
+        SDL_free(tail);
+        return SDL_SetError("Multi-disk zip files aren't supported");
+    }
+    *cd_entries = PACK_Read16(eocd + 10);
+    *cd_size = PACK_Read32(eocd + 12);
+    *cd_offset = PACK_Read32(eocd + 16);
+
+    if ((*cd_entries == 0xFFFF) || (*cd_size == 0xFFFFFFFF) || (*cd_offset == 0xFFFFFFFF)) {
+        const Uint8 *locator = eocd - ZIP64_END_LOCATOR_SIZE;
+        Uint8 zip64[ZIP64_END_OF_CENTRAL_SIZE];
+
+        if ((locator < tail) || (PACK_Read32(locator) != ZIP64_END_LOCATOR_SIG)) {
+            SDL_free(tail);
+            return SDL_SetError("Pack file is missing its zip64 end of central directory");
+        }
+        if (PACK_ReadAt(pack, PACK_Read64(locator + 8), zip64, sizeof(zip64)) < 0) {
+            SDL_free(tail);
+            return -1;
+        }
+        if (PACK_Read32(zip64) != ZIP64_END_OF_CENTRAL_SIG) {
+            SDL_free(tail);
+            return SDL_SetError("Pack file has a corrupt zip64 end of central directory");
+        }
+        *cd_entries = PACK_Read64(zip64 + 32);
+        *cd_size = PACK_Read64(zip64 + 40);
+        *cd_offset = PACK_Read64(zip64 + 48);
+    }
+
+    SDL_free(tail);
+    return 0;
+}
+
+static int PACK_LoadIndex(PackStorage *pack)
+{
+    Uint64 cd_offset, cd_size, cd_entries;
+    Uint8 *cd;
+    const Uint8 *ptr, *end;
+    Uint32 num_buckets = 64;
+    Uint64 i;
+
+    if (PACK_FindCentralDirectory(pack, &cd_offset, &cd_size, &cd_entries) < 0) {
+        return -1;
+    }
+    if ((cd_offset > pack->archive_size) || (cd_size > (pack->archive_size - cd_offset)) ||
+        (cd_entries > (cd_size / ZIP_CENTRAL_HEADER_SIZE))) {
+        return SDL_SetError("Pack file has a corrupt central directory");
+    }
+
+    /* Size the hash table for the files and a fair number of directories up front, so building the index doesn't rehash it */
+    while ((num_buckets < (1u << 20)) && (num_buckets < cd_entries + (cd_entries / 4))) {
+        num_buckets *= 2;
+    }
+    pack->index = SDL_CreateHashTable(NULL, num_buckets, SDL_HashString, SDL_KeyMatchString, NULL, SDL_FALSE);
+    if (!pack->index) {
+        return -1;
+    }
+
+    if (PACK_AddEntry(pack, "", 0, SDL_PATHTYPE_DIRECTORY) != 0) {
+        return -1;
+    }
+
+    if (pack->mem) {
+        cd = NULL;
+        ptr = pack->mem + cd_offset;
+    } else {
+        cd = (Uint8 *)SDL_malloc((size_t)cd_size);
+        if (!cd) {
+            return -1;
+        }
+        if (PACK_ReadAt(pack, cd_offset, cd, cd_size) < 0) {
+            SDL_free(cd);
+            return -1;
+        }
+        ptr = cd;
+    }
+    end = ptr + cd_size;
+
+    for (i = 0; i < cd_entries; ++i) {
+        if (((end - ptr) < ZIP_CENTRAL_HEADER_SIZE) || (PACK_Read32(ptr) != ZIP_CENTRAL_HEADER_SIG)) {
+            break;
+        }
+
+        const Uint16 flags = PACK_Read16(ptr + 8);
+        const Uint16 method = PACK_Read16(ptr + 10);
+        const Uint16 dostime = PACK_Read16(ptr + 12);
+        const Uint16 dosdate = PACK_Read16(ptr + 14);
+        Uint64 compressed_size = PACK_Read32(ptr + 20);
+        Uint64 size = PACK_Read32(ptr + 24);
+        const Uint16 name_len = PACK_Read16(ptr + 28);
+        const Uint16 extra_len = PACK_Read16(ptr + 30);
+        const Uint16 comment_len = PACK_Read16(ptr + 32);
+        Uint64 header_offset = PACK_Read32(ptr + 42);
+        const char *name = (const char *)(ptr + ZIP_CENTRAL_HEADER_SIZE);
+        const Uint8 *extra = ptr + ZIP_CENTRAL_HEADER_SIZE + name_len;
+        const size_t record_size = (size_t)ZIP_CENTRAL_HEADER_SIZE + name_len + extra_len + comment_len;
+        size_t len = name_len;
+        SDL_PathType type = SDL_PATHTYPE_FILE;
+
+        if ((size_t)(end - ptr) < record_size) {
+            break;
+        }
+        if (PACK_ParseZip64Extra(extra, extra_len, &size, &compressed_size, &header_offset) < 0) {
+            SDL_free(cd);
+            return -1;
+        }
+
+        while ((len > 0) && (*name == '/')) {
+            ++name;
+            --len;
+        }
+        if ((len > 0) && (name[len - 1] == '/')) {
+            type = SDL_PATHTYPE_DIRECTORY;
+            while ((len > 0) && (name[len - 1] == '/')) {
+                --len;
+            }
+        }
+
+        if (len > 0) {
+            const int index = PACK_AddEntry(pack, name, len, type);
+            if (index == PACK_NO_ENTRY) {
+                SDL_free(cd);
+                return -1;
+            }
+
+            PackEntry *entry = &pack->entries[index];
+            entry->flags = flags;
+            entry->method = method;
+            entry->size = (type == SDL_PATHTYPE_FILE) ? size : 0;
+            entry->header_offset = header_offset;
+            entry->modify_time = PACK_DosTimeToTime(dostime, dosdate);
+            if ((method == ZIP_METHOD_STORED) && (compressed_size != size)) {
+                SDL_free(cd);
+                return SDL_SetError("Pack file has a corrupt entry for '%s'", entry->path);
+            }
+        }
+
+        ptr += record_size;
+    }
+    SDL_free(cd);
+
+    if (i != cd_entries) {
+        return SDL_SetError("Pack file has a corrupt central directory");
+    }
+    return 0;
+}
+
+/* Storage paths are relative to the root of the archive, so ignore leading and trailing separators */
+static const PackEntry *PACK_LookupPath(PackStorage *pack, const char *path)
+{
+    char stackbuf[256];
+    char *key = stackbuf;
+    size_t len;
+    int index;
+
+    while (*path == '/') {
+        ++path;
+    }
+    if (path[0] == '.' && (path[1] == '\0' || path[1] == '/')) {
+        ++path;
+        while (*path == '/') {
+            ++path;
+        }
+    }
+    len = SDL_strlen(path);
+    while ((len > 0) && (path[len - 1] == '/')) {
+        --len;
+    }
+
+    if (path[len] == '\0') {
+        index = PACK_FindEntry(pack, path);
+    } else {
+        if (len >= sizeof(stackbuf)) {
+            key = (char *)SDL_malloc(len + 1);
+            if (!key) {
+                return NULL;
+            }
+        }
+        SDL_memcpy(key, path, len);
+        key[len] = '\0';
+        index = PACK_FindEntry(pack, key);
+        if (key != stackbuf) {
+            SDL_free(key);
+        }
+    }
+
+    if (index == PACK_NO_ENTRY) {
+        SDL_SetError("Can't find '%s' in pack file", path);
+        return NULL;
+    }
+    return &pack->entries[index];
+}
+
+static int PACK_CloseStorage(void *userdata)
+{
+    PackStorage *pack = (PackStorage *)userdata;
+    int result = 0;
+
+    if (pack->index) {
+        SDL_DestroyHashTable(pack->index);
+    }
+    while (pack->strings) {
+        PackStringBlock *next = pack->strings->next;
+        SDL_free(pack->strings);
+        pack->strings = next;
+    }
+    SDL_free(pack->entries);
+    if (pack->io) {
+        result = SDL_CloseIO(pack->io);
+    }
+    SDL_DestroyMutex(pack->lock);
+    SDL_free(pack);
+    return result;
+}
+
+static int PACK_EnumerateStorageDirectory(void *userdata, const char *path, SDL_EnumerateDirectoryCallback callback, void *callback_userdata)
+{
+    PackStorage *pack = (PackStorage *)userdata;
+    const PackEntry *dir = PACK_LookupPath(pack, path);
+    int child;
+
+    if (!dir) {
+        return -1;
+    }
+    if (dir->type != SDL_PATHTYPE_DIRECTORY) {
+        return SDL_SetError("'%s' is not a directory", path);
+    }
+
+    for (child = dir->first_child; child != PACK_NO_ENTRY; child = pack->entries[child].next_sibling) {
+        const int rc = callback(callback_userdata, path, pack->entries[child].name);
+        if (rc < 0) {
+            return -1;
+        } else if (rc == 0) {
+            break;
+        }
+    }
+    return 0;
+}
+
+static int PACK_GetStoragePathInfo(void *userdata, const char *path, SDL_PathInfo *info)
+{
+    PackStorage *pack = (PackStorage *)userdata;
+    const PackEntry *entry = PACK_LookupPath(pack, path);
+
+    if (!entry) {
+        return -1;
+    }
+    info->type = entry->type;
+    info->size = entry->size;
+    info->create_time = entry->modify_time;
+    info->modify_time = entry->modify_time;
+    info->access_time = entry->modify_time;
+    return 0;
+}
+
+static int PACK_ReadStorageFile(void *userdata, const char *path, void *destination, Uint64 length)
+{
+    PackStorage *pack = (PackStorage *)userdata;
+    const PackEntry *entry = PACK_LookupPath(pack, path);
+    Uint8 header[ZIP_LOCAL_HEADER_SIZE];
+
+    if (!entry) {
+        return -1;
+    }
+    if (entry->type != SDL_PATHTYPE_FILE) {
+        return SDL_SetError("'%s' is not a file", path);
+    }
+    if (entry->flags & ZIP_FLAG_ENCRYPTED) {
+        return SDL_SetError("'%s' is encrypted, which isn't supported", path);
+    }
+    if (entry->method != ZIP_METHOD_STORED) {
+        return SDL_SetError("'%s' is compressed, which isn't supported", path);
+    }
+    if (length > entry->size) {
+        return SDL_SetError("Read size exceeds file size");
+    }
+    if (length > SDL_SIZE_MAX) {
+        return SDL_SetError("Read size exceeds SDL_SIZE_MAX");
+    }
+
+    /* The local header can have a different extra field than the central directory, so it has to be read */
+    if (PACK_ReadAt(pack, entry->header_offset, header, sizeof(header)) < 0) {
+        return -1;
+    }
+    if (PACK_Read32(header) != ZIP_LOCAL_HEADER_SIG) {
+        return SDL_SetError("Pack file has a corrupt entry for '%s'", path);
+    }
+    const Uint64 data_offset = entry->header_offset + ZIP_LOCAL_HEADER_SIZE + PACK_Read16(header + 26) + PACK_Read16(header + 28);
+    return PACK_ReadAt(pack, data_offset, destination, length);
+}
+
+static const SDL_StorageInterface PACK_title_iface = {
+    PACK_CloseStorage,
+    NULL,   /* ready */
+    PACK_EnumerateStorageDirectory,
+    PACK_GetStoragePathInfo,
+    PACK_ReadStorageFile,
+    NULL,   /* write_file */
+    NULL,   /* mkdir */
+    NULL,   /* remove */
+    NULL,   /* rename */
+    NULL,   /* copy */
+    NULL    /* space_remaining */
+};
+
+static SDL_Storage *PACK_Title_Create(const char *override, SDL_PropertiesID props)
+{
+    SDL_Storage *result = NULL;
+    SDL_PathInfo info;
+    PackStorage *pack;
+
+    /* Only archives are handled here, a directory or the default title root goes to the next driver */
+    if (!override || (SDL_GetPathInfo(override, &info) < 0) || (info.type != SDL_PATHTYPE_FILE)) {
+        return NULL;
+    }
+
+    pack = (PackStorage *)SDL_calloc(1, sizeof(*pack));
+    if (!pack) {
+        return NULL;
+    }
+
+    pack->io = SDL_IOFromMappedFile(override);
+    if (!pack->io) {
+        goto failed;
+    }
+    pack->mem = (const Uint8 *)SDL_GetPointerProperty(SDL_GetIOProperties(pack->io), SDL_PROP_IOSTREAM_MEMORY_POINTER, NULL);
+    if (pack->mem) {
+        pack->archive_size = (Uint64)SDL_GetNumberProperty(SDL_GetIOProperties(pack->io), SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, 0);
+    } else {
+        const Sint64 size = SDL_GetIOSize(pack->io);
+        if (size < 0) {
+            goto failed;
+        }
+        pack->archive_size = (Uint64)size;
+
+        /* Reads can come in from the async I/O worker threads */
+        pack->lock = SDL_CreateMutex();
+        if (!pack->lock) {
+            goto failed;
+        }
+    }
+
+    if (PACK_LoadIndex(pack) < 0) {
+        goto failed;
+    }
+
+    result = SDL_OpenStorage(&PACK_title_iface, pack);
+    if (result) {
+        return result;
+    }
+
+failed:
+    PACK_CloseStorage(pack);
+    return NULL;
+}
+
+TitleStorageBootStrap PACK_titlebootstrap = {
+    "pack",
+    "SDL zip archive title storage driver",
+    PACK_Title_Create
+};
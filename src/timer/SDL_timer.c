@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_timer_c.h"
+#include "../SDL_hashtable.h"
 #include "../thread/SDL_systhread.h"
 
 /* #define DEBUG_TIMERS */
@@ -35,23 +36,17 @@ typedef struct SDL_Timer
     void *userdata;
     Uint64 interval;
     Uint64 scheduled;
+    Uint64 sequence;
     SDL_AtomicInt canceled;
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    SDL_TimerID timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
-
-/* The timers are kept in a sorted list */
+/* The timers are kept in a binary heap, ordered by scheduling time */
 typedef struct
 {
     /* Data used by the main thread */
     SDL_Thread *thread;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap;
     SDL_Mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -63,9 +58,13 @@ typedef struct
     SDL_Timer *pending;
     SDL_Timer *freelist;
     SDL_AtomicInt active;
+    SDL_AtomicInt num_canceled;
 
-    /* List of timers - this is only touched by the timer thread */
-    SDL_Timer *timers;
+    /* Heap of timers - this is only touched by the timer thread */
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+    Uint64 sequence;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -73,27 +72,107 @@ static SDL_TimerData SDL_timer_data;
 /* The idea here is that any thread might add a timer, but a single
  * thread manages the active timer queue, sorted by scheduling time.
  *
- * Timers are removed by simply setting a canceled flag
+ * Timers are removed by simply setting a canceled flag, and the timer
+ * thread drops them when they come up, or all at once if too many of
+ * them pile up in the queue.
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+static SDL_bool SDL_TimerBefore(const SDL_Timer *a, const SDL_Timer *b)
 {
-    SDL_Timer *prev, *curr;
+    /* Timers scheduled for the same time run in the order they were queued */
+    if (a->scheduled != b->scheduled) {
+        return a->scheduled < b->scheduled;
+    }
+    return a->sequence < b->sequence;
+}
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+static void SDL_SiftTimerDown(SDL_TimerData *data, int i)
+{
+    SDL_Timer **timers = data->timers;
+    SDL_Timer *timer = timers[i];
+
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= data->num_timers) {
+            break;
+        }
+        if ((child + 1 < data->num_timers) && SDL_TimerBefore(timers[child + 1], timers[child])) {
+            ++child;
+        }
+        if (!SDL_TimerBefore(timers[child], timer)) {
             break;
         }
+        timers[i] = timers[child];
+        i = child;
     }
+    timers[i] = timer;
+}
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
-    } else {
-        data->timers = timer;
+static SDL_bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+{
+    SDL_Timer **timers;
+    int i;
+
+    if (data->num_timers == data->max_timers) {
+        const int max_timers = data->max_timers ? (data->max_timers * 2) : 64;
+        timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return SDL_FALSE;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
     }
-    timer->next = curr;
+
+    timer->sequence = data->sequence++;
+
+    /* Sift the new timer up from the bottom of the heap */
+    timers = data->timers;
+    i = data->num_timers++;
+    while (i > 0) {
+        const int parent = (i - 1) / 2;
+        if (!SDL_TimerBefore(timer, timers[parent])) {
+            break;
+        }
+        timers[i] = timers[parent];
+        i = parent;
+    }
+    timers[i] = timer;
+    return SDL_TRUE;
+}
+
+static SDL_Timer *SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    SDL_Timer *timer = data->timers[0];
+
+    if (--data->num_timers > 0) {
+        data->timers[0] = data->timers[data->num_timers];
+        SDL_SiftTimerDown(data, 0);
+    }
+    return timer;
+}
+
+/* Drop all the canceled timers from the heap, returning them as a list */
+static SDL_Timer *SDL_PurgeCanceledTimers(SDL_TimerData *data)
+{
+    SDL_Timer *canceled = NULL;
+    int i, count = 0;
+
+    for (i = 0; i < data->num_timers; ++i) {
+        SDL_Timer *timer = data->timers[i];
+        if (SDL_AtomicGet(&timer->canceled)) {
+            timer->next = canceled;
+            canceled = timer;
+            SDL_AtomicAdd(&data->num_canceled, -1);
+        } else {
+            data->timers[count++] = timer;
+        }
+    }
+    data->num_timers = count;
+
+    for (i = (count / 2) - 1; i >= 0; --i) {
+        SDL_SiftTimerDown(data, i);
+    }
+    return canceled;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -101,6 +180,7 @@ static int SDLCALL SDL_TimerThread(void *_data)
     SDL_TimerData *data = (SDL_TimerData *)_data;
     SDL_Timer *pending;
     SDL_Timer *current;
+    SDL_Timer *deferred = NULL;
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
     Uint64 tick, now, interval, delay;
@@ -126,11 +206,23 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_UnlockSpinlock(&data->lock);
 
-        /* Sort the pending timers into our list */
+        /* Sort the pending timers into our heap, holding on to any we couldn't make room for */
+        if (deferred) {
+            current = deferred;
+            while (current->next) {
+                current = current->next;
+            }
+            current->next = pending;
+            pending = deferred;
+            deferred = NULL;
+        }
         while (pending) {
             current = pending;
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+            if (!SDL_AddTimerInternal(data, current)) {
+                current->next = deferred;
+                deferred = current;
+            }
         }
         freelist_head = NULL;
         freelist_tail = NULL;
@@ -140,23 +232,31 @@ static int SDLCALL SDL_TimerThread(void *_data)
             break;
         }
 
+        /* Don't let canceled timers pile up when they're scheduled far in the future */
+        if (SDL_AtomicGet(&data->num_canceled) > SDL_max(data->num_timers / 2, 64)) {
+            freelist_head = SDL_PurgeCanceledTimers(data);
+            for (current = freelist_head; current; current = current->next) {
+                freelist_tail = current;
+            }
+        }
+
         /* Initial delay if there are no timers */
-        delay = (Uint64)-1;
+        delay = deferred ? SDL_NS_PER_MS : (Uint64)-1;
 
         tick = SDL_GetTicksNS();
 
         /* Process all the pending timers for this tick */
-        while (data->timers) {
-            current = data->timers;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
             if (tick < current->scheduled) {
                 /* Scheduled for the future, wait a bit */
-                delay = (current->scheduled - tick);
+                delay = SDL_min(delay, current->scheduled - tick);
                 break;
             }
 
             /* We're going to do something with this timer */
-            data->timers = current->next;
+            SDL_RemoveFirstTimer(data);
 
             if (SDL_AtomicGet(&current->canceled)) {
                 interval = 0;
@@ -172,8 +272,12 @@ static int SDLCALL SDL_TimerThread(void *_data)
                 /* Reschedule this timer */
                 current->interval = interval;
                 current->scheduled = tick + interval;
-                SDL_AddTimerInternal(data, current);
+                if (!SDL_AddTimerInternal(data, current)) {
+                    current->next = deferred;
+                    deferred = current;
+                }
             } else {
+                current->next = NULL;
                 if (!freelist_head) {
                     freelist_head = current;
                 }
@@ -182,7 +286,10 @@ static int SDLCALL SDL_TimerThread(void *_data)
                 }
                 freelist_tail = current;
 
-                SDL_AtomicSet(&current->canceled, 1);
+                /* If it was removed, before or during its callback, it was counted as canceled */
+                if (!SDL_AtomicCompareAndSwap(&current->canceled, 0, 1)) {
+                    SDL_AtomicAdd(&data->num_canceled, -1);
+                }
             }
         }
 
@@ -202,6 +309,17 @@ static int SDLCALL SDL_TimerThread(void *_data)
          */
         SDL_WaitSemaphoreTimeoutNS(data->sem, delay);
     }
+
+    /* Anything we were still holding on to gets cleaned up with the rest */
+    SDL_LockSpinlock(&data->lock);
+    while (deferred) {
+        current = deferred;
+        deferred = current->next;
+        current->next = data->freelist;
+        data->freelist = current;
+    }
+    SDL_UnlockSpinlock(&data->lock);
+
     return 0;
 }
 
@@ -216,13 +334,22 @@ int SDL_InitTimers(void)
             return -1;
         }
 
+        /* Every access is under timermap_lock, so the map can grow with the number of timers */
+        data->timermap = SDL_CreateGrowableHashTable(NULL, 64, SDL_HashID, SDL_KeyMatchID, NULL, SDL_FALSE);
+        if (!data->timermap) {
+            SDL_DestroyMutex(data->timermap_lock);
+            return -1;
+        }
+
         data->sem = SDL_CreateSemaphore(0);
         if (!data->sem) {
+            SDL_DestroyHashTable(data->timermap);
             SDL_DestroyMutex(data->timermap_lock);
             return -1;
         }
 
         SDL_AtomicSet(&data->active, 1);
+        SDL_AtomicSet(&data->num_canceled, 0);
 
         /* Timer threads use a callback into the app, so we can't set a limited stack size here. */
         data->thread = SDL_CreateThread(SDL_TimerThread, name, data);
@@ -238,7 +365,7 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (SDL_AtomicCompareAndSwap(&data->active, 1, 0)) { /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -252,9 +379,16 @@ void SDL_QuitTimers(void)
         data->sem = NULL;
 
         /* Clean up the timer entries */
-        while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
+        for (i = 0; i < data->num_timers; ++i) {
+            SDL_free(data->timers[i]);
+        }
+        SDL_free(data->timers);
+        data->timers = NULL;
+        data->num_timers = 0;
+        data->max_timers = 0;
+        while (data->pending) {
+            timer = data->pending;
+            data->pending = timer->next;
             SDL_free(timer);
         }
         while (data->freelist) {
@@ -262,22 +396,34 @@ void SDL_QuitTimers(void)
             data->freelist = timer->next;
             SDL_free(timer);
         }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
-        }
+
+        SDL_DestroyHashTable(data->timermap);
+        data->timermap = NULL;
 
         SDL_DestroyMutex(data->timermap_lock);
         data->timermap_lock = NULL;
     }
 }
 
+/* Forget about a timer ID, returning the timer it was mapped to */
+static SDL_Timer *SDL_UnmapTimer(SDL_TimerData *data, SDL_TimerID id)
+{
+    const void *value = NULL;
+
+    SDL_LockMutex(data->timermap_lock);
+    if (SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, &value)) {
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
+    }
+    SDL_UnlockMutex(data->timermap_lock);
+
+    return (SDL_Timer *)value;
+}
+
 static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *userdata)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    SDL_bool mapped;
 
     if (!callback_ms && !callback_ns) {
         SDL_InvalidParamError("callback");
@@ -299,7 +445,8 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     SDL_UnlockSpinlock(&data->lock);
 
     if (timer) {
-        SDL_RemoveTimer(timer->timerID);
+        /* The ID of a timer that finished on its own is still mapped */
+        SDL_UnmapTimer(data, timer->timerID);
     } else {
         timer = (SDL_Timer *)SDL_malloc(sizeof(*timer));
         if (!timer) {
@@ -314,18 +461,14 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
     SDL_AtomicSet(&timer->canceled, 0);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
+    SDL_LockMutex(data->timermap_lock);
+    mapped = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, timer);
+    SDL_UnlockMutex(data->timermap_lock);
+
+    if (!mapped) {
         SDL_free(timer);
         return 0;
     }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
-    SDL_UnlockMutex(data->timermap_lock);
 
     /* Add the timer to the pending list for the timer thread */
     SDL_LockSpinlock(&data->lock);
@@ -336,7 +479,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     /* Wake up the timer thread if necessary */
     SDL_SignalSemaphore(data->sem);
 
-    return entry->timerID;
+    return timer->timerID;
 }
 
 SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *userdata)
@@ -352,34 +495,19 @@ SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *
 int SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_Timer *timer;
     SDL_bool canceled = SDL_FALSE;
 
     if (!id) {
         return SDL_InvalidParamError("id");
     }
 
-    /* Find the timer */
-    SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
-    }
-    SDL_UnlockMutex(data->timermap_lock);
-
-    if (entry) {
-        if (!SDL_AtomicGet(&entry->timer->canceled)) {
-            SDL_AtomicSet(&entry->timer->canceled, 1);
+    timer = SDL_UnmapTimer(data, id);
+    if (timer) {
+        if (SDL_AtomicCompareAndSwap(&timer->canceled, 0, 1)) {
+            SDL_AtomicIncRef(&data->num_canceled);
             canceled = SDL_TRUE;
         }
-        SDL_free(entry);
     }
     if (canceled) {
         return 0;
@@ -646,23 +774,57 @@ void SDL_Delay(Uint32 ms)
     SDL_SYS_DelayNS(SDL_MS_TO_NS(ms));
 }
 
+/* Precise delays sleep until shortly before the deadline and then spin, and how
+   far ahead of the deadline to wake up is learned from how late the OS actually
+   wakes us up. It goes up quickly when wakeups are late and comes down slowly,
+   but a single late wakeup can at most double it, so one scheduling hiccup
+   doesn't turn into milliseconds of spinning on every delay that follows.
+ */
+#define MIN_DELAY_MARGIN_NS     (20 * SDL_NS_PER_US)
+#define MAX_DELAY_MARGIN_NS     (4 * SDL_NS_PER_MS)
+#define INITIAL_DELAY_MARGIN_NS (1 * SDL_NS_PER_MS)
+
+static SDL_AtomicInt delay_margin_ns;
+
+static Uint64 SDL_UpdateDelayMargin(Uint64 margin, Uint64 late)
+{
+    const Uint64 target = late + (late / 2) + MIN_DELAY_MARGIN_NS;
+
+    if (target > margin) {
+        margin += SDL_min((target - margin) / 4 + 1, margin);
+    } else {
+        margin -= (margin - target) / 16;
+    }
+    margin = SDL_clamp(margin, MIN_DELAY_MARGIN_NS, MAX_DELAY_MARGIN_NS);
+    SDL_AtomicSet(&delay_margin_ns, (int)margin);
+    return margin;
+}
+
 void SDL_DelayNS(Uint64 ns)
 {
-    Uint64 current_value = SDL_GetTicksNS();
-    Uint64 target_value = current_value + ns;
-
-    // Sleep for a short number of cycles
-    // We'll use 1 ms as a scheduling timeslice, it's a good value for modern operating systems
-    const int SCHEDULING_TIMESLICE_NS = 1 * SDL_NS_PER_MS;
-    while (current_value < target_value) {
-        Uint64 remaining_ns = (target_value - current_value);
-        if (remaining_ns > (SCHEDULING_TIMESLICE_NS + SDL_NS_PER_US)) {
-            // Sleep for a short time, less than the scheduling timeslice
-            SDL_SYS_DelayNS(SCHEDULING_TIMESLICE_NS - SDL_NS_PER_US);
+    SDL_DelayUntilNS(SDL_GetTicksNS() + ns);
+}
+
+void SDL_DelayUntilNS(Uint64 deadline)
+{
+    Uint64 now = SDL_GetTicksNS();
+    Uint64 margin = (Uint64)SDL_AtomicGet(&delay_margin_ns);
+
+    if (!margin) {
+        margin = INITIAL_DELAY_MARGIN_NS;
+    }
+
+    while (now < deadline) {
+        if ((deadline - now) > margin) {
+            const Uint64 wakeup = deadline - margin;
+
+            SDL_SYS_DelayNS(wakeup - now);
+            now = SDL_GetTicksNS();
+            margin = SDL_UpdateDelayMargin(margin, (now > wakeup) ? (now - wakeup) : 0);
         } else {
             // Spin for any remaining time
             SDL_CPUPauseInstruction();
+            now = SDL_GetTicksNS();
         }
-        current_value = SDL_GetTicksNS();
     }
 }
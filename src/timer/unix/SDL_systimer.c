@@ -154,6 +154,27 @@ void SDL_SYS_DelayNS(Uint64 ns)
     }
 #endif
 
+#if defined(HAVE_CLOCK_NANOSLEEP) && defined(HAVE_CLOCK_GETTIME)
+    /* Sleep until an absolute time, so being interrupted by signals doesn't add up to extra delay */
+    {
+        struct timespec deadline;
+        if (clock_gettime(CLOCK_MONOTONIC, &deadline) == 0) {
+            deadline.tv_sec += (time_t)(ns / SDL_NS_PER_SECOND);
+            deadline.tv_nsec += (long)(ns % SDL_NS_PER_SECOND);
+            if (deadline.tv_nsec >= SDL_NS_PER_SECOND) {
+                deadline.tv_sec += 1;
+                deadline.tv_nsec -= SDL_NS_PER_SECOND;
+            }
+            do {
+                was_error = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+            } while (was_error == EINTR);
+            if (was_error == 0) {
+                return;
+            }
+        }
+    }
+#endif
+
     /* Set the timeout interval */
 #ifdef HAVE_NANOSLEEP
     remaining.tv_sec = (time_t)(ns / SDL_NS_PER_SECOND);
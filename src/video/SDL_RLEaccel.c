@@ -85,6 +85,10 @@
  *
  *   The end of the sequence is marked by a zero <skip>,<run> pair at the
  *   beginning of an opaque line.
+ *
+ *   Surfaces with premultiplied alpha use the same encoding, for 32 bit
+ *   targets only. Completely transparent pixels are skipped, so any color
+ *   they would add to the destination is dropped.
  */
 
 #include "SDL_sysvideo.h"
@@ -604,17 +608,292 @@ done:
         dst = (Uint16)(d | d >> 16);       \
     } while (0)
 
+/*
+ * For premultiplied alpha 32bpp pixels, blend all four bytes the same way
+ * the generic premultiplied blitters do, and keep only the channels that
+ * exist in the destination.
+ */
+#define BLIT_TRANSL_888_PREMULTIPLIED(src, dst, mask)                             \
+    do {                                                                          \
+        Uint32 s = src;                                                           \
+        Uint32 d = dst;                                                           \
+        unsigned inva = 255 - (s >> 24);                                          \
+        Uint32 d02 = (d & 0x00ff00ff) * inva + 0x00010001;                        \
+        Uint32 d13 = ((d >> 8) & 0x00ff00ff) * inva + 0x00010001;                 \
+        d02 = ((d02 + ((d02 >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;              \
+        d13 = ((d13 + ((d13 >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;              \
+        d02 += s & 0x00ff00ff;                                                    \
+        d13 += (s >> 8) & 0x00ff00ff;                                             \
+        d02 = (d02 | (((d02 >> 8) & 0x00010001) * 0xff)) & 0x00ff00ff;            \
+        d13 = (d13 | (((d13 >> 8) & 0x00010001) * 0xff)) & 0x00ff00ff;            \
+        dst = (d02 | (d13 << 8)) & (mask);                                        \
+    } while (0)
+
+/* Blend a run of translucent 32bpp pixels, mask is the destination channel mask */
+typedef void (*RLETranslRunFunc)(Uint32 *dst, const Uint32 *src, int n, Uint32 mask);
+
+static void BlitTranslRun888(Uint32 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    int i;
+
+    (void)mask;
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_888(src[i], dst[i]);
+    }
+}
+
+static void BlitTranslRun888Premultiplied(Uint32 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    int i;
+
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_888_PREMULTIPLIED(src[i], dst[i], mask);
+    }
+}
+
+#if defined(SDL_SSE2_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+
+static void SDL_TARGETING("sse2") BlitTranslRun888SSE2(Uint32 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    const __m128i alpha_fill = _mm_set1_epi32((int)0xff000000);
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+
+        __m128i s_lo = _mm_unpacklo_epi8(s, _mm_setzero_si128());
+        __m128i s_hi = _mm_unpackhi_epi8(s, _mm_setzero_si128());
+        __m128i d_lo = _mm_unpacklo_epi8(d, _mm_setzero_si128());
+        __m128i d_hi = _mm_unpackhi_epi8(d, _mm_setzero_si128());
+
+        // Splat the alpha in the top byte into all the channels
+        __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, 0xff), 0xff);
+        __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, 0xff), 0xff);
+
+        // dst = (src * alpha + dst * (256 - alpha)) >> 8
+        d_lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s_lo, a_lo),
+                                            _mm_mullo_epi16(d_lo, _mm_sub_epi16(_mm_set1_epi16(256), a_lo))), 8);
+        d_hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s_hi, a_hi),
+                                            _mm_mullo_epi16(d_hi, _mm_sub_epi16(_mm_set1_epi16(256), a_hi))), 8);
+
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_packus_epi16(d_lo, d_hi), alpha_fill));
+    }
+
+    BlitTranslRun888(dst + i, src + i, n - i, mask);
+}
+
+static void SDL_TARGETING("sse2") BlitTranslRun888PremultipliedSSE2(Uint32 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    const __m128i channel_mask = _mm_set1_epi32((int)mask);
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+
+        __m128i s_lo = _mm_unpacklo_epi8(s, _mm_setzero_si128());
+        __m128i s_hi = _mm_unpackhi_epi8(s, _mm_setzero_si128());
+        __m128i d_lo = _mm_unpacklo_epi8(d, _mm_setzero_si128());
+        __m128i d_hi = _mm_unpackhi_epi8(d, _mm_setzero_si128());
+
+        // Splat 255 - alpha into all the channels
+        __m128i inva_lo = _mm_sub_epi16(_mm_set1_epi16(255), _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, 0xff), 0xff));
+        __m128i inva_hi = _mm_sub_epi16(_mm_set1_epi16(255), _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, 0xff), 0xff));
+
+        // dst = dst * (255 - alpha) + 1
+        d_lo = _mm_add_epi16(_mm_mullo_epi16(d_lo, inva_lo), _mm_set1_epi16(1));
+        d_hi = _mm_add_epi16(_mm_mullo_epi16(d_hi, inva_hi), _mm_set1_epi16(1));
+
+        // dst = (dst + (dst >> 8)) >> 8
+        d_lo = _mm_srli_epi16(_mm_add_epi16(d_lo, _mm_srli_epi16(d_lo, 8)), 8);
+        d_hi = _mm_srli_epi16(_mm_add_epi16(d_hi, _mm_srli_epi16(d_hi, 8)), 8);
+
+        // dst = min(src + dst, 255)
+        d = _mm_adds_epu8(_mm_packus_epi16(d_lo, d_hi), s);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_and_si128(d, channel_mask));
+    }
+
+    BlitTranslRun888Premultiplied(dst + i, src + i, n - i, mask);
+}
+
+#endif
+
+#if defined(SDL_AVX2_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+
+static void SDL_TARGETING("avx2") BlitTranslRun888AVX2(Uint32 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    const __m256i alpha_fill = _mm256_set1_epi32((int)0xff000000);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+
+        __m256i s_lo = _mm256_unpacklo_epi8(s, _mm256_setzero_si256());
+        __m256i s_hi = _mm256_unpackhi_epi8(s, _mm256_setzero_si256());
+        __m256i d_lo = _mm256_unpacklo_epi8(d, _mm256_setzero_si256());
+        __m256i d_hi = _mm256_unpackhi_epi8(d, _mm256_setzero_si256());
+
+        // Splat the alpha in the top byte into all the channels
+        __m256i a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, 0xff), 0xff);
+        __m256i a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, 0xff), 0xff);
+
+        // dst = (src * alpha + dst * (256 - alpha)) >> 8
+        d_lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(s_lo, a_lo),
+                                                  _mm256_mullo_epi16(d_lo, _mm256_sub_epi16(_mm256_set1_epi16(256), a_lo))), 8);
+        d_hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(s_hi, a_hi),
+                                                  _mm256_mullo_epi16(d_hi, _mm256_sub_epi16(_mm256_set1_epi16(256), a_hi))), 8);
+
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(_mm256_packus_epi16(d_lo, d_hi), alpha_fill));
+    }
+
+    BlitTranslRun888(dst + i, src + i, n - i, mask);
+}
+
+static void SDL_TARGETING("avx2") BlitTranslRun888PremultipliedAVX2(Uint32 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    const __m256i channel_mask = _mm256_set1_epi32((int)mask);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+
+        __m256i s_lo = _mm256_unpacklo_epi8(s, _mm256_setzero_si256());
+        __m256i s_hi = _mm256_unpackhi_epi8(s, _mm256_setzero_si256());
+        __m256i d_lo = _mm256_unpacklo_epi8(d, _mm256_setzero_si256());
+        __m256i d_hi = _mm256_unpackhi_epi8(d, _mm256_setzero_si256());
+
+        // Splat 255 - alpha into all the channels
+        __m256i inva_lo = _mm256_sub_epi16(_mm256_set1_epi16(255), _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, 0xff), 0xff));
+        __m256i inva_hi = _mm256_sub_epi16(_mm256_set1_epi16(255), _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, 0xff), 0xff));
+
+        // dst = dst * (255 - alpha) + 1
+        d_lo = _mm256_add_epi16(_mm256_mullo_epi16(d_lo, inva_lo), _mm256_set1_epi16(1));
+        d_hi = _mm256_add_epi16(_mm256_mullo_epi16(d_hi, inva_hi), _mm256_set1_epi16(1));
+
+        // dst = (dst + (dst >> 8)) >> 8
+        d_lo = _mm256_srli_epi16(_mm256_add_epi16(d_lo, _mm256_srli_epi16(d_lo, 8)), 8);
+        d_hi = _mm256_srli_epi16(_mm256_add_epi16(d_hi, _mm256_srli_epi16(d_hi, 8)), 8);
+
+        // dst = min(src + dst, 255)
+        d = _mm256_adds_epu8(_mm256_packus_epi16(d_lo, d_hi), s);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_and_si256(d, channel_mask));
+    }
+
+    BlitTranslRun888Premultiplied(dst + i, src + i, n - i, mask);
+}
+
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+
+static void BlitTranslRun888NEON(Uint32 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        // vld4 splits the pixels into one plane per byte, the alpha is in plane 3
+        uint8x8x4_t s = vld4_u8((const Uint8 *)(src + i));
+        uint8x8x4_t d = vld4_u8((const Uint8 *)(dst + i));
+        uint8x8_t a = s.val[3];
+        uint8x8_t inva = vsub_u8(vdup_n_u8(0), a); /* 256 - alpha, alpha is never 0 here */
+        int c;
+
+        // dst = (src * alpha + dst * (256 - alpha)) >> 8
+        for (c = 0; c < 3; ++c) {
+            d.val[c] = vshrn_n_u16(vmlal_u8(vmull_u8(s.val[c], a), d.val[c], inva), 8);
+        }
+        d.val[3] = vdup_n_u8(0xff);
+
+        vst4_u8((Uint8 *)(dst + i), d);
+    }
+
+    BlitTranslRun888(dst + i, src + i, n - i, mask);
+}
+
+static void BlitTranslRun888PremultipliedNEON(Uint32 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    const uint8x16_t channel_mask = vreinterpretq_u8_u32(vdupq_n_u32(mask));
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        uint8x16_t s = vld1q_u8((const Uint8 *)(src + i));
+        uint8x16_t d = vld1q_u8((const Uint8 *)(dst + i));
+
+        // Splat 255 - alpha into all the channels
+        uint8x16_t inva = vmvnq_u8(vreinterpretq_u8_u32(vmulq_n_u32(vshrq_n_u32(vreinterpretq_u32_u8(s), 24), 0x01010101)));
+
+        // dst = dst * (255 - alpha) + 1, then (dst + (dst >> 8)) >> 8
+        uint16x8_t d_lo = vaddq_u16(vmull_u8(vget_low_u8(d), vget_low_u8(inva)), vdupq_n_u16(1));
+        uint16x8_t d_hi = vaddq_u16(vmull_u8(vget_high_u8(d), vget_high_u8(inva)), vdupq_n_u16(1));
+        d = vcombine_u8(vshrn_n_u16(vsraq_n_u16(d_lo, d_lo, 8), 8),
+                        vshrn_n_u16(vsraq_n_u16(d_hi, d_hi, 8), 8));
+
+        // dst = min(src + dst, 255)
+        vst1q_u8((Uint8 *)(dst + i), vandq_u8(vqaddq_u8(d, s), channel_mask));
+    }
+
+    BlitTranslRun888Premultiplied(dst + i, src + i, n - i, mask);
+}
+
+#endif
+
+static RLETranslRunFunc ChooseTranslRun888(SDL_bool premultiplied)
+{
+#if defined(SDL_AVX2_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    if (SDL_HasAVX2()) {
+        return premultiplied ? BlitTranslRun888PremultipliedAVX2 : BlitTranslRun888AVX2;
+    }
+#endif
+#if defined(SDL_SSE2_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    if (SDL_HasSSE2()) {
+        return premultiplied ? BlitTranslRun888PremultipliedSSE2 : BlitTranslRun888SSE2;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    if (SDL_HasNEON()) {
+        return premultiplied ? BlitTranslRun888PremultipliedNEON : BlitTranslRun888NEON;
+    }
+#endif
+    return premultiplied ? BlitTranslRun888Premultiplied : BlitTranslRun888;
+}
+
+/* Blend runs of translucent 16bpp pixels */
+#define BLIT_TRANSL_RUN_565(src, dst, n)        \
+    do {                                        \
+        unsigned i;                             \
+        for (i = 0; i < (n); i++) {             \
+            BLIT_TRANSL_565(src[i], dst[i]);    \
+        }                                       \
+    } while (0)
+
+#define BLIT_TRANSL_RUN_555(src, dst, n)        \
+    do {                                        \
+        unsigned i;                             \
+        for (i = 0; i < (n); i++) {             \
+            BLIT_TRANSL_555(src[i], dst[i]);    \
+        }                                       \
+    } while (0)
+
+/* 32bpp runs use the blender chosen when the blit starts */
+#define BLIT_TRANSL_RUN_888(src, dst, n) \
+    transl_run(dst, src, (int)(n), dst_mask)
+
 /* blit a pixel-alpha RLE surface clipped at the right and/or left edges */
 static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
-                             Uint8 *dstbuf, const SDL_Rect *srcrect)
+                             Uint8 *dstbuf, const SDL_Rect *srcrect,
+                             RLETranslRunFunc transl_run)
 {
     const SDL_PixelFormatDetails *df = surf_dst->internal->format;
+    const Uint32 dst_mask = df->Rmask | df->Gmask | df->Bmask | df->Amask;
     /*
      * clipped blitter: Ptype is the destination pixel type,
-     * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * Ctype the translucent count type, and do_blend_run the macro
+     * to blend a run of pixels.
      */
-#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)                          \
+#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend_run)                      \
     do {                                                                  \
         int linecount = srcrect->h;                                       \
         int left = srcrect->x;                                            \
@@ -670,9 +949,7 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                     if (crun > 0) {                                       \
                         Ptype *dst = (Ptype *)dstbuf + cofs;              \
                         Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);    \
-                        int i;                                            \
-                        for (i = 0; i < crun; i++)                        \
-                            do_blend(src[i], dst[i]);                     \
+                        do_blend_run(src, dst, (unsigned)crun);           \
                     }                                                     \
                     srcbuf += run * 4;                                    \
                     ofs += run;                                           \
@@ -685,13 +962,13 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
     switch (df->bytes_per_pixel) {
     case 2:
         if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_RUN_565);
         } else {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_RUN_555);
         }
         break;
     case 4:
-        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_RUN_888);
         break;
     }
 }
@@ -704,6 +981,8 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
     int w = surf_src->w;
     Uint8 *srcbuf, *dstbuf;
     const SDL_PixelFormatDetails *df = surf_dst->internal->format;
+    const Uint32 dst_mask = df->Rmask | df->Gmask | df->Bmask | df->Amask;
+    RLETranslRunFunc transl_run = ChooseTranslRun888((surf_src->internal->map.info.flags & SDL_COPY_BLEND_PREMULTIPLIED) != 0);
 
     /* Lock the destination if necessary */
     if (SDL_MUSTLOCK(surf_dst)) {
@@ -777,15 +1056,15 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
 
     /* if left or right edge clipping needed, call clip blit */
     if (srcrect->x || srcrect->w != surf_src->w) {
-        RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect);
+        RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect, transl_run);
     } else {
 
         /*
          * non-clipped blitter. Ptype is the destination pixel type,
-         * Ctype the translucent count type, and do_blend the
-         * macro to blend one pixel.
+         * Ctype the translucent count type, and do_blend_run the
+         * macro to blend a run of pixels.
          */
-#define RLEALPHABLIT(Ptype, Ctype, do_blend)                         \
+#define RLEALPHABLIT(Ptype, Ctype, do_blend_run)                     \
     do {                                                             \
         int linecount = srcrect->h;                                  \
         do {                                                         \
@@ -816,13 +1095,9 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
                 srcbuf += 4;                                         \
                 if (run) {                                           \
                     Ptype *dst = (Ptype *)dstbuf + ofs;              \
-                    unsigned i;                                      \
-                    for (i = 0; i < run; i++) {                      \
-                        Uint32 src = *(Uint32 *)srcbuf;              \
-                        do_blend(src, *dst);                         \
-                        srcbuf += 4;                                 \
-                        dst++;                                       \
-                    }                                                \
+                    Uint32 *src = (Uint32 *)srcbuf;                  \
+                    do_blend_run(src, dst, run);                     \
+                    srcbuf += run * 4;                               \
                     ofs += run;                                      \
                 }                                                    \
             } while (ofs < w);                                       \
@@ -833,13 +1108,13 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
         switch (df->bytes_per_pixel) {
         case 2:
             if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_RUN_565);
             } else {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_RUN_555);
             }
             break;
         case 4:
-            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888);
+            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_RUN_888);
             break;
         }
     }
@@ -1016,6 +1291,9 @@ static int RLEAlphaSurface(SDL_Surface *surface)
     masksum = df->Rmask | df->Gmask | df->Bmask;
     switch (df->bytes_per_pixel) {
     case 2:
+        if (surface->internal->map.info.flags & SDL_COPY_BLEND_PREMULTIPLIED) {
+            return -1; /* premultiplied alpha needs the full 8 bit alpha */
+        }
         /* 16bpp: only support 565 and 555 formats */
         switch (masksum) {
         case 0xffff:
@@ -1390,7 +1668,7 @@ int SDL_RLESurface(SDL_Surface *surface)
     flags = surface->internal->map.info.flags;
     if (flags & SDL_COPY_COLORKEY) {
         /* ok */
-    } else if ((flags & SDL_COPY_BLEND) && SDL_ISPIXELFORMAT_ALPHA(surface->format)) {
+    } else if ((flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED)) && SDL_ISPIXELFORMAT_ALPHA(surface->format)) {
         /* ok */
     } else {
         /* If we don't have colorkey or blending, nothing to do... */
@@ -1400,13 +1678,14 @@ int SDL_RLESurface(SDL_Surface *surface)
     /* Pass on combinations not supported */
     if ((flags & SDL_COPY_MODULATE_COLOR) ||
         ((flags & SDL_COPY_MODULATE_ALPHA) && SDL_ISPIXELFORMAT_ALPHA(surface->format)) ||
-        (flags & (SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_ADD_PREMULTIPLIED | SDL_COPY_MOD | SDL_COPY_MUL)) ||
+        ((flags & SDL_COPY_BLEND_PREMULTIPLIED) && !SDL_ISPIXELFORMAT_ALPHA(surface->format)) ||
+        (flags & (SDL_COPY_ADD | SDL_COPY_ADD_PREMULTIPLIED | SDL_COPY_MOD | SDL_COPY_MUL)) ||
         (flags & SDL_COPY_NEAREST)) {
         return -1;
     }
 
     /* Encode and set up the blit */
-    if (!SDL_ISPIXELFORMAT_ALPHA(surface->format) || !(flags & SDL_COPY_BLEND)) {
+    if (!SDL_ISPIXELFORMAT_ALPHA(surface->format) || !(flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED))) {
         if (!surface->internal->map.identity) {
             return -1;
         }
@@ -1414,12 +1693,14 @@ int SDL_RLESurface(SDL_Surface *surface)
             return -1;
         }
         surface->internal->map.blit = SDL_RLEBlit;
+        surface->internal->map.blit_name = "SDL_RLEBlit";
         surface->internal->map.info.flags |= SDL_COPY_RLE_COLORKEY;
     } else {
         if (RLEAlphaSurface(surface) < 0) {
             return -1;
         }
         surface->internal->map.blit = SDL_RLEAlphaBlit;
+        surface->internal->map.blit_name = "SDL_RLEAlphaBlit";
         surface->internal->map.info.flags |= SDL_COPY_RLE_ALPHAKEY;
     }
 
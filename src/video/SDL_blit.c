@@ -91,7 +91,7 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
         SDL_UnlockSurface(dst);
     }
     if (src_locked) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceReadOnly(src);
     }
     /* Blit is done! */
     return okay ? 0 : -1;
@@ -122,8 +122,8 @@ static SDL_bool SDL_UseAltivecPrefetch(void)
 }
 #endif /* SDL_PLATFORM_MACOS */
 
-static SDL_BlitFunc SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelFormat dst_format, int flags,
-                                       SDL_BlitFuncEntry *entries)
+static const SDL_BlitFuncEntry *SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelFormat dst_format, int flags,
+                                                   const SDL_BlitFuncEntry *entries)
 {
     int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_ADD_PREMULTIPLIED | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
     static unsigned int features = 0x7fffffff;
@@ -169,7 +169,7 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelForm
         }
 
         /* We found the best one! */
-        return entries[i].func;
+        return &entries[i];
     }
     return NULL;
 }
@@ -197,6 +197,7 @@ int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
 #endif
 
     map->blit = SDL_SoftBlit;
+    map->blit_name = NULL;
     map->info.src_surface = surface;
     map->info.src_fmt = surface->internal->format;
     map->info.src_pal = surface->internal->palette;
@@ -218,15 +219,15 @@ int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
         if (src_colorspace != dst_colorspace ||
             SDL_BYTESPERPIXEL(surface->format) > 4 ||
             SDL_BYTESPERPIXEL(dst->format) > 4) {
-            blit = SDL_Blit_Slow_Float;
+            blit = SDL_CHOOSE_BLIT(surface, SDL_Blit_Slow_Float);
         }
     }
     if (!blit) {
         if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
-            blit = SDL_BlitCopy;
+            blit = SDL_CHOOSE_BLIT(surface, SDL_BlitCopy);
         } else if (SDL_ISPIXELFORMAT_10BIT(surface->format) ||
                    SDL_ISPIXELFORMAT_10BIT(dst->format)) {
-            blit = SDL_Blit_Slow;
+            blit = SDL_CHOOSE_BLIT(surface, SDL_Blit_Slow);
         }
 #if SDL_HAVE_BLIT_0
         else if (SDL_BITSPERPIXEL(surface->format) < 8 &&
@@ -241,7 +242,7 @@ int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
         }
 #endif
 #if SDL_HAVE_BLIT_A
-        else if (map->info.flags & SDL_COPY_BLEND) {
+        else if (map->info.flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED)) {
             blit = SDL_CalculateBlitA(surface);
         }
 #endif
@@ -255,10 +256,14 @@ int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
     if (!blit) {
         SDL_PixelFormat src_format = surface->format;
         SDL_PixelFormat dst_format = dst->format;
-
-        blit =
+        const SDL_BlitFuncEntry *entry =
             SDL_ChooseBlitFunc(src_format, dst_format, map->info.flags,
                                SDL_GeneratedBlitFuncTable);
+
+        if (entry) {
+            blit = entry->func;
+            map->blit_name = entry->name;
+        }
     }
 #endif
 
@@ -275,7 +280,7 @@ int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
             (!SDL_ISPIXELFORMAT_INDEXED(dst_format) ||
              (dst_format == SDL_PIXELFORMAT_INDEX8 && dst->internal->palette)) &&
             !SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
-            blit = SDL_Blit_Slow;
+            blit = SDL_CHOOSE_BLIT(surface, SDL_Blit_Slow);
         }
     }
     map->data = (void *)blit;
@@ -288,3 +293,71 @@ int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
 
     return 0;
 }
+
+void SDL_AddBlitFuncEntry(SDL_BlitFuncEntry *entries, int max, int *count, SDL_PixelFormat src_format, SDL_PixelFormat dst_format, int flags, SDL_BlitFunc func, const char *name)
+{
+    if (*count < max) {
+        SDL_BlitFuncEntry *entry = &entries[*count];
+
+        entry->src_format = src_format;
+        entry->dst_format = dst_format;
+        entry->flags = flags;
+        entry->cpu = SDL_CPU_ANY;
+        entry->func = func;
+        entry->name = name;
+    }
+    ++*count;
+}
+
+static int SDLCALL SDL_EnumerateBlitFuncTables(SDL_BlitFuncEntry *entries, int max)
+{
+    static const SDL_PixelFormat slow_formats[] = {
+        SDL_PIXELFORMAT_XRGB2101010, SDL_PIXELFORMAT_ARGB2101010,
+        SDL_PIXELFORMAT_RGBA64, SDL_PIXELFORMAT_RGBA128_FLOAT
+    };
+    int i, count = 0;
+
+#if SDL_HAVE_BLIT_AUTO
+    for (i = 0; SDL_GeneratedBlitFuncTable[i].func; ++i) {
+        const SDL_BlitFuncEntry *entry = &SDL_GeneratedBlitFuncTable[i];
+
+        SDL_AddBlitFuncEntry(entries, max, &count, entry->src_format, entry->dst_format, entry->flags, entry->func, entry->name);
+    }
+#endif
+#if SDL_HAVE_BLIT_0
+    SDL_EnumerateBlit0(entries, max, &count);
+#endif
+#if SDL_HAVE_BLIT_1
+    SDL_EnumerateBlit1(entries, max, &count);
+#endif
+#if SDL_HAVE_BLIT_A
+    SDL_EnumerateBlitA(entries, max, &count);
+#endif
+#if SDL_HAVE_BLIT_N
+    SDL_EnumerateBlitN(entries, max, &count);
+#endif
+
+    /* Formats that are only handled by the generic blitters */
+    for (i = 0; i < SDL_arraysize(slow_formats); ++i) {
+        SDL_PixelFormat format = slow_formats[i];
+        SDL_BlitFunc func = SDL_BYTESPERPIXEL(format) > 4 ? SDL_Blit_Slow_Float : SDL_Blit_Slow;
+        const char *name = SDL_BYTESPERPIXEL(format) > 4 ? "SDL_Blit_Slow_Float" : "SDL_Blit_Slow";
+
+        SDL_AddBlitFuncEntry(entries, max, &count, format, SDL_PIXELFORMAT_UNKNOWN, 0, func, name);
+        SDL_AddBlitFuncEntry(entries, max, &count, SDL_PIXELFORMAT_UNKNOWN, format, 0, func, name);
+    }
+    return count;
+}
+
+void SDL_ReportBlitFunc(SDL_Surface *surface, const char *name)
+{
+    SDL_SurfaceData *internal = surface->internal;
+
+    if (internal->props && name != internal->reported_blit) {
+        if (!internal->reported_blit) {
+            SDL_SetPointerProperty(internal->props, SDL_PROP_SURFACE_BLIT_ENUMERATE_POINTER, (void *)SDL_EnumerateBlitFuncTables);
+        }
+        internal->reported_blit = name;
+        SDL_SetStringProperty(internal->props, SDL_PROP_SURFACE_BLIT_FUNCTION_STRING, name);
+    }
+}
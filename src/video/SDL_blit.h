@@ -82,6 +82,7 @@ typedef struct
     int flags;
     unsigned int cpu;
     SDL_BlitFunc func;
+    const char *name;
 } SDL_BlitFuncEntry;
 
 typedef int (SDLCALL *SDL_Blit) (struct SDL_Surface *src, const SDL_Rect *srcrect, struct SDL_Surface *dst, const SDL_Rect *dstrect);
@@ -92,6 +93,7 @@ typedef struct SDL_BlitMap
     int identity;
     SDL_Blit blit;
     void *data;
+    const char *blit_name; /* the name of the function in data, reported to benchmarks */
     SDL_BlitInfo info;
 
     /* the version count matches the destination; mismatch indicates
@@ -100,14 +102,44 @@ typedef struct SDL_BlitMap
     Uint32 src_palette_version;
 } SDL_BlitMap;
 
+/* A blit function in a lookup table, along with its name */
+typedef struct
+{
+    SDL_BlitFunc func;
+    const char *name;
+} SDL_NamedBlitFunc;
+
+#define SDL_NAMED_BLIT(func) { func, #func }
+
+/* Choose a blit function for a surface, remembering its name in the blit map */
+#define SDL_CHOOSE_BLIT(surface, func) ((surface)->internal->map.blit_name = #func, (SDL_BlitFunc)(func))
+#define SDL_CHOOSE_NAMED_BLIT(surface, entry) ((surface)->internal->map.blit_name = (entry).name, (entry).func)
+
+/* Private surface properties, for test/benchblit.c:
+   SDL_PROP_SURFACE_BLIT_FUNCTION_STRING is the name of the last blit function used with the surface as source,
+   SDL_PROP_SURFACE_BLIT_ENUMERATE_POINTER is a SDL_EnumerateBlitFuncs function.
+   They are only set on surfaces that already have properties when they are blitted. */
+#define SDL_PROP_SURFACE_BLIT_FUNCTION_STRING   "SDL.internal.surface.blit_function"
+#define SDL_PROP_SURFACE_BLIT_ENUMERATE_POINTER "SDL.internal.surface.blit_enumerate"
+
+/* Lists the format and flag combinations that have their own blit function, filling in up to max
+   entries and returning the total count. SDL_PIXELFORMAT_UNKNOWN matches any format. */
+typedef int (SDLCALL *SDL_EnumerateBlitFuncs)(SDL_BlitFuncEntry *entries, int max);
+
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst);
+extern void SDL_ReportBlitFunc(SDL_Surface *surface, const char *name);
+extern void SDL_AddBlitFuncEntry(SDL_BlitFuncEntry *entries, int max, int *count, SDL_PixelFormat src_format, SDL_PixelFormat dst_format, int flags, SDL_BlitFunc func, const char *name);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface);
 extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface);
 extern SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface);
 extern SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface);
+extern void SDL_EnumerateBlit0(SDL_BlitFuncEntry *entries, int max, int *count);
+extern void SDL_EnumerateBlit1(SDL_BlitFuncEntry *entries, int max, int *count);
+extern void SDL_EnumerateBlitN(SDL_BlitFuncEntry *entries, int max, int *count);
+extern void SDL_EnumerateBlitA(SDL_BlitFuncEntry *entries, int max, int *count);
 
 /*
  * Useful macros for blitting routines
@@ -592,6 +624,27 @@ extern SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface);
                      dstfmt->Amask;                                         \
         FACTOR_BLEND_8888(tmp, dst, srcA);                                  \
     } while (0)
+
+/* Blend two 8888 pixels with premultiplied alpha and differing formats. */
+#define PREMULTIPLIED_BLEND_SWIZZLE_8888(src, dst, srcfmt, dstfmt)                         \
+    do {                                                                                   \
+        Uint32 srcA = (src >> srcfmt->Ashift) & 0xFF;                                      \
+        Uint32 invA = 255 - srcA;                                                          \
+        Uint32 tmp = (((src >> srcfmt->Rshift) & 0xFF) << dstfmt->Rshift) |                \
+                     (((src >> srcfmt->Gshift) & 0xFF) << dstfmt->Gshift) |                \
+                     (((src >> srcfmt->Bshift) & 0xFF) << dstfmt->Bshift) |                \
+                     (dstfmt->Amask ? (srcA << dstfmt->Ashift) : 0);                       \
+        Uint32 dst02 = (dst & 0x00FF00FF) * invA + 0x00010001;                             \
+        Uint32 dst13 = ((dst >> 8) & 0x00FF00FF) * invA + 0x00010001;                      \
+        dst02 = ((dst02 + ((dst02 >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;                 \
+        dst13 = ((dst13 + ((dst13 >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;                 \
+        dst02 += tmp & 0x00FF00FF;                                                         \
+        dst13 += (tmp >> 8) & 0x00FF00FF;                                                  \
+        dst02 = (dst02 | (((dst02 >> 8) & 0x00010001) * 0xFF)) & 0x00FF00FF;               \
+        dst13 = (dst13 | (((dst13 >> 8) & 0x00010001) * 0xFF)) & 0x00FF00FF;               \
+        dst = (dst02 | (dst13 << 8)) & (dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask | dstfmt->Amask); \
+    } while (0)
+
 /* Blend the RGBA values of two pixels */
 #define ALPHA_BLEND_RGBA(sR, sG, sB, sA, dR, dG, dB, dA) \
     do {                                                 \
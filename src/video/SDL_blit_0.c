@@ -775,8 +775,12 @@ static void Blit1bto4(SDL_BlitInfo *info) {
     BlitBto4(info, 1);
 }
 
-static const SDL_BlitFunc bitmap_blit_1b[] = {
-    (SDL_BlitFunc)NULL, Blit1bto1, Blit1bto2, Blit1bto3, Blit1bto4
+static const SDL_NamedBlitFunc bitmap_blit_1b[] = {
+    { NULL, NULL },
+    SDL_NAMED_BLIT(Blit1bto1),
+    SDL_NAMED_BLIT(Blit1bto2),
+    SDL_NAMED_BLIT(Blit1bto3),
+    SDL_NAMED_BLIT(Blit1bto4),
 };
 
 static void Blit1bto1Key(SDL_BlitInfo *info) {
@@ -795,8 +799,12 @@ static void Blit1bto4Key(SDL_BlitInfo *info) {
     BlitBto4Key(info, 1);
 }
 
-static const SDL_BlitFunc colorkey_blit_1b[] = {
-    (SDL_BlitFunc)NULL, Blit1bto1Key, Blit1bto2Key, Blit1bto3Key, Blit1bto4Key
+static const SDL_NamedBlitFunc colorkey_blit_1b[] = {
+    { NULL, NULL },
+    SDL_NAMED_BLIT(Blit1bto1Key),
+    SDL_NAMED_BLIT(Blit1bto2Key),
+    SDL_NAMED_BLIT(Blit1bto3Key),
+    SDL_NAMED_BLIT(Blit1bto4Key),
 };
 
 static void Blit1btoNAlpha(SDL_BlitInfo *info)
@@ -827,8 +835,12 @@ static void Blit2bto4(SDL_BlitInfo *info) {
     BlitBto4(info, 2);
 }
 
-static const SDL_BlitFunc bitmap_blit_2b[] = {
-    (SDL_BlitFunc)NULL, Blit2bto1, Blit2bto2, Blit2bto3, Blit2bto4
+static const SDL_NamedBlitFunc bitmap_blit_2b[] = {
+    { NULL, NULL },
+    SDL_NAMED_BLIT(Blit2bto1),
+    SDL_NAMED_BLIT(Blit2bto2),
+    SDL_NAMED_BLIT(Blit2bto3),
+    SDL_NAMED_BLIT(Blit2bto4),
 };
 
 static void Blit2bto1Key(SDL_BlitInfo *info) {
@@ -847,8 +859,12 @@ static void Blit2bto4Key(SDL_BlitInfo *info) {
     BlitBto4Key(info, 2);
 }
 
-static const SDL_BlitFunc colorkey_blit_2b[] = {
-    (SDL_BlitFunc)NULL, Blit2bto1Key, Blit2bto2Key, Blit2bto3Key, Blit2bto4Key
+static const SDL_NamedBlitFunc colorkey_blit_2b[] = {
+    { NULL, NULL },
+    SDL_NAMED_BLIT(Blit2bto1Key),
+    SDL_NAMED_BLIT(Blit2bto2Key),
+    SDL_NAMED_BLIT(Blit2bto3Key),
+    SDL_NAMED_BLIT(Blit2bto4Key),
 };
 
 static void Blit2btoNAlpha(SDL_BlitInfo *info)
@@ -879,8 +895,12 @@ static void Blit4bto4(SDL_BlitInfo *info) {
     BlitBto4(info, 4);
 }
 
-static const SDL_BlitFunc bitmap_blit_4b[] = {
-    (SDL_BlitFunc)NULL, Blit4bto1, Blit4bto2, Blit4bto3, Blit4bto4
+static const SDL_NamedBlitFunc bitmap_blit_4b[] = {
+    { NULL, NULL },
+    SDL_NAMED_BLIT(Blit4bto1),
+    SDL_NAMED_BLIT(Blit4bto2),
+    SDL_NAMED_BLIT(Blit4bto3),
+    SDL_NAMED_BLIT(Blit4bto4),
 };
 
 static void Blit4bto1Key(SDL_BlitInfo *info) {
@@ -899,8 +919,12 @@ static void Blit4bto4Key(SDL_BlitInfo *info) {
     BlitBto4Key(info, 4);
 }
 
-static const SDL_BlitFunc colorkey_blit_4b[] = {
-    (SDL_BlitFunc)NULL, Blit4bto1Key, Blit4bto2Key, Blit4bto3Key, Blit4bto4Key
+static const SDL_NamedBlitFunc colorkey_blit_4b[] = {
+    { NULL, NULL },
+    SDL_NAMED_BLIT(Blit4bto1Key),
+    SDL_NAMED_BLIT(Blit4bto2Key),
+    SDL_NAMED_BLIT(Blit4bto3Key),
+    SDL_NAMED_BLIT(Blit4bto4Key),
 };
 
 static void Blit4btoNAlpha(SDL_BlitInfo *info)
@@ -929,21 +953,21 @@ SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface)
         switch (surface->internal->map.info.flags & ~SDL_COPY_RLE_MASK) {
         case 0:
             if (which < SDL_arraysize(bitmap_blit_1b)) {
-                return bitmap_blit_1b[which];
+                return SDL_CHOOSE_NAMED_BLIT(surface, bitmap_blit_1b[which]);
             }
             break;
 
         case SDL_COPY_COLORKEY:
             if (which < SDL_arraysize(colorkey_blit_1b)) {
-                return colorkey_blit_1b[which];
+                return SDL_CHOOSE_NAMED_BLIT(surface, colorkey_blit_1b[which]);
             }
             break;
 
         case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-            return which >= 2 ? Blit1btoNAlpha : (SDL_BlitFunc)NULL;
+            return which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit1btoNAlpha) : NULL;
 
         case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-            return which >= 2 ? Blit1btoNAlphaKey : (SDL_BlitFunc)NULL;
+            return which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit1btoNAlphaKey) : NULL;
         }
         return NULL;
     }
@@ -952,21 +976,21 @@ SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface)
         switch (surface->internal->map.info.flags & ~SDL_COPY_RLE_MASK) {
         case 0:
             if (which < SDL_arraysize(bitmap_blit_2b)) {
-                return bitmap_blit_2b[which];
+                return SDL_CHOOSE_NAMED_BLIT(surface, bitmap_blit_2b[which]);
             }
             break;
 
         case SDL_COPY_COLORKEY:
             if (which < SDL_arraysize(colorkey_blit_2b)) {
-                return colorkey_blit_2b[which];
+                return SDL_CHOOSE_NAMED_BLIT(surface, colorkey_blit_2b[which]);
             }
             break;
 
         case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-            return which >= 2 ? Blit2btoNAlpha : (SDL_BlitFunc)NULL;
+            return which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit2btoNAlpha) : NULL;
 
         case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-            return which >= 2 ? Blit2btoNAlphaKey : (SDL_BlitFunc)NULL;
+            return which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit2btoNAlphaKey) : NULL;
         }
         return NULL;
     }
@@ -975,21 +999,21 @@ SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface)
         switch (surface->internal->map.info.flags & ~SDL_COPY_RLE_MASK) {
         case 0:
             if (which < SDL_arraysize(bitmap_blit_4b)) {
-                return bitmap_blit_4b[which];
+                return SDL_CHOOSE_NAMED_BLIT(surface, bitmap_blit_4b[which]);
             }
             break;
 
         case SDL_COPY_COLORKEY:
             if (which < SDL_arraysize(colorkey_blit_4b)) {
-                return colorkey_blit_4b[which];
+                return SDL_CHOOSE_NAMED_BLIT(surface, colorkey_blit_4b[which]);
             }
             break;
 
         case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-            return which >= 2 ? Blit4btoNAlpha : (SDL_BlitFunc)NULL;
+            return which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit4btoNAlpha) : NULL;
 
         case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-            return which >= 2 ? Blit4btoNAlphaKey : (SDL_BlitFunc)NULL;
+            return which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit4btoNAlphaKey) : NULL;
         }
         return NULL;
     }
@@ -997,4 +1021,22 @@ SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface)
     return NULL;
 }
 
+void SDL_EnumerateBlit0(SDL_BlitFuncEntry *entries, int max, int *count)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_INDEX1MSB, SDL_PIXELFORMAT_INDEX2MSB, SDL_PIXELFORMAT_INDEX4MSB
+    };
+    static const int flags[] = {
+        0, SDL_COPY_COLORKEY, SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND, SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND
+    };
+    int i, j;
+
+    /* The blitters are picked by destination size, so any destination format matches */
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(flags); ++j) {
+            SDL_AddBlitFuncEntry(entries, max, count, formats[i], SDL_PIXELFORMAT_UNKNOWN, flags[j], NULL, NULL);
+        }
+    }
+}
+
 #endif /* SDL_HAVE_BLIT_0 */
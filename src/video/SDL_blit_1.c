@@ -506,12 +506,20 @@ static void Blit1toNAlphaKey(SDL_BlitInfo *info)
     }
 }
 
-static const SDL_BlitFunc one_blit[] = {
-    (SDL_BlitFunc)NULL, Blit1to1, Blit1to2, Blit1to3, Blit1to4
+static const SDL_NamedBlitFunc one_blit[] = {
+    { NULL, NULL },
+    SDL_NAMED_BLIT(Blit1to1),
+    SDL_NAMED_BLIT(Blit1to2),
+    SDL_NAMED_BLIT(Blit1to3),
+    SDL_NAMED_BLIT(Blit1to4),
 };
 
-static const SDL_BlitFunc one_blitkey[] = {
-    (SDL_BlitFunc)NULL, Blit1to1Key, Blit1to2Key, Blit1to3Key, Blit1to4Key
+static const SDL_NamedBlitFunc one_blitkey[] = {
+    { NULL, NULL },
+    SDL_NAMED_BLIT(Blit1to1Key),
+    SDL_NAMED_BLIT(Blit1to2Key),
+    SDL_NAMED_BLIT(Blit1to3Key),
+    SDL_NAMED_BLIT(Blit1to4Key),
 };
 
 SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
@@ -527,31 +535,45 @@ SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
     switch (surface->internal->map.info.flags & ~SDL_COPY_RLE_MASK) {
     case 0:
         if (which < SDL_arraysize(one_blit)) {
-            return one_blit[which];
+            return SDL_CHOOSE_NAMED_BLIT(surface, one_blit[which]);
         }
         break;
 
     case SDL_COPY_COLORKEY:
         if (which < SDL_arraysize(one_blitkey)) {
-            return one_blitkey[which];
+            return SDL_CHOOSE_NAMED_BLIT(surface, one_blitkey[which]);
         }
         break;
 
     case SDL_COPY_COLORKEY | SDL_COPY_BLEND:  /* this is not super-robust but handles a specific case we found sdl12-compat. */
-        return (surface->internal->map.info.a == 255) ? one_blitkey[which] :
-                which >= 2 ? Blit1toNAlphaKey : (SDL_BlitFunc)NULL;
+        return (surface->internal->map.info.a == 255) ? SDL_CHOOSE_NAMED_BLIT(surface, one_blitkey[which]) :
+                which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit1toNAlphaKey) : NULL;
 
     case SDL_COPY_BLEND:
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
         /* Supporting 8bpp->8bpp alpha is doable but requires lots of
            tables which consume space and takes time to precompute,
            so is better left to the user */
-        return which >= 2 ? Blit1toNAlpha : (SDL_BlitFunc)NULL;
+        return which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit1toNAlpha) : NULL;
 
     case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-        return which >= 2 ? Blit1toNAlphaKey : (SDL_BlitFunc)NULL;
+        return which >= 2 ? SDL_CHOOSE_BLIT(surface, Blit1toNAlphaKey) : NULL;
     }
     return (SDL_BlitFunc)NULL;
 }
 
+void SDL_EnumerateBlit1(SDL_BlitFuncEntry *entries, int max, int *count)
+{
+    static const int flags[] = {
+        0, SDL_COPY_COLORKEY, SDL_COPY_COLORKEY | SDL_COPY_BLEND, SDL_COPY_BLEND,
+        SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND, SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND
+    };
+    int i;
+
+    /* The blitters are picked by destination size, so any destination format matches */
+    for (i = 0; i < SDL_arraysize(flags); ++i) {
+        SDL_AddBlitFuncEntry(entries, max, count, SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_UNKNOWN, flags[i], NULL, NULL);
+    }
+}
+
 #endif /* SDL_HAVE_BLIT_1 */
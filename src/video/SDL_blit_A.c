@@ -228,7 +228,154 @@ static void SDL_TARGETING("sse2") Blit888to888SurfaceAlphaSSE2(SDL_BlitInfo *inf
 
             FACTOR_BLEND_8888(src32, dst32, alpha);
 
-            *dst = dst32 | 0xff000000;
+            *(Uint32 *)dst = dst32 | 0xff000000;
+
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+
+static void SDL_TARGETING("avx2") Blit888to888SurfaceAlphaAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    Uint8 alpha = info->a;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+    const Uint32 alpha_fill = ~(dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask);
+
+    const __m256i alpha_fill_mask = _mm256_set1_epi32((int)alpha_fill);
+    const __m256i srcA = _mm256_set1_epi16(alpha);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            // Load 8 src pixels
+            __m256i src256 = _mm256_loadu_si256((__m256i *)src);
+
+            // Load 8 dst pixels
+            __m256i dst256 = _mm256_loadu_si256((__m256i *)dst);
+
+            __m256i src_lo = _mm256_unpacklo_epi8(src256, _mm256_setzero_si256());
+            __m256i src_hi = _mm256_unpackhi_epi8(src256, _mm256_setzero_si256());
+
+            __m256i dst_lo = _mm256_unpacklo_epi8(dst256, _mm256_setzero_si256());
+            __m256i dst_hi = _mm256_unpackhi_epi8(dst256, _mm256_setzero_si256());
+
+            // dst = ((src - dst) * srcA) + ((dst << 8) - dst)
+            dst_lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(src_lo, dst_lo), srcA),
+                                      _mm256_sub_epi16(_mm256_slli_epi16(dst_lo, 8), dst_lo));
+            dst_hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(src_hi, dst_hi), srcA),
+                                      _mm256_sub_epi16(_mm256_slli_epi16(dst_hi, 8), dst_hi));
+
+            // dst += 0x1U (use 0x80 to round instead of floor)
+            dst_lo = _mm256_add_epi16(dst_lo, _mm256_set1_epi16(1));
+            dst_hi = _mm256_add_epi16(dst_hi, _mm256_set1_epi16(1));
+
+            // dst = (dst + (dst >> 8)) >> 8
+            dst_lo = _mm256_srli_epi16(_mm256_add_epi16(dst_lo, _mm256_srli_epi16(dst_lo, 8)), 8);
+            dst_hi = _mm256_srli_epi16(_mm256_add_epi16(dst_hi, _mm256_srli_epi16(dst_hi, 8)), 8);
+
+            dst256 = _mm256_packus_epi16(dst_lo, dst_hi);
+
+            // Set the alpha channels of dst to 255
+            dst256 = _mm256_or_si256(dst256, alpha_fill_mask);
+
+            _mm256_storeu_si256((__m256i *)dst, dst256);
+
+            src += 32;
+            dst += 32;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+
+            FACTOR_BLEND_8888(src32, dst32, alpha);
+
+            *(Uint32 *)dst = dst32 | alpha_fill;
+
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+
+/* Blend 8 channel values with per-lane alpha, matching FACTOR_BLEND_8888 */
+static SDL_INLINE uint8x8_t BlendChannelNEON(uint8x8_t s, uint8x8_t d, uint8x8_t a)
+{
+    // dst = ((src - dst) * srcA) + ((dst << 8) - dst), in wrapping 16-bit arithmetic
+    uint16x8_t x = vmull_u8(s, a);
+    x = vmlsl_u8(x, d, a);
+    x = vaddq_u16(x, vshll_n_u8(d, 8));
+    x = vsubw_u8(x, d);
+
+    // dst += 0x1U
+    x = vaddq_u16(x, vdupq_n_u16(1));
+
+    // dst = (dst + (dst >> 8)) >> 8
+    return vshrn_n_u16(vsraq_n_u16(x, x, 8), 8);
+}
+
+static void Blit888to888SurfaceAlphaNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    Uint8 alpha = info->a;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+    const Uint32 alpha_fill = ~(dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask);
+
+    const uint8x16_t alpha_fill_mask = vreinterpretq_u8_u32(vdupq_n_u32(alpha_fill));
+    const uint8x8_t srcA = vdup_n_u8(alpha);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 4 <= width; i += 4) {
+            // Load 4 src and dst pixels
+            uint8x16_t src128 = vld1q_u8(src);
+            uint8x16_t dst128 = vld1q_u8(dst);
+
+            uint8x8_t dst_lo = BlendChannelNEON(vget_low_u8(src128), vget_low_u8(dst128), srcA);
+            uint8x8_t dst_hi = BlendChannelNEON(vget_high_u8(src128), vget_high_u8(dst128), srcA);
+
+            // Set the alpha channels of dst to 255
+            vst1q_u8(dst, vorrq_u8(vcombine_u8(dst_lo, dst_hi), alpha_fill_mask));
+
+            src += 16;
+            dst += 16;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+
+            FACTOR_BLEND_8888(src32, dst32, alpha);
+
+            *(Uint32 *)dst = dst32 | alpha_fill;
 
             src += 4;
             dst += 4;
@@ -1174,6 +1321,241 @@ static void SDL_TARGETING("avx2") Blit8888to8888PixelAlphaSwizzleAVX2(SDL_BlitIn
 
 #endif
 
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+
+static void Blit8888to8888PixelAlphaSwizzleNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+
+    // The byte index of each channel, vld4 splits pixels into one plane per byte
+    const int sR = srcfmt->Rshift >> 3, sG = srcfmt->Gshift >> 3, sB = srcfmt->Bshift >> 3, sA = srcfmt->Ashift >> 3;
+    const int dR = dstfmt->Rshift >> 3, dG = dstfmt->Gshift >> 3, dB = dstfmt->Bshift >> 3;
+    const int dA = 6 - dR - dG - dB;
+    const uint8x8_t alpha_fill = vdup_n_u8(dstfmt->Amask ? 0xFF : 0x00);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            // Load 8 src and dst pixels
+            uint8x8x4_t src8 = vld4_u8(src);
+            uint8x8x4_t dst8 = vld4_u8(dst);
+            uint8x8_t srcA = src8.val[sA];
+
+            dst8.val[dR] = BlendChannelNEON(src8.val[sR], dst8.val[dR], srcA);
+            dst8.val[dG] = BlendChannelNEON(src8.val[sG], dst8.val[dG], srcA);
+            dst8.val[dB] = BlendChannelNEON(src8.val[sB], dst8.val[dB], srcA);
+            dst8.val[dA] = BlendChannelNEON(alpha_fill, dst8.val[dA], srcA);
+
+            vst4_u8(dst, dst8);
+
+            src += 32;
+            dst += 32;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+            ALPHA_BLEND_SWIZZLE_8888(src32, dst32, srcfmt, dstfmt);
+            *(Uint32 *)dst = dst32;
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
+/* Fast 32-bit RGBA->RGB(A) blending with premultiplied pixel alpha */
+static void Blit8888to8888PixelAlphaPremultiplied(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+
+    while (height--) {
+        int i = 0;
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+            PREMULTIPLIED_BLEND_SWIZZLE_8888(src32, dst32, srcfmt, dstfmt);
+            *(Uint32 *)dst = dst32;
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+
+static void SDL_TARGETING("avx2") Blit8888to8888PixelAlphaPremultipliedAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+    const Uint32 dst_channels = dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask | dstfmt->Amask;
+
+    // The byte offsets for the start of each pixel
+    const __m256i mask_offsets = _mm256_set_epi8(
+        28, 28, 28, 28, 24, 24, 24, 24, 20, 20, 20, 20, 16, 16, 16, 16, 12, 12, 12, 12, 8, 8, 8, 8, 4, 4, 4, 4, 0, 0, 0, 0);
+
+    // Bytes with the high bit set in the shuffle mask are cleared, which drops the unused channel
+    const __m256i convert_mask = _mm256_add_epi32(
+        _mm256_set1_epi32(
+            ((srcfmt->Rshift >> 3) << dstfmt->Rshift) |
+            ((srcfmt->Gshift >> 3) << dstfmt->Gshift) |
+            ((srcfmt->Bshift >> 3) << dstfmt->Bshift) |
+            (dstfmt->Amask ? ((srcfmt->Ashift >> 3) << dstfmt->Ashift) : (~dst_channels & 0x80808080))),
+        mask_offsets);
+
+    const __m256i alpha_splat_mask = _mm256_add_epi8(_mm256_set1_epi8(srcfmt->Ashift >> 3), mask_offsets);
+    const __m256i channel_mask = _mm256_set1_epi32((int)dst_channels);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            // Load 8 src pixels
+            __m256i src256 = _mm256_loadu_si256((__m256i *)src);
+
+            // Load 8 dst pixels
+            __m256i dst256 = _mm256_loadu_si256((__m256i *)dst);
+
+            // Extract 255 - alpha from each pixel and splat it into all the channels
+            __m256i srcInvA = _mm256_xor_si256(_mm256_shuffle_epi8(src256, alpha_splat_mask), _mm256_set1_epi8(-1));
+
+            // Convert to dst format
+            src256 = _mm256_shuffle_epi8(src256, convert_mask);
+
+            __m256i dst_lo = _mm256_unpacklo_epi8(dst256, _mm256_setzero_si256());
+            __m256i dst_hi = _mm256_unpackhi_epi8(dst256, _mm256_setzero_si256());
+
+            __m256i inva_lo = _mm256_unpacklo_epi8(srcInvA, _mm256_setzero_si256());
+            __m256i inva_hi = _mm256_unpackhi_epi8(srcInvA, _mm256_setzero_si256());
+
+            // dst = dst * (255 - srcA) + 1
+            dst_lo = _mm256_add_epi16(_mm256_mullo_epi16(dst_lo, inva_lo), _mm256_set1_epi16(1));
+            dst_hi = _mm256_add_epi16(_mm256_mullo_epi16(dst_hi, inva_hi), _mm256_set1_epi16(1));
+
+            // dst = (dst + (dst >> 8)) >> 8
+            dst_lo = _mm256_srli_epi16(_mm256_add_epi16(dst_lo, _mm256_srli_epi16(dst_lo, 8)), 8);
+            dst_hi = _mm256_srli_epi16(_mm256_add_epi16(dst_hi, _mm256_srli_epi16(dst_hi, 8)), 8);
+
+            // dst = min(src + dst, 255), keeping only the channels present in dst
+            dst256 = _mm256_adds_epu8(_mm256_packus_epi16(dst_lo, dst_hi), src256);
+            _mm256_storeu_si256((__m256i *)dst, _mm256_and_si256(dst256, channel_mask));
+
+            src += 32;
+            dst += 32;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+            PREMULTIPLIED_BLEND_SWIZZLE_8888(src32, dst32, srcfmt, dstfmt);
+            *(Uint32 *)dst = dst32;
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+
+/* Scale 8 channel values by 255 - alpha, matching MULT_DIV_255 */
+static SDL_INLINE uint8x8_t ScaleChannelNEON(uint8x8_t d, uint8x8_t inva)
+{
+    uint16x8_t x = vaddq_u16(vmull_u8(d, inva), vdupq_n_u16(1));
+    return vshrn_n_u16(vsraq_n_u16(x, x, 8), 8);
+}
+
+static void Blit8888to8888PixelAlphaPremultipliedNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+
+    // The byte index of each channel, vld4 splits pixels into one plane per byte
+    const int sR = srcfmt->Rshift >> 3, sG = srcfmt->Gshift >> 3, sB = srcfmt->Bshift >> 3, sA = srcfmt->Ashift >> 3;
+    const int dR = dstfmt->Rshift >> 3, dG = dstfmt->Gshift >> 3, dB = dstfmt->Bshift >> 3;
+    const int dA = 6 - dR - dG - dB;
+    const SDL_bool has_alpha = dstfmt->Amask ? SDL_TRUE : SDL_FALSE;
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            // Load 8 src and dst pixels
+            uint8x8x4_t src8 = vld4_u8(src);
+            uint8x8x4_t dst8 = vld4_u8(dst);
+            uint8x8_t srcInvA = vmvn_u8(src8.val[sA]);
+
+            // dst = min(src + dst * (255 - srcA) / 255, 255)
+            dst8.val[dR] = vqadd_u8(ScaleChannelNEON(dst8.val[dR], srcInvA), src8.val[sR]);
+            dst8.val[dG] = vqadd_u8(ScaleChannelNEON(dst8.val[dG], srcInvA), src8.val[sG]);
+            dst8.val[dB] = vqadd_u8(ScaleChannelNEON(dst8.val[dB], srcInvA), src8.val[sB]);
+            if (has_alpha) {
+                dst8.val[dA] = vqadd_u8(ScaleChannelNEON(dst8.val[dA], srcInvA), src8.val[sA]);
+            } else {
+                dst8.val[dA] = vdup_n_u8(0);
+            }
+
+            vst4_u8(dst, dst8);
+
+            src += 32;
+            dst += 32;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+            PREMULTIPLIED_BLEND_SWIZZLE_8888(src32, dst32, srcfmt, dstfmt);
+            *(Uint32 *)dst = dst32;
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
 /* General (slow) N->N blending with pixel alpha */
 static void BlitNtoNPixelAlpha(SDL_BlitInfo *info)
 {
@@ -1225,48 +1607,72 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
         switch (df->bytes_per_pixel) {
         case 1:
             if (surface->internal->map.info.dst_pal) {
-                return BlitNto1PixelAlpha;
+                return SDL_CHOOSE_BLIT(surface, BlitNto1PixelAlpha);
             } else {
                 /* RGB332 has no palette ! */
-                return BlitNtoNPixelAlpha;
+                return SDL_CHOOSE_BLIT(surface, BlitNtoNPixelAlpha);
             }
 
         case 2:
             if (sf->bytes_per_pixel == 4 && sf->Amask == 0xff000000 && sf->Gmask == 0xff00 && ((sf->Rmask == 0xff && df->Rmask == 0x1f) || (sf->Bmask == 0xff && df->Bmask == 0x1f))) {
                 if (df->Gmask == 0x7e0) {
-                    return BlitARGBto565PixelAlpha;
+                    return SDL_CHOOSE_BLIT(surface, BlitARGBto565PixelAlpha);
                 } else if (df->Gmask == 0x3e0) {
-                    return BlitARGBto555PixelAlpha;
+                    return SDL_CHOOSE_BLIT(surface, BlitARGBto555PixelAlpha);
                 }
             }
-            return BlitNtoNPixelAlpha;
+            return SDL_CHOOSE_BLIT(surface, BlitNtoNPixelAlpha);
 
         case 4:
             if (SDL_PIXELLAYOUT(sf->format) == SDL_PACKEDLAYOUT_8888 && sf->Amask &&
                 SDL_PIXELLAYOUT(df->format) == SDL_PACKEDLAYOUT_8888) {
 #ifdef SDL_AVX2_INTRINSICS
                 if (SDL_HasAVX2()) {
-                    return Blit8888to8888PixelAlphaSwizzleAVX2;
+                    return SDL_CHOOSE_BLIT(surface, Blit8888to8888PixelAlphaSwizzleAVX2);
                 }
 #endif
 #ifdef SDL_SSE4_1_INTRINSICS
                 if (SDL_HasSSE41()) {
-                    return Blit8888to8888PixelAlphaSwizzleSSE41;
+                    return SDL_CHOOSE_BLIT(surface, Blit8888to8888PixelAlphaSwizzleSSE41);
+                }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+                if (SDL_HasNEON()) {
+                    return SDL_CHOOSE_BLIT(surface, Blit8888to8888PixelAlphaSwizzleNEON);
                 }
 #endif
                 if (sf->format == df->format) {
-                    return Blit8888to8888PixelAlpha;
+                    return SDL_CHOOSE_BLIT(surface, Blit8888to8888PixelAlpha);
                 } else {
-                    return Blit8888to8888PixelAlphaSwizzle;
+                    return SDL_CHOOSE_BLIT(surface, Blit8888to8888PixelAlphaSwizzle);
                 }
             }
-            return BlitNtoNPixelAlpha;
+            return SDL_CHOOSE_BLIT(surface, BlitNtoNPixelAlpha);
 
         case 3:
         default:
             break;
         }
-        return BlitNtoNPixelAlpha;
+        return SDL_CHOOSE_BLIT(surface, BlitNtoNPixelAlpha);
+
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        /* Per-pixel premultiplied alpha blits, other formats use the generic blitters */
+        if (sf->bytes_per_pixel == 4 && df->bytes_per_pixel == 4 &&
+            SDL_PIXELLAYOUT(sf->format) == SDL_PACKEDLAYOUT_8888 && sf->Amask &&
+            SDL_PIXELLAYOUT(df->format) == SDL_PACKEDLAYOUT_8888) {
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                return SDL_CHOOSE_BLIT(surface, Blit8888to8888PixelAlphaPremultipliedAVX2);
+            }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+            if (SDL_HasNEON()) {
+                return SDL_CHOOSE_BLIT(surface, Blit8888to8888PixelAlphaPremultipliedNEON);
+            }
+#endif
+            return SDL_CHOOSE_BLIT(surface, Blit8888to8888PixelAlphaPremultiplied);
+        }
+        break;
 
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
         if (sf->Amask == 0) {
@@ -1274,10 +1680,10 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
             switch (df->bytes_per_pixel) {
             case 1:
                 if (surface->internal->map.info.dst_pal) {
-                    return BlitNto1SurfaceAlpha;
+                    return SDL_CHOOSE_BLIT(surface, BlitNto1SurfaceAlpha);
                 } else {
                     /* RGB332 has no palette ! */
-                    return BlitNtoNSurfaceAlpha;
+                    return SDL_CHOOSE_BLIT(surface, BlitNtoNSurfaceAlpha);
                 }
 
             case 2:
@@ -1285,41 +1691,51 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
                     if (df->Gmask == 0x7e0) {
 #ifdef SDL_MMX_INTRINSICS
                         if (SDL_HasMMX()) {
-                            return Blit565to565SurfaceAlphaMMX;
+                            return SDL_CHOOSE_BLIT(surface, Blit565to565SurfaceAlphaMMX);
                         } else
 #endif
                         {
-                            return Blit565to565SurfaceAlpha;
+                            return SDL_CHOOSE_BLIT(surface, Blit565to565SurfaceAlpha);
                         }
                     } else if (df->Gmask == 0x3e0) {
 #ifdef SDL_MMX_INTRINSICS
                         if (SDL_HasMMX()) {
-                            return Blit555to555SurfaceAlphaMMX;
+                            return SDL_CHOOSE_BLIT(surface, Blit555to555SurfaceAlphaMMX);
                         } else
 #endif
                         {
-                            return Blit555to555SurfaceAlpha;
+                            return SDL_CHOOSE_BLIT(surface, Blit555to555SurfaceAlpha);
                         }
                     }
                 }
-                return BlitNtoNSurfaceAlpha;
+                return SDL_CHOOSE_BLIT(surface, BlitNtoNSurfaceAlpha);
 
             case 4:
                 if (sf->Rmask == df->Rmask && sf->Gmask == df->Gmask && sf->Bmask == df->Bmask && sf->bytes_per_pixel == 4) {
+#ifdef SDL_AVX2_INTRINSICS
+                    if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && SDL_HasAVX2()) {
+                        return SDL_CHOOSE_BLIT(surface, Blit888to888SurfaceAlphaAVX2);
+                    }
+#endif
 #ifdef SDL_SSE2_INTRINSICS
                     if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && SDL_HasSSE2()) {
-                        return Blit888to888SurfaceAlphaSSE2;
+                        return SDL_CHOOSE_BLIT(surface, Blit888to888SurfaceAlphaSSE2);
+                    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+                    if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && SDL_HasNEON()) {
+                        return SDL_CHOOSE_BLIT(surface, Blit888to888SurfaceAlphaNEON);
                     }
 #endif
                     if ((sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff) {
-                        return BlitRGBtoRGBSurfaceAlpha;
+                        return SDL_CHOOSE_BLIT(surface, BlitRGBtoRGBSurfaceAlpha);
                     }
                 }
-                return BlitNtoNSurfaceAlpha;
+                return SDL_CHOOSE_BLIT(surface, BlitNtoNSurfaceAlpha);
 
             case 3:
             default:
-                return BlitNtoNSurfaceAlpha;
+                return SDL_CHOOSE_BLIT(surface, BlitNtoNSurfaceAlpha);
             }
         }
         break;
@@ -1329,13 +1745,13 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
             if (df->bytes_per_pixel == 1) {
 
                 if (surface->internal->map.info.dst_pal) {
-                    return BlitNto1SurfaceAlphaKey;
+                    return SDL_CHOOSE_BLIT(surface, BlitNto1SurfaceAlphaKey);
                 } else {
                     /* RGB332 has no palette ! */
-                    return BlitNtoNSurfaceAlphaKey;
+                    return SDL_CHOOSE_BLIT(surface, BlitNtoNSurfaceAlphaKey);
                 }
             } else {
-                return BlitNtoNSurfaceAlphaKey;
+                return SDL_CHOOSE_BLIT(surface, BlitNtoNSurfaceAlphaKey);
             }
         }
         break;
@@ -1344,5 +1760,19 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
     return NULL;
 }
 
+void SDL_EnumerateBlitA(SDL_BlitFuncEntry *entries, int max, int *count)
+{
+    static const int flags[] = {
+        SDL_COPY_BLEND, SDL_COPY_BLEND_PREMULTIPLIED,
+        SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND, SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND
+    };
+    int i;
+
+    /* The blitters are picked by pixel size and masks, so any format matches */
+    for (i = 0; i < SDL_arraysize(flags); ++i) {
+        SDL_AddBlitFuncEntry(entries, max, count, SDL_PIXELFORMAT_UNKNOWN, SDL_PIXELFORMAT_UNKNOWN, flags[i], NULL, NULL);
+    }
+}
+
 #endif /* SDL_HAVE_BLIT_A */
 
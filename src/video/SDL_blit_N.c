@@ -3205,126 +3205,128 @@ struct blit_table
     Uint32 dstR, dstG, dstB;
     Uint32 blit_features;
     SDL_BlitFunc blitfunc;
+    const char *blitname;
     Uint32 alpha; /* bitwise NO_ALPHA, SET_ALPHA, COPY_ALPHA */
 };
+#define BLIT_NAMED(func) func, #func
 static const struct blit_table normal_blit_1[] = {
     /* Default for 8-bit RGB source, never optimized */
-    { 0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0 }
+    { 0, 0, 0, 0, 0, 0, 0, 0, BLIT_NAMED(BlitNtoN), 0 }
 };
 
 static const struct blit_table normal_blit_2[] = {
 #ifdef SDL_ALTIVEC_BLITTERS
     /* has-altivec */
     { 0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00000000, 0x00000000, 0x00000000,
-      BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB565_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      BLIT_FEATURE_HAS_ALTIVEC, BLIT_NAMED(Blit_RGB565_32Altivec), NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     { 0x00007C00, 0x000003E0, 0x0000001F, 4, 0x00000000, 0x00000000, 0x00000000,
-      BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB555_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      BLIT_FEATURE_HAS_ALTIVEC, BLIT_NAMED(Blit_RGB555_32Altivec), NO_ALPHA | COPY_ALPHA | SET_ALPHA },
 #endif
 #ifdef SDL_ARM_SIMD_BLITTERS
     { 0x00000F00, 0x000000F0, 0x0000000F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      BLIT_FEATURE_HAS_ARM_SIMD, Blit_RGB444_XRGB8888ARMSIMD, NO_ALPHA | COPY_ALPHA },
+      BLIT_FEATURE_HAS_ARM_SIMD, BLIT_NAMED(Blit_RGB444_XRGB8888ARMSIMD), NO_ALPHA | COPY_ALPHA },
 #endif
 #if SDL_HAVE_BLIT_N_RGB565
     { 0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      0, Blit_RGB565_ARGB8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      0, BLIT_NAMED(Blit_RGB565_ARGB8888), NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     { 0x0000F800, 0x000007E0, 0x0000001F, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-      0, Blit_RGB565_ABGR8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      0, BLIT_NAMED(Blit_RGB565_ABGR8888), NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     { 0x0000F800, 0x000007E0, 0x0000001F, 4, 0xFF000000, 0x00FF0000, 0x0000FF00,
-      0, Blit_RGB565_RGBA8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      0, BLIT_NAMED(Blit_RGB565_RGBA8888), NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     { 0x0000F800, 0x000007E0, 0x0000001F, 4, 0x0000FF00, 0x00FF0000, 0xFF000000,
-      0, Blit_RGB565_BGRA8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      0, BLIT_NAMED(Blit_RGB565_BGRA8888), NO_ALPHA | COPY_ALPHA | SET_ALPHA },
 #endif
     { 0x00007C00, 0x000003E0, 0x0000001F, 2, 0x00007C00, 0x000003E0, 0x0000001F,
-      0, Blit_RGB555_ARGB1555, SET_ALPHA },
+      0, BLIT_NAMED(Blit_RGB555_ARGB1555), SET_ALPHA },
     { 0x0000001F, 0x000003E0, 0x00007C00, 2, 0x0000001F, 0x000003E0, 0x00007C00,
-      0, Blit_RGB555_ARGB1555, SET_ALPHA },
+      0, BLIT_NAMED(Blit_RGB555_ARGB1555), SET_ALPHA },
 
     /* Default for 16-bit RGB source, used if no other blitter matches */
-    { 0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0 }
+    { 0, 0, 0, 0, 0, 0, 0, 0, BLIT_NAMED(BlitNtoN), 0 }
 };
 
 static const struct blit_table normal_blit_3[] = {
     /* 3->4 with same rgb triplet */
     { 0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-      0, Blit_3or4_to_3or4__same_rgb,
+      0, BLIT_NAMED(Blit_3or4_to_3or4__same_rgb),
 #if HAVE_FAST_WRITE_INT8
       NO_ALPHA |
 #endif
           SET_ALPHA },
     { 0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      0, Blit_3or4_to_3or4__same_rgb,
+      0, BLIT_NAMED(Blit_3or4_to_3or4__same_rgb),
 #if HAVE_FAST_WRITE_INT8
       NO_ALPHA |
 #endif
           SET_ALPHA },
     /* 3->4 with inversed rgb triplet */
     { 0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      0, Blit_3or4_to_3or4__inversed_rgb,
+      0, BLIT_NAMED(Blit_3or4_to_3or4__inversed_rgb),
 #if HAVE_FAST_WRITE_INT8
       NO_ALPHA |
 #endif
           SET_ALPHA },
     { 0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-      0, Blit_3or4_to_3or4__inversed_rgb,
+      0, BLIT_NAMED(Blit_3or4_to_3or4__inversed_rgb),
 #if HAVE_FAST_WRITE_INT8
       NO_ALPHA |
 #endif
           SET_ALPHA },
     /* 3->3 to switch RGB 24 <-> BGR 24 */
     { 0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      0, Blit_3or4_to_3or4__inversed_rgb, NO_ALPHA },
+      0, BLIT_NAMED(Blit_3or4_to_3or4__inversed_rgb), NO_ALPHA },
     { 0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
-      0, Blit_3or4_to_3or4__inversed_rgb, NO_ALPHA },
+      0, BLIT_NAMED(Blit_3or4_to_3or4__inversed_rgb), NO_ALPHA },
     /* Default for 24-bit RGB source, never optimized */
-    { 0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0 }
+    { 0, 0, 0, 0, 0, 0, 0, 0, BLIT_NAMED(BlitNtoN), 0 }
 };
 
 static const struct blit_table normal_blit_4[] = {
 #ifdef SDL_ALTIVEC_BLITTERS
     /* has-altivec | dont-use-prefetch */
     { 0x00000000, 0x00000000, 0x00000000, 4, 0x00000000, 0x00000000, 0x00000000,
-      BLIT_FEATURE_HAS_ALTIVEC | BLIT_FEATURE_ALTIVEC_DONT_USE_PREFETCH, ConvertAltivec32to32_noprefetch, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      BLIT_FEATURE_HAS_ALTIVEC | BLIT_FEATURE_ALTIVEC_DONT_USE_PREFETCH, BLIT_NAMED(ConvertAltivec32to32_noprefetch), NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     /* has-altivec */
     { 0x00000000, 0x00000000, 0x00000000, 4, 0x00000000, 0x00000000, 0x00000000,
-      BLIT_FEATURE_HAS_ALTIVEC, ConvertAltivec32to32_prefetch, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      BLIT_FEATURE_HAS_ALTIVEC, BLIT_NAMED(ConvertAltivec32to32_prefetch), NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     /* has-altivec */
     { 0x00000000, 0x00000000, 0x00000000, 2, 0x0000F800, 0x000007E0, 0x0000001F,
-      BLIT_FEATURE_HAS_ALTIVEC, Blit_XRGB8888_RGB565Altivec, NO_ALPHA },
+      BLIT_FEATURE_HAS_ALTIVEC, BLIT_NAMED(Blit_XRGB8888_RGB565Altivec), NO_ALPHA },
 #endif
 #ifdef SDL_ARM_SIMD_BLITTERS
     { 0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      BLIT_FEATURE_HAS_ARM_SIMD, Blit_XBGR8888_XRGB8888ARMSIMD, NO_ALPHA | COPY_ALPHA },
+      BLIT_FEATURE_HAS_ARM_SIMD, BLIT_NAMED(Blit_XBGR8888_XRGB8888ARMSIMD), NO_ALPHA | COPY_ALPHA },
 #endif
     /* 4->3 with same rgb triplet */
     { 0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
-      0, Blit_3or4_to_3or4__same_rgb, NO_ALPHA | SET_ALPHA },
+      0, BLIT_NAMED(Blit_3or4_to_3or4__same_rgb), NO_ALPHA | SET_ALPHA },
     { 0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      0, Blit_3or4_to_3or4__same_rgb, NO_ALPHA | SET_ALPHA },
+      0, BLIT_NAMED(Blit_3or4_to_3or4__same_rgb), NO_ALPHA | SET_ALPHA },
     /* 4->3 with inversed rgb triplet */
     { 0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      0, Blit_3or4_to_3or4__inversed_rgb, NO_ALPHA | SET_ALPHA },
+      0, BLIT_NAMED(Blit_3or4_to_3or4__inversed_rgb), NO_ALPHA | SET_ALPHA },
     { 0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
-      0, Blit_3or4_to_3or4__inversed_rgb, NO_ALPHA | SET_ALPHA },
+      0, BLIT_NAMED(Blit_3or4_to_3or4__inversed_rgb), NO_ALPHA | SET_ALPHA },
     /* 4->4 with inversed rgb triplet, and COPY_ALPHA to switch ABGR8888 <-> ARGB8888 */
     { 0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-      0, Blit_3or4_to_3or4__inversed_rgb,
+      0, BLIT_NAMED(Blit_3or4_to_3or4__inversed_rgb),
 #if HAVE_FAST_WRITE_INT8
       NO_ALPHA |
 #endif
           SET_ALPHA | COPY_ALPHA },
     { 0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-      0, Blit_3or4_to_3or4__inversed_rgb,
+      0, BLIT_NAMED(Blit_3or4_to_3or4__inversed_rgb),
 #if HAVE_FAST_WRITE_INT8
       NO_ALPHA |
 #endif
           SET_ALPHA | COPY_ALPHA },
     /* RGB 888 and RGB 565 */
     { 0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
-      0, Blit_XRGB8888_RGB565, NO_ALPHA },
+      0, BLIT_NAMED(Blit_XRGB8888_RGB565), NO_ALPHA },
     { 0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x00007C00, 0x000003E0, 0x0000001F,
-      0, Blit_XRGB8888_RGB555, NO_ALPHA },
+      0, BLIT_NAMED(Blit_XRGB8888_RGB555), NO_ALPHA },
     /* Default for 32-bit RGB source, used if no other blitter matches */
-    { 0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0 }
+    { 0, 0, 0, 0, 0, 0, 0, 0, BLIT_NAMED(BlitNtoN), 0 }
 };
 
 static const struct blit_table *const normal_blit[] = {
@@ -3359,14 +3361,14 @@ SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface)
                 (srcfmt->Rmask == 0x00FF0000) &&
                 (srcfmt->Gmask == 0x0000FF00) &&
                 (srcfmt->Bmask == 0x000000FF)) {
-                blitfun = Blit_XRGB8888_index8;
+                blitfun = SDL_CHOOSE_BLIT(surface, Blit_XRGB8888_index8);
             } else if ((srcfmt->bytes_per_pixel == 4) &&
                        (srcfmt->Rmask == 0x3FF00000) &&
                        (srcfmt->Gmask == 0x000FFC00) &&
                        (srcfmt->Bmask == 0x000003FF)) {
-                blitfun = Blit_RGB101010_index8;
+                blitfun = SDL_CHOOSE_BLIT(surface, Blit_RGB101010_index8);
             } else {
-                blitfun = BlitNto1;
+                blitfun = SDL_CHOOSE_BLIT(surface, BlitNto1);
             }
         } else {
             /* Now the meat, choose the blitter we want */
@@ -3392,13 +3394,14 @@ SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface)
                     }
                 }
                 blitfun = table[which].blitfunc;
+                surface->internal->map.blit_name = table[which].blitname;
             }
 
             if (blitfun == BlitNtoN) { /* default C fallback catch-all. Slow! */
                 if (srcfmt->format == SDL_PIXELFORMAT_ARGB2101010) {
-                    blitfun = Blit2101010toN;
+                    blitfun = SDL_CHOOSE_BLIT(surface, Blit2101010toN);
                 } else if (dstfmt->format == SDL_PIXELFORMAT_ARGB2101010) {
-                    blitfun = BlitNto2101010;
+                    blitfun = SDL_CHOOSE_BLIT(surface, BlitNto2101010);
                 } else if (srcfmt->bytes_per_pixel == 4 &&
                            dstfmt->bytes_per_pixel == 4 &&
                            srcfmt->Rmask == dstfmt->Rmask &&
@@ -3407,16 +3410,16 @@ SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface)
                     if (a_need == COPY_ALPHA) {
                         if (srcfmt->Amask == dstfmt->Amask) {
                             /* Fastpath C fallback: 32bit RGBA<->RGBA blit with matching RGBA */
-                            blitfun = SDL_BlitCopy;
+                            blitfun = SDL_CHOOSE_BLIT(surface, SDL_BlitCopy);
                         } else {
-                            blitfun = BlitNtoNCopyAlpha;
+                            blitfun = SDL_CHOOSE_BLIT(surface, BlitNtoNCopyAlpha);
                         }
                     } else {
                         /* Fastpath C fallback: 32bit RGB<->RGBA blit with matching RGB */
-                        blitfun = Blit4to4MaskAlpha;
+                        blitfun = SDL_CHOOSE_BLIT(surface, Blit4to4MaskAlpha);
                     }
                 } else if (a_need == COPY_ALPHA) {
-                    blitfun = BlitNtoNCopyAlpha;
+                    blitfun = SDL_CHOOSE_BLIT(surface, BlitNtoNCopyAlpha);
                 }
             }
         }
@@ -3428,19 +3431,19 @@ SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface)
            If a particular case turns out to be useful we'll add it. */
 
         if (srcfmt->bytes_per_pixel == 2 && surface->internal->map.identity != 0) {
-            return Blit2to2Key;
+            return SDL_CHOOSE_BLIT(surface, Blit2to2Key);
         } else if (dstfmt->bytes_per_pixel == 1) {
-            return BlitNto1Key;
+            return SDL_CHOOSE_BLIT(surface, BlitNto1Key);
         } else {
 #ifdef SDL_ALTIVEC_BLITTERS
             if ((srcfmt->bytes_per_pixel == 4) && (dstfmt->bytes_per_pixel == 4) && SDL_HasAltiVec()) {
-                return Blit32to32KeyAltivec;
+                return SDL_CHOOSE_BLIT(surface, Blit32to32KeyAltivec);
             } else
 #endif
                 if (srcfmt->Amask && dstfmt->Amask) {
-                return BlitNtoNKeyCopyAlpha;
+                return SDL_CHOOSE_BLIT(surface, BlitNtoNKeyCopyAlpha);
             } else {
-                return BlitNtoNKey;
+                return SDL_CHOOSE_BLIT(surface, BlitNtoNKey);
             }
         }
     }
@@ -3448,4 +3451,57 @@ SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface)
     return NULL;
 }
 
+static Uint32 GetMissingMask(int bpp, Uint32 Rmask, Uint32 Gmask, Uint32 Bmask)
+{
+    const Uint32 full = (bpp == 32) ? 0xFFFFFFFF : ((1u << bpp) - 1);
+
+    return full & ~(Rmask | Gmask | Bmask);
+}
+
+void SDL_EnumerateBlitN(SDL_BlitFuncEntry *entries, int max, int *count)
+{
+    int i, which;
+
+    for (i = 0; i < SDL_arraysize(normal_blit); ++i) {
+        const struct blit_table *table = normal_blit[i];
+        const int srcbpp = (i + 1) * 8;
+
+        for (which = 0; table[which].dstbpp; ++which) {
+            const struct blit_table *entry = &table[which];
+            const int dstbpp = entry->dstbpp * 8;
+            const Uint32 srcA = GetMissingMask(srcbpp, entry->srcR, entry->srcG, entry->srcB);
+            const Uint32 dstA = GetMissingMask(dstbpp, entry->dstR, entry->dstG, entry->dstB);
+            SDL_PixelFormat src, dst;
+
+            /* Entries with zero masks only match on pixel size */
+            if (!entry->srcR || !entry->dstR) {
+                continue;
+            }
+            src = SDL_GetPixelFormatForMasks(srcbpp, entry->srcR, entry->srcG, entry->srcB, 0);
+            dst = SDL_GetPixelFormatForMasks(dstbpp, entry->dstR, entry->dstG, entry->dstB, 0);
+            if ((entry->alpha & NO_ALPHA) && src != SDL_PIXELFORMAT_UNKNOWN && dst != SDL_PIXELFORMAT_UNKNOWN) {
+                SDL_AddBlitFuncEntry(entries, max, count, src, dst, 0, entry->blitfunc, entry->blitname);
+            }
+            if (dstA) {
+                dst = SDL_GetPixelFormatForMasks(dstbpp, entry->dstR, entry->dstG, entry->dstB, dstA);
+                if ((entry->alpha & SET_ALPHA) && src != SDL_PIXELFORMAT_UNKNOWN && dst != SDL_PIXELFORMAT_UNKNOWN) {
+                    SDL_AddBlitFuncEntry(entries, max, count, src, dst, 0, entry->blitfunc, entry->blitname);
+                }
+                if (srcA && (entry->alpha & COPY_ALPHA)) {
+                    src = SDL_GetPixelFormatForMasks(srcbpp, entry->srcR, entry->srcG, entry->srcB, srcA);
+                    if (src != SDL_PIXELFORMAT_UNKNOWN && dst != SDL_PIXELFORMAT_UNKNOWN) {
+                        SDL_AddBlitFuncEntry(entries, max, count, src, dst, 0, entry->blitfunc, entry->blitname);
+                    }
+                }
+            }
+        }
+    }
+
+    SDL_AddBlitFuncEntry(entries, max, count, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_INDEX8, 0, Blit_XRGB8888_index8, "Blit_XRGB8888_index8");
+    SDL_AddBlitFuncEntry(entries, max, count, SDL_PIXELFORMAT_XRGB2101010, SDL_PIXELFORMAT_INDEX8, 0, Blit_RGB101010_index8, "Blit_RGB101010_index8");
+    SDL_AddBlitFuncEntry(entries, max, count, SDL_PIXELFORMAT_ARGB2101010, SDL_PIXELFORMAT_UNKNOWN, 0, Blit2101010toN, "Blit2101010toN");
+    SDL_AddBlitFuncEntry(entries, max, count, SDL_PIXELFORMAT_UNKNOWN, SDL_PIXELFORMAT_ARGB2101010, 0, BlitNto2101010, "BlitNto2101010");
+    SDL_AddBlitFuncEntry(entries, max, count, SDL_PIXELFORMAT_UNKNOWN, SDL_PIXELFORMAT_UNKNOWN, SDL_COPY_COLORKEY, NULL, NULL);
+}
+
 #endif /* SDL_HAVE_BLIT_N */
@@ -415,315 +415,980 @@ static Uint16 float_to_half(float a)
     return ir;
 }
 
-static void ReadFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, SDL_Colorspace colorspace, float SDR_white_point,
-                           float *outR, float *outG, float *outB, float *outA)
+/* The float blitter works on chunks of pixels at a time, so that each stage
+ * is a loop over a row of RGBA floats without any per-pixel format or
+ * colorspace decisions. Most stages have SSE2 and NEON versions, and the
+ * transfer function also has an AVX2 version. They handle one pixel at a time
+ * (two for AVX2) with the same operations in the same order as the C versions,
+ * so a value gives the same result wherever it is in the blit.
+ */
+#define SLOW_FLOAT_CHUNK_SIZE   64
+
+/* The sRGB and PQ transfer functions are calculated with lookup tables for
+ * values in [0, 1], and with the exact functions for anything else.
+ *
+ * The tables are indexed by the bits of the float value, which gives 128
+ * entries for each power of two from 2^-64 up to 1, and the result is
+ * interpolated linearly between the two nearest entries. The entries are
+ * calculated with the exact functions, and the largest differences from them
+ * are:
+ *   sRGB from linear:  1.5e-6
+ *   sRGB to linear:    6e-6
+ *   PQ from nits:      2.5e-5, which is about as precise as SDL_PQfromNits() itself
+ *   PQ to nits:        0.03% of the value, at most 2.5 nits
+ */
+#define SLOW_FLOAT_LUT_STEP_BITS    7
+#define SLOW_FLOAT_LUT_OCTAVES      64
+#define SLOW_FLOAT_LUT_SHIFT        (23 - SLOW_FLOAT_LUT_STEP_BITS)
+#define SLOW_FLOAT_LUT_MASK         ((1 << SLOW_FLOAT_LUT_SHIFT) - 1)
+#define SLOW_FLOAT_LUT_FRACTION     (1.0f / (1 << SLOW_FLOAT_LUT_SHIFT))
+#define SLOW_FLOAT_LUT_MIN          ((127 - SLOW_FLOAT_LUT_OCTAVES) << 23)  /* 2^-64 */
+#define SLOW_FLOAT_LUT_MAX          0x3F800000                          /* 1.0f */
+#define SLOW_FLOAT_LUT_SIZE         ((SLOW_FLOAT_LUT_OCTAVES << SLOW_FLOAT_LUT_STEP_BITS) + 2)
+
+typedef float (*SlowBlitTransferFunc)(float v);
+
+typedef struct
 {
-    Uint32 pixel;
-    Uint32 R, G, B, A;
-    float fR = 0.0f, fG = 0.0f, fB = 0.0f, fA = 0.0f;
-    float v[4];
+    SlowBlitTransferFunc func;
+    SDL_SpinLock lock;
+    SDL_AtomicInt ready;
+    float values[SLOW_FLOAT_LUT_SIZE];
+} SlowBlitTransferLUT;
 
-    switch (access) {
-    case SlowBlitPixelAccess_Index8:
-        pixel = *pixels;
-        fR = (float)pal->colors[pixel].r / 255.0f;
-        fG = (float)pal->colors[pixel].g / 255.0f;
-        fB = (float)pal->colors[pixel].b / 255.0f;
-        fA = (float)pal->colors[pixel].a / 255.0f;
+typedef union
+{
+    float f;
+    Sint32 i;
+} SlowBlitFloatBits;
+
+/* The PQ tables work on nits / 10000, so they have the same range as the sRGB ones */
+static float PQfromNormalizedNits(float v)
+{
+    return SDL_PQfromNits(v * 10000.0f);
+}
+
+static float PQtoNormalizedNits(float v)
+{
+    return SDL_PQtoNits(v) / 10000.0f;
+}
+
+static SlowBlitTransferLUT sRGBfromLinearLUT = { SDL_sRGBfromLinear };
+static SlowBlitTransferLUT sRGBtoLinearLUT = { SDL_sRGBtoLinear };
+static SlowBlitTransferLUT PQfromNitsLUT = { PQfromNormalizedNits };
+static SlowBlitTransferLUT PQtoNitsLUT = { PQtoNormalizedNits };
+
+static const float *GetTransferLUT(SlowBlitTransferLUT *lut)
+{
+    if (!SDL_AtomicGet(&lut->ready)) {
+        SDL_LockSpinlock(&lut->lock);
+        if (!SDL_AtomicGet(&lut->ready)) {
+            SlowBlitFloatBits bits;
+            int i;
+
+            for (i = 0; i < SLOW_FLOAT_LUT_SIZE - 1; ++i) {
+                bits.i = SLOW_FLOAT_LUT_MIN + (i << SLOW_FLOAT_LUT_SHIFT);
+                lut->values[i] = lut->func(bits.f);
+            }
+            /* 1.0 interpolates between the last two entries with a fraction of 0 */
+            lut->values[i] = lut->values[i - 1];
+            SDL_AtomicSet(&lut->ready, 1);
+        }
+        SDL_UnlockSpinlock(&lut->lock);
+    }
+    return lut->values;
+}
+
+typedef struct
+{
+    SDL_TransferCharacteristics transfer;
+    float SDR_white_point;
+
+    /* The table for sRGB and PQ, which is used as lut(v * in_scale) * out_scale */
+    const float *lut;
+    SlowBlitTransferFunc func;
+    float in_scale;
+    float out_scale;
+} SlowBlitTransfer;
+
+static void InitSlowBlitTransfer(SlowBlitTransfer *transfer, SDL_TransferCharacteristics characteristics, float SDR_white_point, SDL_bool encode)
+{
+    SlowBlitTransferLUT *lut = NULL;
+
+    SDL_zerop(transfer);
+    transfer->transfer = characteristics;
+    transfer->SDR_white_point = SDR_white_point;
+    transfer->in_scale = 1.0f;
+    transfer->out_scale = 1.0f;
+
+    switch (characteristics) {
+    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
+        lut = encode ? &sRGBfromLinearLUT : &sRGBtoLinearLUT;
         break;
-    case SlowBlitPixelAccess_RGB:
-        DISEMBLE_RGB(pixels, fmt->bytes_per_pixel, fmt, pixel, R, G, B);
-        fR = (float)R / 255.0f;
-        fG = (float)G / 255.0f;
-        fB = (float)B / 255.0f;
-        fA = 1.0f;
+    case SDL_TRANSFER_CHARACTERISTICS_PQ:
+        if (encode) {
+            lut = &PQfromNitsLUT;
+            transfer->in_scale = SDR_white_point / 10000.0f;
+        } else {
+            lut = &PQtoNitsLUT;
+            transfer->out_scale = 10000.0f / SDR_white_point;
+        }
         break;
-    case SlowBlitPixelAccess_RGBA:
-        DISEMBLE_RGBA(pixels, fmt->bytes_per_pixel, fmt, pixel, R, G, B, A);
-        fR = (float)R / 255.0f;
-        fG = (float)G / 255.0f;
-        fB = (float)B / 255.0f;
-        fA = (float)A / 255.0f;
+    default:
         break;
-    case SlowBlitPixelAccess_10Bit:
-        pixel = *((Uint32 *)pixels);
-        switch (fmt->format) {
-        case SDL_PIXELFORMAT_XRGB2101010:
-            RGBAFLOAT_FROM_ARGB2101010(pixel, fR, fG, fB, fA);
-            fA = 1.0f;
-            break;
-        case SDL_PIXELFORMAT_XBGR2101010:
-            RGBAFLOAT_FROM_ABGR2101010(pixel, fR, fG, fB, fA);
-            fA = 1.0f;
-            break;
-        case SDL_PIXELFORMAT_ARGB2101010:
-            RGBAFLOAT_FROM_ARGB2101010(pixel, fR, fG, fB, fA);
-            break;
-        case SDL_PIXELFORMAT_ABGR2101010:
-            RGBAFLOAT_FROM_ABGR2101010(pixel, fR, fG, fB, fA);
-            break;
-        default:
-            fR = fG = fB = fA = 0.0f;
-            break;
+    }
+    if (lut) {
+        transfer->lut = GetTransferLUT(lut);
+        transfer->func = lut->func;
+    }
+}
+
+static SDL_INLINE float LookupTransfer(float v, const SlowBlitTransfer *transfer)
+{
+    SlowBlitFloatBits bits;
+
+    bits.f = v * transfer->in_scale;
+    if (bits.i >= 0 && bits.i <= SLOW_FLOAT_LUT_MAX) {
+        const Sint32 offset = SDL_max(bits.i, SLOW_FLOAT_LUT_MIN) - SLOW_FLOAT_LUT_MIN;
+        const float *entry = &transfer->lut[offset >> SLOW_FLOAT_LUT_SHIFT];
+        const float frac = (float)(offset & SLOW_FLOAT_LUT_MASK) * SLOW_FLOAT_LUT_FRACTION;
+        v = entry[0] + frac * (entry[1] - entry[0]);
+    } else {
+        v = transfer->func(bits.f);
+    }
+    return v * transfer->out_scale;
+}
+
+static void TransferRowLUT(float *rgba, int n, const SlowBlitTransfer *transfer)
+{
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        rgba[0] = LookupTransfer(rgba[0], transfer);
+        rgba[1] = LookupTransfer(rgba[1], transfer);
+        rgba[2] = LookupTransfer(rgba[2], transfer);
+    }
+}
+
+static void ConvertPrimariesRow(float *rgba, int n, const float *matrix)
+{
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        SDL_ConvertColorPrimaries(&rgba[0], &rgba[1], &rgba[2], matrix);
+    }
+}
+
+/* modulate has the factors for R, G, B and A, which are 1.0 if they're not used */
+static void ModulateRow(float *rgba, int n, const float *modulate)
+{
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        rgba[0] *= modulate[0];
+        rgba[1] *= modulate[1];
+        rgba[2] *= modulate[2];
+        rgba[3] *= modulate[3];
+    }
+}
+
+static void PremultiplyRow(float *rgba, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        if (rgba[3] < 1.0f) {
+            rgba[0] *= rgba[3];
+            rgba[1] *= rgba[3];
+            rgba[2] *= rgba[3];
+        }
+    }
+}
+
+static void BlendRow(const float *s, float *d, int n, int blend)
+{
+    int i;
+
+    switch (blend) {
+    case SDL_COPY_BLEND:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            const float inv_srcA = 1.0f - s[3];
+            d[0] = s[0] + (inv_srcA * d[0]);
+            d[1] = s[1] + (inv_srcA * d[1]);
+            d[2] = s[2] + (inv_srcA * d[2]);
+            d[3] = s[3] + (inv_srcA * d[3]);
         }
         break;
-    case SlowBlitPixelAccess_Large:
-        switch (SDL_PIXELTYPE(fmt->format)) {
-        case SDL_PIXELTYPE_ARRAYU16:
-            v[0] = (float)(((Uint16 *)pixels)[0]) / SDL_MAX_UINT16;
-            v[1] = (float)(((Uint16 *)pixels)[1]) / SDL_MAX_UINT16;
-            v[2] = (float)(((Uint16 *)pixels)[2]) / SDL_MAX_UINT16;
-            if (fmt->bytes_per_pixel == 8) {
-                v[3] = (float)(((Uint16 *)pixels)[3]) / SDL_MAX_UINT16;
-            } else {
-                v[3] = 1.0f;
-            }
-            break;
-        case SDL_PIXELTYPE_ARRAYF16:
-            v[0] = half_to_float(((Uint16 *)pixels)[0]);
-            v[1] = half_to_float(((Uint16 *)pixels)[1]);
-            v[2] = half_to_float(((Uint16 *)pixels)[2]);
-            if (fmt->bytes_per_pixel == 8) {
-                v[3] = half_to_float(((Uint16 *)pixels)[3]);
-            } else {
-                v[3] = 1.0f;
-            }
-            break;
-        case SDL_PIXELTYPE_ARRAYF32:
-            v[0] = ((float *)pixels)[0];
-            v[1] = ((float *)pixels)[1];
-            v[2] = ((float *)pixels)[2];
-            if (fmt->bytes_per_pixel == 16) {
-                v[3] = ((float *)pixels)[3];
-            } else {
-                v[3] = 1.0f;
-            }
-            break;
-        default:
-            /* Unknown array type */
-            v[0] = v[1] = v[2] = v[3] = 0.0f;
-            break;
+    case SDL_COPY_ADD:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            d[0] = s[0] + d[0];
+            d[1] = s[1] + d[1];
+            d[2] = s[2] + d[2];
         }
-        switch (SDL_PIXELORDER(fmt->format)) {
-        case SDL_ARRAYORDER_RGB:
-            fR = v[0];
-            fG = v[1];
-            fB = v[2];
-            fA = 1.0f;
-            break;
-        case SDL_ARRAYORDER_RGBA:
-            fR = v[0];
-            fG = v[1];
-            fB = v[2];
-            fA = v[3];
-            break;
-        case SDL_ARRAYORDER_ARGB:
-            fA = v[0];
-            fR = v[1];
-            fG = v[2];
-            fB = v[3];
-            break;
-        case SDL_ARRAYORDER_BGR:
-            fB = v[0];
-            fG = v[1];
-            fR = v[2];
-            fA = 1.0f;
-            break;
-        case SDL_ARRAYORDER_BGRA:
-            fB = v[0];
-            fG = v[1];
-            fR = v[2];
-            fA = v[3];
-            break;
-        case SDL_ARRAYORDER_ABGR:
-            fA = v[0];
-            fB = v[1];
-            fG = v[2];
-            fR = v[3];
-            break;
-        default:
-            /* Unknown array order */
-            fA = fR = fG = fB = 0.0f;
-            break;
+        break;
+    case SDL_COPY_MOD:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            d[0] = (s[0] * d[0]);
+            d[1] = (s[1] * d[1]);
+            d[2] = (s[2] * d[2]);
+        }
+        break;
+    case SDL_COPY_MUL:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            const float inv_srcA = 1.0f - s[3];
+            d[0] = ((s[0] * d[0]) + (d[0] * inv_srcA));
+            d[1] = ((s[1] * d[1]) + (d[1] * inv_srcA));
+            d[2] = ((s[2] * d[2]) + (d[2] * inv_srcA));
         }
         break;
+    case 0:
+        SDL_memcpy(d, s, n * 4 * sizeof(float));
+        break;
     }
+}
 
-    /* Convert to nits so src and dst are guaranteed to be linear and in the same units */
-    switch (SDL_COLORSPACETRANSFER(colorspace)) {
-    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
-        fR = SDL_sRGBtoLinear(fR);
-        fG = SDL_sRGBtoLinear(fG);
-        fB = SDL_sRGBtoLinear(fB);
+#ifdef SDL_SSE2_INTRINSICS
+
+static void SDL_TARGETING("sse2") TransferRowLUT_SSE2(float *rgba, int n, const SlowBlitTransfer *transfer)
+{
+    const float *lut = transfer->lut;
+    const __m128 in_scale = _mm_setr_ps(transfer->in_scale, transfer->in_scale, transfer->in_scale, 1.0f);
+    const __m128 out_scale = _mm_setr_ps(transfer->out_scale, transfer->out_scale, transfer->out_scale, 1.0f);
+    const __m128 fraction = _mm_set1_ps(SLOW_FLOAT_LUT_FRACTION);
+    const __m128i lut_min = _mm_set1_epi32(SLOW_FLOAT_LUT_MIN);
+    const __m128i lut_max = _mm_set1_epi32(SLOW_FLOAT_LUT_MAX);
+    const __m128i lut_mask = _mm_set1_epi32(SLOW_FLOAT_LUT_MASK);
+    const __m128i color = _mm_setr_epi32(-1, -1, -1, 0);
+    const __m128i zero = _mm_setzero_si128();
+    Sint32 index[4];
+    Sint32 outside_lanes[4];
+    float v[4];
+    int i, j;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        const __m128 scaled = _mm_mul_ps(_mm_loadu_ps(rgba), in_scale);
+        const __m128i bits = _mm_castps_si128(scaled);
+        const __m128i outside = _mm_and_si128(_mm_or_si128(_mm_cmplt_epi32(bits, zero), _mm_cmpgt_epi32(bits, lut_max)), color);
+        const __m128i inside = _mm_andnot_si128(outside, color);
+        const __m128i below = _mm_cmplt_epi32(bits, lut_min);
+        __m128i offset;
+        __m128 frac, lo, hi, result;
+
+        offset = _mm_sub_epi32(_mm_or_si128(_mm_andnot_si128(below, bits), _mm_and_si128(below, lut_min)), lut_min);
+        offset = _mm_and_si128(offset, inside);
+        frac = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(offset, lut_mask)), fraction);
+        _mm_storeu_si128((__m128i *)index, _mm_srli_epi32(offset, SLOW_FLOAT_LUT_SHIFT));
+        lo = _mm_setr_ps(lut[index[0]], lut[index[1]], lut[index[2]], 0.0f);
+        hi = _mm_setr_ps(lut[index[0] + 1], lut[index[1] + 1], lut[index[2] + 1], 0.0f);
+        result = _mm_add_ps(lo, _mm_mul_ps(frac, _mm_sub_ps(hi, lo)));
+        result = _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(inside), result), _mm_andnot_ps(_mm_castsi128_ps(inside), scaled));
+        if (_mm_movemask_epi8(outside)) {
+            _mm_storeu_si128((__m128i *)outside_lanes, outside);
+            _mm_storeu_ps(v, result);
+            for (j = 0; j < 3; ++j) {
+                if (outside_lanes[j]) {
+                    v[j] = transfer->func(v[j]);
+                }
+            }
+            result = _mm_loadu_ps(v);
+        }
+        _mm_storeu_ps(rgba, _mm_mul_ps(result, out_scale));
+    }
+}
+
+static void SDL_TARGETING("sse2") ConvertPrimariesRow_SSE2(float *rgba, int n, const float *matrix)
+{
+    const __m128 m0 = _mm_setr_ps(matrix[0 * 3 + 0], matrix[1 * 3 + 0], matrix[2 * 3 + 0], 0.0f);
+    const __m128 m1 = _mm_setr_ps(matrix[0 * 3 + 1], matrix[1 * 3 + 1], matrix[2 * 3 + 1], 0.0f);
+    const __m128 m2 = _mm_setr_ps(matrix[0 * 3 + 2], matrix[1 * 3 + 2], matrix[2 * 3 + 2], 0.0f);
+    const __m128 color = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        const __m128 v = _mm_loadu_ps(rgba);
+        __m128 result;
+
+        result = _mm_mul_ps(m0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+        result = _mm_add_ps(result, _mm_mul_ps(m1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+        result = _mm_add_ps(result, _mm_mul_ps(m2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+        _mm_storeu_ps(rgba, _mm_or_ps(_mm_and_ps(color, result), _mm_andnot_ps(color, v)));
+    }
+}
+
+static void SDL_TARGETING("sse2") ModulateRow_SSE2(float *rgba, int n, const float *modulate)
+{
+    const __m128 m = _mm_loadu_ps(modulate);
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        _mm_storeu_ps(rgba, _mm_mul_ps(_mm_loadu_ps(rgba), m));
+    }
+}
+
+static void SDL_TARGETING("sse2") PremultiplyRow_SSE2(float *rgba, int n)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 color = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        const __m128 v = _mm_loadu_ps(rgba);
+        /* _mm_min_ps() returns 1.0 if alpha is NaN, which leaves the color alone, like the C version */
+        const __m128 a = _mm_min_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), one);
+        const __m128 factor = _mm_or_ps(_mm_and_ps(color, a), _mm_andnot_ps(color, one));
+        _mm_storeu_ps(rgba, _mm_mul_ps(v, factor));
+    }
+}
+
+static void SDL_TARGETING("sse2") BlendRow_SSE2(const float *s, float *d, int n, int blend)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 color = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    __m128 src, dst, inv_srcA, result;
+    int i;
+
+    switch (blend) {
+    case SDL_COPY_BLEND:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            src = _mm_loadu_ps(s);
+            inv_srcA = _mm_sub_ps(one, _mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3)));
+            _mm_storeu_ps(d, _mm_add_ps(src, _mm_mul_ps(inv_srcA, _mm_loadu_ps(d))));
+        }
         break;
-    case SDL_TRANSFER_CHARACTERISTICS_PQ:
-        fR = SDL_PQtoNits(fR) / SDR_white_point;
-        fG = SDL_PQtoNits(fG) / SDR_white_point;
-        fB = SDL_PQtoNits(fB) / SDR_white_point;
+    case SDL_COPY_ADD:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            dst = _mm_loadu_ps(d);
+            result = _mm_add_ps(_mm_loadu_ps(s), dst);
+            _mm_storeu_ps(d, _mm_or_ps(_mm_and_ps(color, result), _mm_andnot_ps(color, dst)));
+        }
         break;
-    case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
-        fR /= SDR_white_point;
-        fG /= SDR_white_point;
-        fB /= SDR_white_point;
+    case SDL_COPY_MOD:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            dst = _mm_loadu_ps(d);
+            result = _mm_mul_ps(_mm_loadu_ps(s), dst);
+            _mm_storeu_ps(d, _mm_or_ps(_mm_and_ps(color, result), _mm_andnot_ps(color, dst)));
+        }
         break;
-    default:
-        /* Unknown, leave it alone */
+    case SDL_COPY_MUL:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            src = _mm_loadu_ps(s);
+            dst = _mm_loadu_ps(d);
+            inv_srcA = _mm_sub_ps(one, _mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3)));
+            result = _mm_add_ps(_mm_mul_ps(src, dst), _mm_mul_ps(dst, inv_srcA));
+            _mm_storeu_ps(d, _mm_or_ps(_mm_and_ps(color, result), _mm_andnot_ps(color, dst)));
+        }
+        break;
+    case 0:
+        SDL_memcpy(d, s, n * 4 * sizeof(float));
         break;
     }
+}
 
-    *outR = fR;
-    *outG = fG;
-    *outB = fB;
-    *outA = fA;
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+
+/* Two pixels at a time with gathers from the table, the last odd pixel is done by the SSE2 version */
+static void SDL_TARGETING("avx2") TransferRowLUT_AVX2(float *rgba, int n, const SlowBlitTransfer *transfer)
+{
+    const float *lut = transfer->lut;
+    const __m256 in_scale = _mm256_setr_ps(transfer->in_scale, transfer->in_scale, transfer->in_scale, 1.0f,
+                                           transfer->in_scale, transfer->in_scale, transfer->in_scale, 1.0f);
+    const __m256 out_scale = _mm256_setr_ps(transfer->out_scale, transfer->out_scale, transfer->out_scale, 1.0f,
+                                            transfer->out_scale, transfer->out_scale, transfer->out_scale, 1.0f);
+    const __m256 fraction = _mm256_set1_ps(SLOW_FLOAT_LUT_FRACTION);
+    const __m256i lut_min = _mm256_set1_epi32(SLOW_FLOAT_LUT_MIN);
+    const __m256i lut_max = _mm256_set1_epi32(SLOW_FLOAT_LUT_MAX);
+    const __m256i lut_mask = _mm256_set1_epi32(SLOW_FLOAT_LUT_MASK);
+    const __m256i color = _mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m256i zero = _mm256_setzero_si256();
+    Sint32 outside_lanes[8];
+    float v[8];
+    int i, j;
+
+    for (i = 0; i + 1 < n; i += 2, rgba += 8) {
+        const __m256 scaled = _mm256_mul_ps(_mm256_loadu_ps(rgba), in_scale);
+        const __m256i bits = _mm256_castps_si256(scaled);
+        const __m256i outside = _mm256_and_si256(_mm256_or_si256(_mm256_cmpgt_epi32(zero, bits), _mm256_cmpgt_epi32(bits, lut_max)), color);
+        const __m256i inside = _mm256_andnot_si256(outside, color);
+        __m256i offset, index;
+        __m256 frac, lo, hi, result;
+
+        offset = _mm256_and_si256(_mm256_sub_epi32(_mm256_max_epi32(bits, lut_min), lut_min), inside);
+        frac = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(offset, lut_mask)), fraction);
+        index = _mm256_srli_epi32(offset, SLOW_FLOAT_LUT_SHIFT);
+        lo = _mm256_i32gather_ps(lut, index, 4);
+        hi = _mm256_i32gather_ps(lut + 1, index, 4);
+        result = _mm256_add_ps(lo, _mm256_mul_ps(frac, _mm256_sub_ps(hi, lo)));
+        result = _mm256_blendv_ps(scaled, result, _mm256_castsi256_ps(inside));
+        if (!_mm256_testz_si256(outside, outside)) {
+            _mm256_storeu_si256((__m256i *)outside_lanes, outside);
+            _mm256_storeu_ps(v, result);
+            for (j = 0; j < 8; ++j) {
+                if (outside_lanes[j]) {
+                    v[j] = transfer->func(v[j]);
+                }
+            }
+            result = _mm256_loadu_ps(v);
+        }
+        _mm256_storeu_ps(rgba, _mm256_mul_ps(result, out_scale));
+    }
+    if (i < n) {
+        TransferRowLUT_SSE2(rgba, n - i, transfer);
+    }
 }
 
-static void WriteFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, Uint8 *table, SDL_Colorspace colorspace, float SDR_white_point,
-                            float fR, float fG, float fB, float fA)
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+
+static void TransferRowLUT_NEON(float *rgba, int n, const SlowBlitTransfer *transfer)
 {
-    Uint32 R, G, B, A;
-    Uint32 pixel;
+    const float *lut = transfer->lut;
+    const float in_scale_values[4] = { transfer->in_scale, transfer->in_scale, transfer->in_scale, 1.0f };
+    const float out_scale_values[4] = { transfer->out_scale, transfer->out_scale, transfer->out_scale, 1.0f };
+    const Uint32 color_values[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 };
+    const float32x4_t in_scale = vld1q_f32(in_scale_values);
+    const float32x4_t out_scale = vld1q_f32(out_scale_values);
+    const float32x4_t fraction = vdupq_n_f32(SLOW_FLOAT_LUT_FRACTION);
+    const int32x4_t lut_min = vdupq_n_s32(SLOW_FLOAT_LUT_MIN);
+    const int32x4_t lut_max = vdupq_n_s32(SLOW_FLOAT_LUT_MAX);
+    const int32x4_t lut_mask = vdupq_n_s32(SLOW_FLOAT_LUT_MASK);
+    const int32x4_t zero = vdupq_n_s32(0);
+    const uint32x4_t color = vld1q_u32(color_values);
+    Sint32 index[4];
+    Uint32 outside_lanes[4];
     float v[4];
+    int i, j;
 
-    /* We converted to nits so src and dst are guaranteed to be linear and in the same units */
-    switch (SDL_COLORSPACETRANSFER(colorspace)) {
-    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
-        fR = SDL_sRGBfromLinear(fR);
-        fG = SDL_sRGBfromLinear(fG);
-        fB = SDL_sRGBfromLinear(fB);
+    for (i = 0; i < n; ++i, rgba += 4) {
+        const float32x4_t scaled = vmulq_f32(vld1q_f32(rgba), in_scale);
+        const int32x4_t bits = vreinterpretq_s32_f32(scaled);
+        const uint32x4_t outside = vandq_u32(vorrq_u32(vcltq_s32(bits, zero), vcgtq_s32(bits, lut_max)), color);
+        const uint32x4_t inside = vbicq_u32(color, outside);
+        const uint32x2_t any_outside = vorr_u32(vget_low_u32(outside), vget_high_u32(outside));
+        int32x4_t offset;
+        float32x4_t frac, lo, hi, result;
+        float values[4];
+
+        offset = vandq_s32(vsubq_s32(vmaxq_s32(bits, lut_min), lut_min), vreinterpretq_s32_u32(inside));
+        frac = vmulq_f32(vcvtq_f32_s32(vandq_s32(offset, lut_mask)), fraction);
+        vst1q_s32(index, vshrq_n_s32(offset, SLOW_FLOAT_LUT_SHIFT));
+        values[0] = lut[index[0]];
+        values[1] = lut[index[1]];
+        values[2] = lut[index[2]];
+        values[3] = 0.0f;
+        lo = vld1q_f32(values);
+        values[0] = lut[index[0] + 1];
+        values[1] = lut[index[1] + 1];
+        values[2] = lut[index[2] + 1];
+        hi = vld1q_f32(values);
+        result = vaddq_f32(lo, vmulq_f32(frac, vsubq_f32(hi, lo)));
+        result = vbslq_f32(inside, result, scaled);
+        if (vget_lane_u32(any_outside, 0) | vget_lane_u32(any_outside, 1)) {
+            vst1q_u32(outside_lanes, outside);
+            vst1q_f32(v, result);
+            for (j = 0; j < 3; ++j) {
+                if (outside_lanes[j]) {
+                    v[j] = transfer->func(v[j]);
+                }
+            }
+            result = vld1q_f32(v);
+        }
+        vst1q_f32(rgba, vmulq_f32(result, out_scale));
+    }
+}
+
+static void ConvertPrimariesRow_NEON(float *rgba, int n, const float *matrix)
+{
+    const float m0_values[4] = { matrix[0 * 3 + 0], matrix[1 * 3 + 0], matrix[2 * 3 + 0], 0.0f };
+    const float m1_values[4] = { matrix[0 * 3 + 1], matrix[1 * 3 + 1], matrix[2 * 3 + 1], 0.0f };
+    const float m2_values[4] = { matrix[0 * 3 + 2], matrix[1 * 3 + 2], matrix[2 * 3 + 2], 0.0f };
+    const Uint32 color_values[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 };
+    const float32x4_t m0 = vld1q_f32(m0_values);
+    const float32x4_t m1 = vld1q_f32(m1_values);
+    const float32x4_t m2 = vld1q_f32(m2_values);
+    const uint32x4_t color = vld1q_u32(color_values);
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        const float32x4_t v = vld1q_f32(rgba);
+        float32x4_t result;
+
+        /* Separate multiplies and adds, so the result is the same as SDL_ConvertColorPrimaries() */
+        result = vmulq_f32(m0, vdupq_n_f32(vgetq_lane_f32(v, 0)));
+        result = vaddq_f32(result, vmulq_f32(m1, vdupq_n_f32(vgetq_lane_f32(v, 1))));
+        result = vaddq_f32(result, vmulq_f32(m2, vdupq_n_f32(vgetq_lane_f32(v, 2))));
+        vst1q_f32(rgba, vbslq_f32(color, result, v));
+    }
+}
+
+static void ModulateRow_NEON(float *rgba, int n, const float *modulate)
+{
+    const float32x4_t m = vld1q_f32(modulate);
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        vst1q_f32(rgba, vmulq_f32(vld1q_f32(rgba), m));
+    }
+}
+
+static void PremultiplyRow_NEON(float *rgba, int n)
+{
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    int i;
+
+    for (i = 0; i < n; ++i, rgba += 4) {
+        const float32x4_t v = vld1q_f32(rgba);
+        const float32x4_t a = vdupq_n_f32(vgetq_lane_f32(v, 3));
+        /* Multiply by 1.0 unless alpha is less than 1.0, including the alpha itself */
+        float32x4_t factor = vbslq_f32(vcltq_f32(a, one), a, one);
+        factor = vsetq_lane_f32(1.0f, factor, 3);
+        vst1q_f32(rgba, vmulq_f32(v, factor));
+    }
+}
+
+static void BlendRow_NEON(const float *s, float *d, int n, int blend)
+{
+    const Uint32 color_values[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 };
+    const uint32x4_t color = vld1q_u32(color_values);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t src, dst, inv_srcA, result;
+    int i;
+
+    switch (blend) {
+    case SDL_COPY_BLEND:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            src = vld1q_f32(s);
+            inv_srcA = vsubq_f32(one, vdupq_n_f32(vgetq_lane_f32(src, 3)));
+            vst1q_f32(d, vaddq_f32(src, vmulq_f32(inv_srcA, vld1q_f32(d))));
+        }
         break;
-    case SDL_TRANSFER_CHARACTERISTICS_PQ:
-        fR = SDL_PQfromNits(fR * SDR_white_point);
-        fG = SDL_PQfromNits(fG * SDR_white_point);
-        fB = SDL_PQfromNits(fB * SDR_white_point);
+    case SDL_COPY_ADD:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            dst = vld1q_f32(d);
+            result = vaddq_f32(vld1q_f32(s), dst);
+            vst1q_f32(d, vbslq_f32(color, result, dst));
+        }
         break;
-    case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
-        fR *= SDR_white_point;
-        fG *= SDR_white_point;
-        fB *= SDR_white_point;
+    case SDL_COPY_MOD:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            dst = vld1q_f32(d);
+            result = vmulq_f32(vld1q_f32(s), dst);
+            vst1q_f32(d, vbslq_f32(color, result, dst));
+        }
         break;
-    default:
-        /* Unknown, leave it alone */
+    case SDL_COPY_MUL:
+        for (i = 0; i < n; ++i, s += 4, d += 4) {
+            src = vld1q_f32(s);
+            dst = vld1q_f32(d);
+            inv_srcA = vsubq_f32(one, vdupq_n_f32(vgetq_lane_f32(src, 3)));
+            result = vaddq_f32(vmulq_f32(src, dst), vmulq_f32(dst, inv_srcA));
+            vst1q_f32(d, vbslq_f32(color, result, dst));
+        }
+        break;
+    case 0:
+        SDL_memcpy(d, s, n * 4 * sizeof(float));
         break;
     }
+}
+
+#endif /* SDL_NEON_INTRINSICS */
+
+typedef struct
+{
+    void (*transfer)(float *rgba, int n, const SlowBlitTransfer *transfer);
+    void (*convert_primaries)(float *rgba, int n, const float *matrix);
+    void (*modulate)(float *rgba, int n, const float *modulate);
+    void (*premultiply)(float *rgba, int n);
+    void (*blend)(const float *s, float *d, int n, int blend);
+} SlowBlitFloatKernels;
+
+static void GetSlowBlitFloatKernels(SlowBlitFloatKernels *kernels)
+{
+    kernels->transfer = TransferRowLUT;
+    kernels->convert_primaries = ConvertPrimariesRow;
+    kernels->modulate = ModulateRow;
+    kernels->premultiply = PremultiplyRow;
+    kernels->blend = BlendRow;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        kernels->transfer = TransferRowLUT_SSE2;
+        kernels->convert_primaries = ConvertPrimariesRow_SSE2;
+        kernels->modulate = ModulateRow_SSE2;
+        kernels->premultiply = PremultiplyRow_SSE2;
+        kernels->blend = BlendRow_SSE2;
+    }
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasSSE2() && SDL_HasAVX2()) {
+        kernels->transfer = TransferRowLUT_AVX2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        kernels->transfer = TransferRowLUT_NEON;
+        kernels->convert_primaries = ConvertPrimariesRow_NEON;
+        kernels->modulate = ModulateRow_NEON;
+        kernels->premultiply = PremultiplyRow_NEON;
+        kernels->blend = BlendRow_NEON;
+    }
+#endif
+}
+
+/* Convert to nits so src and dst are guaranteed to be linear and in the same units */
+static void DecodeTransferRow(const SlowBlitFloatKernels *kernels, const SlowBlitTransfer *transfer, float *rgba, int n)
+{
+    int i;
+
+    if (transfer->lut) {
+        kernels->transfer(rgba, n, transfer);
+    } else if (transfer->transfer == SDL_TRANSFER_CHARACTERISTICS_LINEAR) {
+        for (i = 0; i < n; ++i, rgba += 4) {
+            rgba[0] /= transfer->SDR_white_point;
+            rgba[1] /= transfer->SDR_white_point;
+            rgba[2] /= transfer->SDR_white_point;
+        }
+    } else {
+        /* Unknown, leave it alone */
+    }
+}
+
+/* We converted to nits so src and dst are guaranteed to be linear and in the same units */
+static void EncodeTransferRow(const SlowBlitFloatKernels *kernels, const SlowBlitTransfer *transfer, float *rgba, int n)
+{
+    int i;
+
+    if (transfer->lut) {
+        kernels->transfer(rgba, n, transfer);
+    } else if (transfer->transfer == SDL_TRANSFER_CHARACTERISTICS_LINEAR) {
+        for (i = 0; i < n; ++i, rgba += 4) {
+            rgba[0] *= transfer->SDR_white_point;
+            rgba[1] *= transfer->SDR_white_point;
+            rgba[2] *= transfer->SDR_white_point;
+        }
+    } else {
+        /* Unknown, leave it alone */
+    }
+}
+
+/* Blits with at least this many pixels decode 8-bit and 10-bit values through
+ * tables. The tables hold what DecodeTransferRow() gives for each value, so
+ * the result doesn't depend on the size of the blit.
+ */
+#define SLOW_FLOAT_TABLE_THRESHOLD  1024
+
+typedef struct
+{
+    float decode8[256];
+    float decode10[1024];
+} SlowBlitFloatTables;
+
+static void InitSlowBlitFloatTables(SlowBlitFloatTables *tables, const SlowBlitFloatKernels *kernels, const SlowBlitTransfer *transfer)
+{
+    float rgba[4];
+    int i;
+
+    for (i = 0; i < SDL_arraysize(tables->decode8); ++i) {
+        rgba[0] = rgba[1] = rgba[2] = rgba[3] = (float)i / 255.0f;
+        DecodeTransferRow(kernels, transfer, rgba, 1);
+        tables->decode8[i] = rgba[0];
+    }
+    for (i = 0; i < SDL_arraysize(tables->decode10); ++i) {
+        rgba[0] = rgba[1] = rgba[2] = rgba[3] = (float)i / 1023.0f;
+        DecodeTransferRow(kernels, transfer, rgba, 1);
+        tables->decode10[i] = rgba[0];
+    }
+}
+
+/* Read n pixels sampled at the 16.16 fixed point positions posx, posx + incx, ...
+ * If decode is set, the color values are looked up in it, otherwise they're left encoded.
+ */
+static void ReadFloatRow(const Uint8 *src, Uint64 posx, Uint64 incx, int n, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal,
+                         const float *decode, float *rgba)
+{
+    const int bpp = fmt->bytes_per_pixel;
+    Uint32 pixel;
+    Uint32 R, G, B, A;
+    float v[4];
+    int i;
 
     switch (access) {
     case SlowBlitPixelAccess_Index8:
-        R = (Uint8)SDL_roundf(SDL_clamp(fR, 0.0f, 1.0f) * 7.0f);
-        G = (Uint8)SDL_roundf(SDL_clamp(fG, 0.0f, 1.0f) * 7.0f);
-        B = (Uint8)SDL_roundf(SDL_clamp(fB, 0.0f, 1.0f) * 3.0f);
-        pixel = (R << 5) | (G << 2) | B;
-        if (table) {
-            *pixels = table[pixel];
-        } else {
-            *pixels = pixel;
+        for (i = 0; i < n; ++i, posx += incx, rgba += 4) {
+            const SDL_Color *color = &pal->colors[src[posx >> 16]];
+            if (decode) {
+                rgba[0] = decode[color->r];
+                rgba[1] = decode[color->g];
+                rgba[2] = decode[color->b];
+            } else {
+                rgba[0] = (float)color->r / 255.0f;
+                rgba[1] = (float)color->g / 255.0f;
+                rgba[2] = (float)color->b / 255.0f;
+            }
+            rgba[3] = (float)color->a / 255.0f;
         }
         break;
     case SlowBlitPixelAccess_RGB:
-        R = (Uint8)SDL_roundf(SDL_clamp(fR, 0.0f, 1.0f) * 255.0f);
-        G = (Uint8)SDL_roundf(SDL_clamp(fG, 0.0f, 1.0f) * 255.0f);
-        B = (Uint8)SDL_roundf(SDL_clamp(fB, 0.0f, 1.0f) * 255.0f);
-        ASSEMBLE_RGB(pixels, fmt->bytes_per_pixel, fmt, R, G, B);
-        break;
     case SlowBlitPixelAccess_RGBA:
-        R = (Uint8)SDL_roundf(SDL_clamp(fR, 0.0f, 1.0f) * 255.0f);
-        G = (Uint8)SDL_roundf(SDL_clamp(fG, 0.0f, 1.0f) * 255.0f);
-        B = (Uint8)SDL_roundf(SDL_clamp(fB, 0.0f, 1.0f) * 255.0f);
-        A = (Uint8)SDL_roundf(SDL_clamp(fA, 0.0f, 1.0f) * 255.0f);
-        ASSEMBLE_RGBA(pixels, fmt->bytes_per_pixel, fmt, R, G, B, A);
+        for (i = 0; i < n; ++i, posx += incx, rgba += 4) {
+            const Uint8 *pixels = src + (posx >> 16) * bpp;
+            if (access == SlowBlitPixelAccess_RGBA) {
+                DISEMBLE_RGBA(pixels, bpp, fmt, pixel, R, G, B, A);
+            } else {
+                DISEMBLE_RGB(pixels, bpp, fmt, pixel, R, G, B);
+                A = 255;
+            }
+            if (decode) {
+                rgba[0] = decode[R];
+                rgba[1] = decode[G];
+                rgba[2] = decode[B];
+            } else {
+                rgba[0] = (float)R / 255.0f;
+                rgba[1] = (float)G / 255.0f;
+                rgba[2] = (float)B / 255.0f;
+            }
+            rgba[3] = (float)A / 255.0f;
+        }
         break;
     case SlowBlitPixelAccess_10Bit:
     {
-        switch (fmt->format) {
-        case SDL_PIXELFORMAT_XRGB2101010:
-            fA = 1.0f;
-            SDL_FALLTHROUGH;
-        case SDL_PIXELFORMAT_ARGB2101010:
-            ARGB2101010_FROM_RGBAFLOAT(pixel, fR, fG, fB, fA);
-            break;
-        case SDL_PIXELFORMAT_XBGR2101010:
-            fA = 1.0f;
-            SDL_FALLTHROUGH;
-        case SDL_PIXELFORMAT_ABGR2101010:
-            ABGR2101010_FROM_RGBAFLOAT(pixel, fR, fG, fB, fA);
-            break;
-        default:
-            pixel = 0;
-            break;
+        const SDL_bool abgr = (fmt->format == SDL_PIXELFORMAT_XBGR2101010 || fmt->format == SDL_PIXELFORMAT_ABGR2101010);
+        const SDL_bool has_alpha = (fmt->format == SDL_PIXELFORMAT_ARGB2101010 || fmt->format == SDL_PIXELFORMAT_ABGR2101010);
+
+        for (i = 0; i < n; ++i, posx += incx, rgba += 4) {
+            pixel = *(const Uint32 *)(src + (posx >> 16) * 4);
+            if (abgr) {
+                R = (pixel >> 0) & 0x3FF;
+                B = (pixel >> 20) & 0x3FF;
+            } else {
+                R = (pixel >> 20) & 0x3FF;
+                B = (pixel >> 0) & 0x3FF;
+            }
+            G = (pixel >> 10) & 0x3FF;
+            if (decode) {
+                rgba[0] = decode[R];
+                rgba[1] = decode[G];
+                rgba[2] = decode[B];
+            } else {
+                rgba[0] = (float)R / 1023.0f;
+                rgba[1] = (float)G / 1023.0f;
+                rgba[2] = (float)B / 1023.0f;
+            }
+            rgba[3] = has_alpha ? (float)(pixel >> 30) / 3.0f : 1.0f;
         }
-        *(Uint32 *)pixels = pixel;
         break;
     }
     case SlowBlitPixelAccess_Large:
+    {
+        /* Map the array order to the position of R, G, B and A in the pixel */
+        int iR, iG, iB, iA;
+
         switch (SDL_PIXELORDER(fmt->format)) {
         case SDL_ARRAYORDER_RGB:
-            v[0] = fR;
-            v[1] = fG;
-            v[2] = fB;
-            v[3] = 1.0f;
+            iR = 0, iG = 1, iB = 2, iA = -1;
             break;
         case SDL_ARRAYORDER_RGBA:
-            v[0] = fR;
-            v[1] = fG;
-            v[2] = fB;
-            v[3] = fA;
+            iR = 0, iG = 1, iB = 2, iA = 3;
             break;
         case SDL_ARRAYORDER_ARGB:
-            v[0] = fA;
-            v[1] = fR;
-            v[2] = fG;
-            v[3] = fB;
+            iA = 0, iR = 1, iG = 2, iB = 3;
             break;
         case SDL_ARRAYORDER_BGR:
-            v[0] = fB;
-            v[1] = fG;
-            v[2] = fR;
-            v[3] = 1.0f;
+            iB = 0, iG = 1, iR = 2, iA = -1;
             break;
         case SDL_ARRAYORDER_BGRA:
-            v[0] = fB;
-            v[1] = fG;
-            v[2] = fR;
-            v[3] = fA;
+            iB = 0, iG = 1, iR = 2, iA = 3;
             break;
         case SDL_ARRAYORDER_ABGR:
-            v[0] = fA;
-            v[1] = fB;
-            v[2] = fG;
-            v[3] = fR;
+            iA = 0, iB = 1, iG = 2, iR = 3;
             break;
         default:
             /* Unknown array order */
-            v[0] = v[1] = v[2] = v[3] = 0.0f;
-            break;
+            SDL_memset(rgba, 0, n * 4 * sizeof(*rgba));
+            return;
         }
-        switch (SDL_PIXELTYPE(fmt->format)) {
-        case SDL_PIXELTYPE_ARRAYU16:
-            ((Uint16 *)pixels)[0] = (Uint16)SDL_roundf(SDL_clamp(v[0], 0.0f, 1.0f) * SDL_MAX_UINT16);
-            ((Uint16 *)pixels)[1] = (Uint16)SDL_roundf(SDL_clamp(v[1], 0.0f, 1.0f) * SDL_MAX_UINT16);
-            ((Uint16 *)pixels)[2] = (Uint16)SDL_roundf(SDL_clamp(v[2], 0.0f, 1.0f) * SDL_MAX_UINT16);
-            if (fmt->bytes_per_pixel == 8) {
-                ((Uint16 *)pixels)[3] = (Uint16)SDL_roundf(SDL_clamp(v[3], 0.0f, 1.0f) * SDL_MAX_UINT16);
+
+        for (i = 0; i < n; ++i, posx += incx, rgba += 4) {
+            const Uint8 *pixels = src + (posx >> 16) * bpp;
+
+            switch (SDL_PIXELTYPE(fmt->format)) {
+            case SDL_PIXELTYPE_ARRAYU16:
+                v[0] = (float)(((const Uint16 *)pixels)[0]) / SDL_MAX_UINT16;
+                v[1] = (float)(((const Uint16 *)pixels)[1]) / SDL_MAX_UINT16;
+                v[2] = (float)(((const Uint16 *)pixels)[2]) / SDL_MAX_UINT16;
+                v[3] = (bpp == 8) ? (float)(((const Uint16 *)pixels)[3]) / SDL_MAX_UINT16 : 1.0f;
+                break;
+            case SDL_PIXELTYPE_ARRAYF16:
+                v[0] = half_to_float(((const Uint16 *)pixels)[0]);
+                v[1] = half_to_float(((const Uint16 *)pixels)[1]);
+                v[2] = half_to_float(((const Uint16 *)pixels)[2]);
+                v[3] = (bpp == 8) ? half_to_float(((const Uint16 *)pixels)[3]) : 1.0f;
+                break;
+            case SDL_PIXELTYPE_ARRAYF32:
+                v[0] = ((const float *)pixels)[0];
+                v[1] = ((const float *)pixels)[1];
+                v[2] = ((const float *)pixels)[2];
+                v[3] = (bpp == 16) ? ((const float *)pixels)[3] : 1.0f;
+                break;
+            default:
+                /* Unknown array type */
+                v[0] = v[1] = v[2] = v[3] = 0.0f;
+                break;
             }
-            break;
-        case SDL_PIXELTYPE_ARRAYF16:
-            ((Uint16 *)pixels)[0] = float_to_half(v[0]);
-            ((Uint16 *)pixels)[1] = float_to_half(v[1]);
-            ((Uint16 *)pixels)[2] = float_to_half(v[2]);
-            if (fmt->bytes_per_pixel == 8) {
-                ((Uint16 *)pixels)[3] = float_to_half(v[3]);
+            rgba[0] = v[iR];
+            rgba[1] = v[iG];
+            rgba[2] = v[iB];
+            rgba[3] = (iA >= 0) ? v[iA] : 1.0f;
+        }
+        break;
+    }
+    }
+}
+
+/* Write n encoded pixels */
+static void WriteFloatRow(Uint8 *dst, int n, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, const Uint8 *table,
+                          const float *rgba)
+{
+    const int bpp = fmt->bytes_per_pixel;
+    Uint32 R, G, B, A;
+    Uint32 pixel;
+    float fR, fG, fB, fA;
+    float v[4];
+    int i;
+
+    switch (access) {
+    case SlowBlitPixelAccess_Index8:
+        for (i = 0; i < n; ++i, rgba += 4, dst += bpp) {
+            R = (Uint8)SDL_roundf(SDL_clamp(rgba[0], 0.0f, 1.0f) * 7.0f);
+            G = (Uint8)SDL_roundf(SDL_clamp(rgba[1], 0.0f, 1.0f) * 7.0f);
+            B = (Uint8)SDL_roundf(SDL_clamp(rgba[2], 0.0f, 1.0f) * 3.0f);
+            pixel = (R << 5) | (G << 2) | B;
+            if (table) {
+                *dst = table[pixel];
+            } else {
+                *dst = (Uint8)pixel;
             }
-            break;
-        case SDL_PIXELTYPE_ARRAYF32:
-            ((float *)pixels)[0] = v[0];
-            ((float *)pixels)[1] = v[1];
-            ((float *)pixels)[2] = v[2];
-            if (fmt->bytes_per_pixel == 16) {
-                ((float *)pixels)[3] = v[3];
+        }
+        break;
+    case SlowBlitPixelAccess_RGB:
+    case SlowBlitPixelAccess_RGBA:
+        for (i = 0; i < n; ++i, rgba += 4, dst += bpp) {
+            R = (Uint8)SDL_roundf(SDL_clamp(rgba[0], 0.0f, 1.0f) * 255.0f);
+            G = (Uint8)SDL_roundf(SDL_clamp(rgba[1], 0.0f, 1.0f) * 255.0f);
+            B = (Uint8)SDL_roundf(SDL_clamp(rgba[2], 0.0f, 1.0f) * 255.0f);
+            if (access == SlowBlitPixelAccess_RGBA) {
+                A = (Uint8)SDL_roundf(SDL_clamp(rgba[3], 0.0f, 1.0f) * 255.0f);
+                ASSEMBLE_RGBA(dst, bpp, fmt, R, G, B, A);
+            } else {
+                ASSEMBLE_RGB(dst, bpp, fmt, R, G, B);
+            }
+        }
+        break;
+    case SlowBlitPixelAccess_10Bit:
+        for (i = 0; i < n; ++i, rgba += 4, dst += bpp) {
+            fR = rgba[0];
+            fG = rgba[1];
+            fB = rgba[2];
+            fA = rgba[3];
+            switch (fmt->format) {
+            case SDL_PIXELFORMAT_XRGB2101010:
+                fA = 1.0f;
+                SDL_FALLTHROUGH;
+            case SDL_PIXELFORMAT_ARGB2101010:
+                ARGB2101010_FROM_RGBAFLOAT(pixel, fR, fG, fB, fA);
+                break;
+            case SDL_PIXELFORMAT_XBGR2101010:
+                fA = 1.0f;
+                SDL_FALLTHROUGH;
+            case SDL_PIXELFORMAT_ABGR2101010:
+                ABGR2101010_FROM_RGBAFLOAT(pixel, fR, fG, fB, fA);
+                break;
+            default:
+                pixel = 0;
+                break;
+            }
+            *(Uint32 *)dst = pixel;
+        }
+        break;
+    case SlowBlitPixelAccess_Large:
+        for (i = 0; i < n; ++i, rgba += 4, dst += bpp) {
+            fR = rgba[0];
+            fG = rgba[1];
+            fB = rgba[2];
+            fA = rgba[3];
+            switch (SDL_PIXELORDER(fmt->format)) {
+            case SDL_ARRAYORDER_RGB:
+                v[0] = fR;
+                v[1] = fG;
+                v[2] = fB;
+                v[3] = 1.0f;
+                break;
+            case SDL_ARRAYORDER_RGBA:
+                v[0] = fR;
+                v[1] = fG;
+                v[2] = fB;
+                v[3] = fA;
+                break;
+            case SDL_ARRAYORDER_ARGB:
+                v[0] = fA;
+                v[1] = fR;
+                v[2] = fG;
+                v[3] = fB;
+                break;
+            case SDL_ARRAYORDER_BGR:
+                v[0] = fB;
+                v[1] = fG;
+                v[2] = fR;
+                v[3] = 1.0f;
+                break;
+            case SDL_ARRAYORDER_BGRA:
+                v[0] = fB;
+                v[1] = fG;
+                v[2] = fR;
+                v[3] = fA;
+                break;
+            case SDL_ARRAYORDER_ABGR:
+                v[0] = fA;
+                v[1] = fB;
+                v[2] = fG;
+                v[3] = fR;
+                break;
+            default:
+                /* Unknown array order */
+                v[0] = v[1] = v[2] = v[3] = 0.0f;
+                break;
+            }
+            switch (SDL_PIXELTYPE(fmt->format)) {
+            case SDL_PIXELTYPE_ARRAYU16:
+                ((Uint16 *)dst)[0] = (Uint16)SDL_roundf(SDL_clamp(v[0], 0.0f, 1.0f) * SDL_MAX_UINT16);
+                ((Uint16 *)dst)[1] = (Uint16)SDL_roundf(SDL_clamp(v[1], 0.0f, 1.0f) * SDL_MAX_UINT16);
+                ((Uint16 *)dst)[2] = (Uint16)SDL_roundf(SDL_clamp(v[2], 0.0f, 1.0f) * SDL_MAX_UINT16);
+                if (bpp == 8) {
+                    ((Uint16 *)dst)[3] = (Uint16)SDL_roundf(SDL_clamp(v[3], 0.0f, 1.0f) * SDL_MAX_UINT16);
+                }
+                break;
+            case SDL_PIXELTYPE_ARRAYF16:
+                ((Uint16 *)dst)[0] = float_to_half(v[0]);
+                ((Uint16 *)dst)[1] = float_to_half(v[1]);
+                ((Uint16 *)dst)[2] = float_to_half(v[2]);
+                if (bpp == 8) {
+                    ((Uint16 *)dst)[3] = float_to_half(v[3]);
+                }
+                break;
+            case SDL_PIXELTYPE_ARRAYF32:
+                ((float *)dst)[0] = v[0];
+                ((float *)dst)[1] = v[1];
+                ((float *)dst)[2] = v[2];
+                if (bpp == 16) {
+                    ((float *)dst)[3] = v[3];
+                }
+                break;
+            default:
+                /* Unknown array type */
+                break;
             }
-            break;
-        default:
-            /* Unknown array type */
-            break;
         }
         break;
     }
@@ -809,25 +1474,23 @@ static void ApplyTonemap(SDL_TonemapContext *ctx, float *r, float *g, float *b)
 void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
 {
     const int flags = info->flags;
-    const Uint32 modulateR = info->r;
-    const Uint32 modulateG = info->g;
-    const Uint32 modulateB = info->b;
-    const Uint32 modulateA = info->a;
-    float srcR, srcG, srcB, srcA;
-    float dstR, dstG, dstB, dstA;
-    Uint64 srcy, srcx;
+    const int blend = (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL));
+    float src_rgba[SLOW_FLOAT_CHUNK_SIZE * 4];
+    float dst_rgba[SLOW_FLOAT_CHUNK_SIZE * 4];
+    Uint64 srcy;
     Uint64 posy, posx;
     Uint64 incy, incx;
     const SDL_PixelFormatDetails *src_fmt = info->src_fmt;
     const SDL_Palette *src_pal = info->src_pal;
     const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
     const SDL_Palette *dst_pal = info->dst_pal;
-    int srcbpp = src_fmt->bytes_per_pixel;
     int dstbpp = dst_fmt->bytes_per_pixel;
     SlowBlitPixelAccess src_access;
     SlowBlitPixelAccess dst_access;
     SDL_Colorspace src_colorspace;
     SDL_Colorspace dst_colorspace;
+    SDL_TransferCharacteristics src_transfer;
+    SDL_TransferCharacteristics dst_transfer;
     SDL_ColorPrimaries src_primaries;
     SDL_ColorPrimaries dst_primaries;
     const float *color_primaries_matrix = NULL;
@@ -836,9 +1499,20 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     float dst_headroom;
     float src_headroom;
     SDL_TonemapContext tonemap;
+    SlowBlitFloatKernels kernels;
+    SlowBlitTransfer src_decode_transfer;
+    SlowBlitTransfer dst_decode_transfer;
+    SlowBlitTransfer dst_encode_transfer;
+    SlowBlitFloatTables *tables = NULL;
+    const float *src_decode = NULL;
+    const float *dst_decode = NULL;
+    float modulate[4];
+    int i;
 
     src_colorspace = info->src_surface->internal->colorspace;
     dst_colorspace = info->dst_surface->internal->colorspace;
+    src_transfer = SDL_COLORSPACETRANSFER(src_colorspace);
+    dst_transfer = SDL_COLORSPACETRANSFER(dst_colorspace);
     src_primaries = SDL_COLORSPACEPRIMARIES(src_colorspace);
     dst_primaries = SDL_COLORSPACEPRIMARIES(dst_colorspace);
 
@@ -887,92 +1561,102 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     src_access = GetPixelAccessMethod(src_fmt->format);
     dst_access = GetPixelAccessMethod(dst_fmt->format);
 
+    GetSlowBlitFloatKernels(&kernels);
+    InitSlowBlitTransfer(&src_decode_transfer, src_transfer, src_white_point, SDL_FALSE);
+    InitSlowBlitTransfer(&dst_decode_transfer, dst_transfer, dst_white_point, SDL_FALSE);
+    InitSlowBlitTransfer(&dst_encode_transfer, dst_transfer, dst_white_point, SDL_TRUE);
+
+    /* Building the tables costs about as much as decoding a few hundred pixels */
+    if ((Sint64)info->dst_w * info->dst_h >= SLOW_FLOAT_TABLE_THRESHOLD) {
+        /* The destination is decoded with its own transfer function, which is usually the same as the source */
+        const SDL_bool same_transfer = (dst_transfer == src_transfer && dst_white_point == src_white_point);
+        const SDL_bool src_tables = (src_access != SlowBlitPixelAccess_Large);
+        const SDL_bool dst_tables = (blend && dst_access != SlowBlitPixelAccess_Large && !(src_tables && same_transfer));
+
+        if (src_tables || dst_tables) {
+            tables = (SlowBlitFloatTables *)SDL_malloc(2 * sizeof(*tables));
+        }
+        if (tables) {
+            if (src_tables) {
+                InitSlowBlitFloatTables(&tables[0], &kernels, &src_decode_transfer);
+                src_decode = (src_access == SlowBlitPixelAccess_10Bit) ? tables[0].decode10 : tables[0].decode8;
+            }
+            if (dst_tables) {
+                InitSlowBlitFloatTables(&tables[1], &kernels, &dst_decode_transfer);
+                dst_decode = (dst_access == SlowBlitPixelAccess_10Bit) ? tables[1].decode10 : tables[1].decode8;
+            } else if (blend && dst_access != SlowBlitPixelAccess_Large) {
+                dst_decode = (dst_access == SlowBlitPixelAccess_10Bit) ? tables[0].decode10 : tables[0].decode8;
+            }
+        }
+    }
+    if (!blend) {
+        /* don't care */
+        SDL_zeroa(dst_rgba);
+    }
+
+    modulate[0] = (flags & SDL_COPY_MODULATE_COLOR) ? (float)info->r / 255.0f : 1.0f;
+    modulate[1] = (flags & SDL_COPY_MODULATE_COLOR) ? (float)info->g / 255.0f : 1.0f;
+    modulate[2] = (flags & SDL_COPY_MODULATE_COLOR) ? (float)info->b / 255.0f : 1.0f;
+    modulate[3] = (flags & SDL_COPY_MODULATE_ALPHA) ? (float)info->a / 255.0f : 1.0f;
+
     incy = ((Uint64)info->src_h << 16) / info->dst_h;
     incx = ((Uint64)info->src_w << 16) / info->dst_w;
     posy = incy / 2; /* start at the middle of pixel */
 
     while (info->dst_h--) {
-        Uint8 *src = 0;
+        const Uint8 *src;
         Uint8 *dst = info->dst;
-        int n = info->dst_w;
+        int remaining = info->dst_w;
         posx = incx / 2; /* start at the middle of pixel */
         srcy = posy >> 16;
-        while (n--) {
-            srcx = posx >> 16;
-            src = (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
+        src = info->src + (srcy * info->src_pitch);
+        while (remaining > 0) {
+            const int n = SDL_min(remaining, SLOW_FLOAT_CHUNK_SIZE);
+            float *s;
 
-            ReadFloatPixel(src, src_access, src_fmt, src_pal, src_colorspace, src_white_point, &srcR, &srcG, &srcB, &srcA);
+            ReadFloatRow(src, posx, incx, n, src_access, src_fmt, src_pal, src_decode, src_rgba);
+            if (!src_decode) {
+                DecodeTransferRow(&kernels, &src_decode_transfer, src_rgba, n);
+            }
 
             if (tonemap.op) {
-                ApplyTonemap(&tonemap, &srcR, &srcG, &srcB);
+                for (i = 0, s = src_rgba; i < n; ++i, s += 4) {
+                    ApplyTonemap(&tonemap, &s[0], &s[1], &s[2]);
+                }
             }
 
             if (color_primaries_matrix) {
-                SDL_ConvertColorPrimaries(&srcR, &srcG, &srcB, color_primaries_matrix);
+                kernels.convert_primaries(src_rgba, n, color_primaries_matrix);
             }
 
             if (flags & SDL_COPY_COLORKEY) {
                 /* colorkey isn't supported */
             }
-            if ((flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
-                ReadFloatPixel(dst, dst_access, dst_fmt, dst_pal, dst_colorspace, dst_white_point, &dstR, &dstG, &dstB, &dstA);
-            } else {
-                /* don't care */
-                dstR = dstG = dstB = dstA = 0.0f;
+            if (blend) {
+                ReadFloatRow(dst, (Uint64)1 << 15, (Uint64)1 << 16, n, dst_access, dst_fmt, dst_pal, dst_decode, dst_rgba);
+                if (!dst_decode) {
+                    DecodeTransferRow(&kernels, &dst_decode_transfer, dst_rgba, n);
+                }
             }
 
-            if (flags & SDL_COPY_MODULATE_COLOR) {
-                srcR = (srcR * modulateR) / 255;
-                srcG = (srcG * modulateG) / 255;
-                srcB = (srcB * modulateB) / 255;
-            }
-            if (flags & SDL_COPY_MODULATE_ALPHA) {
-                srcA = (srcA * modulateA) / 255;
+            if (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) {
+                kernels.modulate(src_rgba, n, modulate);
             }
             if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
-                if (srcA < 1.0f) {
-                    srcR = (srcR * srcA);
-                    srcG = (srcG * srcA);
-                    srcB = (srcB * srcA);
-                }
-            }
-            switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
-            case 0:
-                dstR = srcR;
-                dstG = srcG;
-                dstB = srcB;
-                dstA = srcA;
-                break;
-            case SDL_COPY_BLEND:
-                dstR = srcR + ((1.0f - srcA) * dstR);
-                dstG = srcG + ((1.0f - srcA) * dstG);
-                dstB = srcB + ((1.0f - srcA) * dstB);
-                dstA = srcA + ((1.0f - srcA) * dstA);
-                break;
-            case SDL_COPY_ADD:
-                dstR = srcR + dstR;
-                dstG = srcG + dstG;
-                dstB = srcB + dstB;
-                break;
-            case SDL_COPY_MOD:
-                dstR = (srcR * dstR);
-                dstG = (srcG * dstG);
-                dstB = (srcB * dstB);
-                break;
-            case SDL_COPY_MUL:
-                dstR = ((srcR * dstR) + (dstR * (1.0f - srcA)));
-                dstG = ((srcG * dstG) + (dstG * (1.0f - srcA)));
-                dstB = ((srcB * dstB) + (dstB * (1.0f - srcA)));
-                break;
+                kernels.premultiply(src_rgba, n);
             }
+            kernels.blend(src_rgba, dst_rgba, n, blend);
 
-            WriteFloatPixel(dst, dst_access, dst_fmt, info->table, dst_colorspace, dst_white_point, dstR, dstG, dstB, dstA);
+            EncodeTransferRow(&kernels, &dst_encode_transfer, dst_rgba, n);
+            WriteFloatRow(dst, n, dst_access, dst_fmt, info->table, dst_rgba);
 
-            posx += incx;
-            dst += dstbpp;
+            posx += incx * n;
+            dst += dstbpp * n;
+            remaining -= n;
         }
         posy += incy;
         info->dst += info->dst_pitch;
     }
-}
 
+    SDL_free(tables);
+}
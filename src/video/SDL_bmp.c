@@ -36,6 +36,9 @@
 
 #define SAVE_32BIT_BMP
 
+/* Saved pixels are converted and written in bands of about this many bytes */
+#define BMP_SAVE_BAND_SIZE (256 * 1024)
+
 /* Compression encodings for BMP files */
 #ifndef BI_RGB
 #define BI_RGB       0
@@ -164,6 +167,22 @@ static SDL_bool readRlePixels(SDL_Surface *surface, SDL_IOStream *src, int isRle
     }
 }
 
+/* Read a block of data, allowing for streams that return short reads */
+static SDL_bool readFully(SDL_IOStream *src, void *ptr, size_t size)
+{
+    Uint8 *data = (Uint8 *)ptr;
+
+    while (size > 0) {
+        size_t amount = SDL_ReadIO(src, data, size);
+        if (amount == 0) {
+            return SDL_FALSE;
+        }
+        data += amount;
+        size -= amount;
+    }
+    return SDL_TRUE;
+}
+
 static void CorrectAlphaChannel(SDL_Surface *surface)
 {
     /* Check to see if there is any alpha channel data */
@@ -197,7 +216,7 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, SDL_bool closeio)
 {
     SDL_bool was_error = SDL_TRUE;
     Sint64 fp_offset = 0;
-    int i, pad;
+    int i;
     SDL_Surface *surface;
     Uint32 Rmask = 0;
     Uint32 Gmask = 0;
@@ -506,18 +525,19 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, SDL_bool closeio)
         }
         goto done;
     }
+    /* The surface pitch is 4-byte aligned just like the BMP rows, so the
+       whole image can be read in one go and flipped afterwards if needed. */
     top = (Uint8 *)surface->pixels;
     end = (Uint8 *)surface->pixels + (surface->h * surface->pitch);
-    pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
-    if (topDown) {
-        bits = top;
-    } else {
-        bits = end - surface->pitch;
+    if (!readFully(src, top, (size_t)(end - top))) {
+        goto done;
     }
-    while (bits >= top && bits < end) {
-        if (SDL_ReadIO(src, bits, surface->pitch) != (size_t)surface->pitch) {
+    if (!topDown) {
+        if (SDL_FlipSurface(surface, SDL_FLIP_VERTICAL) < 0) {
             goto done;
         }
+    }
+    for (bits = top; bits < end; bits += surface->pitch) {
         if (biBitCount == 8 && surface->internal->palette && biClrUsed < (1u << biBitCount)) {
             for (i = 0; i < surface->w; ++i) {
                 if (bits[i] >= biClrUsed) {
@@ -550,21 +570,6 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, SDL_bool closeio)
         }
         }
 #endif
-
-        /* Skip padding bytes, ugh */
-        if (pad) {
-            Uint8 padbyte;
-            for (i = 0; i < pad; ++i) {
-                if (!SDL_ReadU8(src, &padbyte)) {
-                    goto done;
-                }
-            }
-        }
-        if (topDown) {
-            bits += surface->pitch;
-        } else {
-            bits -= surface->pitch;
-        }
     }
     if (correctAlpha) {
         CorrectAlphaChannel(surface);
@@ -594,10 +599,12 @@ SDL_Surface *SDL_LoadBMP(const char *file)
 int SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, SDL_bool closeio)
 {
     SDL_bool was_error = SDL_TRUE;
-    Sint64 fp_offset, new_offset;
-    int i, pad;
+    int i, y;
     SDL_Surface *intermediate_surface;
-    Uint8 *bits;
+    SDL_PixelFormat save_format = SDL_PIXELFORMAT_UNKNOWN;
+    SDL_bool convert_rows = SDL_FALSE;
+    SDL_Palette *palette = NULL;
+    Uint8 *band = NULL;
     SDL_bool save32bit = SDL_FALSE;
     SDL_bool saveLegacyBMP = SDL_FALSE;
 
@@ -657,7 +664,7 @@ int SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, SDL_bool closeio)
                              SDL_BITSPERPIXEL(surface->format));
                 goto done;
             }
-        } else if ((SDL_BITSPERPIXEL(surface->format) == 24) && !save32bit &&
+        } else if ((SDL_BITSPERPIXEL(surface->format) == 24) && (SDL_BYTESPERPIXEL(surface->format) == 3) && !save32bit &&
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
                    (surface->internal->format->Rmask == 0x00FF0000) &&
                    (surface->internal->format->Gmask == 0x0000FF00) &&
@@ -679,13 +686,26 @@ int SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, SDL_bool closeio)
             } else {
                 pixel_format = SDL_PIXELFORMAT_BGR24;
             }
-            intermediate_surface = SDL_ConvertSurface(surface, pixel_format);
-            if (!intermediate_surface) {
-                SDL_SetError("Couldn't convert image to %d bpp",
-                             (int)SDL_BITSPERPIXEL(pixel_format));
-                goto done;
+
+            if (!SDL_ISPIXELFORMAT_FOURCC(surface->format) && !surface->internal->palette &&
+                !(surface->internal->map.info.flags & SDL_COPY_COLORKEY)) {
+                /* Plain pixel conversion, done a band of rows at a time while writing */
+                intermediate_surface = surface;
+                save_format = pixel_format;
+                convert_rows = SDL_TRUE;
+            } else {
+                intermediate_surface = SDL_ConvertSurface(surface, pixel_format);
+                if (!intermediate_surface) {
+                    SDL_SetError("Couldn't convert image to %d bpp",
+                                 (int)SDL_BITSPERPIXEL(pixel_format));
+                    goto done;
+                }
             }
         }
+        if (!convert_rows) {
+            save_format = intermediate_surface->format;
+            palette = intermediate_surface->internal->palette;
+        }
     } else {
         /* Set no error here because it may overwrite a more useful message from
            SDL_IOFromFile() if SDL_SaveBMP_IO() is called from SDL_SaveBMP(). */
@@ -697,39 +717,25 @@ int SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, SDL_bool closeio)
     }
 
     if (SDL_LockSurface(intermediate_surface) == 0) {
-        const size_t bw = intermediate_surface->w * intermediate_surface->internal->format->bytes_per_pixel;
-
-        /* Set the BMP file header values */
-        bfSize = 0; /* We'll write this when we're done */
-        bfReserved1 = 0;
-        bfReserved2 = 0;
-        bfOffBits = 0; /* We'll write this when we're done */
-
-        /* Write the BMP file header values */
-        fp_offset = SDL_TellIO(dst);
-        if (fp_offset < 0) {
-            goto done;
-        }
-        if (SDL_WriteIO(dst, magic, 2) != 2 ||
-            !SDL_WriteU32LE(dst, bfSize) ||
-            !SDL_WriteU16LE(dst, bfReserved1) ||
-            !SDL_WriteU16LE(dst, bfReserved2) ||
-            !SDL_WriteU32LE(dst, bfOffBits)) {
-            goto done;
-        }
+        const int w = intermediate_surface->w;
+        const int h = intermediate_surface->h;
+        const int pitch = intermediate_surface->pitch;
+        const size_t bw = (size_t)w * SDL_BYTESPERPIXEL(save_format);
+        const size_t row_size = (bw + 3) & ~3;
+        int band_rows;
 
         /* Set the BMP info values */
         biSize = 40;
-        biWidth = intermediate_surface->w;
-        biHeight = intermediate_surface->h;
+        biWidth = w;
+        biHeight = h;
         biPlanes = 1;
-        biBitCount = intermediate_surface->internal->format->bits_per_pixel;
+        biBitCount = SDL_BITSPERPIXEL(save_format);
         biCompression = BI_RGB;
-        biSizeImage = intermediate_surface->h * intermediate_surface->pitch;
+        biSizeImage = (Uint32)(h * row_size);
         biXPelsPerMeter = 0;
         biYPelsPerMeter = 0;
-        if (intermediate_surface->internal->palette) {
-            biClrUsed = intermediate_surface->internal->palette->ncolors;
+        if (palette) {
+            biClrUsed = palette->ncolors;
         } else {
             biClrUsed = 0;
         }
@@ -750,6 +756,22 @@ int SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, SDL_bool closeio)
             bV4GammaBlue = 0;
         }
 
+        /* Set the BMP file header values, everything is known up front so
+           the stream never needs to seek back */
+        bfOffBits = 14 + biSize + biClrUsed * 4;
+        bfSize = bfOffBits + biSizeImage;
+        bfReserved1 = 0;
+        bfReserved2 = 0;
+
+        /* Write the BMP file header values */
+        if (SDL_WriteIO(dst, magic, 2) != 2 ||
+            !SDL_WriteU32LE(dst, bfSize) ||
+            !SDL_WriteU16LE(dst, bfReserved1) ||
+            !SDL_WriteU16LE(dst, bfReserved2) ||
+            !SDL_WriteU32LE(dst, bfOffBits)) {
+            goto done;
+        }
+
         /* Write the BMP info values */
         if (!SDL_WriteU32LE(dst, biSize) ||
             !SDL_WriteS32LE(dst, biWidth) ||
@@ -787,66 +809,52 @@ int SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, SDL_bool closeio)
         }
 
         /* Write the palette (in BGR color order) */
-        if (intermediate_surface->internal->palette) {
-            SDL_Color *colors;
-            int ncolors;
-
-            colors = intermediate_surface->internal->palette->colors;
-            ncolors = intermediate_surface->internal->palette->ncolors;
-            for (i = 0; i < ncolors; ++i) {
-                if (!SDL_WriteU8(dst, colors[i].b) ||
-                    !SDL_WriteU8(dst, colors[i].g) ||
-                    !SDL_WriteU8(dst, colors[i].r) ||
-                    !SDL_WriteU8(dst, colors[i].a)) {
+        if (palette) {
+            for (i = 0; i < palette->ncolors; ++i) {
+                if (!SDL_WriteU8(dst, palette->colors[i].b) ||
+                    !SDL_WriteU8(dst, palette->colors[i].g) ||
+                    !SDL_WriteU8(dst, palette->colors[i].r) ||
+                    !SDL_WriteU8(dst, palette->colors[i].a)) {
                     goto done;
                 }
             }
         }
 
-        /* Write the bitmap offset */
-        bfOffBits = (Uint32)(SDL_TellIO(dst) - fp_offset);
-        if (SDL_SeekIO(dst, fp_offset + 10, SDL_IO_SEEK_SET) < 0) {
-            goto done;
-        }
-        if (!SDL_WriteU32LE(dst, bfOffBits)) {
-            goto done;
-        }
-        if (SDL_SeekIO(dst, fp_offset + bfOffBits, SDL_IO_SEEK_SET) < 0) {
+        /* Write the bitmap image upside down, a band of rows at a time.
+           The band has a spare row at the end for flipping converted rows,
+           and it's zeroed so the row padding is written as zeroes. */
+        band_rows = (int)SDL_clamp(BMP_SAVE_BAND_SIZE / row_size, 1, (size_t)SDL_max(h, 1));
+        band = (Uint8 *)SDL_calloc(band_rows + 1, row_size);
+        if (!band) {
             goto done;
         }
+        for (y = h; y > 0; ) {
+            const int rows = SDL_min(band_rows, y);
+            const Uint8 *bits;
 
-        /* Write the bitmap image upside down */
-        bits = (Uint8 *)intermediate_surface->pixels + (intermediate_surface->h * intermediate_surface->pitch);
-        pad = ((bw % 4) ? (4 - (bw % 4)) : 0);
-        while (bits > (Uint8 *)intermediate_surface->pixels) {
-            bits -= intermediate_surface->pitch;
-            if (SDL_WriteIO(dst, bits, bw) != bw) {
-                goto done;
-            }
-            if (pad) {
-                const Uint8 padbyte = 0;
-                for (i = 0; i < pad; ++i) {
-                    if (!SDL_WriteU8(dst, padbyte)) {
-                        goto done;
-                    }
+            y -= rows;
+            bits = (const Uint8 *)intermediate_surface->pixels + (size_t)y * pitch;
+            if (convert_rows) {
+                Uint8 *spare = band + band_rows * row_size;
+                Uint8 *a, *b;
+
+                if (SDL_ConvertPixelsAndColorspace(w, rows, surface->format, surface->internal->colorspace, surface->internal->props, bits, pitch,
+                                                   save_format, SDL_GetDefaultColorspaceForFormat(save_format), 0, band, (int)row_size) < 0) {
+                    goto done;
+                }
+                for (a = band, b = band + (rows - 1) * row_size; a < b; a += row_size, b -= row_size) {
+                    SDL_memcpy(spare, a, row_size);
+                    SDL_memcpy(a, b, row_size);
+                    SDL_memcpy(b, spare, row_size);
+                }
+            } else {
+                for (i = 0; i < rows; ++i) {
+                    SDL_memcpy(band + i * row_size, bits + (size_t)(rows - 1 - i) * pitch, bw);
                 }
             }
-        }
-
-        /* Write the BMP file size */
-        new_offset = SDL_TellIO(dst);
-        if (new_offset < 0) {
-            goto done;
-        }
-        bfSize = (Uint32)(new_offset - fp_offset);
-        if (SDL_SeekIO(dst, fp_offset + 2, SDL_IO_SEEK_SET) < 0) {
-            goto done;
-        }
-        if (!SDL_WriteU32LE(dst, bfSize)) {
-            goto done;
-        }
-        if (SDL_SeekIO(dst, fp_offset + bfSize, SDL_IO_SEEK_SET) < 0) {
-            goto done;
+            if (SDL_WriteIO(dst, band, rows * row_size) != rows * row_size) {
+                goto done;
+            }
         }
 
         /* Close it up.. */
@@ -856,6 +864,7 @@ int SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, SDL_bool closeio)
     }
 
 done:
+    SDL_free(band);
     if (intermediate_surface && intermediate_surface != surface) {
         SDL_DestroySurface(intermediate_surface);
     }
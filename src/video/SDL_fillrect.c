@@ -22,6 +22,12 @@
 
 #include "SDL_blit.h"
 
+/* Fills at least this large bypass the cache with non-temporal stores.
+ * This is about the size of a typical L2 cache, anything larger would
+ * evict most of it for pixels that are unlikely to be read back soon.
+ */
+#define FILL_STREAM_THRESHOLD (1024 * 1024)
+
 #ifdef SDL_SSE_INTRINSICS
 /* *INDENT-OFF* */ /* clang-format off */
 
@@ -43,19 +49,17 @@
     c128 = *(__m128 *)cccc;
 #endif
 
-#define SSE_WORK \
+#define SSE_WORK(store) \
     for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
+        store((float *)(p+0), c128); \
+        store((float *)(p+16), c128); \
+        store((float *)(p+32), c128); \
+        store((float *)(p+48), c128); \
         p += 64; \
     }
 
-#define SSE_END
-
-#define DEFINE_SSE_FILLRECT(bpp, type) \
-static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+#define DEFINE_SSE_FILLRECT(bpp, type, suffix, store, end) \
+static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##suffix(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 { \
     int i, n; \
     Uint8 *p = NULL; \
@@ -76,7 +80,7 @@ static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, in
                     p += (bpp); \
                 } \
             } \
-            SSE_WORK; \
+            SSE_WORK(store); \
         } \
         if (n & 63) { \
             int remainder = (n & 63); \
@@ -89,42 +93,272 @@ static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, in
         pixels += pitch; \
     } \
  \
-    SSE_END; \
+    end \
+}
+
+#define DEFINE_SSE_FILLRECT1(suffix, store, end) \
+static void SDL_TARGETING("sse") SDL_FillSurfaceRect1##suffix(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    int i, n; \
+ \
+    SSE_BEGIN; \
+    while (h--) { \
+        Uint8 *p = pixels; \
+        n = w; \
+ \
+        if (n > 63) { \
+            int adjust = 16 - ((uintptr_t)p & 15); \
+            if (adjust) { \
+                n -= adjust; \
+                SDL_memset(p, color, adjust); \
+                p += adjust; \
+            } \
+            SSE_WORK(store); \
+        } \
+        if (n & 63) { \
+            int remainder = (n & 63); \
+            SDL_memset(p, color, remainder); \
+        } \
+        pixels += pitch; \
+    } \
+ \
+    end \
+}
+
+/* The streaming versions need a fence to order the non-temporal stores */
+DEFINE_SSE_FILLRECT1(SSE, _mm_store_ps, )
+DEFINE_SSE_FILLRECT1(SSEStream, _mm_stream_ps, _mm_sfence();)
+DEFINE_SSE_FILLRECT(2, Uint16, SSE, _mm_store_ps, )
+DEFINE_SSE_FILLRECT(2, Uint16, SSEStream, _mm_stream_ps, _mm_sfence();)
+DEFINE_SSE_FILLRECT(4, Uint32, SSE, _mm_store_ps, )
+DEFINE_SSE_FILLRECT(4, Uint32, SSEStream, _mm_stream_ps, _mm_sfence();)
+
+/* *INDENT-ON* */ /* clang-format on */
+#endif            /* __SSE__ */
+
+#ifdef SDL_AVX_INTRINSICS
+/* *INDENT-OFF* */ /* clang-format off */
+
+#define AVX_WORK(store) \
+    for (i = n / 128; i--;) { \
+        store((__m256i *)(p+0), c256); \
+        store((__m256i *)(p+32), c256); \
+        store((__m256i *)(p+64), c256); \
+        store((__m256i *)(p+96), c256); \
+        p += 128; \
+    }
+
+#define DEFINE_AVX_FILLRECT(bpp, type, suffix, store, end) \
+static void SDL_TARGETING("avx") SDL_FillSurfaceRect##bpp##suffix(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    const __m256i c256 = _mm256_set1_epi32((int)color); \
+    int i, n; \
+    Uint8 *p = NULL; \
+ \
+    while (h--) { \
+        n = (w) * (bpp); \
+        p = pixels; \
+ \
+        if (n > 127) { \
+            int adjust = 32 - ((uintptr_t)p & 31); \
+            if (adjust < 32) { \
+                n -= adjust; \
+                adjust /= (bpp); \
+                while (adjust--) { \
+                    *((type *)p) = (type)color; \
+                    p += (bpp); \
+                } \
+            } \
+            AVX_WORK(store); \
+        } \
+        if (n & 127) { \
+            int remainder = (n & 127); \
+            if (remainder >= 64) { \
+                _mm256_storeu_si256((__m256i *)(p+0), c256); \
+                _mm256_storeu_si256((__m256i *)(p+32), c256); \
+                p += 64; \
+                remainder -= 64; \
+            } \
+            remainder /= (bpp); \
+            while (remainder--) { \
+                *((type *)p) = (type)color; \
+                p += (bpp); \
+            } \
+        } \
+        pixels += pitch; \
+    } \
+ \
+    end \
+}
+
+DEFINE_AVX_FILLRECT(1, Uint8, AVX, _mm256_store_si256, )
+DEFINE_AVX_FILLRECT(1, Uint8, AVXStream, _mm256_stream_si256, _mm_sfence();)
+DEFINE_AVX_FILLRECT(2, Uint16, AVX, _mm256_store_si256, )
+DEFINE_AVX_FILLRECT(2, Uint16, AVXStream, _mm256_stream_si256, _mm_sfence();)
+DEFINE_AVX_FILLRECT(4, Uint32, AVX, _mm256_store_si256, )
+DEFINE_AVX_FILLRECT(4, Uint32, AVXStream, _mm256_stream_si256, _mm_sfence();)
+
+/* *INDENT-ON* */ /* clang-format on */
+#endif            /* SDL_AVX_INTRINSICS */
+
+#ifdef SDL_SSE2_INTRINSICS
+/* *INDENT-OFF* */ /* clang-format off */
+
+/* 24-bit pixels repeat every 48 bytes, so three 16-byte vectors hold the
+ * pattern. A row is filled pixel by pixel until it's 16-byte aligned,
+ * which is at most 15 pixels because 3 and 16 are coprime.
+ */
+#define DEFINE_SSE2_FILLRECT3(suffix, store, end) \
+static void SDL_TARGETING("sse2") SDL_FillSurfaceRect3##suffix(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    DECLARE_ALIGNED(Uint8, pattern[48], 16); \
+    __m128i c0, c1, c2; \
+    int i, n; \
+    Uint8 *p; \
+ \
+    for (i = 0; i < 48; i += 3) { \
+        pattern[i + 0] = (Uint8)(color & 0xFF); \
+        pattern[i + 1] = (Uint8)((color >> 8) & 0xFF); \
+        pattern[i + 2] = (Uint8)((color >> 16) & 0xFF); \
+    } \
+    c0 = _mm_load_si128((const __m128i *)(pattern + 0)); \
+    c1 = _mm_load_si128((const __m128i *)(pattern + 16)); \
+    c2 = _mm_load_si128((const __m128i *)(pattern + 32)); \
+ \
+    while (h--) { \
+        n = w; \
+        p = pixels; \
+ \
+        while (n > 0 && ((uintptr_t)p & 15)) { \
+            p[0] = pattern[0]; \
+            p[1] = pattern[1]; \
+            p[2] = pattern[2]; \
+            p += 3; \
+            --n; \
+        } \
+        for (i = n / 16; i--;) { \
+            store((__m128i *)(p+0), c0); \
+            store((__m128i *)(p+16), c1); \
+            store((__m128i *)(p+32), c2); \
+            p += 48; \
+        } \
+        for (n &= 15; n--;) { \
+            p[0] = pattern[0]; \
+            p[1] = pattern[1]; \
+            p[2] = pattern[2]; \
+            p += 3; \
+        } \
+        pixels += pitch; \
+    } \
+    end \
 }
 
-static void SDL_TARGETING("sse") SDL_FillSurfaceRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+DEFINE_SSE2_FILLRECT3(SSE2, _mm_store_si128, )
+DEFINE_SSE2_FILLRECT3(SSE2Stream, _mm_stream_si128, _mm_sfence();)
+
+/* *INDENT-ON* */ /* clang-format on */
+#endif            /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_FillSurfaceRect4NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
+    const uint32x4_t c128 = vdupq_n_u32(color);
     int i, n;
 
-    SSE_BEGIN;
     while (h--) {
-        Uint8 *p = pixels;
-        n = w;
+        Uint32 *p = (Uint32 *)pixels;
+
+        for (i = w / 16; i--;) {
+            vst1q_u32(p + 0, c128);
+            vst1q_u32(p + 4, c128);
+            vst1q_u32(p + 8, c128);
+            vst1q_u32(p + 12, c128);
+            p += 16;
+        }
+        for (n = w & 15; n--;) {
+            *p++ = color;
+        }
+        pixels += pitch;
+    }
+}
 
-        if (n > 63) {
-            int adjust = 16 - ((uintptr_t)p & 15);
-            if (adjust) {
-                n -= adjust;
-                SDL_memset(p, color, adjust);
-                p += adjust;
-            }
-            SSE_WORK;
+static void SDL_FillSurfaceRect2NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    const uint16x8_t c128 = vdupq_n_u16((Uint16)color);
+    int i, n;
+
+    while (h--) {
+        Uint16 *p = (Uint16 *)pixels;
+
+        for (i = w / 32; i--;) {
+            vst1q_u16(p + 0, c128);
+            vst1q_u16(p + 8, c128);
+            vst1q_u16(p + 16, c128);
+            vst1q_u16(p + 24, c128);
+            p += 32;
         }
-        if (n & 63) {
-            int remainder = (n & 63);
-            SDL_memset(p, color, remainder);
+        for (n = w & 31; n--;) {
+            *p++ = (Uint16)color;
         }
         pixels += pitch;
     }
+}
+
+static void SDL_FillSurfaceRect1NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    const uint8x16_t c128 = vdupq_n_u8((Uint8)color);
+    int i;
 
-    SSE_END;
+    while (h--) {
+        Uint8 *p = pixels;
+
+        for (i = w / 64; i--;) {
+            vst1q_u8(p + 0, c128);
+            vst1q_u8(p + 16, c128);
+            vst1q_u8(p + 32, c128);
+            vst1q_u8(p + 48, c128);
+            p += 64;
+        }
+        SDL_memset(p, color, w & 63);
+        pixels += pitch;
+    }
 }
-/* DEFINE_SSE_FILLRECT(1, Uint8) */
-DEFINE_SSE_FILLRECT(2, Uint16)
-DEFINE_SSE_FILLRECT(4, Uint32)
 
-/* *INDENT-ON* */ /* clang-format on */
-#endif            /* __SSE__ */
+/* vst3 interleaves the three bytes of the color for 16 pixels at a time */
+static void SDL_FillSurfaceRect3NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    Uint8 b1 = (Uint8)(color & 0xFF);
+    Uint8 b2 = (Uint8)((color >> 8) & 0xFF);
+    Uint8 b3 = (Uint8)((color >> 16) & 0xFF);
+#elif SDL_BYTEORDER == SDL_BIG_ENDIAN
+    Uint8 b1 = (Uint8)((color >> 16) & 0xFF);
+    Uint8 b2 = (Uint8)((color >> 8) & 0xFF);
+    Uint8 b3 = (Uint8)(color & 0xFF);
+#endif
+    uint8x16x3_t c384;
+    int i, n;
+
+    c384.val[0] = vdupq_n_u8(b1);
+    c384.val[1] = vdupq_n_u8(b2);
+    c384.val[2] = vdupq_n_u8(b3);
+
+    while (h--) {
+        Uint8 *p = pixels;
+
+        for (i = w / 16; i--;) {
+            vst3q_u8(p, c384);
+            p += 48;
+        }
+        for (n = w & 15; n--;) {
+            *p++ = b1;
+            *p++ = b2;
+            *p++ = b3;
+        }
+        pixels += pitch;
+    }
+}
+#endif /* SDL_NEON_INTRINSICS */
 
 static void SDL_FillSurfaceRect1(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
@@ -254,6 +488,7 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
     Uint8 *pixels;
     const SDL_Rect *rect;
     void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
+    void (*stream_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
     int i;
 
     if (!SDL_SurfaceValid(dst)) {
@@ -269,6 +504,7 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
     if (!dst->pixels) {
         return SDL_SetError("SDL_FillSurfaceRects(): You must lock the surface");
     }
+    SDL_InvalidateSurfaceMipmaps(dst);
 
     if (!rects) {
         return SDL_InvalidParamError("SDL_FillSurfaceRects(): rects");
@@ -297,9 +533,23 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         {
             color |= (color << 8);
             color |= (color << 16);
+#ifdef SDL_AVX_INTRINSICS
+            if (SDL_HasAVX()) {
+                fill_function = SDL_FillSurfaceRect1AVX;
+                stream_function = SDL_FillSurfaceRect1AVXStream;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect1SSE;
+                stream_function = SDL_FillSurfaceRect1SSEStream;
+                break;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                fill_function = SDL_FillSurfaceRect1NEON;
                 break;
             }
 #endif
@@ -310,9 +560,23 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         case 2:
         {
             color |= (color << 16);
+#ifdef SDL_AVX_INTRINSICS
+            if (SDL_HasAVX()) {
+                fill_function = SDL_FillSurfaceRect2AVX;
+                stream_function = SDL_FillSurfaceRect2AVXStream;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect2SSE;
+                stream_function = SDL_FillSurfaceRect2SSEStream;
+                break;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                fill_function = SDL_FillSurfaceRect2NEON;
                 break;
             }
 #endif
@@ -321,17 +585,43 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         }
 
         case 3:
-            /* 24-bit RGB is a slow path, at least for now. */
-            {
-                fill_function = SDL_FillSurfaceRect3;
+        {
+#ifdef SDL_SSE2_INTRINSICS
+            if (SDL_HasSSE2()) {
+                fill_function = SDL_FillSurfaceRect3SSE2;
+                stream_function = SDL_FillSurfaceRect3SSE2Stream;
                 break;
             }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                fill_function = SDL_FillSurfaceRect3NEON;
+                break;
+            }
+#endif
+            fill_function = SDL_FillSurfaceRect3;
+            break;
+        }
 
         case 4:
         {
+#ifdef SDL_AVX_INTRINSICS
+            if (SDL_HasAVX()) {
+                fill_function = SDL_FillSurfaceRect4AVX;
+                stream_function = SDL_FillSurfaceRect4AVXStream;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect4SSE;
+                stream_function = SDL_FillSurfaceRect4SSEStream;
+                break;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                fill_function = SDL_FillSurfaceRect4NEON;
                 break;
             }
 #endif
@@ -355,7 +645,13 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
                  rect->x * SDL_BYTESPERPIXEL(dst->format);
 
-        fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        /* Large fills bypass the cache */
+        if (stream_function &&
+            (size_t)rect->w * rect->h * SDL_BYTESPERPIXEL(dst->format) >= FILL_STREAM_THRESHOLD) {
+            stream_function(pixels, dst->pitch, color, rect->w, rect->h);
+        } else {
+            fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        }
     }
 
     /* We're done! */
@@ -24,6 +24,44 @@
 
 static int SDL_LowerSoftStretchNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
 static int SDL_LowerSoftStretchLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+static int SDL_LowerSoftStretchConvert(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
+static int SDL_LowerSoftStretchBest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+
+/* Formats that can be read and written a pixel at a time with DISEMBLE_RGBA() and ASSEMBLE_RGBA() */
+static SDL_bool IsStretchConvertFormat(SDL_PixelFormat format)
+{
+    if (SDL_ISPIXELFORMAT_FOURCC(format) ||
+        SDL_ISPIXELFORMAT_INDEXED(format) ||
+        SDL_ISPIXELFORMAT_10BIT(format) ||
+        SDL_BYTESPERPIXEL(format) > 4) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* Returns SDL_TRUE if the surfaces can be scaled and converted in a single pass */
+static SDL_bool CanStretchConvert(SDL_Surface *src, SDL_Surface *dst)
+{
+    if (!IsStretchConvertFormat(src->format) || !IsStretchConvertFormat(dst->format)) {
+        return SDL_FALSE;
+    }
+    if (src->internal->colorspace != dst->internal->colorspace) {
+        /* This needs a float conversion */
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_CanSoftStretchLinear(SDL_Surface *src, SDL_Surface *dst)
+{
+    if (src->format == dst->format &&
+        SDL_BYTESPERPIXEL(src->format) == 4 &&
+        !SDL_ISPIXELFORMAT_INDEXED(src->format) &&
+        !SDL_ISPIXELFORMAT_10BIT(src->format)) {
+        return SDL_TRUE;
+    }
+    return CanStretchConvert(src, dst);
+}
 
 int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
                     SDL_Surface *dst, const SDL_Rect *dstrect,
@@ -42,7 +80,7 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
         return SDL_InvalidParamError("dst");
     }
 
-    if (src->format != dst->format) {
+    if (src->format != dst->format && !CanStretchConvert(src, dst)) {
         // Slow!
         SDL_Surface *src_tmp = SDL_ConvertSurfaceAndColorspace(src, dst->format, dst->internal->palette, dst->internal->colorspace, dst->internal->props);
         if (!src_tmp) {
@@ -86,12 +124,12 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
         return SDL_InvalidParamError("scaleMode");
     }
 
-    if (scaleMode != SDL_SCALEMODE_NEAREST) {
+    if (scaleMode == SDL_SCALEMODE_BEST && !CanStretchConvert(src, dst)) {
         scaleMode = SDL_SCALEMODE_LINEAR;
     }
 
-    if (scaleMode == SDL_SCALEMODE_LINEAR) {
-        if (SDL_BYTESPERPIXEL(src->format) != 4 || src->format == SDL_PIXELFORMAT_ARGB2101010) {
+    if (scaleMode != SDL_SCALEMODE_NEAREST) {
+        if (!SDL_CanSoftStretchLinear(src, dst)) {
             return SDL_SetError("Wrong format");
         }
     }
@@ -153,7 +191,12 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
         src_locked = 1;
     }
 
-    if (scaleMode == SDL_SCALEMODE_NEAREST) {
+    if (scaleMode == SDL_SCALEMODE_BEST) {
+        ret = SDL_LowerSoftStretchBest(src, srcrect, dst, dstrect);
+    } else if (src->format != dst->format ||
+        (scaleMode == SDL_SCALEMODE_LINEAR && SDL_BYTESPERPIXEL(src->format) != 4)) {
+        ret = SDL_LowerSoftStretchConvert(src, srcrect, dst, dstrect, scaleMode);
+    } else if (scaleMode == SDL_SCALEMODE_NEAREST) {
         ret = SDL_LowerSoftStretchNearest(src, srcrect, dst, dstrect);
     } else {
         ret = SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect);
@@ -164,7 +207,7 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
         SDL_UnlockSurface(dst);
     }
     if (src_locked) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceReadOnly(src);
     }
 
     return ret;
@@ -985,3 +1028,799 @@ int SDL_LowerSoftStretchNearest(SDL_Surface *s, const SDL_Rect *srcrect,
         return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
     }
 }
+
+/* Scale and convert in a single pass, only reading the source pixels that are sampled */
+static int scale_mat_convert_nearest(const Uint8 *src_ptr, int src_w, int src_h, int src_pitch, const SDL_PixelFormatDetails *src_fmt,
+                                     Uint8 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_PixelFormatDetails *dst_fmt)
+{
+    const int srcbpp = src_fmt->bytes_per_pixel;
+    const int dstbpp = dst_fmt->bytes_per_pixel;
+    Uint32 bpp = dstbpp;
+    Uint32 pixel;
+    unsigned R, G, B, A;
+    SDL_SCALE_NEAREST__START
+    for (i = 0; i < dst_h; i++) {
+        SDL_SCALE_NEAREST__HEIGHT
+        while (n--) {
+            const Uint8 *src;
+            srcx = srcbpp * (posx >> 16);
+            posx += incx;
+            src = (const Uint8 *)src_h0 + srcx;
+            DISEMBLE_RGBA(src, srcbpp, src_fmt, pixel, R, G, B, A);
+            ASSEMBLE_RGBA(dst, dstbpp, dst_fmt, R, G, B, A);
+            dst += dstbpp;
+        }
+        dst += dst_gap;
+    }
+    return 0;
+}
+
+static int scale_mat_convert_linear(const Uint8 *src, int src_w, int src_h, int src_pitch, const SDL_PixelFormatDetails *src_fmt,
+                                    Uint8 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_PixelFormatDetails *dst_fmt)
+{
+    const int srcbpp = src_fmt->bytes_per_pixel;
+    const int dstbpp = dst_fmt->bytes_per_pixel;
+    int *offsets;
+    int *fracs;
+    Uint32 pixel;
+    unsigned R[4], G[4], B[4], A[4];
+    int x;
+    BILINEAR___START
+
+    /* The horizontal sample positions are the same for every row */
+    offsets = (int *)SDL_malloc(dst_w * 2 * sizeof(*offsets));
+    if (!offsets) {
+        return -1;
+    }
+    fracs = offsets + dst_w;
+    fp_sum_w = fp_sum_w_init;
+    for (x = 0; x < dst_w; ++x) {
+        int index_w;
+        if (x < left_pad_w) {
+            index_w = 0;
+            fracs[x] = FRAC_ZERO;
+        } else if (x >= dst_w - right_pad_w) {
+            index_w = SDL_max(src_w - 2, 0);
+            fracs[x] = FRAC_ONE;
+        } else {
+            index_w = SRC_INDEX(fp_sum_w);
+            fracs[x] = FRAC(fp_sum_w);
+            fp_sum_w += fp_step_w;
+        }
+        offsets[x] = index_w * srcbpp;
+    }
+    dst_gap = dst_pitch - dstbpp * dst_w;
+    (void)middle_init;
+
+    for (i = 0; i < dst_h; i++) {
+        const Uint8 *row0, *row1;
+        const int next = (src_w > 1) ? srcbpp : 0;
+
+        BILINEAR___HEIGHT
+        (void)middle;
+
+        row0 = (const Uint8 *)src_h0;
+        row1 = (const Uint8 *)src_h1;
+        for (x = 0; x < dst_w; ++x) {
+            const Uint8 *s0 = row0 + offsets[x];
+            const Uint8 *s1 = row1 + offsets[x];
+            const unsigned frac_w0 = fracs[x];
+            const unsigned frac_w1 = FRAC_ONE - frac_w0;
+            unsigned tR0, tG0, tB0, tA0;
+            unsigned tR1, tG1, tB1, tA1;
+
+            DISEMBLE_RGBA(s0, srcbpp, src_fmt, pixel, R[0], G[0], B[0], A[0]);
+            DISEMBLE_RGBA(s0 + next, srcbpp, src_fmt, pixel, R[1], G[1], B[1], A[1]);
+            DISEMBLE_RGBA(s1, srcbpp, src_fmt, pixel, R[2], G[2], B[2], A[2]);
+            DISEMBLE_RGBA(s1 + next, srcbpp, src_fmt, pixel, R[3], G[3], B[3], A[3]);
+
+            /* Vertical first, then horizontal, matching INTERPOL_BILINEAR() */
+            tR0 = INTEGER(frac_h1 * R[0] + frac_h0 * R[2]);
+            tG0 = INTEGER(frac_h1 * G[0] + frac_h0 * G[2]);
+            tB0 = INTEGER(frac_h1 * B[0] + frac_h0 * B[2]);
+            tA0 = INTEGER(frac_h1 * A[0] + frac_h0 * A[2]);
+            tR1 = INTEGER(frac_h1 * R[1] + frac_h0 * R[3]);
+            tG1 = INTEGER(frac_h1 * G[1] + frac_h0 * G[3]);
+            tB1 = INTEGER(frac_h1 * B[1] + frac_h0 * B[3]);
+            tA1 = INTEGER(frac_h1 * A[1] + frac_h0 * A[3]);
+            R[0] = INTEGER(frac_w1 * tR0 + frac_w0 * tR1);
+            G[0] = INTEGER(frac_w1 * tG0 + frac_w0 * tG1);
+            B[0] = INTEGER(frac_w1 * tB0 + frac_w0 * tB1);
+            A[0] = INTEGER(frac_w1 * tA0 + frac_w0 * tA1);
+
+            ASSEMBLE_RGBA(dst, dstbpp, dst_fmt, R[0], G[0], B[0], A[0]);
+            dst += dstbpp;
+        }
+        dst += dst_gap;
+    }
+
+    SDL_free(offsets);
+    return 0;
+}
+
+int SDL_LowerSoftStretchConvert(SDL_Surface *s, const SDL_Rect *srcrect,
+                                SDL_Surface *d, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    const SDL_PixelFormatDetails *src_fmt = s->internal->format;
+    const SDL_PixelFormatDetails *dst_fmt = d->internal->format;
+    int src_w = srcrect->w;
+    int src_h = srcrect->h;
+    int dst_w = dstrect->w;
+    int dst_h = dstrect->h;
+    int src_pitch = s->pitch;
+    int dst_pitch = d->pitch;
+    const Uint8 *src = (const Uint8 *)s->pixels + srcrect->x * src_fmt->bytes_per_pixel + srcrect->y * src_pitch;
+    Uint8 *dst = (Uint8 *)d->pixels + dstrect->x * dst_fmt->bytes_per_pixel + dstrect->y * dst_pitch;
+
+    if (scaleMode == SDL_SCALEMODE_NEAREST) {
+        return scale_mat_convert_nearest(src, src_w, src_h, src_pitch, src_fmt, dst, dst_w, dst_h, dst_pitch, dst_fmt);
+    } else {
+        return scale_mat_convert_linear(src, src_w, src_h, src_pitch, src_fmt, dst, dst_w, dst_h, dst_pitch, dst_fmt);
+    }
+}
+
+/* High quality scaling for SDL_SCALEMODE_BEST
+ *
+ * This is a separable resampler: each destination pixel is a weighted sum
+ * of a contiguous run of source pixels, first horizontally and then
+ * vertically. When reducing, the weights are the area of each source pixel
+ * covered by the destination pixel (box filter), which handles both integer
+ * and fractional reductions without aliasing. When enlarging, the weights
+ * come from a Catmull-Rom bicubic kernel.
+ *
+ * The channels are filtered as values scaled by 255. When alpha isn't
+ * premultiplied, the color is multiplied by alpha first and divided by the
+ * filtered alpha afterwards, so transparent pixels don't bleed their color
+ * into the visible ones. The horizontal and vertical filter passes have
+ * SSE2 and NEON versions, which give the same results as the C ones.
+ */
+#define BEST_WEIGHT_BITS    14
+#define BEST_WEIGHT_ONE     (1 << BEST_WEIGHT_BITS)
+
+typedef struct
+{
+    int start;
+    int count;
+    const int *weights;
+} ScaleContrib;
+
+static float CubicWeight(float x)
+{
+    const float a = -0.5f;
+
+    x = SDL_fabsf(x);
+    if (x <= 1.0f) {
+        return ((a + 2.0f) * x - (a + 3.0f)) * x * x + 1.0f;
+    } else if (x < 2.0f) {
+        return ((a * x - 5.0f * a) * x + 8.0f * a) * x - 4.0f * a;
+    }
+    return 0.0f;
+}
+
+static ScaleContrib *CreateScaleContribs(int src_n, int dst_n)
+{
+    const double scale = (double)src_n / dst_n;
+    const SDL_bool reduce = (scale > 1.0);
+    const int max_taps = reduce ? (int)SDL_ceil(scale) + 1 : 4;
+    ScaleContrib *contribs;
+    int *weights;
+    int i, j;
+
+    contribs = (ScaleContrib *)SDL_malloc(dst_n * (sizeof(*contribs) + max_taps * sizeof(*weights)));
+    if (!contribs) {
+        return NULL;
+    }
+    weights = (int *)(contribs + dst_n);
+
+    for (i = 0; i < dst_n; ++i, weights += max_taps) {
+        ScaleContrib *contrib = &contribs[i];
+        float w[4];
+        int sum = 0, largest = 0;
+
+        if (reduce) {
+            const double x0 = i * scale;
+            const double x1 = (i + 1) * scale;
+
+            contrib->start = (int)x0;
+            contrib->count = SDL_min((int)SDL_ceil(x1), src_n) - contrib->start;
+            for (j = 0; j < contrib->count; ++j) {
+                const double left = SDL_max(x0, (double)(contrib->start + j));
+                const double right = SDL_min(x1, (double)(contrib->start + j + 1));
+                weights[j] = (int)(((right - left) / scale) * BEST_WEIGHT_ONE + 0.5);
+            }
+        } else {
+            const float center = (float)((i + 0.5) * scale - 0.5);
+            const int base = (int)SDL_floorf(center) - 1;
+            const float t = center - SDL_floorf(center);
+            int first, last;
+
+            w[0] = CubicWeight(t + 1.0f);
+            w[1] = CubicWeight(t);
+            w[2] = CubicWeight(1.0f - t);
+            w[3] = CubicWeight(2.0f - t);
+
+            /* Taps outside the source use the edge pixels */
+            first = SDL_max(base, 0);
+            last = SDL_min(base + 3, src_n - 1);
+            if (first > last) {
+                first = last = (base < 0) ? 0 : src_n - 1;
+            }
+            contrib->start = first;
+            contrib->count = last - first + 1;
+            for (j = 0; j < contrib->count; ++j) {
+                weights[j] = 0;
+            }
+            for (j = 0; j < 4; ++j) {
+                const int index = SDL_clamp(base + j, first, last) - first;
+                weights[index] += (int)SDL_roundf(w[j] * BEST_WEIGHT_ONE);
+            }
+        }
+
+        /* Make sure the weights add up to exactly one */
+        for (j = 0; j < contrib->count; ++j) {
+            sum += weights[j];
+            if (weights[j] > weights[largest]) {
+                largest = j;
+            }
+        }
+        weights[largest] += BEST_WEIGHT_ONE - sum;
+        contrib->weights = weights;
+    }
+    return contribs;
+}
+
+/* Decode a source row into R, G, B and A values scaled by 255, with the color scaled by alpha instead if weight_alpha is set */
+typedef void (*DecodeRowBestFunc)(const Uint8 *src_row, int src_w, const SDL_PixelFormatDetails *src_fmt, SDL_bool weight_alpha, Uint16 *decoded);
+
+/* Filter decoded source pixels horizontally into one row of dst_w pixels */
+typedef void (*ScaleRowBestFunc)(const Uint16 *decoded, const ScaleContrib *contribs, Sint32 *row, int dst_w);
+
+/* Filter the horizontally scaled rows in taps vertically into one row of dst_w pixels */
+typedef void (*CombineRowsBestFunc)(Sint32 *const *taps, const ScaleContrib *contrib, Sint32 *combined, int dst_w);
+
+static void decode_row_best(const Uint8 *src_row, int src_w, const SDL_PixelFormatDetails *src_fmt, SDL_bool weight_alpha, Uint16 *decoded)
+{
+    const int srcbpp = src_fmt->bytes_per_pixel;
+    Uint32 pixel;
+    unsigned R, G, B, A;
+    int x;
+
+    for (x = 0; x < src_w; ++x, src_row += srcbpp, decoded += 4) {
+        unsigned scale;
+
+        DISEMBLE_RGBA(src_row, srcbpp, src_fmt, pixel, R, G, B, A);
+        scale = weight_alpha ? A : 255;
+        decoded[0] = (Uint16)(R * scale);
+        decoded[1] = (Uint16)(G * scale);
+        decoded[2] = (Uint16)(B * scale);
+        decoded[3] = (Uint16)(A * 255);
+    }
+}
+
+/* 32-bit formats with 8 bits per channel have SIMD decoders */
+static SDL_bool IsBestFormat8888(const SDL_PixelFormatDetails *fmt)
+{
+    return fmt->bytes_per_pixel == 4 && fmt->Rbits == 8 && fmt->Gbits == 8 && fmt->Bbits == 8 &&
+           (fmt->Abits == 8 || fmt->Abits == 0);
+}
+
+static void scale_row_best(const Uint16 *decoded, const ScaleContrib *contribs, Sint32 *row, int dst_w)
+{
+    int x, i, j;
+
+    for (x = 0; x < dst_w; ++x, row += 4) {
+        const ScaleContrib *contrib_x = &contribs[x];
+        const Uint16 *s = decoded + contrib_x->start * 4;
+        Sint32 sum[4] = { 0, 0, 0, 0 };
+
+        for (j = 0; j < contrib_x->count; ++j, s += 4) {
+            const int weight = contrib_x->weights[j];
+            sum[0] += weight * s[0];
+            sum[1] += weight * s[1];
+            sum[2] += weight * s[2];
+            sum[3] += weight * s[3];
+        }
+        for (i = 0; i < 4; ++i) {
+            row[i] = (sum[i] + (1 << (BEST_WEIGHT_BITS - 1))) >> BEST_WEIGHT_BITS;
+        }
+    }
+}
+
+static void combine_rows_best(Sint32 *const *taps, const ScaleContrib *contrib, Sint32 *combined, int dst_w)
+{
+    int x, i, k;
+
+    for (x = 0; x < dst_w * 4; x += 4) {
+        Sint32 sum[4] = { 0, 0, 0, 0 };
+
+        for (k = 0; k < contrib->count; ++k) {
+            const Sint32 *s = taps[k] + x;
+            const int weight = contrib->weights[k];
+            sum[0] += weight * s[0];
+            sum[1] += weight * s[1];
+            sum[2] += weight * s[2];
+            sum[3] += weight * s[3];
+        }
+        for (i = 0; i < 4; ++i) {
+            combined[x + i] = (sum[i] + (1 << (BEST_WEIGHT_BITS - 1))) >> BEST_WEIGHT_BITS;
+        }
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* _mm_madd_epi16() multiplies signed 16-bit values, so the channels are biased by -0x8000
+ * to fit. The weights always add up to BEST_WEIGHT_ONE, so the sums are off by exactly
+ * 0x8000 * BEST_WEIGHT_ONE, which is added back along with the rounding.
+ */
+#define BEST_SSE_BIAS (0x8000 * BEST_WEIGHT_ONE + (1 << (BEST_WEIGHT_BITS - 1)))
+
+static void SDL_TARGETING("sse2") decode_row_best_8888_SSE(const Uint8 *src_row, int src_w, const SDL_PixelFormatDetails *src_fmt, SDL_bool weight_alpha, Uint16 *decoded)
+{
+    const __m128i Rshift = _mm_cvtsi32_si128(src_fmt->Rshift);
+    const __m128i Gshift = _mm_cvtsi32_si128(src_fmt->Gshift);
+    const __m128i Bshift = _mm_cvtsi32_si128(src_fmt->Bshift);
+    const __m128i Ashift = _mm_cvtsi32_si128(src_fmt->Ashift);
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i opaque = _mm_set1_epi32(255);
+    const SDL_bool has_alpha = (src_fmt->Amask != 0);
+    int x;
+
+    /* Four pixels at a time, each channel in the low byte of a 32-bit lane */
+    for (x = 0; x + 4 <= src_w; x += 4, src_row += 16, decoded += 16) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)src_row);
+        const __m128i a = has_alpha ? _mm_and_si128(_mm_srl_epi32(pixels, Ashift), mask) : opaque;
+        const __m128i scale = weight_alpha ? a : opaque;
+        const __m128i r = _mm_mullo_epi16(_mm_and_si128(_mm_srl_epi32(pixels, Rshift), mask), scale);
+        const __m128i g = _mm_mullo_epi16(_mm_and_si128(_mm_srl_epi32(pixels, Gshift), mask), scale);
+        const __m128i b = _mm_mullo_epi16(_mm_and_si128(_mm_srl_epi32(pixels, Bshift), mask), scale);
+        const __m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+        const __m128i ba = _mm_or_si128(b, _mm_slli_epi32(_mm_mullo_epi16(a, opaque), 16));
+
+        _mm_storeu_si128((__m128i *)decoded, _mm_unpacklo_epi32(rg, ba));
+        _mm_storeu_si128((__m128i *)(decoded + 8), _mm_unpackhi_epi32(rg, ba));
+    }
+    decode_row_best(src_row, src_w - x, src_fmt, weight_alpha, decoded);
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse2") best_weight_pair_SSE(int weight0, int weight1)
+{
+    return _mm_set1_epi32((int)(((Uint32)weight0 & 0xFFFF) | ((Uint32)weight1 << 16)));
+}
+
+static void SDL_TARGETING("sse2") scale_row_best_SSE(const Uint16 *decoded, const ScaleContrib *contribs, Sint32 *row, int dst_w)
+{
+    const __m128i sign = _mm_set1_epi16((short)0x8000);
+    const __m128i bias = _mm_set1_epi32(BEST_SSE_BIAS);
+    int x, j;
+
+    for (x = 0; x < dst_w; ++x, row += 4) {
+        const ScaleContrib *contrib_x = &contribs[x];
+        const int *weights = contrib_x->weights;
+        const Uint16 *s = decoded + contrib_x->start * 4;
+        __m128i sum = bias;
+
+        /* Two source pixels at a time, interleaved as R0 R1 G0 G1 B0 B1 A0 A1 */
+        for (j = 0; j + 1 < contrib_x->count; j += 2, s += 8) {
+            __m128i pixels = _mm_xor_si128(_mm_loadu_si128((const __m128i *)s), sign);
+            pixels = _mm_unpacklo_epi16(pixels, _mm_srli_si128(pixels, 8));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(pixels, best_weight_pair_SSE(weights[j], weights[j + 1])));
+        }
+        if (j < contrib_x->count) {
+            __m128i pixel = _mm_xor_si128(_mm_loadl_epi64((const __m128i *)s), sign);
+            pixel = _mm_unpacklo_epi16(pixel, _mm_setzero_si128());
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(pixel, best_weight_pair_SSE(weights[j], 0)));
+        }
+        _mm_storeu_si128((__m128i *)row, _mm_srai_epi32(sum, BEST_WEIGHT_BITS));
+    }
+}
+
+/* This packs the rows to 16 bits, so it's only used when the horizontal pass reduces,
+ * where the weights aren't negative and the rows stay in the range 0 to 255 * 255.
+ */
+static void SDL_TARGETING("sse2") combine_rows_best_SSE(Sint32 *const *taps, const ScaleContrib *contrib, Sint32 *combined, int dst_w)
+{
+    const __m128i sign = _mm_set1_epi32(0x8000);
+    const __m128i bias = _mm_set1_epi32(BEST_SSE_BIAS);
+    const int *weights = contrib->weights;
+    int x, k;
+
+    /* Two destination pixels at a time, the last one is repeated if dst_w is odd */
+    for (x = 0; x < dst_w * 4; x += 8) {
+        const int next = (x + 4 < dst_w * 4) ? 4 : 0;
+        __m128i sum0 = bias;
+        __m128i sum1 = bias;
+
+        for (k = 0; k < contrib->count; k += 2) {
+            const Sint32 *s0 = taps[k] + x;
+            __m128i row0 = _mm_packs_epi32(_mm_sub_epi32(_mm_loadu_si128((const __m128i *)s0), sign),
+                                           _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(s0 + next)), sign));
+            __m128i row1 = _mm_setzero_si128();
+            __m128i weight;
+
+            if (k + 1 < contrib->count) {
+                const Sint32 *s1 = taps[k + 1] + x;
+                row1 = _mm_packs_epi32(_mm_sub_epi32(_mm_loadu_si128((const __m128i *)s1), sign),
+                                       _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(s1 + next)), sign));
+                weight = best_weight_pair_SSE(weights[k], weights[k + 1]);
+            } else {
+                weight = best_weight_pair_SSE(weights[k], 0);
+            }
+            sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(_mm_unpacklo_epi16(row0, row1), weight));
+            sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(_mm_unpackhi_epi16(row0, row1), weight));
+        }
+        _mm_storeu_si128((__m128i *)(combined + x), _mm_srai_epi32(sum0, BEST_WEIGHT_BITS));
+        if (next) {
+            _mm_storeu_si128((__m128i *)(combined + x + 4), _mm_srai_epi32(sum1, BEST_WEIGHT_BITS));
+        }
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+static void decode_row_best_8888_NEON(const Uint8 *src_row, int src_w, const SDL_PixelFormatDetails *src_fmt, SDL_bool weight_alpha, Uint16 *decoded)
+{
+    const uint8x8_t opaque = vdup_n_u8(255);
+    int x;
+
+    /* Eight pixels at a time, split into one vector per byte of the pixels */
+    for (x = 0; x + 8 <= src_w; x += 8, src_row += 32, decoded += 32) {
+        const uint8x8x4_t bytes = vld4_u8(src_row);
+        const uint8x8_t a = src_fmt->Amask ? bytes.val[src_fmt->Ashift / 8] : opaque;
+        const uint8x8_t scale = weight_alpha ? a : opaque;
+        uint16x8x4_t channels;
+
+        channels.val[0] = vmull_u8(bytes.val[src_fmt->Rshift / 8], scale);
+        channels.val[1] = vmull_u8(bytes.val[src_fmt->Gshift / 8], scale);
+        channels.val[2] = vmull_u8(bytes.val[src_fmt->Bshift / 8], scale);
+        channels.val[3] = vmull_u8(a, opaque);
+        vst4q_u16(decoded, channels);
+    }
+    decode_row_best(src_row, src_w - x, src_fmt, weight_alpha, decoded);
+}
+#endif
+
+static void scale_row_best_NEON(const Uint16 *decoded, const ScaleContrib *contribs, Sint32 *row, int dst_w)
+{
+    const int32x4_t half = vdupq_n_s32(1 << (BEST_WEIGHT_BITS - 1));
+    int x, j;
+
+    for (x = 0; x < dst_w; ++x, row += 4) {
+        const ScaleContrib *contrib_x = &contribs[x];
+        const Uint16 *s = decoded + contrib_x->start * 4;
+        int32x4_t sum = half;
+
+        for (j = 0; j < contrib_x->count; ++j, s += 4) {
+            const int32x4_t pixel = vreinterpretq_s32_u32(vmovl_u16(vld1_u16(s)));
+            sum = vmlaq_n_s32(sum, pixel, contrib_x->weights[j]);
+        }
+        vst1q_s32(row, vshrq_n_s32(sum, BEST_WEIGHT_BITS));
+    }
+}
+
+static void combine_rows_best_NEON(Sint32 *const *taps, const ScaleContrib *contrib, Sint32 *combined, int dst_w)
+{
+    const int32x4_t half = vdupq_n_s32(1 << (BEST_WEIGHT_BITS - 1));
+    int x, k;
+
+    for (x = 0; x < dst_w * 4; x += 4) {
+        int32x4_t sum = half;
+
+        for (k = 0; k < contrib->count; ++k) {
+            sum = vmlaq_n_s32(sum, vld1q_s32(taps[k] + x), contrib->weights[k]);
+        }
+        vst1q_s32(combined + x, vshrq_n_s32(sum, BEST_WEIGHT_BITS));
+    }
+}
+#endif
+
+static int scale_mat_best(const Uint8 *src, int src_w, int src_h, int src_pitch, const SDL_PixelFormatDetails *src_fmt,
+                          Uint8 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_PixelFormatDetails *dst_fmt,
+                          SDL_bool weight_alpha)
+{
+    const int dstbpp = dst_fmt->bytes_per_pixel;
+    DecodeRowBestFunc decode_row = decode_row_best;
+    ScaleRowBestFunc scale_row = scale_row_best;
+    CombineRowsBestFunc combine_rows = combine_rows_best;
+    ScaleContrib *contribs_x = NULL;
+    ScaleContrib *contribs_y = NULL;
+    Uint16 *decoded = NULL;
+    Sint32 *rows = NULL;
+    Sint32 **taps = NULL;
+    Sint32 *combined = NULL;
+    int *cached = NULL;
+    int num_rows = 0;
+    unsigned R, G, B, A;
+    int x, y, i, k;
+    int ret = -1;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        if (IsBestFormat8888(src_fmt)) {
+            decode_row = decode_row_best_8888_SSE;
+        }
+        scale_row = scale_row_best_SSE;
+        if (src_w >= dst_w) {
+            combine_rows = combine_rows_best_SSE;
+        }
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        if (IsBestFormat8888(src_fmt)) {
+            decode_row = decode_row_best_8888_NEON;
+        }
+#endif
+        scale_row = scale_row_best_NEON;
+        combine_rows = combine_rows_best_NEON;
+    }
+#endif
+
+    contribs_x = CreateScaleContribs(src_w, dst_w);
+    contribs_y = CreateScaleContribs(src_h, dst_h);
+    if (!contribs_x || !contribs_y) {
+        goto done;
+    }
+
+    /* Keep enough horizontally scaled rows for one destination row */
+    for (y = 0; y < dst_h; ++y) {
+        num_rows = SDL_max(num_rows, contribs_y[y].count);
+    }
+    decoded = (Uint16 *)SDL_malloc(src_w * 4 * sizeof(*decoded));
+    rows = (Sint32 *)SDL_malloc(num_rows * dst_w * 4 * sizeof(*rows));
+    taps = (Sint32 **)SDL_malloc(num_rows * sizeof(*taps));
+    combined = (Sint32 *)SDL_malloc(dst_w * 4 * sizeof(*combined));
+    cached = (int *)SDL_malloc(num_rows * sizeof(*cached));
+    if (!decoded || !rows || !taps || !combined || !cached) {
+        goto done;
+    }
+    for (i = 0; i < num_rows; ++i) {
+        cached[i] = -1;
+    }
+
+    for (y = 0; y < dst_h; ++y) {
+        const ScaleContrib *contrib_y = &contribs_y[y];
+        Uint8 *dst_row = dst + y * dst_pitch;
+        const Sint32 *value;
+
+        /* Scale the source rows needed for this destination row */
+        for (k = 0; k < contrib_y->count; ++k) {
+            const int src_y = contrib_y->start + k;
+
+            taps[k] = rows + (src_y % num_rows) * dst_w * 4;
+            if (cached[src_y % num_rows] == src_y) {
+                continue;
+            }
+            cached[src_y % num_rows] = src_y;
+
+            decode_row(src + src_y * src_pitch, src_w, src_fmt, weight_alpha, decoded);
+            scale_row(decoded, contribs_x, taps[k], dst_w);
+        }
+
+        /* Combine them vertically */
+        combine_rows(taps, contrib_y, combined, dst_w);
+
+        for (x = 0, value = combined; x < dst_w; ++x, value += 4, dst_row += dstbpp) {
+            int channel[4];
+
+            for (i = 0; i < 4; ++i) {
+                channel[i] = SDL_clamp(value[i], 0, 255 * 255);
+            }
+
+            /* Scale the channels back down, color by the filtered alpha if it was weighted by alpha */
+            if (weight_alpha) {
+                const int alpha = channel[3];
+                for (i = 0; i < 3; ++i) {
+                    channel[i] = (alpha > 0) ? SDL_min((channel[i] * 255 + alpha / 2) / alpha, 255) : 0;
+                }
+            } else {
+                for (i = 0; i < 3; ++i) {
+                    channel[i] = (channel[i] + 127) / 255;
+                }
+            }
+            R = channel[0];
+            G = channel[1];
+            B = channel[2];
+            A = (channel[3] + 127) / 255;
+            ASSEMBLE_RGBA(dst_row, dstbpp, dst_fmt, R, G, B, A);
+        }
+    }
+    ret = 0;
+
+done:
+    SDL_free(contribs_x);
+    SDL_free(contribs_y);
+    SDL_free(decoded);
+    SDL_free(rows);
+    SDL_free(taps);
+    SDL_free(combined);
+    SDL_free(cached);
+    return ret;
+}
+
+int SDL_LowerSoftStretchBest(SDL_Surface *s, const SDL_Rect *srcrect,
+                             SDL_Surface *d, const SDL_Rect *dstrect)
+{
+    const SDL_PixelFormatDetails *src_fmt = s->internal->format;
+    const SDL_PixelFormatDetails *dst_fmt = d->internal->format;
+    const Uint8 *src = (const Uint8 *)s->pixels + srcrect->x * src_fmt->bytes_per_pixel + srcrect->y * s->pitch;
+    Uint8 *dst = (Uint8 *)d->pixels + dstrect->x * dst_fmt->bytes_per_pixel + dstrect->y * d->pitch;
+    const SDL_bool weight_alpha = (SDL_ISPIXELFORMAT_ALPHA(s->format) &&
+                                   !(s->internal->map.info.flags & (SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD_PREMULTIPLIED)));
+
+    return scale_mat_best(src, srcrect->w, srcrect->h, s->pitch, src_fmt, dst, dstrect->w, dstrect->h, d->pitch, dst_fmt, weight_alpha);
+}
+
+/* Mipmap generation: each destination pixel is the average of a 2x2 block of source pixels.
+ * When the source has an odd width or height, the last column or row of blocks also takes in
+ * the remaining source column or row, so those pixels aren't dropped.
+ * When alpha isn't premultiplied, the color channels are weighted by alpha so that
+ * transparent pixels don't bleed their color into the visible ones.
+ */
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") halve_row_8888_SSE(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int dst_w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+
+    while (dst_w >= 2) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)row0);
+        const __m128i b = _mm_loadu_si128((const __m128i *)row1);
+        /* Pixels 0 and 1 in lo, 2 and 3 in hi, with both rows added */
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        __m128i sum;
+
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+        sum = _mm_unpacklo_epi64(lo, hi);
+        sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+        _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(sum, zero));
+
+        row0 += 16;
+        row1 += 16;
+        dst += 8;
+        dst_w -= 2;
+    }
+    if (dst_w) {
+        int i;
+        for (i = 0; i < 4; ++i) {
+            dst[i] = (Uint8)((row0[i] + row0[4 + i] + row1[i] + row1[4 + i] + 2) >> 2);
+        }
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void halve_row_8888_NEON(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int dst_w)
+{
+    while (dst_w >= 2) {
+        const uint8x16_t a = vld1q_u8(row0);
+        const uint8x16_t b = vld1q_u8(row1);
+        /* Pixels 0 and 1 in lo, 2 and 3 in hi, with both rows added */
+        const uint16x8_t lo = vaddl_u8(vget_low_u8(a), vget_low_u8(b));
+        const uint16x8_t hi = vaddl_u8(vget_high_u8(a), vget_high_u8(b));
+        const uint16x8_t sum = vcombine_u16(vadd_u16(vget_low_u16(lo), vget_high_u16(lo)),
+                                            vadd_u16(vget_low_u16(hi), vget_high_u16(hi)));
+        vst1_u8(dst, vrshrn_n_u16(sum, 2));
+
+        row0 += 16;
+        row1 += 16;
+        dst += 8;
+        dst_w -= 2;
+    }
+    if (dst_w) {
+        int i;
+        for (i = 0; i < 4; ++i) {
+            dst[i] = (Uint8)((row0[i] + row0[4 + i] + row1[i] + row1[4 + i] + 2) >> 2);
+        }
+    }
+}
+#endif
+
+static void halve_row_8888(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int dst_w)
+{
+    int i;
+
+    for (i = 0; i < dst_w * 4; ++i) {
+        const int x = (i & ~3) * 2 + (i & 3);
+        dst[i] = (Uint8)((row0[x] + row0[x + 4] + row1[x] + row1[x + 4] + 2) >> 2);
+    }
+}
+
+/* Average a block of up to 3x3 source pixels */
+static void halve_block(const Uint8 *row, int pitch, int cols, int rows, int bpp, const SDL_PixelFormatDetails *fmt,
+                        SDL_bool weight_alpha, unsigned *r, unsigned *g, unsigned *b, unsigned *a)
+{
+    const unsigned count = (unsigned)(cols * rows);
+    unsigned sumR = 0, sumG = 0, sumB = 0, sumA = 0;
+    unsigned weightedR = 0, weightedG = 0, weightedB = 0;
+    int x, y;
+
+    for (y = 0; y < rows; ++y, row += pitch) {
+        const Uint8 *pixels = row;
+        for (x = 0; x < cols; ++x, pixels += bpp) {
+            Uint32 pixel;
+            unsigned R, G, B, A;
+
+            DISEMBLE_RGBA(pixels, bpp, fmt, pixel, R, G, B, A);
+            sumR += R;
+            sumG += G;
+            sumB += B;
+            sumA += A;
+            weightedR += R * A;
+            weightedG += G * A;
+            weightedB += B * A;
+        }
+    }
+
+    if (weight_alpha && sumA > 0 && sumA < count * 255) {
+        *r = (weightedR + sumA / 2) / sumA;
+        *g = (weightedG + sumA / 2) / sumA;
+        *b = (weightedB + sumA / 2) / sumA;
+    } else {
+        *r = (sumR + count / 2) / count;
+        *g = (sumG + count / 2) / count;
+        *b = (sumB + count / 2) / count;
+    }
+    *a = (sumA + count / 2) / count;
+}
+
+int SDL_SoftHalveSurface(SDL_Surface *src, SDL_Surface *dst)
+{
+    const SDL_PixelFormatDetails *fmt = src->internal->format;
+    const int bpp = fmt->bytes_per_pixel;
+    const SDL_bool weight_alpha = (SDL_ISPIXELFORMAT_ALPHA(src->format) &&
+                                   !(src->internal->map.info.flags & (SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD_PREMULTIPLIED)));
+    const int block_w = (src->w > 1) ? 2 : 1;
+    const int block_h = (src->h > 1) ? 2 : 1;
+    /* The last block takes in the remaining column or row of an odd size */
+    const int last_block_w = block_w + (src->w > 1 ? (src->w & 1) : 0);
+    const int last_block_h = block_h + (src->h > 1 ? (src->h & 1) : 0);
+    const int fast_w = (last_block_w == 2) ? dst->w : dst->w - 1;
+    int x, y;
+
+    if (src->format != dst->format ||
+        dst->w != SDL_max(src->w / 2, 1) || dst->h != SDL_max(src->h / 2, 1)) {
+        return SDL_SetError("Invalid mipmap surface");
+    }
+    if (!IsStretchConvertFormat(src->format)) {
+        return SDL_Unsupported();
+    }
+
+    for (y = 0; y < dst->h; ++y) {
+        const Uint8 *row = (const Uint8 *)src->pixels + (2 * y) * src->pitch;
+        const int rows = (y == dst->h - 1) ? last_block_h : block_h;
+        Uint8 *out = (Uint8 *)dst->pixels + y * dst->pitch;
+
+        x = 0;
+        if (bpp == 4 && SDL_PIXELLAYOUT(src->format) == SDL_PACKEDLAYOUT_8888 && !weight_alpha &&
+            block_w == 2 && rows == 2 && fast_w > 0) {
+            const Uint8 *row1 = row + src->pitch;
+#ifdef SDL_NEON_INTRINSICS
+            if (hasNEON()) {
+                halve_row_8888_NEON(row, row1, out, fast_w);
+            } else
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+            if (hasSSE2()) {
+                halve_row_8888_SSE(row, row1, out, fast_w);
+            } else
+#endif
+            {
+                halve_row_8888(row, row1, out, fast_w);
+            }
+            x = fast_w;
+        }
+
+        for (; x < dst->w; ++x) {
+            const int cols = (x == dst->w - 1) ? last_block_w : block_w;
+            unsigned r, g, b, a;
+
+            halve_block(row + 2 * x * bpp, src->pitch, cols, rows, bpp, fmt, weight_alpha, &r, &g, &b, &a);
+            ASSEMBLE_RGBA(out + x * bpp, bpp, fmt, r, g, b, a);
+        }
+    }
+    return 0;
+}
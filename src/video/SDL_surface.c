@@ -470,6 +470,39 @@ SDL_bool SDL_SurfaceHasRLE(SDL_Surface *surface)
     return SDL_TRUE;
 }
 
+int SDL_PrepareSurfaceRLE(SDL_Surface *surface, SDL_Surface *dst)
+{
+    if (!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+
+    if (!SDL_SurfaceValid(dst)) {
+        return SDL_InvalidParamError("dst");
+    }
+
+    if (surface->internal->locked || dst->internal->locked) {
+        return SDL_SetError("Surfaces must not be locked during RLE encoding");
+    }
+
+#if SDL_HAVE_RLE
+    if (SDL_SetSurfaceRLE(surface, SDL_TRUE) < 0) {
+        return -1;
+    }
+
+    /* This encodes the surface for the destination format */
+    if (SDL_ValidateMap(surface, dst) < 0) {
+        return -1;
+    }
+
+    if (!(surface->internal->flags & SDL_INTERNAL_SURFACE_RLEACCEL)) {
+        return SDL_SetError("RLE acceleration isn't supported for this blit");
+    }
+    return 0;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 int SDL_SetSurfaceColorKey(SDL_Surface *surface, SDL_bool enabled, Uint32 key)
 {
     int flags;
@@ -852,6 +885,8 @@ int SDL_BlitSurfaceUnchecked(SDL_Surface *src, const SDL_Rect *srcrect,
     if (SDL_ValidateMap(src, dst) < 0) {
         return -1;
     }
+    SDL_InvalidateSurfaceMipmaps(dst);
+    SDL_ReportBlitFunc(src, src->internal->map.blit_name);
     return src->internal->map.blit(src, srcrect, dst, dstrect);
 }
 
@@ -1107,6 +1142,50 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
                                               SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_ADD_PREMULTIPLIED | SDL_COPY_MOD | SDL_COPY_MUL |
                                               SDL_COPY_COLORKEY);
 
+    SDL_InvalidateSurfaceMipmaps(dst);
+
+    if (src->internal->num_mipmaps > 0 && !src->internal->mipmaps_dirty && scaleMode != SDL_SCALEMODE_NEAREST &&
+        !(src->internal->map.info.flags & SDL_COPY_COLORKEY)) {
+        /* Use the smallest mipmap that is at least as large as the destination */
+        int level = 0;
+        while (level < src->internal->num_mipmaps &&
+               (srcrect->w >> (level + 1)) >= dstrect->w &&
+               (srcrect->h >> (level + 1)) >= dstrect->h) {
+            ++level;
+        }
+        if (level > 0) {
+            SDL_Surface *mipmap = src->internal->mipmaps[level - 1];
+            SDL_InternalSurface tmp_data;
+            SDL_Surface *tmp;
+            SDL_Rect mip_rect;
+            Uint8 r, g, b, a;
+            SDL_BlendMode blendMode;
+            int ret;
+
+            mip_rect.x = SDL_min(srcrect->x >> level, mipmap->w - 1);
+            mip_rect.y = SDL_min(srcrect->y >> level, mipmap->h - 1);
+            mip_rect.w = SDL_clamp(srcrect->w >> level, 1, mipmap->w - mip_rect.x);
+            mip_rect.h = SDL_clamp(srcrect->h >> level, 1, mipmap->h - mip_rect.y);
+
+            /* Blit the mipmap pixels with the source settings, without changing the mipmap,
+               so the same source surface can still be used from several threads at once */
+            tmp = SDL_InitializeSurface(&tmp_data, mipmap->w, mipmap->h, mipmap->format, src->internal->colorspace, 0, mipmap->pixels, mipmap->pitch, SDL_TRUE);
+            if (!tmp) {
+                return -1;
+            }
+            SDL_GetSurfaceColorMod(src, &r, &g, &b);
+            SDL_GetSurfaceAlphaMod(src, &a);
+            SDL_GetSurfaceBlendMode(src, &blendMode);
+            SDL_SetSurfaceColorMod(tmp, r, g, b);
+            SDL_SetSurfaceAlphaMod(tmp, a);
+            SDL_SetSurfaceBlendMode(tmp, blendMode);
+
+            ret = SDL_BlitSurfaceUncheckedScaled(tmp, &mip_rect, dst, dstrect, scaleMode);
+            SDL_DestroySurface(tmp);
+            return ret;
+        }
+    }
+
     if (srcrect->w > SDL_MAX_UINT16 || srcrect->h > SDL_MAX_UINT16 ||
         dstrect->w > SDL_MAX_UINT16 || dstrect->h > SDL_MAX_UINT16) {
         return SDL_SetError("Size too large for scaling");
@@ -1121,18 +1200,17 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
         if (!(src->internal->map.info.flags & complex_copy_flags) &&
             src->format == dst->format &&
             !SDL_ISPIXELFORMAT_INDEXED(src->format)) {
+            SDL_ReportBlitFunc(src, "SDL_SoftStretch");
             return SDL_SoftStretch(src, srcrect, dst, dstrect, SDL_SCALEMODE_NEAREST);
         } else {
             return SDL_BlitSurfaceUnchecked(src, srcrect, dst, dstrect);
         }
     } else {
         if (!(src->internal->map.info.flags & complex_copy_flags) &&
-            src->format == dst->format &&
-            !SDL_ISPIXELFORMAT_INDEXED(src->format) &&
-            SDL_BYTESPERPIXEL(src->format) == 4 &&
-            src->format != SDL_PIXELFORMAT_ARGB2101010) {
-            /* fast path */
-            return SDL_SoftStretch(src, srcrect, dst, dstrect, SDL_SCALEMODE_LINEAR);
+            SDL_CanSoftStretchLinear(src, dst)) {
+            /* fast path, converting the format while scaling if needed */
+            SDL_ReportBlitFunc(src, "SDL_SoftStretch");
+            return SDL_SoftStretch(src, srcrect, dst, dstrect, scaleMode);
         } else {
             /* Use intermediate surface(s) */
             SDL_Surface *tmp1 = NULL;
@@ -1182,7 +1260,7 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
             if (is_complex_copy_flags || src->format != dst->format) {
                 SDL_Rect tmprect;
                 SDL_Surface *tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                SDL_SoftStretch(src, &srcrect2, tmp2, NULL, SDL_SCALEMODE_LINEAR);
+                SDL_SoftStretch(src, &srcrect2, tmp2, NULL, scaleMode);
 
                 SDL_SetSurfaceColorMod(tmp2, r, g, b);
                 SDL_SetSurfaceAlphaMod(tmp2, alpha);
@@ -1195,7 +1273,7 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
                 ret = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, dstrect);
                 SDL_DestroySurface(tmp2);
             } else {
-                ret = SDL_SoftStretch(src, &srcrect2, dst, dstrect, SDL_SCALEMODE_LINEAR);
+                ret = SDL_SoftStretch(src, &srcrect2, dst, dstrect, scaleMode);
             }
 
             SDL_DestroySurface(tmp1);
@@ -1579,6 +1657,18 @@ void SDL_UnlockSurface(SDL_Surface *surface)
         return;
     }
 
+    /* The pixels may have been changed while the surface was locked */
+    if (surface->internal->locked) {
+        SDL_InvalidateSurfaceMipmaps(surface);
+    }
+    SDL_UnlockSurfaceReadOnly(surface);
+}
+
+/*
+ * Unlock a surface that was only read while locked, keeping its mipmaps
+ */
+void SDL_UnlockSurfaceReadOnly(SDL_Surface *surface)
+{
     /* Only perform an unlock if we are locked */
     if (!surface->internal->locked || (--surface->internal->locked > 0)) {
         return;
@@ -1657,6 +1747,133 @@ static int SDL_FlipSurfaceVertical(SDL_Surface *surface)
     return 0;
 }
 
+int SDL_GenerateSurfaceMipmaps(SDL_Surface *surface)
+{
+    SDL_Surface **mipmaps = NULL;
+    SDL_Surface *prev;
+    SDL_BlendMode blendMode;
+    SDL_bool reuse;
+    int num_mipmaps = 0;
+    int w, h, i;
+    int ret = 0;
+
+    if (!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (surface->w <= 0 || surface->h <= 0 || !surface->pixels) {
+        SDL_RemoveSurfaceMipmaps(surface);
+        return 0;
+    }
+    SDL_GetSurfaceBlendMode(surface, &blendMode);
+
+    for (w = surface->w, h = surface->h; w > 1 || h > 1; w = SDL_max(w / 2, 1), h = SDL_max(h / 2, 1)) {
+        ++num_mipmaps;
+    }
+
+    /* Rebuild existing mipmaps in place, they stay out of date until that succeeds */
+    reuse = (surface->internal->num_mipmaps == num_mipmaps);
+    if (reuse) {
+        mipmaps = surface->internal->mipmaps;
+        surface->internal->mipmaps_dirty = SDL_TRUE;
+    } else if (num_mipmaps > 0) {
+        mipmaps = (SDL_Surface **)SDL_calloc(num_mipmaps, sizeof(*mipmaps));
+        if (!mipmaps) {
+            return -1;
+        }
+    }
+
+    if (SDL_LockSurface(surface) < 0) {
+        if (!reuse) {
+            SDL_free(mipmaps);
+        }
+        return -1;
+    }
+    prev = surface;
+    for (i = 0; i < num_mipmaps; ++i) {
+        SDL_Surface *mipmap = mipmaps[i];
+        if (!mipmap) {
+            mipmap = SDL_CreateSurface(SDL_max(prev->w / 2, 1), SDL_max(prev->h / 2, 1), surface->format);
+            if (!mipmap) {
+                ret = -1;
+                break;
+            }
+            mipmaps[i] = mipmap;
+        }
+        /* The blend mode also selects premultiplied alpha handling for the next level */
+        if (SDL_SetSurfaceColorspace(mipmap, surface->internal->colorspace) < 0 ||
+            SDL_SetSurfaceBlendMode(mipmap, blendMode) < 0 ||
+            SDL_SoftHalveSurface(prev, mipmap) < 0) {
+            ret = -1;
+            break;
+        }
+        prev = mipmap;
+    }
+    SDL_UnlockSurfaceReadOnly(surface);
+
+    if (ret < 0) {
+        if (!reuse) {
+            for (i = 0; i < num_mipmaps; ++i) {
+                SDL_DestroySurface(mipmaps[i]);
+            }
+            SDL_free(mipmaps);
+        }
+        return ret;
+    }
+
+    if (!reuse) {
+        SDL_RemoveSurfaceMipmaps(surface);
+        surface->internal->num_mipmaps = num_mipmaps;
+        surface->internal->mipmaps = mipmaps;
+    }
+    surface->internal->mipmaps_dirty = SDL_FALSE;
+    return 0;
+}
+
+SDL_Surface *SDL_GetSurfaceMipmap(SDL_Surface *surface, int level)
+{
+    if (!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        return NULL;
+    }
+    if (level < 0 || level > surface->internal->num_mipmaps) {
+        SDL_InvalidParamError("level");
+        return NULL;
+    }
+    if (level == 0) {
+        return surface;
+    }
+    if (surface->internal->mipmaps_dirty) {
+        SDL_SetError("Surface mipmaps are out of date");
+        return NULL;
+    }
+    return surface->internal->mipmaps[level - 1];
+}
+
+void SDL_InvalidateSurfaceMipmaps(SDL_Surface *surface)
+{
+    /* Keep the mipmap surfaces around so SDL_GenerateSurfaceMipmaps() can refill them */
+    if (surface->internal->num_mipmaps > 0) {
+        surface->internal->mipmaps_dirty = SDL_TRUE;
+    }
+}
+
+void SDL_RemoveSurfaceMipmaps(SDL_Surface *surface)
+{
+    int i;
+
+    if (!SDL_SurfaceValid(surface)) {
+        return;
+    }
+
+    for (i = 0; i < surface->internal->num_mipmaps; ++i) {
+        SDL_DestroySurface(surface->internal->mipmaps[i]);
+    }
+    SDL_free(surface->internal->mipmaps);
+    surface->internal->mipmaps = NULL;
+    surface->internal->num_mipmaps = 0;
+    surface->internal->mipmaps_dirty = SDL_FALSE;
+}
+
 int SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip)
 {
     if (!SDL_SurfaceValid(surface)) {
@@ -1665,6 +1882,7 @@ int SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip)
     if (!surface->pixels) {
         return 0;
     }
+    SDL_InvalidateSurfaceMipmaps(surface);
 
     switch (flip) {
     case SDL_FLIP_HORIZONTAL:
@@ -2073,14 +2291,202 @@ int SDL_ConvertPixels(int width, int height,
                       dst_format, SDL_COLORSPACE_UNKNOWN, 0, dst, dst_pitch);
 }
 
+/* Surfaces with at least this many pixels may be split across threads */
+#define SURFACE_PARALLEL_THRESHOLD (1024 * 1024)
+#define SURFACE_MAX_THREADS        16
+
+typedef void (*SDL_SurfaceRowsFunc)(void *userdata, int y, int h);
+
+typedef struct
+{
+    SDL_SurfaceRowsFunc func;
+    void *userdata;
+    int y;
+    int h;
+} SDL_SurfaceRowsTask;
+
+static int SDLCALL SDL_SurfaceRowsThread(void *data)
+{
+    SDL_SurfaceRowsTask *task = (SDL_SurfaceRowsTask *)data;
+
+    task->func(task->userdata, task->y, task->h);
+    return 0;
+}
+
+/* Process the rows of a block of pixels, split into bands across threads
+ * for large blocks when allowed by SDL_HINT_SURFACE_THREADS
+ */
+static void SDL_ProcessSurfaceRows(int width, int height, SDL_SurfaceRowsFunc func, void *userdata)
+{
+    SDL_SurfaceRowsTask tasks[SURFACE_MAX_THREADS];
+    SDL_Thread *threads[SURFACE_MAX_THREADS];
+    const char *hint;
+    int num_threads = 1;
+    int i, y;
+
+    if ((Sint64)width * height >= SURFACE_PARALLEL_THRESHOLD) {
+        hint = SDL_GetHint(SDL_HINT_SURFACE_THREADS);
+        if (hint) {
+            num_threads = SDL_atoi(hint);
+            if (num_threads <= 0) {
+                num_threads = SDL_GetCPUCount();
+            }
+        }
+        num_threads = SDL_clamp(num_threads, 1, SDL_min(SURFACE_MAX_THREADS, height));
+    }
+
+    if (num_threads == 1) {
+        func(userdata, 0, height);
+        return;
+    }
+
+    y = 0;
+    for (i = 0; i < num_threads; ++i) {
+        tasks[i].func = func;
+        tasks[i].userdata = userdata;
+        tasks[i].y = y;
+        tasks[i].h = (height - y) / (num_threads - i);
+        y += tasks[i].h;
+    }
+
+    /* The calling thread handles the first band */
+    for (i = 1; i < num_threads; ++i) {
+        threads[i] = SDL_CreateThread(SDL_SurfaceRowsThread, "SDLSurfaceRows", &tasks[i]);
+        if (!threads[i]) {
+            SDL_SurfaceRowsThread(&tasks[i]);
+        }
+    }
+    SDL_SurfaceRowsThread(&tasks[0]);
+    for (i = 1; i < num_threads; ++i) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+}
+
 /*
  * Premultiply the alpha on a block of pixels
  *
  * Here are some ideas for optimization:
  * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
  * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
+ *
+ * The 8888 SIMD kernels compute x / 255 exactly as (x + 1 + (x >> 8)) >> 8,
+ * which holds for every product of two 8-bit values. They work on bytes in
+ * memory, so alpha_byte is 3 for AXYZ8888 and 0 for XYZA8888 pixels on
+ * little endian systems.
  */
 
+#if defined(SDL_SSE2_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static int SDL_TARGETING("sse2") SDL_PremultiplyAlphaRow8888_SSE2(const Uint32 *src, Uint32 *dst, int width, int alpha_byte)
+{
+    const __m128i alpha_mask = _mm_set1_epi32((int)(0xFFu << (alpha_byte * 8)));
+    int i = 0;
+
+    for (; i + 4 <= width; i += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i lo = _mm_unpacklo_epi8(pixels, _mm_setzero_si128());
+        __m128i hi = _mm_unpackhi_epi8(pixels, _mm_setzero_si128());
+        __m128i a_lo, a_hi;
+
+        if (alpha_byte == 3) {
+            a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF);
+            a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF);
+        } else {
+            a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0x00), 0x00);
+            a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0x00), 0x00);
+        }
+
+        lo = _mm_mullo_epi16(lo, a_lo);
+        hi = _mm_mullo_epi16(hi, a_hi);
+        lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, _mm_set1_epi16(1)), _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, _mm_set1_epi16(1)), _mm_srli_epi16(hi, 8)), 8);
+
+        /* Keep the original alpha */
+        lo = _mm_packus_epi16(lo, hi);
+        lo = _mm_or_si128(_mm_andnot_si128(alpha_mask, lo), _mm_and_si128(alpha_mask, pixels));
+        _mm_storeu_si128((__m128i *)(dst + i), lo);
+    }
+    return i;
+}
+#endif
+
+#if defined(SDL_AVX2_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static int SDL_TARGETING("avx2") SDL_PremultiplyAlphaRow8888_AVX2(const Uint32 *src, Uint32 *dst, int width, int alpha_byte)
+{
+    const __m256i alpha_mask = _mm256_set1_epi32((int)(0xFFu << (alpha_byte * 8)));
+    int i = 0;
+
+    for (; i + 8 <= width; i += 8) {
+        __m256i pixels = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i lo = _mm256_unpacklo_epi8(pixels, _mm256_setzero_si256());
+        __m256i hi = _mm256_unpackhi_epi8(pixels, _mm256_setzero_si256());
+        __m256i a_lo, a_hi;
+
+        if (alpha_byte == 3) {
+            a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xFF), 0xFF);
+            a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xFF), 0xFF);
+        } else {
+            a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0x00), 0x00);
+            a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0x00), 0x00);
+        }
+
+        lo = _mm256_mullo_epi16(lo, a_lo);
+        hi = _mm256_mullo_epi16(hi, a_hi);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(lo, _mm256_set1_epi16(1)), _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(hi, _mm256_set1_epi16(1)), _mm256_srli_epi16(hi, 8)), 8);
+
+        /* Keep the original alpha */
+        lo = _mm256_packus_epi16(lo, hi);
+        lo = _mm256_or_si256(_mm256_andnot_si256(alpha_mask, lo), _mm256_and_si256(alpha_mask, pixels));
+        _mm256_storeu_si256((__m256i *)(dst + i), lo);
+    }
+    return i;
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static int SDL_PremultiplyAlphaRow8888_NEON(const Uint32 *src, Uint32 *dst, int width, int alpha_byte)
+{
+    int i = 0;
+
+    for (; i + 8 <= width; i += 8) {
+        uint8x8x4_t pixels = vld4_u8((const Uint8 *)(src + i));
+        uint8x8_t alpha = pixels.val[alpha_byte];
+        int c;
+
+        for (c = 0; c < 4; ++c) {
+            if (c != alpha_byte) {
+                uint16x8_t x = vmull_u8(pixels.val[c], alpha);
+                pixels.val[c] = vshrn_n_u16(vsraq_n_u16(vaddq_u16(x, vdupq_n_u16(1)), x, 8), 8);
+            }
+        }
+        vst4_u8((Uint8 *)(dst + i), pixels);
+    }
+    return i;
+}
+#endif
+
+static int SDL_PremultiplyAlphaRow8888(const Uint32 *src, Uint32 *dst, int width, int alpha_byte)
+{
+#if defined(SDL_AVX2_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    if (SDL_HasAVX2()) {
+        return SDL_PremultiplyAlphaRow8888_AVX2(src, dst, width, alpha_byte);
+    }
+#endif
+#if defined(SDL_SSE2_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    if (SDL_HasSSE2()) {
+        return SDL_PremultiplyAlphaRow8888_SSE2(src, dst, width, alpha_byte);
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    if (SDL_HasNEON()) {
+        return SDL_PremultiplyAlphaRow8888_NEON(src, dst, width, alpha_byte);
+    }
+#endif
+    return 0;
+}
+
 static void SDL_PremultiplyAlpha_AXYZ8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
 {
     int c;
@@ -2092,7 +2498,11 @@ static void SDL_PremultiplyAlpha_AXYZ8888(int width, int height, const void *src
     while (height--) {
         const Uint32 *src_px = (const Uint32 *)src;
         Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
+        int done = SDL_PremultiplyAlphaRow8888(src_px, dst_px, width, 3);
+
+        src_px += done;
+        dst_px += done;
+        for (c = width - done; c; --c) {
             /* Component bytes extraction. */
             srcpixel = *src_px++;
             RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
@@ -2123,7 +2533,11 @@ static void SDL_PremultiplyAlpha_XYZA8888(int width, int height, const void *src
     while (height--) {
         const Uint32 *src_px = (const Uint32 *)src;
         Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
+        int done = SDL_PremultiplyAlphaRow8888(src_px, dst_px, width, 0);
+
+        src_px += done;
+        dst_px += done;
+        for (c = width - done; c; --c) {
             /* Component bytes extraction. */
             srcpixel = *src_px++;
             RGBA_FROM_RGBA8888(srcpixel, srcR, srcG, srcB, srcA);
@@ -2143,6 +2557,42 @@ static void SDL_PremultiplyAlpha_XYZA8888(int width, int height, const void *src
     }
 }
 
+#ifdef SDL_SSE_INTRINSICS
+static int SDL_TARGETING("sse") SDL_PremultiplyAlphaRow128_SSE(const float *src, float *dst, int width)
+{
+    int i;
+
+    for (i = 0; i < width; ++i) {
+        __m128 pixel = _mm_loadu_ps(src);
+        __m128 alpha = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(0, 0, 0, 0));
+
+        /* Multiply all the components by alpha, then put the original alpha back */
+        _mm_storeu_ps(dst, _mm_move_ss(_mm_mul_ps(pixel, alpha), pixel));
+        src += 4;
+        dst += 4;
+    }
+    return width;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int SDL_PremultiplyAlphaRow128_NEON(const float *src, float *dst, int width)
+{
+    int i;
+
+    for (i = 0; i < width; ++i) {
+        float32x4_t pixel = vld1q_f32(src);
+        float alpha = vgetq_lane_f32(pixel, 0);
+
+        /* Multiply all the components by alpha, then put the original alpha back */
+        vst1q_f32(dst, vsetq_lane_f32(alpha, vmulq_n_f32(pixel, alpha), 0));
+        src += 4;
+        dst += 4;
+    }
+    return width;
+}
+#endif
+
 static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
 {
     int c;
@@ -2151,7 +2601,21 @@ static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src,
     while (height--) {
         const float *src_px = (const float *)src;
         float *dst_px = (float *)dst;
-        for (c = width; c; --c) {
+        int done = 0;
+
+#ifdef SDL_SSE_INTRINSICS
+        if (SDL_HasSSE()) {
+            done = SDL_PremultiplyAlphaRow128_SSE(src_px, dst_px, width);
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (!done && SDL_HasNEON()) {
+            done = SDL_PremultiplyAlphaRow128_NEON(src_px, dst_px, width);
+        }
+#endif
+        src_px += done * 4;
+        dst_px += done * 4;
+        for (c = width - done; c; --c) {
             flA = *src_px++;
             flR = *src_px++;
             flG = *src_px++;
@@ -2172,6 +2636,23 @@ static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src,
     }
 }
 
+typedef struct
+{
+    void (*kernel)(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch);
+    int width;
+    const Uint8 *src;
+    int src_pitch;
+    Uint8 *dst;
+    int dst_pitch;
+} SDL_PremultiplyAlphaRows;
+
+static void SDL_PremultiplyAlphaRowsFunc(void *userdata, int y, int h)
+{
+    SDL_PremultiplyAlphaRows *rows = (SDL_PremultiplyAlphaRows *)userdata;
+
+    rows->kernel(rows->width, h, rows->src + (size_t)y * rows->src_pitch, rows->src_pitch, rows->dst + (size_t)y * rows->dst_pitch, rows->dst_pitch);
+}
+
 static int SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch, SDL_bool linear)
 {
     SDL_Surface *convert = NULL;
@@ -2179,6 +2660,7 @@ static int SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_Pi
     int final_dst_pitch = dst_pitch;
     SDL_PixelFormat format;
     SDL_Colorspace colorspace;
+    SDL_PremultiplyAlphaRows rows;
     int result = -1;
 
     if (!src) {
@@ -2246,20 +2728,26 @@ static int SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_Pi
     switch (format) {
     case SDL_PIXELFORMAT_ARGB8888:
     case SDL_PIXELFORMAT_ABGR8888:
-        SDL_PremultiplyAlpha_AXYZ8888(width, height, src, src_pitch, dst, dst_pitch);
+        rows.kernel = SDL_PremultiplyAlpha_AXYZ8888;
         break;
     case SDL_PIXELFORMAT_RGBA8888:
     case SDL_PIXELFORMAT_BGRA8888:
-        SDL_PremultiplyAlpha_XYZA8888(width, height, src, src_pitch, dst, dst_pitch);
+        rows.kernel = SDL_PremultiplyAlpha_XYZA8888;
         break;
     case SDL_PIXELFORMAT_ARGB128_FLOAT:
     case SDL_PIXELFORMAT_ABGR128_FLOAT:
-        SDL_PremultiplyAlpha_AXYZ128(width, height, src, src_pitch, dst, dst_pitch);
+        rows.kernel = SDL_PremultiplyAlpha_AXYZ128;
         break;
     default:
         SDL_SetError("Unexpected internal pixel format");
         goto done;
     }
+    rows.width = width;
+    rows.src = (const Uint8 *)src;
+    rows.src_pitch = src_pitch;
+    rows.dst = (Uint8 *)dst;
+    rows.dst_pitch = dst_pitch;
+    SDL_ProcessSurfaceRows(width, height, SDL_PremultiplyAlphaRowsFunc, &rows);
 
     if (dst != final_dst) {
         if (SDL_ConvertPixelsAndColorspace(width, height, format, colorspace, 0, convert->pixels, convert->pitch, dst_format, dst_colorspace, dst_properties, final_dst, final_dst_pitch) < 0) {
@@ -2294,10 +2782,29 @@ int SDL_PremultiplySurfaceAlpha(SDL_Surface *surface, SDL_bool linear)
     }
 
     colorspace = surface->internal->colorspace;
+    SDL_InvalidateSurfaceMipmaps(surface);
 
     return SDL_PremultiplyAlphaPixelsAndColorspace(surface->w, surface->h, surface->format, colorspace, surface->internal->props, surface->pixels, surface->pitch, surface->format, colorspace, surface->internal->props, surface->pixels, surface->pitch, linear);
 }
 
+typedef struct
+{
+    Uint8 *pixels;
+    int pitch;
+    size_t row_size;
+} SDL_ClearSurfaceRows;
+
+static void SDL_ClearSurfaceRowsFunc(void *userdata, int y, int h)
+{
+    SDL_ClearSurfaceRows *rows = (SDL_ClearSurfaceRows *)userdata;
+
+    for (; h--; ++y) {
+        if (y > 0) {
+            SDL_memcpy(rows->pixels + (size_t)y * rows->pitch, rows->pixels, rows->row_size);
+        }
+    }
+}
+
 int SDL_ClearSurface(SDL_Surface *surface, float r, float g, float b, float a)
 {
     SDL_Rect clip_rect;
@@ -2307,6 +2814,8 @@ int SDL_ClearSurface(SDL_Surface *surface, float r, float g, float b, float a)
         return SDL_InvalidParamError("surface");
     }
 
+    SDL_InvalidateSurfaceMipmaps(surface);
+
     SDL_GetSurfaceClipRect(surface, &clip_rect);
     SDL_SetSurfaceClipRect(surface, NULL);
 
@@ -2331,6 +2840,28 @@ int SDL_ClearSurface(SDL_Surface *surface, float r, float g, float b, float a)
             result = SDL_ConvertPixelsAndColorspace(surface->w, surface->h, tmp->format, tmp->internal->colorspace, tmp->internal->props, tmp->pixels, tmp->pitch, surface->format, surface->internal->colorspace, surface->internal->props, surface->pixels, surface->pitch);
         }
         SDL_DestroySurface(tmp);
+    } else if (surface->pixels && SDL_BYTESPERPIXEL(surface->format) <= sizeof(float) * 4) {
+        // Convert the color once and replicate it, the first row is the pattern for the others
+        const float color[4] = { r, g, b, a };
+        SDL_ClearSurfaceRows rows;
+        Uint8 pixel[sizeof(float) * 4];
+        const int bpp = SDL_BYTESPERPIXEL(surface->format);
+        const size_t row_size = (size_t)surface->w * bpp;
+        size_t filled;
+
+        result = SDL_ConvertPixelsAndColorspace(1, 1, SDL_PIXELFORMAT_RGBA128_FLOAT, surface->internal->colorspace, 0, color, sizeof(color), surface->format, surface->internal->colorspace, surface->internal->props, pixel, sizeof(pixel));
+        if (result < 0 || surface->w <= 0 || surface->h <= 0) {
+            goto done;
+        }
+
+        rows.pixels = (Uint8 *)surface->pixels;
+        rows.pitch = surface->pitch;
+        rows.row_size = row_size;
+        SDL_memcpy(rows.pixels, pixel, bpp);
+        for (filled = bpp; filled < row_size; filled *= 2) {
+            SDL_memcpy(rows.pixels + filled, rows.pixels, SDL_min(filled, row_size - filled));
+        }
+        SDL_ProcessSurfaceRows(surface->w, surface->h, SDL_ClearSurfaceRowsFunc, &rows);
     } else {
         // Take advantage of blit color conversion
         SDL_Surface *tmp = SDL_CreateSurface(1, 1, SDL_PIXELFORMAT_RGBA128_FLOAT);
@@ -2455,7 +2986,7 @@ int SDL_ReadSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 *r, Uint8 *g,
     }
 
     if (SDL_MUSTLOCK(surface)) {
-        SDL_UnlockSurface(surface);
+        SDL_UnlockSurfaceReadOnly(surface);
     }
     return result;
 }
@@ -2551,7 +3082,7 @@ int SDL_ReadSurfacePixelFloat(SDL_Surface *surface, int x, int y, float *r, floa
         }
 
         if (SDL_MUSTLOCK(surface)) {
-            SDL_UnlockSurface(surface);
+            SDL_UnlockSurfaceReadOnly(surface);
         }
     }
     return result;
@@ -2577,6 +3108,7 @@ int SDL_WriteSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 r, Uint8 g,
     }
 
     bytes_per_pixel = SDL_BYTESPERPIXEL(surface->format);
+    SDL_InvalidateSurfaceMipmaps(surface);
 
     if (SDL_MUSTLOCK(surface)) {
         if (SDL_LockSurface(surface) < 0) {
@@ -2693,6 +3225,8 @@ void SDL_DestroySurface(SDL_Surface *surface)
 
     SDL_DestroyProperties(surface->internal->props);
 
+    SDL_RemoveSurfaceMipmaps(surface);
+
     SDL_InvalidateMap(&surface->internal->map);
 
     while (surface->internal->locked > 0) {
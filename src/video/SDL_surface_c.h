@@ -60,6 +60,15 @@ struct SDL_SurfaceData
 
     /** info for fast blit mapping to other surfaces */
     SDL_BlitMap map;
+
+    /** half size copies of the surface, created by SDL_GenerateSurfaceMipmaps() */
+    int num_mipmaps;
+    SDL_Surface **mipmaps;
+    /** the pixels may have changed since the mipmaps were generated */
+    SDL_bool mipmaps_dirty;
+
+    /** the blit function last published in the surface properties */
+    const char *reported_blit;
 };
 
 typedef struct SDL_InternalSurface
@@ -76,6 +85,10 @@ extern float SDL_GetDefaultSDRWhitePoint(SDL_Colorspace colorspace);
 extern float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace colorspace);
 extern float SDL_GetDefaultHDRHeadroom(SDL_Colorspace colorspace);
 extern float SDL_GetSurfaceHDRHeadroom(SDL_Surface *surface, SDL_Colorspace colorspace);
+extern SDL_bool SDL_CanSoftStretchLinear(SDL_Surface *src, SDL_Surface *dst);
 extern int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
+extern int SDL_SoftHalveSurface(SDL_Surface *src, SDL_Surface *dst);
+extern void SDL_InvalidateSurfaceMipmaps(SDL_Surface *surface);
+extern void SDL_UnlockSurfaceReadOnly(SDL_Surface *surface);
 
 #endif /* SDL_surface_c_h_ */
@@ -427,6 +427,11 @@ int SDL_SetWindowTextureVSync(SDL_VideoDevice *_this, SDL_Window *window, int vs
     return SDL_SetRenderVSync(data->renderer, vsync);
 }
 
+SDL_bool SDL_HasWindowTextureFramebuffer(SDL_Window *window)
+{
+    return SDL_HasProperty(SDL_GetWindowProperties(window), SDL_PROP_WINDOW_TEXTUREDATA_POINTER);
+}
+
 static int SDL_GetWindowTextureVSync(SDL_VideoDevice *_this, SDL_Window *window, int *vsync)
 {
     SDL_WindowTextureData *data;
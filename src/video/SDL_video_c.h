@@ -58,6 +58,7 @@ extern int SDL_VideoInit(const char *driver_name);
 extern void SDL_VideoQuit(void);
 
 extern int SDL_SetWindowTextureVSync(struct SDL_VideoDevice *_this, SDL_Window *window, int vsync);
+extern SDL_bool SDL_HasWindowTextureFramebuffer(SDL_Window *window);
 
 extern int SDL_ReadSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a);
 
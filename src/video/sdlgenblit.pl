@@ -685,7 +685,18 @@ __EOF__
                                 $flags = "0";
                             }
                             print FILE "($flags), SDL_CPU_ANY,";
-                            output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
+                            output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, ",");
+                            print FILE " \"SDL_Blit_${src}_${dst}";
+                            if ( $modulate ) {
+                                print FILE "_Modulate";
+                            }
+                            if ( $blend ) {
+                                print FILE "_Blend";
+                            }
+                            if ( $scale ) {
+                                print FILE "_Scale";
+                            }
+                            print FILE "\" },\n";
                         }
                     }
                 }
@@ -693,7 +704,7 @@ __EOF__
         }
     }
     print FILE <<__EOF__;
-    { 0, 0, 0, 0, NULL }
+    { 0, 0, 0, 0, NULL, NULL }
 };
 
 __EOF__
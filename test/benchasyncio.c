@@ -0,0 +1,330 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark program comparing synchronous file loading with the async I/O
+   backends, reading many small files and then one large file in chunks
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define MAX_CHUNKS_IN_FLIGHT 64
+
+static const char *drivers[] = { "io_uring", "generic" };
+
+static char *SmallFileName(const char *dir, int index)
+{
+    char *path = NULL;
+    SDL_asprintf(&path, "%s/small%05d.bin", dir, index);
+    return path;
+}
+
+static char *LargeFileName(const char *dir)
+{
+    char *path = NULL;
+    SDL_asprintf(&path, "%s/large.bin", dir);
+    return path;
+}
+
+static SDL_bool WriteTestFile(const char *path, Uint64 size, Uint64 *seed)
+{
+    Uint8 block[64 * 1024];
+    SDL_IOStream *io = SDL_IOFromFile(path, "wb");
+    SDL_bool result = SDL_TRUE;
+
+    if (!io) {
+        return SDL_FALSE;
+    }
+    while (size > 0 && result) {
+        const size_t len = (size_t)SDL_min(size, sizeof(block));
+        size_t i;
+
+        for (i = 0; i < len; ++i) {
+            block[i] = (Uint8)SDL_rand_r(seed, 256);
+        }
+        if (SDL_WriteIO(io, block, len) != len) {
+            result = SDL_FALSE;
+        }
+        size -= len;
+    }
+    if (SDL_CloseIO(io) < 0) {
+        result = SDL_FALSE;
+    }
+    return result;
+}
+
+static double ReportTime(const char *what, const char *how, Uint64 start, Uint64 bytes, int files)
+{
+    const double seconds = (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_SECOND;
+    SDL_Log("%-12s %-10s %6d files %10.1f ms %10.1f MB/s", what, how, files, seconds * 1000.0, (bytes / (1024.0 * 1024.0)) / seconds);
+    return seconds;
+}
+
+static void BenchmarkSmallFilesSync(const char *dir, int num_files)
+{
+    Uint64 start = SDL_GetTicksNS();
+    Uint64 total = 0;
+    int i;
+
+    for (i = 0; i < num_files; ++i) {
+        char *path = SmallFileName(dir, i);
+        size_t size = 0;
+        void *data = SDL_LoadFile(path, &size);
+        if (data) {
+            total += size;
+            SDL_free(data);
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s", path, SDL_GetError());
+        }
+        SDL_free(path);
+    }
+    ReportTime("small files", "sync", start, total, num_files);
+}
+
+static void BenchmarkSmallFilesAsync(const char *dir, int num_files, const char *driver)
+{
+    SDL_AsyncIOQueue *queue;
+    Uint64 start, total = 0;
+    int i, pending = 0, failed = 0;
+
+    SDL_SetHint(SDL_HINT_ASYNCIO_DRIVER, driver);
+    queue = SDL_CreateAsyncIOQueue();
+    if (!queue) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create async I/O queue: %s", SDL_GetError());
+        return;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_files; ++i) {
+        char *path = SmallFileName(dir, i);
+        if (SDL_LoadFileAsync(path, queue, NULL) == 0) {
+            ++pending;
+        } else {
+            ++failed;
+        }
+        SDL_free(path);
+    }
+    while (pending > 0) {
+        SDL_AsyncIOOutcome outcomes[32];
+        int num = SDL_GetAsyncIOResults(queue, outcomes, SDL_arraysize(outcomes));
+
+        if (num == 0 && SDL_WaitAsyncIOResult(queue, &outcomes[0], -1)) {
+            num = 1;
+        }
+        for (i = 0; i < num; ++i) {
+            if (outcomes[i].result == SDL_ASYNCIO_COMPLETE) {
+                total += outcomes[i].bytes_transferred;
+            } else {
+                ++failed;
+            }
+            SDL_free(outcomes[i].buffer);
+        }
+        pending -= SDL_max(num, 0);
+    }
+    ReportTime("small files", driver, start, total, num_files);
+    if (failed) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d loads failed", failed);
+    }
+
+    SDL_DestroyAsyncIOQueue(queue);
+}
+
+static void BenchmarkLargeFileSync(const char *dir, Uint64 chunk_size)
+{
+    char *path = LargeFileName(dir);
+    SDL_IOStream *io = SDL_IOFromFile(path, "rb");
+    Uint8 *chunk = (Uint8 *)SDL_malloc((size_t)chunk_size);
+    Uint64 start = SDL_GetTicksNS();
+    Uint64 total = 0;
+
+    if (io && chunk) {
+        size_t len;
+        while ((len = SDL_ReadIO(io, chunk, (size_t)chunk_size)) > 0) {
+            total += len;
+        }
+        ReportTime("large file", "sync", start, total, 1);
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't read %s: %s", path, SDL_GetError());
+    }
+    SDL_CloseIO(io);
+    SDL_free(chunk);
+    SDL_free(path);
+}
+
+static void BenchmarkLargeFileAsync(const char *dir, Uint64 chunk_size, const char *driver)
+{
+    char *path = LargeFileName(dir);
+    Uint8 *chunks = NULL;
+    SDL_AsyncIOQueue *queue = NULL;
+    SDL_AsyncIO *asyncio = NULL;
+    Uint64 start, total = 0, offset = 0;
+    Sint64 size;
+    int i, pending = 0, failed = 0;
+
+    SDL_SetHint(SDL_HINT_ASYNCIO_DRIVER, driver);
+    queue = SDL_CreateAsyncIOQueue();
+    asyncio = SDL_AsyncIOFromFile(path, "r");
+    chunks = (Uint8 *)SDL_malloc((size_t)chunk_size * MAX_CHUNKS_IN_FLIGHT);
+    if (!queue || !asyncio || !chunks) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't set up async read of %s: %s", path, SDL_GetError());
+        goto done;
+    }
+
+    start = SDL_GetTicksNS();
+    size = SDL_GetAsyncIOSize(asyncio);
+
+    /* Keep a window of chunk reads in flight, each chunk buffer is reused when its read lands */
+    for (i = 0; i < MAX_CHUNKS_IN_FLIGHT && (Sint64)offset < size; ++i) {
+        SDL_ReadAsyncIO(asyncio, chunks + i * chunk_size, offset, chunk_size, queue, chunks + i * chunk_size);
+        offset += chunk_size;
+        ++pending;
+    }
+    while (pending > 0) {
+        SDL_AsyncIOOutcome outcome;
+
+        if (!SDL_WaitAsyncIOResult(queue, &outcome, -1)) {
+            continue;
+        }
+        --pending;
+        if (outcome.result == SDL_ASYNCIO_COMPLETE) {
+            total += outcome.bytes_transferred;
+        } else {
+            ++failed;
+        }
+        if ((Sint64)offset < size) {
+            SDL_ReadAsyncIO(asyncio, outcome.userdata, offset, chunk_size, queue, outcome.userdata);
+            offset += chunk_size;
+            ++pending;
+        }
+    }
+    ReportTime("large file", driver, start, total, 1);
+    if (failed) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d chunk reads failed", failed);
+    }
+
+    SDL_CloseAsyncIO(asyncio, SDL_FALSE, queue, NULL);
+    asyncio = NULL;
+
+done:
+    if (asyncio) {
+        SDL_CloseAsyncIO(asyncio, SDL_FALSE, queue, NULL);
+    }
+    SDL_DestroyAsyncIOQueue(queue);
+    SDL_free(chunks);
+    SDL_free(path);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const char *dir = "benchasyncio.tmp";
+    int num_files = 1000;
+    int small_size = 4096;
+    int large_size_mb = 64;
+    int chunk_size_kb = 256;
+    Uint64 seed = 0x1234;
+    SDL_bool keep = SDL_FALSE;
+    int i, d;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--dir") == 0 && argv[i + 1]) {
+                dir = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--files") == 0 && argv[i + 1]) {
+                num_files = SDL_atoi(argv[i + 1]);
+                consumed = (num_files > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--small-size") == 0 && argv[i + 1]) {
+                small_size = SDL_atoi(argv[i + 1]);
+                consumed = (small_size > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--large-size") == 0 && argv[i + 1]) {
+                large_size_mb = SDL_atoi(argv[i + 1]);
+                consumed = (large_size_mb > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--chunk-size") == 0 && argv[i + 1]) {
+                chunk_size_kb = SDL_atoi(argv[i + 1]);
+                consumed = (chunk_size_kb > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--keep") == 0) {
+                keep = SDL_TRUE;
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--dir PATH]", "[--files N]", "[--small-size BYTES]", "[--large-size MB]",
+                "[--chunk-size KB]", "[--keep]", NULL
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    SDL_Log("Creating %d files of %d bytes and one file of %d MB in %s", num_files, small_size, large_size_mb, dir);
+    SDL_CreateDirectory(dir);
+    for (i = 0; i < num_files; ++i) {
+        char *path = SmallFileName(dir, i);
+        if (!WriteTestFile(path, (Uint64)small_size, &seed)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s: %s", path, SDL_GetError());
+            SDL_free(path);
+            return 1;
+        }
+        SDL_free(path);
+    }
+    {
+        char *path = LargeFileName(dir);
+        if (!WriteTestFile(path, (Uint64)large_size_mb * 1024 * 1024, &seed)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s: %s", path, SDL_GetError());
+            SDL_free(path);
+            return 1;
+        }
+        SDL_free(path);
+    }
+
+    /* The files were just written, so these mostly measure the request overhead of each path */
+    BenchmarkSmallFilesSync(dir, num_files);
+    for (d = 0; d < SDL_arraysize(drivers); ++d) {
+        BenchmarkSmallFilesAsync(dir, num_files, drivers[d]);
+    }
+    BenchmarkLargeFileSync(dir, (Uint64)chunk_size_kb * 1024);
+    for (d = 0; d < SDL_arraysize(drivers); ++d) {
+        BenchmarkLargeFileAsync(dir, (Uint64)chunk_size_kb * 1024, drivers[d]);
+    }
+
+    if (!keep) {
+        for (i = 0; i < num_files; ++i) {
+            char *path = SmallFileName(dir, i);
+            SDL_RemovePath(path);
+            SDL_free(path);
+        }
+        {
+            char *path = LargeFileName(dir);
+            SDL_RemovePath(path);
+            SDL_free(path);
+        }
+        SDL_RemovePath(dir);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -0,0 +1,463 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark program measuring software blit throughput for every
+   combination of source format, destination format and blit flags
+   that has a blit function of its own, along with the function used.
+   The combinations are read from the blit tables inside SDL, so this
+   program needs the SDL source tree to build.
+*/
+
+/* Hack #1: avoid inclusion of SDL_main.h by SDL_internal.h */
+#define SDL_main_h_
+
+/* Hack #2: avoid dynapi renaming (must be done before #include <SDL3/SDL.h>) */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_internal.h"
+#include "../src/video/SDL_blit.h"
+
+/* Hack #3: undo Hack #1 */
+#ifdef SDL_main_h_
+#undef SDL_main_h_
+#endif
+#ifdef SDL_MAIN_NOIMPL
+#undef SDL_MAIN_NOIMPL
+#endif
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define MAX_FORMATS 64
+#define MAX_MODES   64
+
+/* The blit flags that select the blend operation, one of which is used at a time */
+#define BLEND_FLAGS (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_ADD_PREMULTIPLIED | SDL_COPY_MOD | SDL_COPY_MUL)
+
+/* The blit flags that are benchmarked along with any blend operation */
+#define MODIFIER_FLAGS (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_COLORKEY)
+
+typedef struct
+{
+    char name[64];
+    int flags;
+} BlitMode;
+
+static SDL_PixelFormat src_formats[MAX_FORMATS];
+static int num_src_formats;
+static SDL_PixelFormat dst_formats[MAX_FORMATS];
+static int num_dst_formats;
+static BlitMode blit_modes[MAX_MODES];
+static int num_blit_modes;
+
+static const int default_sizes[] = { 16, 128, 512 };
+
+/* A description of the blit that was measured, or the reason it couldn't be */
+static char blit_description[256];
+
+static void AddFormat(SDL_PixelFormat *formats, int *count, SDL_PixelFormat format)
+{
+    int i;
+
+    /* Unknown formats in the tables match any format */
+    if (format == SDL_PIXELFORMAT_UNKNOWN) {
+        return;
+    }
+    for (i = 0; i < *count; ++i) {
+        if (formats[i] == format) {
+            return;
+        }
+    }
+    if (*count < MAX_FORMATS) {
+        formats[(*count)++] = format;
+    }
+}
+
+static void AddMode(int flags)
+{
+    static const struct
+    {
+        int flag;
+        const char *name;
+    } flag_names[] = {
+        { SDL_COPY_BLEND, "blend" },
+        { SDL_COPY_BLEND_PREMULTIPLIED, "blend_premultiplied" },
+        { SDL_COPY_ADD, "add" },
+        { SDL_COPY_ADD_PREMULTIPLIED, "add_premultiplied" },
+        { SDL_COPY_MOD, "mod" },
+        { SDL_COPY_MUL, "mul" },
+        { SDL_COPY_MODULATE_COLOR, "colormod" },
+        { SDL_COPY_MODULATE_ALPHA, "alphamod" },
+        { SDL_COPY_COLORKEY, "colorkey" },
+    };
+    BlitMode *mode;
+    int i;
+
+    for (i = 0; i < num_blit_modes; ++i) {
+        if (blit_modes[i].flags == flags) {
+            return;
+        }
+    }
+    if (num_blit_modes == MAX_MODES) {
+        return;
+    }
+
+    mode = &blit_modes[num_blit_modes++];
+    mode->flags = flags;
+    mode->name[0] = '\0';
+    for (i = 0; i < SDL_arraysize(flag_names); ++i) {
+        if (flags & flag_names[i].flag) {
+            if (mode->name[0]) {
+                SDL_strlcat(mode->name, "+", sizeof(mode->name));
+            }
+            SDL_strlcat(mode->name, flag_names[i].name, sizeof(mode->name));
+        }
+    }
+    if (!mode->name[0]) {
+        SDL_strlcpy(mode->name, "none", sizeof(mode->name));
+    }
+}
+
+/* Build the format and mode lists from the blit tables SDL chooses from */
+static SDL_bool EnumerateBlits(void)
+{
+    SDL_Surface *src = SDL_CreateSurface(1, 1, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Surface *dst = SDL_CreateSurface(1, 1, SDL_PIXELFORMAT_ARGB8888);
+    SDL_EnumerateBlitFuncs enumerate = NULL;
+    SDL_BlitFuncEntry *entries;
+    int i, count;
+
+    /* The blit tables are published on source surfaces with properties */
+    if (src && dst && SDL_GetSurfaceProperties(src) && SDL_BlitSurface(src, NULL, dst, NULL) == 0) {
+        enumerate = (SDL_EnumerateBlitFuncs)SDL_GetPointerProperty(SDL_GetSurfaceProperties(src), SDL_PROP_SURFACE_BLIT_ENUMERATE_POINTER, NULL);
+    }
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+    if (!enumerate) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't find the blit tables, is this the SDL library this program was built with?");
+        return SDL_FALSE;
+    }
+
+    count = enumerate(NULL, 0);
+    entries = (SDL_BlitFuncEntry *)SDL_calloc(count, sizeof(*entries));
+    if (!entries) {
+        return SDL_FALSE;
+    }
+    count = enumerate(entries, count);
+
+    for (i = 0; i < count; ++i) {
+        const int flags = entries[i].flags;
+        const int modifiers = flags & MODIFIER_FLAGS;
+        int blend;
+
+        AddFormat(src_formats, &num_src_formats, entries[i].src_format);
+        AddFormat(dst_formats, &num_dst_formats, entries[i].dst_format);
+
+        /* Table entries list every blend operation they handle, benchmark each one */
+        if (!(flags & BLEND_FLAGS)) {
+            AddMode(modifiers);
+        }
+        for (blend = SDL_COPY_BLEND; blend <= SDL_COPY_MUL; blend <<= 1) {
+            if (flags & blend & BLEND_FLAGS) {
+                AddMode(blend | modifiers);
+            }
+        }
+    }
+    SDL_free(entries);
+    return SDL_TRUE;
+}
+
+static const char *ShortFormatName(SDL_PixelFormat format)
+{
+    const char *name = SDL_GetPixelFormatName(format);
+    const char *prefix = "SDL_PIXELFORMAT_";
+
+    if (SDL_strncmp(name, prefix, SDL_strlen(prefix)) == 0) {
+        name += SDL_strlen(prefix);
+    }
+    return name;
+}
+
+static SDL_bool MatchesFilter(const char *filter, const char *name)
+{
+    return !filter || SDL_strcasecmp(filter, name) == 0;
+}
+
+/* Describe the blit function SDL chose, and the operations the source surface asks of it */
+static void DescribeBlit(SDL_Surface *src, SDL_Surface *dst, SDL_bool scaled)
+{
+    const char *func = SDL_GetStringProperty(SDL_GetSurfaceProperties(src), SDL_PROP_SURFACE_BLIT_FUNCTION_STRING, "unknown");
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    Uint8 r = 255, g = 255, b = 255, a = 255;
+
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+
+    (void)SDL_snprintf(blit_description, sizeof(blit_description), "%s (%s%s%s%s%s%s)",
+                       func,
+                       (blendMode == SDL_BLENDMODE_NONE) ? ((src->format == dst->format) ? "copy" : "convert") : "blend",
+                       SDL_ISPIXELFORMAT_ALPHA(src->format) ? "" : ", opaque source",
+                       (r != 255 || g != 255 || b != 255) ? ", color mod" : "",
+                       (a != 255) ? ", alpha mod" : "",
+                       SDL_SurfaceHasColorKey(src) ? ", color key" : "",
+                       scaled ? ", nearest scaling" : "");
+}
+
+static void SetBlitMode(SDL_Surface *src, const BlitMode *mode)
+{
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+
+    switch (mode->flags & BLEND_FLAGS) {
+    case SDL_COPY_BLEND:
+        blendMode = SDL_BLENDMODE_BLEND;
+        break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        blendMode = SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+        break;
+    case SDL_COPY_ADD:
+        blendMode = SDL_BLENDMODE_ADD;
+        break;
+    case SDL_COPY_ADD_PREMULTIPLIED:
+        blendMode = SDL_BLENDMODE_ADD_PREMULTIPLIED;
+        break;
+    case SDL_COPY_MOD:
+        blendMode = SDL_BLENDMODE_MOD;
+        break;
+    case SDL_COPY_MUL:
+        blendMode = SDL_BLENDMODE_MUL;
+        break;
+    default:
+        break;
+    }
+    SDL_SetSurfaceBlendMode(src, blendMode);
+    SDL_SetSurfaceAlphaMod(src, (mode->flags & SDL_COPY_MODULATE_ALPHA) ? 128 : 255);
+    if (mode->flags & SDL_COPY_MODULATE_COLOR) {
+        SDL_SetSurfaceColorMod(src, 192, 128, 64);
+    } else {
+        SDL_SetSurfaceColorMod(src, 255, 255, 255);
+    }
+    SDL_SetSurfaceColorKey(src, (mode->flags & SDL_COPY_COLORKEY) ? SDL_TRUE : SDL_FALSE, 0);
+}
+
+static SDL_Surface *CreateBenchSurface(int w, int h, SDL_PixelFormat format, Uint64 *seed)
+{
+    SDL_Surface *surface = SDL_CreateSurface(w, h, format);
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+
+    /* Create the properties up front, so the blit function used is reported in them */
+    SDL_GetSurfaceProperties(surface);
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
+        if (palette) {
+            SDL_Color colors[256];
+            for (x = 0; x < palette->ncolors; ++x) {
+                colors[x].r = (Uint8)SDL_rand_bits_r(seed);
+                colors[x].g = (Uint8)SDL_rand_bits_r(seed);
+                colors[x].b = (Uint8)SDL_rand_bits_r(seed);
+                colors[x].a = (Uint8)SDL_rand_bits_r(seed);
+            }
+            SDL_SetPaletteColors(palette, colors, 0, palette->ncolors);
+        }
+    }
+
+    if (SDL_ISPIXELFORMAT_FLOAT(format)) {
+        for (y = 0; y < h; ++y) {
+            float *row = (float *)((Uint8 *)surface->pixels + y * surface->pitch);
+            for (x = 0; x < w * 4; ++x) {
+                row[x] = (float)SDL_rand_bits_r(seed) / (float)SDL_MAX_UINT32;
+            }
+        }
+    } else {
+        /* Fill whole rows, formats with less than 8 bits per pixel pack several pixels in a byte */
+        for (y = 0; y < h; ++y) {
+            Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+            for (x = 0; x < surface->pitch; ++x) {
+                row[x] = (Uint8)SDL_rand_bits_r(seed);
+            }
+        }
+    }
+    return surface;
+}
+
+static double BenchmarkBlit(SDL_Surface *src, SDL_Surface *dst, SDL_bool scaled, Uint64 duration_ns, int *iterations)
+{
+    Uint64 start, now, end;
+    int count = 0;
+
+    /* Warm up, this also builds the blit mapping */
+    if (scaled) {
+        if (SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_NEAREST) < 0) {
+            SDL_snprintf(blit_description, sizeof(blit_description), "unsupported: %s", SDL_GetError());
+            *iterations = 0;
+            return 0.0;
+        }
+    } else if (SDL_BlitSurface(src, NULL, dst, NULL) < 0) {
+        SDL_snprintf(blit_description, sizeof(blit_description), "unsupported: %s", SDL_GetError());
+        *iterations = 0;
+        return 0.0;
+    }
+    DescribeBlit(src, dst, scaled);
+
+    start = SDL_GetTicksNS();
+    end = start + duration_ns;
+    do {
+        if (scaled) {
+            SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_NEAREST);
+        } else {
+            SDL_BlitSurface(src, NULL, dst, NULL);
+        }
+        ++count;
+        now = SDL_GetTicksNS();
+    } while (now < end);
+
+    *iterations = count;
+    return ((double)dst->w * dst->h * count) / ((double)(now - start) / SDL_NS_PER_SECOND) / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const char *src_filter = NULL;
+    const char *dst_filter = NULL;
+    const char *mode_filter = NULL;
+    int sizes[8];
+    int num_sizes = 0;
+    int duration_ms = 10;
+    SDL_bool scaled = SDL_FALSE;
+    Uint64 seed = 0x1234;
+    int i, s, d, m, z;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    if (!EnumerateBlits()) {
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--src") == 0 && argv[i + 1]) {
+                src_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--dst") == 0 && argv[i + 1]) {
+                dst_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--mode") == 0 && argv[i + 1]) {
+                mode_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1] && num_sizes < SDL_arraysize(sizes)) {
+                sizes[num_sizes] = SDL_atoi(argv[i + 1]);
+                if (sizes[num_sizes] > 0) {
+                    ++num_sizes;
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--duration") == 0 && argv[i + 1]) {
+                duration_ms = SDL_atoi(argv[i + 1]);
+                if (duration_ms > 0) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--scaled") == 0) {
+                scaled = SDL_TRUE;
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--src FORMAT]", "[--dst FORMAT]", "[--mode MODE]", "[--size N ...]",
+                "[--duration MS]", "[--scaled]", NULL
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            SDL_Log("FORMAT is a pixel format name without the SDL_PIXELFORMAT_ prefix, e.g. ARGB8888");
+            SDL_Log("MODE is one of:");
+            for (m = 0; m < num_blit_modes; ++m) {
+                SDL_Log("    %s", blit_modes[m].name);
+            }
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (num_sizes == 0) {
+        for (i = 0; i < SDL_arraysize(default_sizes); ++i) {
+            sizes[num_sizes++] = default_sizes[i];
+        }
+    }
+
+    SDL_Log("%-14s %-14s %-32s %6s %10s %8s  %s", "source", "destination", "mode", "size", "Mpix/s", "blits", "measured");
+
+    for (s = 0; s < num_src_formats; ++s) {
+        if (!MatchesFilter(src_filter, ShortFormatName(src_formats[s]))) {
+            continue;
+        }
+        for (d = 0; d < num_dst_formats; ++d) {
+            if (!MatchesFilter(dst_filter, ShortFormatName(dst_formats[d]))) {
+                continue;
+            }
+            for (z = 0; z < num_sizes; ++z) {
+                /* Scaled blits read a smaller source to exercise the scaling path */
+                const int src_size = scaled ? (sizes[z] * 3 + 3) / 4 : sizes[z];
+                SDL_Surface *src = CreateBenchSurface(src_size, src_size, src_formats[s], &seed);
+                SDL_Surface *dst = CreateBenchSurface(sizes[z], sizes[z], dst_formats[d], &seed);
+
+                if (!src || !dst) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s", SDL_GetError());
+                    SDL_DestroySurface(src);
+                    SDL_DestroySurface(dst);
+                    continue;
+                }
+
+                for (m = 0; m < num_blit_modes; ++m) {
+                    const BlitMode *mode = &blit_modes[m];
+                    int iterations;
+                    double mpix;
+
+                    if (!MatchesFilter(mode_filter, mode->name)) {
+                        continue;
+                    }
+
+                    SetBlitMode(src, mode);
+
+                    mpix = BenchmarkBlit(src, dst, scaled, (Uint64)duration_ms * SDL_NS_PER_MS, &iterations);
+                    SDL_Log("%-14s %-14s %-32s %6d %10.1f %8d  %s",
+                            ShortFormatName(src_formats[s]), ShortFormatName(dst_formats[d]),
+                            mode->name, sizes[z], mpix, iterations, blit_description);
+                }
+                SDL_DestroySurface(src);
+                SDL_DestroySurface(dst);
+            }
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
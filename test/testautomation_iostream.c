@@ -304,6 +304,10 @@ static int iostrm_testConstMem(void *arg)
     /* Run generic tests */
     testGenericIOStreamValidations(rw, SDL_FALSE);
 
+    /* Check the memory properties */
+    SDLTest_AssertCheck(SDL_GetPointerProperty(SDL_GetIOProperties(rw), SDL_PROP_IOSTREAM_MEMORY_POINTER, NULL) == IOStreamHelloWorldCompString,
+                        "Verify SDL_PROP_IOSTREAM_MEMORY_POINTER is the memory passed in");
+
     /* Close handle */
     result = SDL_CloseIO(rw);
     SDLTest_AssertPass("Call to SDL_CloseIO() succeeded");
@@ -393,6 +397,216 @@ static int iostrm_testFileRead(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading from a memory mapped file.
+ *
+ * \sa SDL_IOFromMappedFile
+ * \sa SDL_CloseIO
+ */
+static int iostrm_testMappedFile(void *arg)
+{
+    SDL_IOStream *rw;
+    SDL_PropertiesID props;
+    const char *mem;
+    Sint64 size;
+    int result;
+
+    /* Read test. */
+    rw = SDL_IOFromMappedFile(IOStreamReadTestFilename);
+    SDLTest_AssertPass("Call to SDL_IOFromMappedFile() succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromMappedFile does not return NULL");
+
+    /* Bail out if NULL */
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* Run generic tests */
+    testGenericIOStreamValidations(rw, SDL_FALSE);
+
+    /* The mapping is exposed through the stream properties, if the platform supports it */
+    props = SDL_GetIOProperties(rw);
+    mem = (const char *)SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_MEMORY_POINTER, NULL);
+    if (mem) {
+        size = SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, -1);
+        SDLTest_AssertCheck(size == SDL_GetIOSize(rw), "Verify mapping size, expected %" SDL_PRIs64 ", got %" SDL_PRIs64, SDL_GetIOSize(rw), size);
+        SDLTest_AssertCheck(size == (Sint64)SDL_strlen(IOStreamHelloWorldCompString) &&
+                            SDL_memcmp(mem, IOStreamHelloWorldCompString, (size_t)size) == 0, "Verify mapped memory is correct");
+    } else {
+        SDLTest_Log("SDL_IOFromMappedFile() fell back to regular file access");
+    }
+
+    /* Close handle */
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertPass("Call to SDL_CloseIO() succeeded");
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    /* Empty files can be opened too */
+    rw = SDL_IOFromFile(IOStreamWriteTestFilename, "w");
+    SDLTest_AssertCheck(rw != NULL, "Verify creating an empty file with SDL_IOFromFile does not return NULL");
+    SDL_CloseIO(rw);
+    rw = SDL_IOFromMappedFile(IOStreamWriteTestFilename);
+    SDLTest_AssertCheck(rw != NULL, "Verify opening an empty file with SDL_IOFromMappedFile does not return NULL");
+    if (rw) {
+        char c;
+        size = SDL_GetIOSize(rw);
+        SDLTest_AssertCheck(size == 0, "Verify size of empty file, expected 0, got %" SDL_PRIs64, size);
+        SDLTest_AssertCheck(SDL_ReadIO(rw, &c, 1) == 0, "Verify reading an empty file returns 0");
+        SDLTest_AssertCheck(SDL_GetIOStatus(rw) == SDL_IO_STATUS_EOF, "Verify reading an empty file reaches EOF");
+        SDL_CloseIO(rw);
+    }
+
+    /* Missing files fail */
+    rw = SDL_IOFromMappedFile("iostrm_nonexistent");
+    SDLTest_AssertCheck(rw == NULL, "Verify opening a missing file with SDL_IOFromMappedFile returns NULL");
+
+    return TEST_COMPLETED;
+}
+
+/* Waits for the given number of async I/O tasks, checking that they all succeeded */
+static int waitAsyncIOResults(SDL_AsyncIOQueue *queue, int count)
+{
+    int completed = 0;
+    int failed = 0;
+
+    while (completed < count) {
+        SDL_AsyncIOOutcome outcomes[16];
+        int i, num;
+
+        num = SDL_GetAsyncIOResults(queue, outcomes, SDL_arraysize(outcomes));
+        if (num == 0 && SDL_WaitAsyncIOResult(queue, &outcomes[0], 1000)) {
+            num = 1;
+        }
+        if (num <= 0) {
+            SDLTest_AssertCheck(num == 0, "Verify SDL_GetAsyncIOResults() succeeds, got %d", num);
+            break;
+        }
+        for (i = 0; i < num; ++i) {
+            if (outcomes[i].result != SDL_ASYNCIO_COMPLETE ||
+                outcomes[i].bytes_transferred != outcomes[i].bytes_requested) {
+                ++failed;
+            }
+        }
+        completed += num;
+    }
+    SDLTest_AssertCheck(completed == count, "Verify all async tasks completed, expected %d, got %d", count, completed);
+    return failed;
+}
+
+/**
+ * Tests asynchronous reads and writes, with each of the backends.
+ *
+ * \sa SDL_AsyncIOFromFile
+ * \sa SDL_ReadAsyncIO
+ * \sa SDL_WriteAsyncIO
+ * \sa SDL_LoadFileAsync
+ * \sa SDL_ReadStorageFileAsync
+ */
+static int iostrm_testAsyncIO(void *arg)
+{
+    static const char *drivers[] = { "io_uring", "generic" };
+    const int num_chunks = 64;
+    const int chunk_size = 1024;
+    Uint8 *data = (Uint8 *)SDL_malloc(num_chunks * chunk_size);
+    Uint8 *readback = (Uint8 *)SDL_malloc(num_chunks * chunk_size);
+    int d, i, failed;
+
+    if (!data || !readback) {
+        SDL_free(data);
+        SDL_free(readback);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < num_chunks * chunk_size; ++i) {
+        data[i] = (Uint8)(i * 7 + (i >> 10));
+    }
+
+    for (d = 0; d < SDL_arraysize(drivers); ++d) {
+        SDL_AsyncIOQueue *queue;
+        SDL_AsyncIOOutcome outcome;
+        SDL_AsyncIO *asyncio;
+        SDL_Storage *storage;
+        char buffer[64];
+
+        SDL_SetHint(SDL_HINT_ASYNCIO_DRIVER, drivers[d]);
+        SDLTest_Log("Testing async I/O with the \"%s\" driver", drivers[d]);
+
+        queue = SDL_CreateAsyncIOQueue();
+        SDLTest_AssertCheck(queue != NULL, "Verify SDL_CreateAsyncIOQueue() does not return NULL");
+        if (!queue) {
+            continue;
+        }
+
+        /* Scatter the chunks in reverse order, then gather them in order */
+        asyncio = SDL_AsyncIOFromFile(IOStreamWriteTestFilename, "w+");
+        SDLTest_AssertCheck(asyncio != NULL, "Verify SDL_AsyncIOFromFile(..., \"w+\") does not return NULL");
+        if (asyncio) {
+            for (i = num_chunks - 1; i >= 0; --i) {
+                SDL_WriteAsyncIO(asyncio, data + i * chunk_size, (Uint64)i * chunk_size, chunk_size, queue, NULL);
+            }
+            failed = waitAsyncIOResults(queue, num_chunks);
+            SDLTest_AssertCheck(failed == 0, "Verify async writes succeeded, %d failed", failed);
+            SDLTest_AssertCheck(SDL_GetAsyncIOSize(asyncio) == num_chunks * chunk_size, "Verify file size after async writes");
+
+            SDL_memset(readback, 0, num_chunks * chunk_size);
+            for (i = 0; i < num_chunks; ++i) {
+                SDL_ReadAsyncIO(asyncio, readback + i * chunk_size, (Uint64)i * chunk_size, chunk_size, queue, NULL);
+            }
+            /* The close waits for the reads to finish */
+            SDLTest_AssertCheck(SDL_CloseAsyncIO(asyncio, SDL_TRUE, queue, NULL) == 0, "Verify SDL_CloseAsyncIO() succeeds");
+            failed = waitAsyncIOResults(queue, num_chunks + 1);
+            SDLTest_AssertCheck(failed == 0, "Verify async reads and close succeeded, %d failed", failed);
+            SDLTest_AssertCheck(SDL_memcmp(data, readback, num_chunks * chunk_size) == 0, "Verify async reads returned the written data");
+        }
+
+        /* Whole file loads are null terminated and report short files */
+        SDLTest_AssertCheck(SDL_LoadFileAsync(IOStreamReadTestFilename, queue, buffer) == 0, "Verify SDL_LoadFileAsync() succeeds");
+        SDL_zero(outcome);
+        SDL_WaitAsyncIOResult(queue, &outcome, 5000);
+        SDLTest_AssertCheck(outcome.userdata == buffer && outcome.result == SDL_ASYNCIO_COMPLETE && outcome.asyncio == NULL,
+                            "Verify SDL_LoadFileAsync() outcome");
+        SDLTest_AssertCheck(outcome.buffer && outcome.bytes_transferred == SDL_strlen(IOStreamHelloWorldCompString) &&
+                            SDL_strcmp((const char *)outcome.buffer, IOStreamHelloWorldCompString) == 0,
+                            "Verify SDL_LoadFileAsync() loaded the file");
+        SDL_free(outcome.buffer);
+        SDLTest_AssertCheck(SDL_LoadFileAsync("iostrm_nonexistent", queue, NULL) < 0, "Verify SDL_LoadFileAsync() fails on a missing file");
+
+        /* Reads past the end of the file are short */
+        asyncio = SDL_AsyncIOFromFile(IOStreamReadTestFilename, "r");
+        SDLTest_AssertCheck(asyncio != NULL, "Verify SDL_AsyncIOFromFile(..., \"r\") does not return NULL");
+        if (asyncio) {
+            SDL_ReadAsyncIO(asyncio, buffer, 6, sizeof(buffer), queue, NULL);
+            SDL_zero(outcome);
+            SDL_WaitAsyncIOResult(queue, &outcome, 5000);
+            SDLTest_AssertCheck(outcome.result == SDL_ASYNCIO_COMPLETE && outcome.bytes_transferred == 6 &&
+                                SDL_memcmp(buffer, IOStreamHelloWorldCompString + 6, 6) == 0, "Verify short async read");
+            SDL_CloseAsyncIO(asyncio, SDL_FALSE, queue, NULL);
+        }
+
+        /* Storage reads go through the queue too */
+        storage = SDL_OpenFileStorage(NULL);
+        SDLTest_AssertCheck(storage != NULL, "Verify SDL_OpenFileStorage() does not return NULL");
+        if (storage) {
+            SDL_memset(buffer, 0, sizeof(buffer));
+            SDLTest_AssertCheck(SDL_ReadStorageFileAsync(storage, IOStreamReadTestFilename, buffer, SDL_strlen(IOStreamHelloWorldCompString), queue, storage) == 0,
+                                "Verify SDL_ReadStorageFileAsync() succeeds");
+            do {
+                SDL_zero(outcome);
+                SDL_WaitAsyncIOResult(queue, &outcome, 5000);
+            } while (outcome.type == SDL_ASYNCIO_TASK_CLOSE);
+            SDLTest_AssertCheck(outcome.userdata == storage && outcome.result == SDL_ASYNCIO_COMPLETE &&
+                                SDL_strcmp(buffer, IOStreamHelloWorldCompString) == 0, "Verify SDL_ReadStorageFileAsync() read the file");
+            SDL_CloseStorage(storage);
+        }
+
+        SDL_DestroyAsyncIOQueue(queue);
+    }
+    SDL_ResetHint(SDL_HINT_ASYNCIO_DRIVER);
+
+    SDL_free(data);
+    SDL_free(readback);
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests writing from file.
  *
@@ -647,6 +861,121 @@ static int iostrm_testFileWriteReadEndian(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests buffering an existing stream
+ *
+ * \sa SDL_CreateBufferedIO
+ * \sa SDL_CloseIO
+ */
+static int iostrm_testBufferedIO(void *arg)
+{
+    SDL_IOStream *src, *rw;
+    Uint8 data[64];
+    Uint32 value32;
+    Uint16 value16;
+    Sint64 i;
+    size_t s;
+    int result;
+
+    /* A buffer smaller than the test string, so reads and writes straddle refills */
+    src = SDL_IOFromDynamicMem();
+    SDLTest_AssertCheck(src != NULL, "Verify opening memory with SDL_IOFromDynamicMem does not return NULL");
+    if (src == NULL) {
+        return TEST_ABORTED;
+    }
+    rw = SDL_CreateBufferedIO(src, 7, SDL_TRUE);
+    SDLTest_AssertPass("Call to SDL_CreateBufferedIO(src, 7, SDL_TRUE) succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify result of SDL_CreateBufferedIO is not NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    testGenericIOStreamValidations(rw, SDL_TRUE);
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    /* Endian helpers and mixed reads and writes on a file */
+    src = SDL_IOFromFile(IOStreamWriteTestFilename, "w+");
+    SDLTest_AssertCheck(src != NULL, "Verify opening file with SDL_IOFromFile in write mode does not return NULL");
+    if (src == NULL) {
+        return TEST_ABORTED;
+    }
+    rw = SDL_CreateBufferedIO(src, 16, SDL_TRUE);
+    SDLTest_AssertCheck(rw != NULL, "Verify result of SDL_CreateBufferedIO is not NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < 32; ++i) {
+        if (!SDL_WriteU16LE(rw, (Uint16)(i * 1000)) || !SDL_WriteU32BE(rw, (Uint32)(i * 100000))) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == 32, "Verify all values were written, expected 32, got %" SDL_PRIs64, i);
+    i = SDL_GetIOSize(rw);
+    SDLTest_AssertCheck(i == 32 * 6, "Verify size includes pending writes, expected %d, got %" SDL_PRIs64, 32 * 6, i);
+
+    i = SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(i == 0, "Verify seek to 0, expected 0, got %" SDL_PRIs64, i);
+    for (i = 0; i < 32; ++i) {
+        if (!SDL_ReadU16LE(rw, &value16) || value16 != (Uint16)(i * 1000) ||
+            !SDL_ReadU32BE(rw, &value32) || value32 != (Uint32)(i * 100000)) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == 32, "Verify all values were read back, expected 32, got %" SDL_PRIs64, i);
+    SDLTest_AssertCheck(!SDL_ReadU8(rw, &data[0]), "Verify reading past the end fails");
+    SDLTest_AssertCheck(SDL_GetIOStatus(rw) == SDL_IO_STATUS_EOF, "Verify status is SDL_IO_STATUS_EOF");
+
+    /* Seek backwards within the read-ahead data, then overwrite from there */
+    i = SDL_SeekIO(rw, 6, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(i == 6, "Verify seek to 6, expected 6, got %" SDL_PRIs64, i);
+    SDLTest_AssertCheck(SDL_ReadU16LE(rw, &value16) && value16 == 1000, "Verify value after seek is 1000, got %hu", value16);
+    i = SDL_SeekIO(rw, -2, SDL_IO_SEEK_CUR);
+    SDLTest_AssertCheck(i == 6, "Verify relative seek to 6, expected 6, got %" SDL_PRIs64, i);
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &data[0]), "Verify reading one byte succeeds");
+    SDLTest_AssertCheck(SDL_WriteU8(rw, 0xAB), "Verify writing after a read succeeds");
+    i = SDL_SeekIO(rw, 0, SDL_IO_SEEK_CUR);
+    SDLTest_AssertCheck(i == 8, "Verify position after read and write, expected 8, got %" SDL_PRIs64, i);
+
+    /* A read bigger than the buffer bypasses it */
+    i = SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    s = SDL_ReadIO(rw, data, sizeof(data));
+    SDLTest_AssertCheck(s == sizeof(data), "Verify large read, expected %d, got %d", (int)sizeof(data), (int)s);
+    SDLTest_AssertCheck(data[6] == (Uint8)(1000 & 0xFF) && data[7] == 0xAB, "Verify the byte written after a read landed in place");
+
+    /* The large read leaves nothing buffered, so seeking back re-reads the source */
+    i = SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(i == 0, "Verify seek to 0, expected 0, got %" SDL_PRIs64, i);
+    s = SDL_ReadIO(rw, data, 1) + SDL_ReadIO(rw, data, 15);
+    SDLTest_AssertCheck(s == 16, "Verify reading the whole buffer, expected 16, got %d", (int)s);
+    s = SDL_ReadIO(rw, data, sizeof(data));
+    SDLTest_AssertCheck(s == sizeof(data), "Verify large read, expected %d, got %d", (int)sizeof(data), (int)s);
+    i = SDL_SeekIO(rw, 72, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(i == 72, "Verify seek to 72, expected 72, got %" SDL_PRIs64, i);
+    SDLTest_AssertCheck(SDL_ReadU16LE(rw, &value16) && value16 == 12000, "Verify value after large read is 12000, got %hu", value16);
+    i = SDL_SeekIO(rw, 0, SDL_IO_SEEK_CUR);
+    SDLTest_AssertCheck(i == 74, "Verify position after read, expected 74, got %" SDL_PRIs64, i);
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    /* Read-only sources stay read-only */
+    src = SDL_IOFromConstMem(IOStreamHelloWorldTestString, sizeof(IOStreamHelloWorldTestString) - 1);
+    rw = SDL_CreateBufferedIO(src, 0, SDL_TRUE);
+    SDLTest_AssertCheck(rw != NULL, "Verify result of SDL_CreateBufferedIO is not NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    testGenericIOStreamValidations(rw, SDL_FALSE);
+    i = SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(i == 0, "Verify seek to 0, expected 0, got %" SDL_PRIs64, i);
+    SDLTest_AssertCheck(!SDL_WriteU32LE(rw, 0x12345678), "Verify SDL_WriteU32LE fails on a read-only stream");
+    SDLTest_AssertCheck(SDL_GetIOStatus(rw) == SDL_IO_STATUS_READONLY, "Verify status is SDL_IO_STATUS_READONLY");
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &data[0]) && data[0] == (Uint8)IOStreamHelloWorldTestString[0], "Verify the read-only data is unchanged");
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* IOStream test cases */
@@ -686,10 +1015,22 @@ static const SDLTest_TestCaseReference iostrmTest9 = {
     (SDLTest_TestCaseFp)iostrm_testCompareRWFromMemWithRWFromFile, "iostrm_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile IOStream for read and seek", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference iostrmTest10 = {
+    (SDLTest_TestCaseFp)iostrm_testMappedFile, "iostrm_testMappedFile", "Tests reading from a memory mapped file", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest11 = {
+    (SDLTest_TestCaseFp)iostrm_testAsyncIO, "iostrm_testAsyncIO", "Tests asynchronous reads and writes", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest12 = {
+    (SDLTest_TestCaseFp)iostrm_testBufferedIO, "iostrm_testBufferedIO", "Tests buffering an existing stream", TEST_ENABLED
+};
+
 /* Sequence of IOStream test cases */
 static const SDLTest_TestCaseReference *iostrmTests[] = {
     &iostrmTest1, &iostrmTest2, &iostrmTest3, &iostrmTest4, &iostrmTest5, &iostrmTest6,
-    &iostrmTest7, &iostrmTest8, &iostrmTest9, NULL
+    &iostrmTest7, &iostrmTest8, &iostrmTest9, &iostrmTest10, &iostrmTest11, &iostrmTest12, NULL
 };
 
 /* IOStream test suite (global) */
@@ -1438,6 +1438,392 @@ static int render_testUVWrapping(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests the per-frame statistics published by SDL_RenderPresent
+ *
+ * \sa SDL_GetRendererProperties
+ * \sa SDL_RenderPresent
+ */
+static int render_testFrameStatistics(void *arg)
+{
+    SDL_PropertiesID props;
+    SDL_Texture *tface;
+    SDL_FRect rect;
+    Sint64 value;
+    int i;
+
+    tface = loadTestFace();
+    SDLTest_AssertCheck(tface != NULL, "Verify loadTestFace() result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+
+    props = SDL_GetRendererProperties(renderer);
+    SDLTest_AssertCheck(props != 0, "Verify SDL_GetRendererProperties() result");
+
+    /* Start with an empty frame */
+    SDL_RenderPresent(renderer);
+    value = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_DRAW_CALLS_NUMBER, -1);
+    SDLTest_AssertCheck(value == 0, "Validate draw calls for an empty frame, expected: 0, got: %" SDL_PRIs64, value);
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+    for (i = 0; i < 3; ++i) {
+        rect.x = (float)(i * 10);
+        rect.y = 0.0f;
+        rect.w = 8.0f;
+        rect.h = 8.0f;
+        CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect))
+    }
+    for (i = 0; i < 2; ++i) {
+        rect.x = (float)(i * 20);
+        rect.y = 20.0f;
+        rect.w = 16.0f;
+        rect.h = 16.0f;
+        CHECK_FUNC(SDL_RenderTexture, (renderer, tface, NULL, &rect))
+    }
+    SDL_RenderPresent(renderer);
+
+    value = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_DRAW_CALLS_NUMBER, -1);
+    SDLTest_AssertCheck(value == 5, "Validate draw calls, expected: 5, got: %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_TEXTURE_CHANGES_NUMBER, -1);
+    SDLTest_AssertCheck(value == 1, "Validate texture changes, expected: 1, got: %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_VERTICES_NUMBER, -1);
+    SDLTest_AssertCheck(value >= 20, "Validate vertices, expected: >= 20, got: %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER, -1);
+    SDLTest_AssertCheck(value >= 5, "Validate commands, expected: >= 5, got: %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_FLUSHES_NUMBER, -1);
+    SDLTest_AssertCheck(value >= 1, "Validate flushes, expected: >= 1, got: %" SDL_PRIs64, value);
+
+    SDL_DestroyTexture(tface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests rendering with a separate render thread
+ *
+ * \sa SDL_CreateRendererWithProperties
+ * \sa SDL_RenderPresent
+ */
+static int render_testRenderThread(void *arg)
+{
+    SDL_Window *thread_window;
+    SDL_Renderer *thread_renderer;
+    SDL_PropertiesID props;
+    SDL_RenderReadback *readback;
+    SDL_Surface *surface;
+    SDL_FRect rect;
+    SDL_bool threaded;
+    Uint8 r, g, b, a;
+    int i;
+
+    thread_window = SDL_CreateWindow("render_testRenderThread", TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 0);
+    SDLTest_AssertCheck(thread_window != NULL, "Check SDL_CreateWindow result");
+    if (thread_window == NULL) {
+        return TEST_ABORTED;
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, SDL_PROP_RENDERER_CREATE_WINDOW_POINTER, thread_window);
+    SDL_SetStringProperty(props, SDL_PROP_RENDERER_CREATE_NAME_STRING, SDL_SOFTWARE_RENDERER);
+    SDL_SetBooleanProperty(props, SDL_PROP_RENDERER_CREATE_RENDER_THREAD_BOOLEAN, SDL_TRUE);
+    thread_renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(thread_renderer != NULL, "Check SDL_CreateRendererWithProperties result: %s", thread_renderer != NULL ? "success" : SDL_GetError());
+    if (thread_renderer == NULL) {
+        SDL_DestroyWindow(thread_window);
+        return TEST_ABORTED;
+    }
+
+    threaded = SDL_GetBooleanProperty(SDL_GetRendererProperties(thread_renderer), SDL_PROP_RENDERER_RENDER_THREAD_BOOLEAN, SDL_FALSE);
+    SDLTest_Log("Render thread %s", threaded ? "enabled" : "not supported");
+
+    rect.x = 10.0f;
+    rect.y = 10.0f;
+    rect.w = 20.0f;
+    rect.h = 20.0f;
+    for (i = 0; i < 10; ++i) {
+        CHECK_FUNC(SDL_SetRenderDrawColor, (thread_renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderClear, (thread_renderer))
+        CHECK_FUNC(SDL_SetRenderDrawColor, (thread_renderer, 0, 255, 0, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderFillRect, (thread_renderer, &rect))
+        if (i < 9) {
+            CHECK_FUNC(SDL_RenderPresent, (thread_renderer))
+        }
+    }
+
+    /* Reading back waits for the render thread and draws the pending commands */
+    surface = SDL_RenderReadPixels(thread_renderer, NULL);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface != NULL ? "success" : SDL_GetError());
+    if (surface) {
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 0, 0, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Check cleared pixel, expected: 255,0,0, got: %d,%d,%d", r, g, b);
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 15, 15, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 0 && g == 255 && b == 0, "Check filled pixel, expected: 0,255,0, got: %d,%d,%d", r, g, b);
+        SDL_DestroySurface(surface);
+    }
+
+    /* Logical presentation switches render targets around every present */
+    CHECK_FUNC(SDL_SetRenderLogicalPresentation, (thread_renderer, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, SDL_LOGICAL_PRESENTATION_STRETCH, SDL_SCALEMODE_NEAREST))
+    for (i = 0; i < 10; ++i) {
+        CHECK_FUNC(SDL_SetRenderDrawColor, (thread_renderer, 0, 0, 255, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderClear, (thread_renderer))
+        CHECK_FUNC(SDL_SetRenderDrawColor, (thread_renderer, 255, 255, 0, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderFillRect, (thread_renderer, &rect))
+        if (i < 9) {
+            CHECK_FUNC(SDL_RenderPresent, (thread_renderer))
+        }
+    }
+
+    surface = SDL_RenderReadPixels(thread_renderer, NULL);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface != NULL ? "success" : SDL_GetError());
+    if (surface) {
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 0, 0, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 0 && g == 0 && b == 255, "Check cleared pixel, expected: 0,0,255, got: %d,%d,%d", r, g, b);
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 15, 15, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 255 && g == 255 && b == 0, "Check filled pixel, expected: 255,255,0, got: %d,%d,%d", r, g, b);
+        SDL_DestroySurface(surface);
+    }
+
+    /* Asynchronous reads are done on the render thread */
+    readback = SDL_RenderReadPixelsAsync(thread_renderer, NULL, NULL, NULL);
+    SDLTest_AssertCheck(readback != NULL, "Validate result from SDL_RenderReadPixelsAsync, got: %s", readback != NULL ? "success" : SDL_GetError());
+    if (readback) {
+        CHECK_FUNC(SDL_RenderClear, (thread_renderer))
+        surface = SDL_WaitRenderReadback(readback);
+        SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_WaitRenderReadback, got: %s", surface != NULL ? "success" : SDL_GetError());
+        if (surface) {
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 15, 15, &r, &g, &b, &a))
+            SDLTest_AssertCheck(r == 255 && g == 255 && b == 0, "Check filled pixel, expected: 255,255,0, got: %d,%d,%d", r, g, b);
+            SDL_DestroySurface(surface);
+        }
+    }
+
+    SDL_DestroyRenderer(thread_renderer);
+    SDL_DestroyWindow(thread_window);
+
+    return TEST_COMPLETED;
+}
+
+static void SDLCALL readback_callback(void *userdata, SDL_RenderReadback *readback)
+{
+    SDL_AtomicInt *count = (SDL_AtomicInt *)userdata;
+
+    (void)readback;
+    SDL_AtomicAdd(count, 1);
+}
+
+/**
+ * Tests reading pixels without waiting for the result
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ * \sa SDL_IsRenderReadbackComplete
+ * \sa SDL_WaitRenderReadback
+ */
+static int render_testReadPixelsAsync(void *arg)
+{
+    static const Uint8 colors[3][3] = { { 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 255 } };
+    SDL_RenderReadback *readback;
+    SDL_RenderReadback *readbacks[SDL_arraysize(colors)];
+    SDL_Surface *surface;
+    SDL_AtomicInt count;
+    SDL_Rect rect;
+    Uint8 r, g, b, a;
+    int i;
+
+    SDL_AtomicSet(&count, 0);
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (renderer))
+
+    rect.x = 10;
+    rect.y = 20;
+    rect.w = 30;
+    rect.h = 40;
+    readback = SDL_RenderReadPixelsAsync(renderer, &rect, readback_callback, &count);
+    SDLTest_AssertCheck(readback != NULL, "Validate result from SDL_RenderReadPixelsAsync, got: %s", readback != NULL ? "success" : SDL_GetError());
+    if (readback == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* Drawing after the request must not show up in the result */
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 255, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (renderer))
+
+    SDLTest_Log("Readback %s complete before waiting", SDL_IsRenderReadbackComplete(readback) ? "was" : "was not");
+
+    surface = SDL_WaitRenderReadback(readback);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_WaitRenderReadback, got: %s", surface != NULL ? "success" : SDL_GetError());
+    SDLTest_AssertCheck(SDL_AtomicGet(&count) == 1, "Validate callback count, expected: 1, got: %d", SDL_AtomicGet(&count));
+    if (surface) {
+        SDLTest_AssertCheck(surface->w == rect.w && surface->h == rect.h, "Validate surface size, expected: %dx%d, got: %dx%d", rect.w, rect.h, surface->w, surface->h);
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 0, 0, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Check pixel, expected: 255,0,0, got: %d,%d,%d", r, g, b);
+        SDL_DestroySurface(surface);
+    }
+
+    /* The commands issued after the request are still drawn */
+    surface = SDL_RenderReadPixels(renderer, &rect);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface != NULL ? "success" : SDL_GetError());
+    if (surface) {
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 0, 0, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 0 && g == 0 && b == 255, "Check pixel, expected: 0,0,255, got: %d,%d,%d", r, g, b);
+        SDL_DestroySurface(surface);
+    }
+
+    /* Several readbacks can be in flight, and they complete in order */
+    for (i = 0; i < SDL_arraysize(readbacks); ++i) {
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, colors[i][0], colors[i][1], colors[i][2], SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderClear, (renderer))
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 255, 255, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderPoint, (renderer, (float)rect.x, (float)rect.y))
+        readbacks[i] = SDL_RenderReadPixelsAsync(renderer, &rect, readback_callback, &count);
+        SDLTest_AssertCheck(readbacks[i] != NULL, "Validate result from SDL_RenderReadPixelsAsync, got: %s", readbacks[i] != NULL ? "success" : SDL_GetError());
+        if (readbacks[i] == NULL) {
+            return TEST_ABORTED;
+        }
+    }
+    for (i = 0; i < 1000 && !SDL_IsRenderReadbackComplete(readbacks[SDL_arraysize(readbacks) - 1]); ++i) {
+        SDL_Delay(1);
+    }
+    SDLTest_AssertCheck(SDL_IsRenderReadbackComplete(readbacks[SDL_arraysize(readbacks) - 1]), "Validate the last readback completes without waiting");
+    SDLTest_AssertCheck(SDL_AtomicGet(&count) == 1 + SDL_arraysize(readbacks), "Validate callback count, expected: %d, got: %d", (int)(1 + SDL_arraysize(readbacks)), SDL_AtomicGet(&count));
+    for (i = 0; i < SDL_arraysize(readbacks); ++i) {
+        SDLTest_AssertCheck(SDL_IsRenderReadbackComplete(readbacks[i]), "Validate readback %d is complete", i);
+        surface = SDL_WaitRenderReadback(readbacks[i]);
+        SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_WaitRenderReadback, got: %s", surface != NULL ? "success" : SDL_GetError());
+        if (surface) {
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 0, 0, &r, &g, &b, &a))
+            SDLTest_AssertCheck(r == 255 && g == 255 && b == 255, "Check top left pixel, expected: 255,255,255, got: %d,%d,%d", r, g, b);
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, rect.w - 1, rect.h - 1, &r, &g, &b, &a))
+            SDLTest_AssertCheck(r == colors[i][0] && g == colors[i][1] && b == colors[i][2],
+                                "Check pixel, expected: %d,%d,%d, got: %d,%d,%d", colors[i][0], colors[i][1], colors[i][2], r, g, b);
+            SDL_DestroySurface(surface);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+static SDL_Texture *CreatePackedTexture(Uint32 color)
+{
+    SDL_Texture *texture;
+    SDL_PropertiesID props;
+    Uint32 pixels[8 * 8];
+    int i;
+
+    for (i = 0; i < SDL_arraysize(pixels); ++i) {
+        pixels[i] = color;
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, SDL_PIXELFORMAT_ARGB8888);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, 8);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, 8);
+    SDL_SetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN, SDL_TRUE);
+    texture = SDL_CreateTextureWithProperties(renderer, props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(texture != NULL, "Check SDL_CreateTextureWithProperties result: %s", texture != NULL ? "success" : SDL_GetError());
+    if (texture) {
+        CHECK_FUNC(SDL_UpdateTexture, (texture, NULL, pixels, 8 * sizeof(Uint32)))
+    }
+    return texture;
+}
+
+/**
+ * Tests drawing textures packed into a shared atlas texture
+ *
+ * \sa SDL_CreateTextureWithProperties
+ * \sa SDL_RenderTexture
+ * \sa SDL_RenderGeometry
+ */
+static int render_testTextureAtlas(void *arg)
+{
+    const Uint32 colors[3] = { 0xFFFF0000, 0xFF00FF00, 0xFF0000FF };
+    SDL_Texture *textures[3];
+    SDL_Surface *surface;
+    SDL_FRect dst;
+    SDL_Vertex verts[3];
+    Uint8 r, g, b, a;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(textures); ++i) {
+        textures[i] = CreatePackedTexture(colors[i]);
+        if (!textures[i]) {
+            return TEST_ABORTED;
+        }
+    }
+    SDLTest_AssertCheck(SDL_GetBooleanProperty(SDL_GetTextureProperties(textures[0]), SDL_PROP_TEXTURE_ATLAS_BOOLEAN, SDL_FALSE),
+                        "Validate SDL_PROP_TEXTURE_ATLAS_BOOLEAN is set");
+
+    /* Packed textures share the scale mode of the texture they're packed into */
+    SDLTest_AssertCheck(SDL_SetTextureScaleMode(textures[0], SDL_SCALEMODE_NEAREST) < 0, "Validate SDL_SetTextureScaleMode fails on a packed texture");
+
+    /* Destroying one texture doesn't affect the others packed with it */
+    SDL_DestroyTexture(textures[1]);
+    textures[1] = CreatePackedTexture(colors[1]);
+    if (!textures[1]) {
+        SDL_DestroyTexture(textures[0]);
+        SDL_DestroyTexture(textures[2]);
+        return TEST_ABORTED;
+    }
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (renderer))
+    for (i = 0; i < SDL_arraysize(textures); ++i) {
+        dst.x = (float)(i * 16);
+        dst.y = 0.0f;
+        dst.w = 16.0f;
+        dst.h = 16.0f;
+        CHECK_FUNC(SDL_RenderTexture, (renderer, textures[i], NULL, &dst))
+    }
+
+    /* A triangle covering the corner at 0,32 sampled from the second texture */
+    SDL_zeroa(verts);
+    for (i = 0; i < SDL_arraysize(verts); ++i) {
+        verts[i].color.r = 1.0f;
+        verts[i].color.g = 1.0f;
+        verts[i].color.b = 1.0f;
+        verts[i].color.a = 1.0f;
+    }
+    verts[0].position.x = 0.0f;
+    verts[0].position.y = 32.0f;
+    verts[1].position.x = 32.0f;
+    verts[1].position.y = 32.0f;
+    verts[1].tex_coord.x = 1.0f;
+    verts[2].position.x = 0.0f;
+    verts[2].position.y = 64.0f;
+    verts[2].tex_coord.y = 1.0f;
+    CHECK_FUNC(SDL_RenderGeometry, (renderer, textures[1], verts, SDL_arraysize(verts), NULL, 0))
+
+    surface = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface != NULL ? "success" : SDL_GetError());
+    if (surface) {
+        for (i = 0; i < SDL_arraysize(textures); ++i) {
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, i * 16 + 8, 8, &r, &g, &b, &a))
+            SDLTest_AssertCheck(((Uint32)0xFF << 24 | (Uint32)r << 16 | (Uint32)g << 8 | b) == colors[i],
+                                "Check texture %d pixel, expected: 0x%.8" SDL_PRIx32 ", got: %d,%d,%d", i, colors[i], r, g, b);
+
+            /* The edges are filtered with the padding around the texture, which repeats its edge pixels */
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, i * 16, 0, &r, &g, &b, &a))
+            SDLTest_AssertCheck(((Uint32)0xFF << 24 | (Uint32)r << 16 | (Uint32)g << 8 | b) == colors[i],
+                                "Check texture %d top left pixel, expected: 0x%.8" SDL_PRIx32 ", got: %d,%d,%d", i, colors[i], r, g, b);
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, i * 16 + 15, 15, &r, &g, &b, &a))
+            SDLTest_AssertCheck(((Uint32)0xFF << 24 | (Uint32)r << 16 | (Uint32)g << 8 | b) == colors[i],
+                                "Check texture %d bottom right pixel, expected: 0x%.8" SDL_PRIx32 ", got: %d,%d,%d", i, colors[i], r, g, b);
+        }
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 4, 36, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 0 && g == 255 && b == 0, "Check geometry pixel, expected: 0,255,0, got: %d,%d,%d", r, g, b);
+        SDL_DestroySurface(surface);
+    }
+
+    for (i = 0; i < SDL_arraysize(textures); ++i) {
+        SDL_DestroyTexture(textures[i]);
+    }
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -1489,6 +1875,22 @@ static const SDLTest_TestCaseReference renderTestUVWrapping = {
     (SDLTest_TestCaseFp)render_testUVWrapping, "render_testUVWrapping", "Tests geometry UV wrapping", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTestFrameStatistics = {
+    (SDLTest_TestCaseFp)render_testFrameStatistics, "render_testFrameStatistics", "Tests per-frame render statistics", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRenderThread = {
+    (SDLTest_TestCaseFp)render_testRenderThread, "render_testRenderThread", "Tests rendering with a render thread", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestReadPixelsAsync = {
+    (SDLTest_TestCaseFp)render_testReadPixelsAsync, "render_testReadPixelsAsync", "Tests reading pixels without waiting for the result", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestTextureAtlas = {
+    (SDLTest_TestCaseFp)render_testTextureAtlas, "render_testTextureAtlas", "Tests drawing textures packed into a shared texture", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestGetNumRenderDrivers,
@@ -1503,6 +1905,10 @@ static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestClipRect,
     &renderTestLogicalSize,
     &renderTestUVWrapping,
+    &renderTestFrameStatistics,
+    &renderTestRenderThread,
+    &renderTestReadPixelsAsync,
+    &renderTestTextureAtlas,
     NULL
 };
 
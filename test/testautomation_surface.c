@@ -1298,6 +1298,1018 @@ static int surface_testPremultiplyAlpha(void *arg)
     return TEST_COMPLETED;
 }
 
+static int surface_testFloatConversion(void *arg)
+{
+    const int width = 256, height = 32;
+    SDL_Surface *surface = NULL, *linear = NULL, *result = NULL;
+    float expected[4];
+    const float *actual;
+    const Uint32 *pixels, *results;
+    Uint32 pixel;
+    int x, y, ret;
+    int mismatches = 0;
+    int encode_mismatches = 0;
+    int max_delta = 0;
+
+    /* Large conversions use lookup tables, which must match converting single pixels exactly */
+    surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (!surface) {
+        goto done;
+    }
+    for (y = 0; y < height; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < width; ++x) {
+            row[x] = 0xFF000000 | (x << 16) | ((255 - x) << 8) | ((x + y * 8) & 0xFF);
+        }
+    }
+
+    linear = SDL_ConvertSurfaceAndColorspace(surface, SDL_PIXELFORMAT_RGBA128_FLOAT, NULL, SDL_COLORSPACE_SRGB_LINEAR, 0);
+    SDLTest_AssertCheck(linear != NULL, "SDL_ConvertSurfaceAndColorspace(SDL_PIXELFORMAT_RGBA128_FLOAT)");
+    if (!linear) {
+        goto done;
+    }
+    for (y = 0; y < height; ++y) {
+        pixels = (const Uint32 *)((const Uint8 *)surface->pixels + y * surface->pitch);
+        actual = (const float *)((const Uint8 *)linear->pixels + y * linear->pitch);
+        for (x = 0; x < width; ++x, actual += 4) {
+            ret = SDL_ConvertPixelsAndColorspace(1, 1, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_SRGB, 0, &pixels[x], sizeof(Uint32),
+                                                 SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, expected, sizeof(expected));
+            if (ret < 0 ||
+                actual[0] != expected[0] ||
+                actual[1] != expected[1] ||
+                actual[2] != expected[2] ||
+                actual[3] != expected[3]) {
+                ++mismatches;
+            }
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Check sRGB to linear float conversion matches single pixel conversion, expected 0 mismatches, got %d", mismatches);
+
+    /* Encoding back to 8-bit sRGB gives the same result as encoding single pixels, and is within 1 of the original values */
+    result = SDL_ConvertSurfaceAndColorspace(linear, SDL_PIXELFORMAT_XRGB8888, NULL, SDL_COLORSPACE_SRGB, 0);
+    SDLTest_AssertCheck(result != NULL, "SDL_ConvertSurfaceAndColorspace(SDL_PIXELFORMAT_XRGB8888)");
+    if (!result) {
+        goto done;
+    }
+    for (y = 0; y < height; ++y) {
+        pixels = (const Uint32 *)((const Uint8 *)surface->pixels + y * surface->pitch);
+        results = (const Uint32 *)((const Uint8 *)result->pixels + y * result->pitch);
+        actual = (const float *)((const Uint8 *)linear->pixels + y * linear->pitch);
+        for (x = 0; x < width; ++x, actual += 4) {
+            int shift;
+            ret = SDL_ConvertPixelsAndColorspace(1, 1, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, actual, sizeof(expected),
+                                                 SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_SRGB, 0, &pixel, sizeof(pixel));
+            if (ret < 0 || pixel != results[x]) {
+                ++encode_mismatches;
+            }
+            pixel = results[x];
+            for (shift = 0; shift < 24; shift += 8) {
+                int delta = SDL_abs((int)((pixel >> shift) & 0xFF) - (int)((pixels[x] >> shift) & 0xFF));
+                max_delta = SDL_max(max_delta, delta);
+            }
+        }
+    }
+    SDLTest_AssertCheck(encode_mismatches == 0, "Check linear float to sRGB conversion matches single pixel conversion, expected 0 mismatches, got %d", encode_mismatches);
+    SDLTest_AssertCheck(max_delta <= 1, "Check linear float to sRGB conversion round trip, expected maximum error 1, got %d", max_delta);
+
+done:
+    SDL_DestroySurface(surface);
+    SDL_DestroySurface(linear);
+    SDL_DestroySurface(result);
+    return TEST_COMPLETED;
+}
+
+/* These match the functions in SDL_pixels.c */
+static float sRGBtoLinear(float v)
+{
+    if (v <= 0.04045f) {
+        return v / 12.92f;
+    }
+    return SDL_powf((v + 0.055f) / 1.055f, 2.4f);
+}
+
+static float sRGBfromLinear(float v)
+{
+    if (v <= 0.0031308f) {
+        return v * 12.92f;
+    }
+    return SDL_powf(v, 1.0f / 2.4f) * 1.055f - 0.055f;
+}
+
+static float PQtoNits(float v)
+{
+    const float c1 = 0.8359375f;
+    const float c2 = 18.8515625f;
+    const float c3 = 18.6875f;
+    const float oo_m1 = 1.0f / 0.1593017578125f;
+    const float oo_m2 = 1.0f / 78.84375f;
+
+    float num = SDL_max(SDL_powf(v, oo_m2) - c1, 0.0f);
+    float den = c2 - c3 * SDL_powf(v, oo_m2);
+    return 10000.0f * SDL_powf(num / den, oo_m1);
+}
+
+static float PQfromNits(float v)
+{
+    const float c1 = 0.8359375f;
+    const float c2 = 18.8515625f;
+    const float c3 = 18.6875f;
+    const float m1 = 0.1593017578125f;
+    const float m2 = 78.84375f;
+
+    float y = SDL_clamp(v / 10000.0f, 0.0f, 1.0f);
+    float num = c1 + c2 * SDL_powf(y, m1);
+    float den = 1.0f + c3 * SDL_powf(y, m1);
+    return SDL_powf(num / den, m2);
+}
+
+/* Convert a row of float pixels and return the largest difference from the exact transfer function.
+ * If relative is set, the difference is relative to the expected value.
+ */
+static float CheckFloatTransfer(const float *values, int count, float scale, SDL_Colorspace src_colorspace, SDL_Colorspace dst_colorspace, float (*exact)(float), SDL_bool relative)
+{
+    float *src = (float *)SDL_malloc(count * 4 * sizeof(float));
+    float *dst = (float *)SDL_malloc(count * 4 * sizeof(float));
+    float max_error = -1.0f;
+    int i, c;
+
+    if (src && dst) {
+        for (i = 0; i < count; ++i) {
+            /* Put each value in a different channel and position in the chunk */
+            for (c = 0; c < 3; ++c) {
+                src[i * 4 + c] = values[(i + c * 17) % count] * scale;
+            }
+            src[i * 4 + 3] = 1.0f;
+        }
+        if (SDL_ConvertPixelsAndColorspace(count, 1, SDL_PIXELFORMAT_RGBA128_FLOAT, src_colorspace, 0, src, count * 4 * sizeof(float),
+                                           SDL_PIXELFORMAT_RGBA128_FLOAT, dst_colorspace, 0, dst, count * 4 * sizeof(float)) == 0) {
+            max_error = 0.0f;
+            for (i = 0; i < count * 4; ++i) {
+                float expected, error;
+
+                if ((i % 4) == 3) {
+                    expected = 1.0f;
+                } else {
+                    expected = exact(src[i]);
+                }
+                if (SDL_isnanf(expected)) {
+                    /* PQ isn't defined for negative values, so there's nothing to match except NaN */
+                    error = SDL_isnanf(dst[i]) ? 0.0f : 1.0f;
+                } else {
+                    error = SDL_fabsf(dst[i] - expected);
+                    if (relative) {
+                        /* The PQ curve is flat enough near black that this doesn't matter for tiny values */
+                        error /= SDL_max(expected, 1e-6f);
+                    }
+                }
+                max_error = SDL_max(max_error, error);
+            }
+        }
+    }
+    SDL_free(src);
+    SDL_free(dst);
+    return max_error;
+}
+
+static float PQfromNitsExact(float v)
+{
+    /* The source is linear with an SDR white point of 1.0, and HDR10 has an SDR white point of 203 nits */
+    return PQfromNits(v * 203.0f);
+}
+
+static float PQtoNitsExact(float v)
+{
+    return PQtoNits(v) / 203.0f;
+}
+
+/**
+ * Tests that the transfer functions used when converting float pixels are within the documented tolerance of the exact functions.
+ */
+static int surface_testFloatTransferAccuracy(void *arg)
+{
+    const SDL_Colorspace bt2020_linear = SDL_DEFINE_COLORSPACE(SDL_COLOR_TYPE_RGB,
+                                                               SDL_COLOR_RANGE_FULL,
+                                                               SDL_COLOR_PRIMARIES_BT2020,
+                                                               SDL_TRANSFER_CHARACTERISTICS_LINEAR,
+                                                               SDL_MATRIX_COEFFICIENTS_IDENTITY,
+                                                               SDL_CHROMA_LOCATION_NONE);
+    const int steps = 65536;
+    float *values;
+    float error;
+    int count = 0;
+    int i;
+
+    values = (float *)SDL_malloc((steps + 128) * sizeof(float));
+    SDLTest_AssertCheck(values != NULL, "SDL_malloc()");
+    if (!values) {
+        return TEST_ABORTED;
+    }
+
+    /* Evenly spaced values, small values down to the bottom of the tables, and values outside of [0, 1] */
+    for (i = 0; i <= steps; ++i) {
+        values[count++] = (float)i / steps;
+    }
+    for (i = 1; i <= 70; ++i) {
+        values[count++] = SDL_powf(2.0f, -(float)i * 0.999f);
+    }
+    values[count++] = 0.0f;
+    values[count++] = -0.0f;
+    values[count++] = -0.25f;
+    values[count++] = 1.5f;
+    values[count++] = 1.0f + 1e-6f;
+
+    error = CheckFloatTransfer(values, count, 1.0f, SDL_COLORSPACE_SRGB_LINEAR, SDL_COLORSPACE_SRGB, sRGBfromLinear, SDL_FALSE);
+    SDLTest_AssertCheck(error >= 0.0f && error <= 2e-6f, "Check linear to sRGB conversion, expected maximum error 2e-6, got %g", error);
+
+    error = CheckFloatTransfer(values, count, 1.0f, SDL_COLORSPACE_SRGB, SDL_COLORSPACE_SRGB_LINEAR, sRGBtoLinear, SDL_FALSE);
+    SDLTest_AssertCheck(error >= 0.0f && error <= 7e-6f, "Check sRGB to linear conversion, expected maximum error 7e-6, got %g", error);
+
+    /* Cover the whole PQ range, 10000 nits is 10000 / 203 with an SDR white point of 203 nits */
+    error = CheckFloatTransfer(values, count, 10000.0f / 203.0f, bt2020_linear, SDL_COLORSPACE_HDR10, PQfromNitsExact, SDL_FALSE);
+    SDLTest_AssertCheck(error >= 0.0f && error <= 3e-5f, "Check linear to PQ conversion, expected maximum error 3e-5, got %g", error);
+
+    error = CheckFloatTransfer(values, count, 1.0f, SDL_COLORSPACE_HDR10, bt2020_linear, PQtoNitsExact, SDL_TRUE);
+    SDLTest_AssertCheck(error >= 0.0f && error <= 3e-4f, "Check PQ to linear conversion, expected maximum relative error 3e-4, got %g", error);
+
+    SDL_free(values);
+    return TEST_COMPLETED;
+}
+
+static int surface_testScaledConversion(void *arg)
+{
+    static const struct
+    {
+        SDL_PixelFormat src_format;
+        SDL_PixelFormat dst_format;
+    } tests[] = {
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR24 },
+    };
+    int i, x, y, ret;
+
+    /* Scaling while converting should match converting first and then scaling */
+    for (i = 0; i < SDL_arraysize(tests); ++i) {
+        SDL_Surface *src = SDL_CreateSurface(97, 61, tests[i].src_format);
+        SDL_Surface *converted = NULL;
+        SDL_Surface *expected = SDL_CreateSurface(40, 75, tests[i].dst_format);
+        SDL_Surface *actual = SDL_CreateSurface(40, 75, tests[i].dst_format);
+        int mismatches = 0;
+
+        SDLTest_AssertCheck(src && expected && actual, "Create %s and %s surfaces",
+                            SDL_GetPixelFormatName(tests[i].src_format), SDL_GetPixelFormatName(tests[i].dst_format));
+        if (!src || !expected || !actual) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(expected);
+            SDL_DestroySurface(actual);
+            continue;
+        }
+
+        for (y = 0; y < src->h; ++y) {
+            for (x = 0; x < src->w; ++x) {
+                SDL_WriteSurfacePixel(src, x, y, (Uint8)(x * 255 / src->w), (Uint8)(y * 255 / src->h), (Uint8)((x * y) & 0xFF), 255);
+            }
+        }
+        converted = SDL_ConvertSurface(src, tests[i].dst_format);
+        SDLTest_AssertCheck(converted != NULL, "SDL_ConvertSurface()");
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+
+        ret = SDL_BlitSurfaceScaled(converted, NULL, expected, NULL, SDL_SCALEMODE_LINEAR);
+        SDLTest_AssertCheck(ret == 0, "SDL_BlitSurfaceScaled(%s), expected 0, got %d", SDL_GetPixelFormatName(tests[i].dst_format), ret);
+        ret = SDL_BlitSurfaceScaled(src, NULL, actual, NULL, SDL_SCALEMODE_LINEAR);
+        SDLTest_AssertCheck(ret == 0, "SDL_BlitSurfaceScaled(%s), expected 0, got %d", SDL_GetPixelFormatName(tests[i].src_format), ret);
+
+        for (y = 0; y < actual->h; ++y) {
+            for (x = 0; x < actual->w; ++x) {
+                Uint8 r1, g1, b1, a1, r2, g2, b2, a2;
+                SDL_ReadSurfacePixel(expected, x, y, &r1, &g1, &b1, &a1);
+                SDL_ReadSurfacePixel(actual, x, y, &r2, &g2, &b2, &a2);
+                /* The SIMD scalers may round differently by 1 */
+                if (SDL_abs(r1 - r2) > 1 || SDL_abs(g1 - g2) > 1 || SDL_abs(b1 - b2) > 1 || SDL_abs(a1 - a2) > 1) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Check %s to %s scaled conversion, expected 0 mismatched pixels, got %d",
+                            SDL_GetPixelFormatName(tests[i].src_format), SDL_GetPixelFormatName(tests[i].dst_format), mismatches);
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(converted);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+    }
+    return TEST_COMPLETED;
+}
+
+/* The fraction of destination pixel i that source pixel j covers when reducing src_n pixels to dst_n */
+static double AreaCoverage(int i, int j, int src_n, int dst_n)
+{
+    const double scale = (double)src_n / dst_n;
+    const double left = SDL_max(i * scale, (double)j);
+    const double right = SDL_min((i + 1) * scale, (double)(j + 1));
+
+    return (right > left) ? (right - left) / scale : 0.0;
+}
+
+static int surface_testScaleBest(void *arg)
+{
+    SDL_Surface *src, *dst;
+    int x, y, i, j, ret;
+    int min_value = 255, max_value = 0;
+    double max_error = 0.0;
+    Uint8 r, g, b, a;
+    Uint64 seed = 1;
+    SDL_bool solid = SDL_TRUE;
+
+    /* Reducing a checkerboard should average it to gray without aliasing */
+    src = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_XRGB8888);
+    dst = SDL_CreateSurface(21, 13, SDL_PIXELFORMAT_RGB565);
+    SDLTest_AssertCheck(src && dst, "Create surfaces");
+    if (!src || !dst) {
+        goto done;
+    }
+    for (y = 0; y < src->h; ++y) {
+        for (x = 0; x < src->w; ++x) {
+            Uint8 v = ((x ^ y) & 1) ? 255 : 0;
+            SDL_WriteSurfacePixel(src, x, y, v, v, v, 255);
+        }
+    }
+    ret = SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_BEST);
+    SDLTest_AssertCheck(ret == 0, "SDL_BlitSurfaceScaled(SDL_SCALEMODE_BEST), expected 0, got %d", ret);
+    for (y = 0; y < dst->h; ++y) {
+        for (x = 0; x < dst->w; ++x) {
+            SDL_ReadSurfacePixel(dst, x, y, &r, &g, &b, &a);
+            min_value = SDL_min(min_value, g);
+            max_value = SDL_max(max_value, g);
+        }
+    }
+    SDLTest_AssertCheck(min_value >= 96 && max_value <= 160, "Check reduced checkerboard, expected values in 96-160, got %d-%d", min_value, max_value);
+    SDL_DestroySurface(dst);
+
+    /* Enlarging a solid color should keep it unchanged */
+    SDL_FillSurfaceRect(src, NULL, SDL_MapSurfaceRGB(src, 10, 128, 240));
+    dst = SDL_CreateSurface(100, 150, SDL_PIXELFORMAT_ABGR8888);
+    SDLTest_AssertCheck(dst != NULL, "Create surface");
+    if (!dst) {
+        goto done;
+    }
+    ret = SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_BEST);
+    SDLTest_AssertCheck(ret == 0, "SDL_BlitSurfaceScaled(SDL_SCALEMODE_BEST), expected 0, got %d", ret);
+    for (y = 0; y < dst->h; ++y) {
+        for (x = 0; x < dst->w; ++x) {
+            SDL_ReadSurfacePixel(dst, x, y, &r, &g, &b, &a);
+            if (r != 10 || g != 128 || b != 240 || a != 255) {
+                solid = SDL_FALSE;
+            }
+        }
+    }
+    SDLTest_AssertCheck(solid, "Check enlarged solid color is unchanged");
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+
+    /* The color of transparent pixels shouldn't bleed into the reduced result */
+    src = SDL_CreateSurface(4, 4, SDL_PIXELFORMAT_ARGB8888);
+    dst = SDL_CreateSurface(1, 1, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src && dst, "Create surfaces");
+    if (!src || !dst) {
+        goto done;
+    }
+    for (y = 0; y < src->h; ++y) {
+        for (x = 0; x < src->w; ++x) {
+            if (x < 2) {
+                SDL_WriteSurfacePixel(src, x, y, 255, 0, 0, 255);
+            } else {
+                SDL_WriteSurfacePixel(src, x, y, 0, 255, 0, 0);
+            }
+        }
+    }
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    ret = SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_BEST);
+    SDLTest_AssertCheck(ret == 0, "SDL_BlitSurfaceScaled(SDL_SCALEMODE_BEST), expected 0, got %d", ret);
+    SDL_ReadSurfacePixel(dst, 0, 0, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 255 && g == 0 && b == 0 && (a == 127 || a == 128),
+                        "Check reduced half transparent pixel, expected 255,0,0,128, got %d,%d,%d,%d", r, g, b, a);
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+
+    /* Reducing by fractional amounts should match the exact area average of the source */
+    src = SDL_CreateSurface(37, 23, SDL_PIXELFORMAT_XRGB8888);
+    dst = SDL_CreateSurface(11, 7, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(src && dst, "Create surfaces");
+    if (!src || !dst) {
+        goto done;
+    }
+    for (y = 0; y < src->h; ++y) {
+        for (x = 0; x < src->w; ++x) {
+            SDL_WriteSurfacePixel(src, x, y, (Uint8)SDL_rand_bits_r(&seed), (Uint8)SDL_rand_bits_r(&seed), (Uint8)SDL_rand_bits_r(&seed), 255);
+        }
+    }
+    ret = SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_BEST);
+    SDLTest_AssertCheck(ret == 0, "SDL_BlitSurfaceScaled(SDL_SCALEMODE_BEST), expected 0, got %d", ret);
+    for (y = 0; y < dst->h; ++y) {
+        for (x = 0; x < dst->w; ++x) {
+            double expected[3] = { 0.0, 0.0, 0.0 };
+            Uint8 actual[3];
+
+            for (j = 0; j < src->h; ++j) {
+                const double coverage_y = AreaCoverage(y, j, src->h, dst->h);
+                if (coverage_y == 0.0) {
+                    continue;
+                }
+                for (i = 0; i < src->w; ++i) {
+                    const double coverage = coverage_y * AreaCoverage(x, i, src->w, dst->w);
+                    SDL_ReadSurfacePixel(src, i, j, &r, &g, &b, &a);
+                    expected[0] += coverage * r;
+                    expected[1] += coverage * g;
+                    expected[2] += coverage * b;
+                }
+            }
+            SDL_ReadSurfacePixel(dst, x, y, &actual[0], &actual[1], &actual[2], &a);
+            for (i = 0; i < 3; ++i) {
+                max_error = SDL_max(max_error, SDL_fabs(actual[i] - expected[i]));
+            }
+        }
+    }
+    SDLTest_AssertCheck(max_error < 1.0, "Check reduced pixels against the area average, expected error < 1, got %g", max_error);
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+    return TEST_COMPLETED;
+}
+
+static int surface_testMipmaps(void *arg)
+{
+    SDL_Surface *surface, *mipmap, *dst;
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    Uint8 r2, g2, b2, a2;
+    int x, y, ret;
+    int mismatches = 0;
+
+    surface = SDL_CreateSurface(64, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+
+    /* One opaque red pixel in each 2x2 block, the rest transparent green */
+    for (y = 0; y < surface->h; ++y) {
+        for (x = 0; x < surface->w; ++x) {
+            if ((x & 1) == 0 && (y & 1) == 0) {
+                SDL_WriteSurfacePixel(surface, x, y, 255, 0, 0, 255);
+            } else {
+                SDL_WriteSurfacePixel(surface, x, y, 0, 255, 0, 0);
+            }
+        }
+    }
+
+    mipmap = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(mipmap == NULL, "Check SDL_GetSurfaceMipmap() before generating mipmaps, expected NULL, got %p", (void *)mipmap);
+
+    ret = SDL_GenerateSurfaceMipmaps(surface);
+    SDLTest_AssertCheck(ret == 0, "SDL_GenerateSurfaceMipmaps(), expected 0, got %d", ret);
+
+    mipmap = SDL_GetSurfaceMipmap(surface, 0);
+    SDLTest_AssertCheck(mipmap == surface, "Check mipmap level 0 is the surface");
+    mipmap = SDL_GetSurfaceMipmap(surface, 6);
+    SDLTest_AssertCheck(mipmap && mipmap->w == 1 && mipmap->h == 1, "Check mipmap level 6 is 1x1");
+    mipmap = SDL_GetSurfaceMipmap(surface, 7);
+    SDLTest_AssertCheck(mipmap == NULL, "Check mipmap level 7 doesn't exist");
+
+    mipmap = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(mipmap && mipmap->w == 32 && mipmap->h == 16 && mipmap->format == surface->format, "Check mipmap level 1 is 32x16");
+    if (mipmap) {
+        /* Transparent pixels shouldn't bleed their color into the result */
+        SDL_ReadSurfacePixel(mipmap, 5, 5, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 255 && g == 0 && b == 0 && a == 64, "Check alpha weighted average, expected 255,0,0,64, got %d,%d,%d,%d", r, g, b, a);
+    }
+
+    /* Scaled blits should use the closest mipmap */
+    dst = SDL_CreateSurface(8, 4, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(dst != NULL, "SDL_CreateSurface()");
+    mipmap = SDL_GetSurfaceMipmap(surface, 3);
+    if (dst && mipmap) {
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+        ret = SDL_BlitSurfaceScaled(surface, NULL, dst, NULL, SDL_SCALEMODE_LINEAR);
+        SDLTest_AssertCheck(ret == 0, "SDL_BlitSurfaceScaled(), expected 0, got %d", ret);
+        for (y = 0; y < dst->h; ++y) {
+            for (x = 0; x < dst->w; ++x) {
+                SDL_ReadSurfacePixel(dst, x, y, &r, &g, &b, &a);
+                SDL_ReadSurfacePixel(mipmap, x, y, &r2, &g2, &b2, &a2);
+                if (r != r2 || g != g2 || b != b2 || a != a2) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Check scaled blit matches mipmap level 3, expected 0 mismatches, got %d", mismatches);
+
+        /* The blit uses the settings of the surface without changing the mipmap */
+        SDL_GetSurfaceBlendMode(mipmap, &blendMode);
+        SDLTest_AssertCheck(blendMode == SDL_BLENDMODE_BLEND, "Check mipmap blend mode is unchanged, expected SDL_BLENDMODE_BLEND, got 0x%.8" SDL_PRIx32, blendMode);
+    }
+    SDL_DestroySurface(dst);
+
+    SDL_RemoveSurfaceMipmaps(surface);
+    mipmap = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(mipmap == NULL, "Check SDL_GetSurfaceMipmap() after removing mipmaps, expected NULL, got %p", (void *)mipmap);
+
+    /* Changing the pixels marks the mipmaps out of date until they are generated again */
+    SDL_GenerateSurfaceMipmaps(surface);
+    SDL_FillSurfaceRect(surface, NULL, 0);
+    mipmap = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(mipmap == NULL, "Check SDL_GetSurfaceMipmap() after SDL_FillSurfaceRect(), expected NULL, got %p", (void *)mipmap);
+    SDL_GenerateSurfaceMipmaps(surface);
+    SDL_LockSurface(surface);
+    mipmap = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(mipmap != NULL, "Check SDL_GetSurfaceMipmap() while locked, expected non-NULL");
+    SDL_UnlockSurface(surface);
+    mipmap = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(mipmap == NULL, "Check SDL_GetSurfaceMipmap() after SDL_UnlockSurface(), expected NULL, got %p", (void *)mipmap);
+
+    /* Reading the pixels or blitting from the surface keeps the mipmaps */
+    SDL_GenerateSurfaceMipmaps(surface);
+    SDL_ReadSurfacePixel(surface, 0, 0, &r, &g, &b, &a);
+    dst = SDL_CreateSurface(8, 4, SDL_PIXELFORMAT_ARGB8888);
+    if (dst) {
+        SDL_BlitSurfaceScaled(surface, NULL, dst, NULL, SDL_SCALEMODE_LINEAR);
+        SDL_DestroySurface(dst);
+    }
+    mipmap = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(mipmap != NULL, "Check SDL_GetSurfaceMipmap() after reading the surface, expected non-NULL");
+
+    /* Generating them again refills the existing levels */
+    SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGB(surface, 200, 100, 50));
+    ret = SDL_GenerateSurfaceMipmaps(surface);
+    SDLTest_AssertCheck(ret == 0, "SDL_GenerateSurfaceMipmaps(), expected 0, got %d", ret);
+    dst = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(dst == mipmap, "Check mipmap level 1 was reused");
+    if (dst) {
+        SDL_ReadSurfacePixel(dst, 5, 5, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 200 && g == 100 && b == 50, "Check regenerated mipmap, expected 200,100,50, got %d,%d,%d", r, g, b);
+    }
+    SDL_DestroySurface(surface);
+
+    /* The last row and column of an odd size are included in the average */
+    surface = SDL_CreateSurface(3, 3, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    SDL_FillSurfaceRect(surface, NULL, 0);
+    SDL_WriteSurfacePixel(surface, 2, 2, 180, 90, 45, 255);
+    ret = SDL_GenerateSurfaceMipmaps(surface);
+    SDLTest_AssertCheck(ret == 0, "SDL_GenerateSurfaceMipmaps(), expected 0, got %d", ret);
+    mipmap = SDL_GetSurfaceMipmap(surface, 1);
+    SDLTest_AssertCheck(mipmap && mipmap->w == 1 && mipmap->h == 1, "Check mipmap level 1 is 1x1");
+    if (mipmap) {
+        SDL_ReadSurfacePixel(mipmap, 0, 0, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 20 && g == 10 && b == 5, "Check 3x3 average, expected 20,10,5, got %d,%d,%d", r, g, b);
+    }
+    SDL_DestroySurface(surface);
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testBlendKernels(void *arg)
+{
+    static const struct
+    {
+        SDL_PixelFormat src_format;
+        SDL_PixelFormat dst_format;
+        SDL_BlendMode blendMode;
+        Uint8 alphaMod;
+    } tests[] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_BLENDMODE_BLEND, 255 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_BLEND, 255 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND_PREMULTIPLIED, 255 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND_PREMULTIPLIED, 255 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, SDL_BLENDMODE_BLEND_PREMULTIPLIED, 255 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_BLEND, 100 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND, 77 },
+    };
+    Uint64 seed = 0x5eed;
+    int i, x, y, ret;
+
+    /* The blend kernels should match the reference per pixel formula, including the unaligned tails */
+    for (i = 0; i < SDL_arraysize(tests); ++i) {
+        SDL_Surface *src = SDL_CreateSurface(67, 5, tests[i].src_format);
+        SDL_Surface *dst = SDL_CreateSurface(67, 5, tests[i].dst_format);
+        SDL_Surface *orig = NULL;
+        SDL_bool dst_alpha = SDL_ISPIXELFORMAT_ALPHA(tests[i].dst_format);
+        int mismatches = 0;
+
+        SDLTest_AssertCheck(src && dst, "Create %s and %s surfaces",
+                            SDL_GetPixelFormatName(tests[i].src_format), SDL_GetPixelFormatName(tests[i].dst_format));
+        if (!src || !dst) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            continue;
+        }
+
+        for (y = 0; y < src->h; ++y) {
+            for (x = 0; x < src->w; ++x) {
+                Uint8 a = (Uint8)SDL_rand_bits_r(&seed);
+                Uint8 r = (Uint8)SDL_rand_bits_r(&seed);
+                Uint8 g = (Uint8)SDL_rand_bits_r(&seed);
+                Uint8 b = (Uint8)SDL_rand_bits_r(&seed);
+                if (tests[i].blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+                    r = (Uint8)(r * a / 255);
+                    g = (Uint8)(g * a / 255);
+                    b = (Uint8)(b * a / 255);
+                }
+                SDL_WriteSurfacePixel(src, x, y, r, g, b, a);
+                SDL_WriteSurfacePixel(dst, x, y, (Uint8)SDL_rand_bits_r(&seed), (Uint8)SDL_rand_bits_r(&seed),
+                                      (Uint8)SDL_rand_bits_r(&seed), (Uint8)SDL_rand_bits_r(&seed));
+            }
+        }
+        orig = SDL_DuplicateSurface(dst);
+        SDLTest_AssertCheck(orig != NULL, "SDL_DuplicateSurface()");
+
+        SDL_SetSurfaceBlendMode(src, tests[i].blendMode);
+        SDL_SetSurfaceAlphaMod(src, tests[i].alphaMod);
+        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "SDL_BlitSurface(), expected 0, got %d", ret);
+
+        for (y = 0; orig && y < dst->h; ++y) {
+            for (x = 0; x < dst->w; ++x) {
+                Uint8 s[4], d[4], out[4];
+                int c, expected[4];
+
+                SDL_ReadSurfacePixel(src, x, y, &s[0], &s[1], &s[2], &s[3]);
+                SDL_ReadSurfacePixel(orig, x, y, &d[0], &d[1], &d[2], &d[3]);
+                SDL_ReadSurfacePixel(dst, x, y, &out[0], &out[1], &out[2], &out[3]);
+                if (tests[i].alphaMod != 255) {
+                    s[3] = tests[i].alphaMod;
+                }
+                for (c = 0; c < 4; ++c) {
+                    if (tests[i].blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+                        int v = d[c] * (255 - s[3]) + 1;
+                        expected[c] = SDL_min(s[c] + ((v + (v >> 8)) >> 8), 255);
+                    } else {
+                        int v = (c == 3 ? 255 : s[c]) * s[3] + d[c] * (255 - s[3]) + 1;
+                        expected[c] = (v + (v >> 8)) >> 8;
+                    }
+                }
+                if (!dst_alpha) {
+                    expected[3] = 255;
+                } else if (tests[i].alphaMod != 255) {
+                    expected[3] = 255;
+                }
+                for (c = 0; c < 4; ++c) {
+                    if (out[c] != expected[c]) {
+                        ++mismatches;
+                        break;
+                    }
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Check %s to %s blend mode 0x%x, expected 0 mismatched pixels, got %d",
+                            SDL_GetPixelFormatName(tests[i].src_format), SDL_GetPixelFormatName(tests[i].dst_format),
+                            tests[i].blendMode, mismatches);
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        SDL_DestroySurface(orig);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testPrepareRLE(void *arg)
+{
+    static const SDL_BlendMode modes[] = { SDL_BLENDMODE_BLEND, SDL_BLENDMODE_BLEND_PREMULTIPLIED };
+    Uint64 seed = 0x12e;
+    int i, m, x, y, ret;
+
+    for (m = 0; m < SDL_arraysize(modes); ++m) {
+        SDL_Surface *sprite = SDL_CreateSurface(67, 9, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *encoded = NULL;
+        SDL_Surface *expected = SDL_CreateSurface(80, 12, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *actual = SDL_CreateSurface(80, 12, SDL_PIXELFORMAT_ARGB8888);
+        /* Unclipped, and clipped on the left and right edges */
+        const SDL_Rect rects[] = { { 3, 1, 0, 0 }, { -5, 2, 0, 0 }, { 40, 0, 0, 0 } };
+        const int tolerance = (modes[m] == SDL_BLENDMODE_BLEND) ? 2 : 0;
+        int mismatches = 0;
+
+        SDLTest_AssertCheck(sprite && expected && actual, "Create surfaces");
+        if (!sprite || !expected || !actual) {
+            SDL_DestroySurface(sprite);
+            SDL_DestroySurface(expected);
+            SDL_DestroySurface(actual);
+            continue;
+        }
+
+        /* A sprite with transparent, opaque and translucent runs */
+        for (y = 0; y < sprite->h; ++y) {
+            for (x = 0; x < sprite->w; ++x) {
+                Uint8 a = (x / 7 + y) % 3 == 0 ? 0 : ((x / 7 + y) % 3 == 1 ? 255 : (Uint8)SDL_rand_r(&seed, 256));
+                Uint8 r = (Uint8)SDL_rand_bits_r(&seed);
+                Uint8 g = (Uint8)SDL_rand_bits_r(&seed);
+                Uint8 b = (Uint8)SDL_rand_bits_r(&seed);
+                if (modes[m] == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+                    r = (Uint8)(r * a / 255);
+                    g = (Uint8)(g * a / 255);
+                    b = (Uint8)(b * a / 255);
+                }
+                SDL_WriteSurfacePixel(sprite, x, y, r, g, b, a);
+            }
+        }
+        encoded = SDL_DuplicateSurface(sprite);
+        SDLTest_AssertCheck(encoded != NULL, "SDL_DuplicateSurface()");
+        if (!encoded) {
+            SDL_DestroySurface(sprite);
+            SDL_DestroySurface(expected);
+            SDL_DestroySurface(actual);
+            continue;
+        }
+        SDL_SetSurfaceBlendMode(sprite, modes[m]);
+        SDL_SetSurfaceBlendMode(encoded, modes[m]);
+
+        ret = SDL_PrepareSurfaceRLE(encoded, actual);
+        SDLTest_AssertCheck(ret == 0, "SDL_PrepareSurfaceRLE(), expected 0, got %d", ret);
+        SDLTest_AssertCheck(SDL_SurfaceHasRLE(encoded), "SDL_SurfaceHasRLE(), expected SDL_TRUE");
+
+        SDL_FillSurfaceRect(expected, NULL, SDL_MapSurfaceRGBA(expected, 40, 80, 120, 255));
+        SDL_FillSurfaceRect(actual, NULL, SDL_MapSurfaceRGBA(actual, 40, 80, 120, 255));
+        for (i = 0; i < SDL_arraysize(rects); ++i) {
+            SDL_Rect rect = rects[i];
+            SDL_BlitSurface(sprite, NULL, expected, &rect);
+            rect = rects[i];
+            SDL_BlitSurface(encoded, NULL, actual, &rect);
+        }
+
+        for (y = 0; y < actual->h; ++y) {
+            for (x = 0; x < actual->w; ++x) {
+                Uint8 r1, g1, b1, a1, r2, g2, b2, a2;
+                SDL_ReadSurfacePixel(expected, x, y, &r1, &g1, &b1, &a1);
+                SDL_ReadSurfacePixel(actual, x, y, &r2, &g2, &b2, &a2);
+                if (SDL_abs(r1 - r2) > tolerance || SDL_abs(g1 - g2) > tolerance || SDL_abs(b1 - b2) > tolerance) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Check RLE blit with blend mode 0x%x, expected 0 mismatched pixels, got %d", modes[m], mismatches);
+
+        SDL_DestroySurface(sprite);
+        SDL_DestroySurface(encoded);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+    }
+
+    /* Blend modes that RLE can't accelerate are an error */
+    {
+        SDL_Surface *sprite = SDL_CreateSurface(8, 8, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *dst = SDL_CreateSurface(8, 8, SDL_PIXELFORMAT_ARGB8888);
+
+        SDL_SetSurfaceBlendMode(sprite, SDL_BLENDMODE_ADD);
+        ret = SDL_PrepareSurfaceRLE(sprite, dst);
+        SDLTest_AssertCheck(ret < 0, "SDL_PrepareSurfaceRLE() with additive blending, expected < 0, got %d", ret);
+
+        SDL_DestroySurface(sprite);
+        SDL_DestroySurface(dst);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testPremultiplyLarge(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888,
+        SDL_PIXELFORMAT_BGRA8888,
+    };
+    static const char *threads[] = { "1", "4" };
+    Uint64 seed = 0x38;
+    int i, t, x, y, ret;
+
+    for (t = 0; t < SDL_arraysize(threads); ++t) {
+        SDL_SetHint(SDL_HINT_SURFACE_THREADS, threads[t]);
+
+        for (i = 0; i < SDL_arraysize(formats); ++i) {
+            /* Large enough to be split across threads, with an odd width for the SIMD tails */
+            SDL_Surface *surface = SDL_CreateSurface(1031, 1029, formats[i]);
+            SDL_Surface *orig;
+            int mismatches = 0;
+
+            SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+            if (!surface) {
+                continue;
+            }
+            for (y = 0; y < surface->h; ++y) {
+                Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+                for (x = 0; x < surface->w; ++x) {
+                    row[x] = SDL_rand_bits_r(&seed);
+                }
+            }
+            orig = SDL_DuplicateSurface(surface);
+            SDLTest_AssertCheck(orig != NULL, "SDL_DuplicateSurface()");
+            if (!orig) {
+                SDL_DestroySurface(surface);
+                continue;
+            }
+
+            ret = SDL_PremultiplySurfaceAlpha(surface, SDL_FALSE);
+            SDLTest_AssertCheck(ret == 0, "SDL_PremultiplySurfaceAlpha(%s) with %s threads, expected 0, got %d",
+                                SDL_GetPixelFormatName(formats[i]), threads[t], ret);
+
+            for (y = 0; y < surface->h; ++y) {
+                for (x = 0; x < surface->w; ++x) {
+                    Uint8 r, g, b, a, r2, g2, b2, a2;
+                    SDL_ReadSurfacePixel(orig, x, y, &r, &g, &b, &a);
+                    SDL_ReadSurfacePixel(surface, x, y, &r2, &g2, &b2, &a2);
+                    if (r2 != r * a / 255 || g2 != g * a / 255 || b2 != b * a / 255 || a2 != a) {
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Check %s premultiplied pixels with %s threads, expected 0 mismatches, got %d",
+                                SDL_GetPixelFormatName(formats[i]), threads[t], mismatches);
+
+            SDL_DestroySurface(surface);
+            SDL_DestroySurface(orig);
+        }
+
+        /* Clearing a float surface replicates the converted color */
+        {
+            SDL_Surface *surface = SDL_CreateSurface(1030, 1025, SDL_PIXELFORMAT_RGBA128_FLOAT);
+            int mismatches = 0;
+
+            SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+            if (surface) {
+                ret = SDL_ClearSurface(surface, 0.25f, 0.5f, 0.75f, 1.0f);
+                SDLTest_AssertCheck(ret == 0, "SDL_ClearSurface() with %s threads, expected 0, got %d", threads[t], ret);
+                for (y = 0; y < surface->h; ++y) {
+                    const float *row = (const float *)((Uint8 *)surface->pixels + y * surface->pitch);
+                    for (x = 0; x < surface->w; ++x) {
+                        if (row[x * 4 + 0] != 0.25f || row[x * 4 + 1] != 0.5f || row[x * 4 + 2] != 0.75f || row[x * 4 + 3] != 1.0f) {
+                            ++mismatches;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Check cleared pixels with %s threads, expected 0 mismatches, got %d", threads[t], mismatches);
+                SDL_DestroySurface(surface);
+            }
+        }
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_THREADS);
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testBitmapRoundTrip(void *arg)
+{
+    static const struct
+    {
+        SDL_PixelFormat format;
+        int w, h;
+    } tests[] = {
+        { SDL_PIXELFORMAT_XRGB8888, 33, 7 },   /* converted to 24-bit in bands */
+        { SDL_PIXELFORMAT_ARGB8888, 17, 5 },   /* converted to 32-bit in bands */
+        { SDL_PIXELFORMAT_RGB565, 1023, 300 }, /* several bands, padded rows */
+        { SDL_PIXELFORMAT_BGR24, 35, 3 },      /* written directly */
+        { SDL_PIXELFORMAT_INDEX8, 13, 4 },     /* written directly with a palette */
+    };
+    Uint64 seed = 0x39;
+    int i, x, y, ret;
+
+    for (i = 0; i < SDL_arraysize(tests); ++i) {
+        SDL_Surface *surface = SDL_CreateSurface(tests[i].w, tests[i].h, tests[i].format);
+        SDL_Surface *loaded = NULL;
+        SDL_IOStream *io = SDL_IOFromDynamicMem();
+        Sint64 size;
+        int mismatches = 0;
+
+        SDLTest_AssertCheck(surface && io, "Create surface and stream");
+        if (!surface || !io) {
+            SDL_DestroySurface(surface);
+            SDL_CloseIO(io);
+            continue;
+        }
+        if (SDL_ISPIXELFORMAT_INDEXED(tests[i].format)) {
+            SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
+            for (x = 0; x < palette->ncolors; ++x) {
+                palette->colors[x].r = (Uint8)x;
+                palette->colors[x].g = (Uint8)(255 - x);
+                palette->colors[x].b = (Uint8)(x * 3);
+            }
+        }
+        for (y = 0; y < surface->h; ++y) {
+            Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+            for (x = 0; x < surface->w * SDL_BYTESPERPIXEL(tests[i].format); ++x) {
+                row[x] = (Uint8)SDL_rand_bits_r(&seed);
+            }
+        }
+
+        ret = SDL_SaveBMP_IO(surface, io, SDL_FALSE);
+        SDLTest_AssertCheck(ret == 0, "SDL_SaveBMP_IO(%s), expected 0, got %d", SDL_GetPixelFormatName(tests[i].format), ret);
+        size = SDL_TellIO(io);
+        SDLTest_AssertCheck(size == SDL_GetIOSize(io), "Check stream position is at the end of the file");
+        SDL_SeekIO(io, 0, SDL_IO_SEEK_SET);
+        loaded = SDL_LoadBMP_IO(io, SDL_TRUE);
+        SDLTest_AssertCheck(loaded != NULL, "SDL_LoadBMP_IO()");
+        if (loaded) {
+            SDLTest_AssertCheck(loaded->w == surface->w && loaded->h == surface->h, "Check loaded size, expected %dx%d, got %dx%d",
+                                surface->w, surface->h, loaded->w, loaded->h);
+            for (y = 0; y < surface->h && y < loaded->h; ++y) {
+                for (x = 0; x < surface->w && x < loaded->w; ++x) {
+                    Uint8 r1, g1, b1, a1, r2, g2, b2, a2;
+                    SDL_ReadSurfacePixel(surface, x, y, &r1, &g1, &b1, &a1);
+                    SDL_ReadSurfacePixel(loaded, x, y, &r2, &g2, &b2, &a2);
+                    if (r1 != r2 || g1 != g2 || b1 != b2 || a1 != a2) {
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Check %s round trip, expected 0 mismatched pixels, got %d",
+                                SDL_GetPixelFormatName(tests[i].format), mismatches);
+        }
+
+        SDL_DestroySurface(surface);
+        SDL_DestroySurface(loaded);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testFillRects(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_INDEX8,
+        SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_ARGB8888,
+    };
+    /* Odd offsets and sizes for the vector heads and tails, and a fill
+       large enough to use non-temporal stores */
+    static const SDL_Rect rects[] = {
+        { 0, 0, 1, 1 }, { 1, 1, 3, 2 }, { 5, 3, 61, 3 }, { 3, 7, 130, 4 },
+        { 7, 12, 257, 5 }, { 1, 20, 1021, 2 }, { 2, 30, 1200, 1000 }
+    };
+    const Uint32 colors[] = { 0x01, 0xABCD, 0x123456, 0x89ABCDEF };
+    int i, r, x, y, ret;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        const int bpp = SDL_BYTESPERPIXEL(formats[i]);
+        const Uint32 mask = (bpp == 4) ? 0xFFFFFFFF : ((1u << (bpp * 8)) - 1);
+        SDL_Surface *surface = SDL_CreateSurface(1210, 1040, formats[i]);
+
+        SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface(%s)", SDL_GetPixelFormatName(formats[i]));
+        if (!surface) {
+            continue;
+        }
+
+        for (r = 0; r < SDL_arraysize(rects); ++r) {
+            const Uint32 color = colors[r % SDL_arraysize(colors)] & mask;
+            int mismatches = 0;
+
+            SDL_memset(surface->pixels, 0, (size_t)surface->h * surface->pitch);
+            ret = SDL_FillSurfaceRect(surface, &rects[r], color);
+            SDLTest_AssertCheck(ret == 0, "SDL_FillSurfaceRect(), expected 0, got %d", ret);
+
+            /* Check the rectangle and a pixel around it */
+            for (y = SDL_max(rects[r].y - 1, 0); y <= rects[r].y + rects[r].h && y < surface->h; ++y) {
+                const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+                for (x = SDL_max(rects[r].x - 1, 0); x <= rects[r].x + rects[r].w && x < surface->w; ++x) {
+                    const SDL_bool inside = (x >= rects[r].x && x < rects[r].x + rects[r].w &&
+                                             y >= rects[r].y && y < rects[r].y + rects[r].h);
+                    Uint32 pixel = 0;
+                    switch (bpp) {
+                    case 1:
+                        pixel = row[x];
+                        break;
+                    case 2:
+                        pixel = ((const Uint16 *)row)[x];
+                        break;
+                    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                        pixel = row[x * 3] | (row[x * 3 + 1] << 8) | (row[x * 3 + 2] << 16);
+#else
+                        pixel = (row[x * 3] << 16) | (row[x * 3 + 1] << 8) | row[x * 3 + 2];
+#endif
+                        break;
+                    case 4:
+                        pixel = ((const Uint32 *)row)[x];
+                        break;
+                    }
+                    if (pixel != (inside ? color : 0)) {
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Check %s fill of %dx%d at %d,%d, expected 0 mismatched pixels, got %d",
+                                SDL_GetPixelFormatName(formats[i]), rects[r].w, rects[r].h, rects[r].x, rects[r].y, mismatches);
+        }
+        SDL_DestroySurface(surface);
+    }
+
+    return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -1386,6 +2398,46 @@ static const SDLTest_TestCaseReference surfaceTestPremultiplyAlpha = {
     surface_testPremultiplyAlpha, "surface_testPremultiplyAlpha", "Test alpha premultiply operations.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestFloatConversion = {
+    surface_testFloatConversion, "surface_testFloatConversion", "Test float and colorspace conversion accuracy.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestFloatTransferAccuracy = {
+    surface_testFloatTransferAccuracy, "surface_testFloatTransferAccuracy", "Test float transfer functions against the exact functions.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestScaledConversion = {
+    surface_testScaledConversion, "surface_testScaledConversion", "Test scaling while converting formats.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestScaleBest = {
+    surface_testScaleBest, "surface_testScaleBest", "Test high quality scaling.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestMipmaps = {
+    surface_testMipmaps, "surface_testMipmaps", "Test surface mipmap generation.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlendKernels = {
+    surface_testBlendKernels, "surface_testBlendKernels", "Test the optimized alpha blending blitters.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestPrepareRLE = {
+    surface_testPrepareRLE, "surface_testPrepareRLE", "Test RLE encoding surfaces ahead of time.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestPremultiplyLarge = {
+    surface_testPremultiplyLarge, "surface_testPremultiplyLarge", "Test premultiplying and clearing large surfaces.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBitmapRoundTrip = {
+    surface_testBitmapRoundTrip, "surface_testBitmapRoundTrip", "Test saving and loading bitmaps in various formats.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestFillRects = {
+    surface_testFillRects, "surface_testFillRects", "Test filling rectangles of all pixel sizes.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestSaveLoadBitmap,
@@ -1409,6 +2461,16 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestPalette,
     &surfaceTestClearSurface,
     &surfaceTestPremultiplyAlpha,
+    &surfaceTestFloatConversion,
+    &surfaceTestFloatTransferAccuracy,
+    &surfaceTestScaledConversion,
+    &surfaceTestScaleBest,
+    &surfaceTestMipmaps,
+    &surfaceTestBlendKernels,
+    &surfaceTestPrepareRLE,
+    &surfaceTestPremultiplyLarge,
+    &surfaceTestBitmapRoundTrip,
+    &surfaceTestFillRects,
     NULL
 };
 
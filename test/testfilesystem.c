@@ -58,11 +58,510 @@ static int SDLCALL enum_callback(void *userdata, const char *origdir, const char
 }
 
 
+typedef struct EnumerateCounts
+{
+    int entries;
+    int mismatches;
+} EnumerateCounts;
+
+static int SDLCALL enum_info_callback(void *userdata, const char *origdir, const char *fname, const SDL_PathInfo *info)
+{
+    EnumerateCounts *counts = (EnumerateCounts *)userdata;
+    SDL_PathInfo statinfo;
+    char *fullpath = NULL;
+
+    if (SDL_asprintf(&fullpath, "%s/%s", origdir, fname) < 0) {
+        return -1;
+    }
+
+    /* The provided info should match asking for each entry separately */
+    if (SDL_GetPathInfo(fullpath, &statinfo) == 0 &&
+        (statinfo.type != info->type || (info->type == SDL_PATHTYPE_FILE && statinfo.size != info->size))) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Info for '%s' didn't match SDL_GetPathInfo()", fullpath);
+        counts->mismatches++;
+    }
+    counts->entries++;
+
+    SDL_free(fullpath);
+    return 1;
+}
+
+static int SDLCALL enum_count_callback(void *userdata, const char *origdir, const char *fname, const SDL_PathInfo *info)
+{
+    ((EnumerateCounts *)userdata)->entries++;
+    return 1;
+}
+
+/* The way a tree had to be walked before SDL_EnumerateDirectoryWithInfo(), for comparison */
+static int SDLCALL enum_stat_callback(void *userdata, const char *origdir, const char *fname)
+{
+    SDL_PathInfo info;
+    char *fullpath = NULL;
+
+    if (SDL_asprintf(&fullpath, "%s/%s", origdir, fname) < 0) {
+        return -1;
+    }
+    if (SDL_GetPathInfo(fullpath, &info) == 0) {
+        ((EnumerateCounts *)userdata)->entries++;
+        if (info.type == SDL_PATHTYPE_DIRECTORY) {
+            SDL_EnumerateDirectory(fullpath, enum_stat_callback, userdata);
+        }
+    }
+    SDL_free(fullpath);
+    return 1;
+}
+
+/* Time a recursive walk of the tree against the same walk with a stat per entry */
+static void BenchmarkEnumerate(const char *path)
+{
+    EnumerateCounts counts;
+    Uint64 start;
+
+    SDL_zero(counts);
+    start = SDL_GetTicksNS();
+    SDL_EnumerateDirectoryWithInfo(path, SDL_ENUMERATE_RECURSIVE, enum_count_callback, &counts);
+    SDL_Log("Enumerated %d entries recursively with info in %.1f ms", counts.entries, (SDL_GetTicksNS() - start) / 1000000.0);
+
+    SDL_zero(counts);
+    start = SDL_GetTicksNS();
+    SDL_EnumerateDirectory(path, enum_stat_callback, &counts);
+    SDL_Log("Enumerated %d entries recursively with SDL_GetPathInfo() in %.1f ms", counts.entries, (SDL_GetTicksNS() - start) / 1000000.0);
+}
+
+static void TestEnumerateWithInfo(const char *path)
+{
+    EnumerateCounts counts;
+
+    SDL_zero(counts);
+    if (SDL_EnumerateDirectoryWithInfo(path, 0, enum_info_callback, &counts) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_EnumerateDirectoryWithInfo('%s') failed: %s", path, SDL_GetError());
+    } else {
+        SDL_Log("Enumerated %d entries with info, %d mismatches", counts.entries, counts.mismatches);
+    }
+
+    SDL_zero(counts);
+    if (SDL_EnumerateDirectoryWithInfo(path, SDL_ENUMERATE_RECURSIVE, enum_info_callback, &counts) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Recursive SDL_EnumerateDirectoryWithInfo('%s') failed: %s", path, SDL_GetError());
+    } else {
+        SDL_Log("Enumerated %d entries recursively with info, %d mismatches", counts.entries, counts.mismatches);
+    }
+
+    BenchmarkEnumerate(path);
+}
+
+static void CreateEmptyFile(const char *path)
+{
+    SDL_IOStream *stream = SDL_IOFromFile(path, "wb");
+    if (stream) {
+        SDL_CloseIO(stream);
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_IOFromFile('%s', 'wb') failed: %s", path, SDL_GetError());
+    }
+}
+
+static void CheckGlob(const char *pattern, SDL_GlobFlags flags, int expected)
+{
+    int count = -1;
+    char **globlist = SDL_GlobDirectory("testfilesystem-glob", pattern, flags, &count);
+    if (!globlist) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GlobDirectory('%s') failed: %s", pattern ? pattern : "(null)", SDL_GetError());
+    } else if (count != expected) {
+        int i;
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GlobDirectory('%s', %s) found %d entries, expected %d", pattern ? pattern : "(null)",
+                     (flags & SDL_GLOB_CASEINSENSITIVE) ? "SDL_GLOB_CASEINSENSITIVE" : "0", count, expected);
+        for (i = 0; i < count; i++) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "    '%s'", globlist[i]);
+        }
+    }
+    SDL_free(globlist);
+}
+
+static void TestGlob(void)
+{
+    SDL_CreateDirectory("testfilesystem-glob");
+    SDL_CreateDirectory("testfilesystem-glob/Data");
+    SDL_CreateDirectory("testfilesystem-glob/Data/Levels");
+    SDL_CreateDirectory("testfilesystem-glob/data2");
+    CreateEmptyFile("testfilesystem-glob/Data/Levels/a.map");
+    CreateEmptyFile("testfilesystem-glob/Data/Levels/b.MAP");
+    CreateEmptyFile("testfilesystem-glob/Data/Levels/c.txt");
+    CreateEmptyFile("testfilesystem-glob/data2/x.map");
+    CreateEmptyFile("testfilesystem-glob/\xC3\x84rger.map");  /* U+00C4 LATIN CAPITAL LETTER A WITH DIAERESIS */
+
+    CheckGlob(NULL, 0, 8);
+    CheckGlob("*", 0, 3);
+    CheckGlob("*/*", 0, 2);
+    CheckGlob("Data/Levels/*.map", 0, 1);
+    CheckGlob("data/levels/*.map", 0, 0);
+    CheckGlob("data/levels/*.map", SDL_GLOB_CASEINSENSITIVE, 2);
+    CheckGlob("*/*.map", 0, 1);
+    CheckGlob("*/*/?.*", 0, 3);
+    CheckGlob("*.map", 0, 1);
+    CheckGlob("\xC3\xA4rger.MAP", SDL_GLOB_CASEINSENSITIVE, 1);
+    CheckGlob("?rger.map", 0, 0);  /* without case folding, '?' is a single byte */
+    CheckGlob("?rger.map", SDL_GLOB_CASEINSENSITIVE, 1);
+    CheckGlob("Data/", 0, 0);
+
+    SDL_RemovePath("testfilesystem-glob/\xC3\x84rger.map");
+    SDL_RemovePath("testfilesystem-glob/data2/x.map");
+    SDL_RemovePath("testfilesystem-glob/Data/Levels/c.txt");
+    SDL_RemovePath("testfilesystem-glob/Data/Levels/b.MAP");
+    SDL_RemovePath("testfilesystem-glob/Data/Levels/a.map");
+    SDL_RemovePath("testfilesystem-glob/data2");
+    SDL_RemovePath("testfilesystem-glob/Data/Levels");
+    SDL_RemovePath("testfilesystem-glob/Data");
+    SDL_RemovePath("testfilesystem-glob");
+}
+
+static void WriteZip16(SDL_IOStream *io, Uint16 value)
+{
+    SDL_WriteU16LE(io, value);
+}
+
+static void WriteZip32(SDL_IOStream *io, Uint32 value)
+{
+    SDL_WriteU32LE(io, value);
+}
+
+/* Write a zip file with stored entries, names ending in '/' are directories */
+static SDL_bool WriteTestZip(const char *path, const char **names, const char **contents, const Uint16 *methods, int count)
+{
+    SDL_IOStream *io = SDL_IOFromFile(path, "wb");
+    Uint32 *offsets = (Uint32 *)SDL_calloc(count, sizeof(*offsets));
+    Sint64 cd_offset;
+    int i;
+
+    if (!io || !offsets) {
+        SDL_CloseIO(io);
+        SDL_free(offsets);
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < count; i++) {
+        const Uint32 namelen = (Uint32)SDL_strlen(names[i]);
+        const Uint32 datalen = (Uint32)SDL_strlen(contents[i]);
+        offsets[i] = (Uint32)SDL_TellIO(io);
+        WriteZip32(io, 0x04034b50);
+        WriteZip16(io, 10);          /* version needed */
+        WriteZip16(io, 0);           /* flags */
+        WriteZip16(io, methods[i]);
+        WriteZip16(io, 0);           /* time */
+        WriteZip16(io, (44 << 9) | (6 << 5) | 15);  /* date, 2024-06-15 */
+        WriteZip32(io, 0);           /* crc, not checked */
+        WriteZip32(io, datalen);
+        WriteZip32(io, datalen);
+        WriteZip16(io, (Uint16)namelen);
+        WriteZip16(io, 4);           /* an empty extra field, so the data doesn't directly follow the name */
+        SDL_WriteIO(io, names[i], namelen);
+        WriteZip32(io, 0xCAFE);
+        SDL_WriteIO(io, contents[i], datalen);
+    }
+
+    cd_offset = SDL_TellIO(io);
+    for (i = 0; i < count; i++) {
+        const Uint32 namelen = (Uint32)SDL_strlen(names[i]);
+        const Uint32 datalen = (Uint32)SDL_strlen(contents[i]);
+        WriteZip32(io, 0x02014b50);
+        WriteZip16(io, 20);          /* version made by */
+        WriteZip16(io, 10);          /* version needed */
+        WriteZip16(io, 0);           /* flags */
+        WriteZip16(io, methods[i]);
+        WriteZip16(io, 0);           /* time */
+        WriteZip16(io, (44 << 9) | (6 << 5) | 15);  /* date */
+        WriteZip32(io, 0);           /* crc */
+        WriteZip32(io, datalen);
+        WriteZip32(io, datalen);
+        WriteZip16(io, (Uint16)namelen);
+        WriteZip16(io, 0);           /* extra */
+        WriteZip16(io, 0);           /* comment */
+        WriteZip16(io, 0);           /* disk */
+        WriteZip16(io, 0);           /* internal attributes */
+        WriteZip32(io, 0);           /* external attributes */
+        WriteZip32(io, offsets[i]);
+        SDL_WriteIO(io, names[i], namelen);
+    }
+
+    WriteZip32(io, 0x06054b50);
+    WriteZip16(io, 0);
+    WriteZip16(io, 0);
+    WriteZip16(io, (Uint16)count);
+    WriteZip16(io, (Uint16)count);
+    WriteZip32(io, (Uint32)(SDL_TellIO(io) - 12 - cd_offset));
+    WriteZip32(io, (Uint32)cd_offset);
+    WriteZip16(io, 7);
+    SDL_WriteIO(io, "comment", 7);
+
+    SDL_free(offsets);
+    return (SDL_CloseIO(io) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+static int SDLCALL count_callback(void *userdata, const char *dirname, const char *fname)
+{
+    (*(int *)userdata)++;
+    return 1;
+}
+
+static void CheckPackGlob(SDL_Storage *storage, const char *path, const char *pattern, int expected)
+{
+    int count = -1;
+    char **globlist = SDL_GlobStorageDirectory(storage, path, pattern, 0, &count);
+    if (!globlist) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GlobStorageDirectory('%s', '%s') failed: %s", path, pattern ? pattern : "(null)", SDL_GetError());
+    } else if (count != expected) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GlobStorageDirectory('%s', '%s') found %d entries, expected %d", path, pattern ? pattern : "(null)", count, expected);
+    }
+    SDL_free(globlist);
+}
+
+static void CheckPackFile(SDL_Storage *storage, const char *path, const char *expected)
+{
+    char buffer[64];
+    Uint64 size = 0;
+
+    SDL_zero(buffer);
+    if (SDL_GetStorageFileSize(storage, path, &size) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GetStorageFileSize('%s') failed: %s", path, SDL_GetError());
+    } else if (size != SDL_strlen(expected)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GetStorageFileSize('%s') returned %d, expected %d", path, (int)size, (int)SDL_strlen(expected));
+    } else if (SDL_ReadStorageFile(storage, path, buffer, size) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ReadStorageFile('%s') failed: %s", path, SDL_GetError());
+    } else if (SDL_strcmp(buffer, expected) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ReadStorageFile('%s') read '%s', expected '%s'", path, buffer, expected);
+    }
+}
+
+static void TestPackStorage(void)
+{
+    const char *zipname = "testfilesystem-pack.zip";
+    const char *names[] = { "readme.txt", "data/", "data/levels/one.map", "data/levels/two.map", "data/music/theme.ogg", "packed.bin" };
+    const char *contents[] = { "hello", "", "level one", "level two", "oggs", "deflated" };
+    const Uint16 methods[] = { 0, 0, 0, 0, 0, 8 };
+    SDL_Storage *storage;
+    SDL_PathInfo info;
+    Uint8 scratch[1];
+    int count = 0;
+
+    if (!WriteTestZip(zipname, names, contents, methods, SDL_arraysize(names))) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s: %s", zipname, SDL_GetError());
+        return;
+    }
+
+    storage = SDL_OpenTitleStorage(zipname, 0);
+    if (!storage) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_OpenTitleStorage('%s') failed: %s", zipname, SDL_GetError());
+        SDL_RemovePath(zipname);
+        return;
+    }
+
+    CheckPackFile(storage, "readme.txt", "hello");
+    CheckPackFile(storage, "/data/levels/two.map", "level two");
+    CheckPackFile(storage, "data/music/theme.ogg", "oggs");
+    if (SDL_GetStoragePathInfo(storage, "data/levels", &info) < 0 || info.type != SDL_PATHTYPE_DIRECTORY) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Implied directory 'data/levels' is missing from the pack");
+    }
+    if (SDL_GetStoragePathInfo(storage, "data/missing.map", &info) == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GetStoragePathInfo('data/missing.map') should have failed");
+    }
+    if (SDL_ReadStorageFile(storage, "packed.bin", scratch, sizeof(scratch)) == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Reading a compressed entry should have failed");
+    }
+
+    SDL_EnumerateStorageDirectory(storage, "", count_callback, &count);
+    if (count != 3) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Enumerating the pack root found %d entries, expected 3", count);
+    }
+    count = 0;
+    SDL_EnumerateStorageDirectory(storage, "data/", count_callback, &count);
+    if (count != 2) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Enumerating 'data/' in the pack found %d entries, expected 2", count);
+    }
+
+    CheckPackGlob(storage, "", NULL, 8);
+    CheckPackGlob(storage, "", "data/*/*.map", 2);
+    CheckPackGlob(storage, "data", "*/t*", 2);
+
+    SDL_CloseStorage(storage);
+    SDL_RemovePath(zipname);
+}
+
+static void CheckCacheCounts(SDL_Storage *storage, const char *what, Sint64 hits, Sint64 misses)
+{
+    const SDL_PropertiesID props = SDL_GetStorageProperties(storage);
+    const Sint64 actual_hits = SDL_GetNumberProperty(props, SDL_PROP_STORAGE_CACHE_HITS_NUMBER, -1);
+    const Sint64 actual_misses = SDL_GetNumberProperty(props, SDL_PROP_STORAGE_CACHE_MISSES_NUMBER, -1);
+    if (actual_hits != hits || actual_misses != misses) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: cache has %d hits and %d misses, expected %d and %d", what,
+                     (int)actual_hits, (int)actual_misses, (int)hits, (int)misses);
+    }
+}
+
+static void CheckCachedRead(SDL_Storage *storage, const char *path, const char *expected)
+{
+    char buffer[32];
+
+    SDL_zero(buffer);
+    if (SDL_ReadStorageFile(storage, path, buffer, SDL_strlen(expected)) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ReadStorageFile('%s') failed: %s", path, SDL_GetError());
+    } else if (SDL_strcmp(buffer, expected) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ReadStorageFile('%s') read '%s', expected '%s'", path, buffer, expected);
+    }
+}
+
+static void TestCachedStorage(void)
+{
+    const char *dir = "testfilesystem-cache";
+    SDL_Storage *storage;
+    SDL_IOStream *io;
+    Uint8 scratch[1];
+
+    SDL_CreateDirectory(dir);
+    storage = SDL_CreateCachedStorage(SDL_OpenFileStorage(dir), 10, SDL_TRUE);
+    if (!storage) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateCachedStorage() failed: %s", SDL_GetError());
+        SDL_RemovePath(dir);
+        return;
+    }
+
+    SDL_WriteStorageFile(storage, "a.txt", "first", 5);
+    SDL_WriteStorageFile(storage, "b.txt", "second", 6);
+    CheckCachedRead(storage, "a.txt", "first");
+    CheckCachedRead(storage, "a.txt", "first");
+    CheckCacheCounts(storage, "Reading a file twice", 1, 1);
+
+    /* Writing through the cache drops the old contents, even if the size and time don't change */
+    SDL_WriteStorageFile(storage, "a.txt", "FIRST", 5);
+    CheckCachedRead(storage, "a.txt", "FIRST");
+    CheckCacheCounts(storage, "Reading a file after writing it", 1, 2);
+
+    /* Changes made behind the cache's back are noticed by size */
+    io = SDL_IOFromFile("testfilesystem-cache/a.txt", "wb");
+    if (io) {
+        SDL_WriteIO(io, "changed", 7);
+        SDL_CloseIO(io);
+    }
+    CheckCachedRead(storage, "a.txt", "changed");
+    CheckCacheCounts(storage, "Reading a file changed outside the cache", 1, 3);
+
+    /* Both files don't fit in 10 bytes, so reading one evicts the other */
+    CheckCachedRead(storage, "b.txt", "second");
+    CheckCachedRead(storage, "b.txt", "second");
+    CheckCachedRead(storage, "a.txt", "changed");
+    CheckCacheCounts(storage, "Reading past the cache size", 2, 5);
+    CheckCachedRead(storage, "a.txt", "changed");
+    CheckCacheCounts(storage, "Reading the newest file", 3, 5);
+    if (SDL_GetNumberProperty(SDL_GetStorageProperties(storage), SDL_PROP_STORAGE_CACHE_SIZE_NUMBER, -1) > 10) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cache grew past its limit");
+    }
+
+    SDL_RenameStoragePath(storage, "b.txt", "a.txt");
+    CheckCachedRead(storage, "a.txt", "second");
+    CheckCacheCounts(storage, "Reading a file replaced by a rename", 3, 6);
+
+    SDL_RemoveStoragePath(storage, "a.txt");
+    if (SDL_ReadStorageFile(storage, "a.txt", scratch, sizeof(scratch)) == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Reading a removed file through the cache should have failed");
+    }
+
+    SDL_CloseStorage(storage);
+    SDL_RemovePath(dir);
+}
+
+/* Copy through a small buffer the way SDL_CopyFile() used to, for comparison */
+static int CopyFileSlowly(const char *oldpath, const char *newpath)
+{
+    char buffer[4096];
+    SDL_IOStream *input = SDL_IOFromFile(oldpath, "rb");
+    SDL_IOStream *output = SDL_IOFromFile(newpath, "wb");
+    size_t len;
+    int retval = 0;
+
+    if (!input || !output) {
+        retval = -1;
+    } else {
+        while ((len = SDL_ReadIO(input, buffer, sizeof(buffer))) > 0) {
+            if (SDL_WriteIO(output, buffer, len) < len) {
+                retval = -1;
+                break;
+            }
+        }
+    }
+    if (input) {
+        SDL_CloseIO(input);
+    }
+    if (output && SDL_CloseIO(output) < 0) {
+        retval = -1;
+    }
+    return retval;
+}
+
+static SDL_bool FilesMatch(const char *a, const char *b)
+{
+    size_t sizeA = 0, sizeB = 0;
+    void *dataA = SDL_LoadFile(a, &sizeA);
+    void *dataB = SDL_LoadFile(b, &sizeB);
+    const SDL_bool match = (dataA && dataB && sizeA == sizeB && SDL_memcmp(dataA, dataB, sizeA) == 0);
+
+    SDL_free(dataA);
+    SDL_free(dataB);
+    return match;
+}
+
+static void BenchmarkCopyFile(int size_mb)
+{
+    const char *source = "testfilesystem-copy-src";
+    const char *dest = "testfilesystem-copy-dst";
+    const Uint64 size = (Uint64)size_mb * 1024 * 1024;
+    Uint64 start, seed = 0x1234;
+    Uint8 block[64 * 1024];
+    SDL_IOStream *stream;
+    double seconds;
+    Uint64 i;
+
+    stream = SDL_IOFromFile(source, "wb");
+    if (!stream) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_IOFromFile('%s', 'wb') failed: %s", source, SDL_GetError());
+        return;
+    }
+    for (i = 0; i < size; i += sizeof(block)) {
+        size_t j;
+        for (j = 0; j < sizeof(block); ++j) {
+            block[j] = (Uint8)SDL_rand_r(&seed, 256);
+        }
+        SDL_WriteIO(stream, block, (size_t)SDL_min(size - i, sizeof(block)));
+    }
+    SDL_CloseIO(stream);
+
+    start = SDL_GetTicksNS();
+    if (CopyFileSlowly(source, dest) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Copying '%s' with a 4 KB buffer failed: %s", source, SDL_GetError());
+    } else {
+        seconds = (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_SECOND;
+        SDL_Log("Copied %d MB with a 4 KB buffer in %.1f ms (%.1f MB/s)", size_mb, seconds * 1000.0, size_mb / seconds);
+    }
+    SDL_RemovePath(dest);
+
+    start = SDL_GetTicksNS();
+    if (SDL_CopyFile(source, dest) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CopyFile('%s', '%s') failed: %s", source, dest, SDL_GetError());
+    } else {
+        seconds = (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_SECOND;
+        SDL_Log("Copied %d MB with SDL_CopyFile() in %.1f ms (%.1f MB/s)", size_mb, seconds * 1000.0, size_mb / seconds);
+        if (!FilesMatch(source, dest)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Contents of '%s' didn't match '%s'", dest, source);
+        }
+    }
+    SDL_RemovePath(dest);
+    SDL_RemovePath(source);
+}
+
 int main(int argc, char *argv[])
 {
     SDLTest_CommonState *state;
     char *pref_path;
     const char *base_path;
+    int copy_benchmark_mb = 0;
+    const char *enumerate_benchmark_path = NULL;
+    int i;
 
     /* Initialize test framework */
     state = SDLTest_CommonCreateState(argv, 0);
@@ -74,8 +573,26 @@ int main(int argc, char *argv[])
     SDL_SetLogPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
 
     /* Parse commandline */
-    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
-        return 1;
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--copy-benchmark") == 0 && argv[i + 1]) {
+                copy_benchmark_mb = SDL_atoi(argv[i + 1]);
+                consumed = (copy_benchmark_mb > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--enumerate-benchmark") == 0 && argv[i + 1]) {
+                enumerate_benchmark_path = argv[i + 1];
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--copy-benchmark MB]", "[--enumerate-benchmark PATH]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
     }
 
     if (SDL_Init(0) == -1) {
@@ -118,17 +635,22 @@ int main(int argc, char *argv[])
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Base path enumeration failed!");
         }
 
+        TestEnumerateWithInfo(base_path);
+
         globlist = SDL_GlobDirectory(base_path, "*/test*/T?st*", SDL_GLOB_CASEINSENSITIVE, NULL);
         if (!globlist) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Base path globbing failed!");
         } else {
-            int i;
             for (i = 0; globlist[i]; i++) {
                 SDL_Log("GLOB[%d]: '%s'", i, globlist[i]);
             }
             SDL_free(globlist);
         }
 
+        TestGlob();
+        TestPackStorage();
+        TestCachedStorage();
+
         /* !!! FIXME: put this in a subroutine and make it test more thoroughly (and put it in testautomation). */
         if (SDL_CreateDirectory("testfilesystem-test") == -1) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateDirectory('testfilesystem-test') failed: %s", SDL_GetError());
@@ -183,6 +705,14 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (copy_benchmark_mb > 0) {
+        BenchmarkCopyFile(copy_benchmark_mb);
+    }
+
+    if (enumerate_benchmark_path) {
+        BenchmarkEnumerate(enumerate_benchmark_path);
+    }
+
     SDL_Quit();
     SDLTest_CommonDestroyState(state);
     return 0;
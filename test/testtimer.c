@@ -72,6 +72,141 @@ callback(void *param, SDL_TimerID timerID, Uint32 interval)
     return interval;
 }
 
+/* Lateness buckets for the wakeup jitter histogram, in microseconds */
+static const int jitter_buckets_us[] = { 5, 10, 25, 50, 100, 250, 500, 1000 };
+
+static void log_jitter_histogram(const char *what, const Uint64 *late_ns, int count)
+{
+    int histogram[SDL_arraysize(jitter_buckets_us) + 1];
+    Uint64 total = 0, worst = 0;
+    int i, b;
+
+    SDL_zeroa(histogram);
+    for (i = 0; i < count; ++i) {
+        const Uint64 late_us = late_ns[i] / SDL_NS_PER_US;
+        for (b = 0; b < SDL_arraysize(jitter_buckets_us); ++b) {
+            if (late_us < (Uint64)jitter_buckets_us[b]) {
+                break;
+            }
+        }
+        ++histogram[b];
+        total += late_ns[i];
+        worst = SDL_max(worst, late_ns[i]);
+    }
+
+    SDL_Log("%s: average %.1f us late, worst %.1f us\n", what, (double)total / count / SDL_NS_PER_US, (double)worst / SDL_NS_PER_US);
+    for (b = 0; b < SDL_arraysize(histogram); ++b) {
+        char bar[51];
+        const int len = (histogram[b] * 50 + count - 1) / count;
+        SDL_memset(bar, '#', len);
+        bar[len] = '\0';
+        if (b < SDL_arraysize(jitter_buckets_us)) {
+            SDL_Log("  < %4d us: %5d %s\n", jitter_buckets_us[b], histogram[b], bar);
+        } else {
+            SDL_Log("  >=%4d us: %5d %s\n", jitter_buckets_us[b - 1], histogram[b], bar);
+        }
+    }
+}
+
+/* Run a frame loop at a fixed rate and record how late each frame started */
+static void measure_frame_jitter(int fps, int frames, SDL_bool absolute)
+{
+    const Uint64 interval = SDL_NS_PER_SECOND / fps;
+    Uint64 *late_ns = (Uint64 *)SDL_malloc(frames * sizeof(*late_ns));
+    Uint64 start, deadline, now;
+    char what[64];
+    int i;
+
+    if (!late_ns) {
+        return;
+    }
+
+    start = SDL_GetTicksNS();
+    deadline = start;
+    for (i = 0; i < frames; ++i) {
+        deadline += interval;
+        if (absolute) {
+            SDL_DelayUntilNS(deadline);
+        } else {
+            SDL_DelayNS(interval);
+        }
+        now = SDL_GetTicksNS();
+        late_ns[i] = (now > deadline) ? (now - deadline) : 0;
+        if (!absolute) {
+            /* each relative delay starts from when the last one ended */
+            deadline = now;
+        }
+    }
+    now = SDL_GetTicksNS();
+
+    SDL_snprintf(what, sizeof(what), "%d frames at %d FPS with %s", frames, fps, absolute ? "SDL_DelayUntilNS" : "SDL_DelayNS");
+    log_jitter_histogram(what, late_ns, frames);
+    SDL_Log("  took %.3f ms, expected %.3f ms\n", (double)(now - start) / SDL_NS_PER_MS, (double)(interval * frames) / SDL_NS_PER_MS);
+
+    SDL_free(late_ns);
+}
+
+static SDL_AtomicInt fired;
+
+static Uint64 SDLCALL
+fire_once(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    SDL_AtomicIncRef(&fired);
+    return 0;
+}
+
+static void benchmark_timers(int count)
+{
+    SDL_TimerID *ids = (SDL_TimerID *)SDL_malloc(count * sizeof(*ids));
+    Uint64 seed = 0x5eed;
+    Uint64 start, elapsed;
+    int i, failed = 0;
+
+    if (!ids) {
+        return;
+    }
+
+    /* Timers far in the future, removed in random order before any of them fire */
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        ids[i] = SDL_AddTimerNS(SDL_NS_PER_SECOND * 10 + SDL_rand_r(&seed, SDL_NS_PER_SECOND), ticktockNS, NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    SDL_Log("Adding %d timers took %.1f ms\n", count, (double)elapsed / SDL_NS_PER_MS);
+
+    for (i = count - 1; i > 0; --i) {
+        const int j = SDL_rand_r(&seed, i + 1);
+        const SDL_TimerID tmp = ids[i];
+        ids[i] = ids[j];
+        ids[j] = tmp;
+    }
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        if (SDL_RemoveTimer(ids[i]) < 0) {
+            ++failed;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    SDL_Log("Removing %d timers took %.1f ms\n", count, (double)elapsed / SDL_NS_PER_MS);
+    if (failed) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't remove %d timers\n", failed);
+    }
+
+    /* Short-lived timers that all fire */
+    SDL_AtomicSet(&fired, 0);
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        SDL_AddTimerNS(1 + SDL_rand_r(&seed, 10 * SDL_NS_PER_MS), fire_once, NULL);
+    }
+    while (SDL_AtomicGet(&fired) < count && (SDL_GetTicksNS() - start) < 10 * SDL_NS_PER_SECOND) {
+        SDL_Delay(1);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    SDL_Log("%d of %d short timers fired in %.1f ms\n", SDL_AtomicGet(&fired), count, (double)elapsed / SDL_NS_PER_MS);
+
+    SDL_free(ids);
+}
+
 int main(int argc, char *argv[])
 {
     int i;
@@ -211,6 +346,10 @@ int main(int argc, char *argv[])
         SDL_Log("Overslept %.2f ms\n", (double)total_overslept / SDL_NS_PER_MS);
     }
 
+    /* Wakeup jitter, and drift over a second's worth of frames */
+    measure_frame_jitter(240, 240, SDL_FALSE);
+    measure_frame_jitter(240, 240, SDL_TRUE);
+
     /* Wait for the results to be seen */
     SDL_Delay(1 * 1000);
 
@@ -241,6 +380,8 @@ int main(int argc, char *argv[])
     SDL_RemoveTimer(t2);
     SDL_RemoveTimer(t3);
 
+    benchmark_timers(100000);
+
     ticks = 0;
     start_perf = SDL_GetPerformanceCounter();
     for (i = 0; i < 1000000; ++i) {